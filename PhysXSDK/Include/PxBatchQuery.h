@@ -45,6 +45,24 @@ class PxBatchQuery
 	*/
 	virtual	void							execute() = 0;
 
+	/**
+	\brief Executes batched queries in parallel on the scene's CPU dispatcher.
+
+	The queued queries are split into ranges that run as tasks, one of them on the calling thread, and the call blocks until all of them
+	are done. The results are identical to execute(), including their order and the placement of touch hits in the user buffers.
+
+	The queries run serially as with execute() if the scene has no CPU dispatcher, if there are too few queries, if PVD records scene
+	queries, or if any touch buffer is smaller than the sum of the maxTouchHits of the queued queries of its type.
+
+	\note The filter shaders can be called from several threads at the same time.
+	\note Must not be called from a task running on the scene's CPU dispatcher.
+
+	\param[in] maxNbTasks Maximum number of tasks. 0 uses one task per worker thread of the dispatcher, plus one for the calling thread.
+
+	@see execute() PxSceneDesc.cpuDispatcher
+	*/
+	virtual	void							executeParallel(PxU32 maxNbTasks = 0) = 0;
+
 	/**
 	\brief Gets the prefilter shader in use for this scene query.
 
@@ -1286,6 +1286,18 @@ class PxScene
 	*/
 	virtual void				forceDynamicTreeRebuild(bool rebuildStaticStructure, bool rebuildDynamicStructure)	= 0;
 
+	/**
+	\brief Retrieves the statistics of the pruning structures of static and dynamic objects.
+
+	The statistics of a #PxPruningStructure::eNONE structure are all zero.
+
+	\param[out] staticStats	Statistics of the structure containing static objects
+	\param[out] dynamicStats	Statistics of the structure containing dynamic objects
+
+	@see PxPruningStructureStatistics PxSceneDesc.staticStructure PxSceneDesc.dynamicStructure
+	*/
+	virtual void				getPruningStructureStatistics(PxPruningStructureStatistics& staticStats, PxPruningStructureStatistics& dynamicStats) const = 0;
+
 	/**
 	\brief Performs a raycast against objects in the scene, returns results in a PxRaycastBuffer object
 	or via a custom user callback implementation inheriting from PxRaycastCallback.
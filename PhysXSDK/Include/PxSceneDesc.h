@@ -49,6 +49,18 @@ dynamic AABB tree, without the per-frame overhead. This can be a good choice for
 objects, if no static objects are added, moved or removed after the scene has been
 created. If there is no such guarantee (e.g. when streaming parts of the world in and out),
 then the dynamic version is a better choice even for static objects.
+
+eSTATIC_QUANTIZED_AABB_TREE behaves like eSTATIC_AABB_TREE, but after each rebuild the tree is
+converted to a 4-wide tree with 16-bit quantized bounds, one cache line per node. It uses less than
+half the memory and is usually faster to query for large static worlds, at the cost of a slightly
+longer rebuild.
+
+eDYNAMIC_REFIT_AABB_TREE is a dynamic AABB tree that is not rebuilt continuously. Moved objects are
+refitted and the tree is locally restructured with tree rotations to keep its quality. A new tree is only
+built in the background when objects are added or removed, or when the SAH cost of the tree exceeds
+#PxSceneDesc::dynamicTreeRebuildQualityThreshold times its cost after the last rebuild. This avoids
+most of the per-frame rebuild cost of eDYNAMIC_AABB_TREE for scenes where many objects move but few are
+added or removed.
 */
 struct PxPruningStructure
 {
@@ -57,11 +69,54 @@ struct PxPruningStructure
 		eNONE,					//!< Using a simple data structure
 		eDYNAMIC_AABB_TREE,		//!< Using a dynamic AABB tree
 		eSTATIC_AABB_TREE,		//!< Using a static AABB tree
+		eSTATIC_QUANTIZED_AABB_TREE,	//!< Using a static AABB tree with compressed, cache line sized nodes
+		eDYNAMIC_REFIT_AABB_TREE,		//!< Using a dynamic AABB tree maintained with refits and rotations, rebuilt on demand
 
 		eLAST
 	};
 };
 
+/**
+\brief Statistics of the tree pruning structure of a scene.
+
+Counters accumulate from the creation of the scene.
+
+@see PxScene::getPruningStructureStatistics()
+*/
+struct PxPruningStructureStatistics
+{
+	/**
+	\brief Number of trees built, including full rebuilds of static trees.
+	*/
+	PxU32	nbRebuilds;
+
+	/**
+	\brief Number of times the current tree was refitted to moved objects.
+	*/
+	PxU32	nbRefits;
+
+	/**
+	\brief Number of tree rotations applied while refitting. Only #PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE rotates.
+	*/
+	PxU32	nbRotations;
+
+	/**
+	\brief SAH cost of the current tree divided by its cost when it was built, 1 for a fresh tree and larger when it degrades.
+
+	0 if there is no tree.
+
+	@see PxSceneDesc::dynamicTreeRebuildQualityThreshold
+	*/
+	PxReal	treeQuality;
+
+	/**
+	\brief True while a new tree is built in the background.
+	*/
+	bool	rebuildInProgress;
+
+	PxPruningStructureStatistics() : nbRebuilds(0), nbRefits(0), nbRotations(0), treeQuality(0.0f), rebuildInProgress(false)	{}
+};
+
 
 /**
 \brief The order in which collide and solve are run in a normal simulation time-step
@@ -248,6 +303,20 @@ struct PxSceneFlag
 		*/
 		eREQUIRE_RW_LOCK = (1 << 12),
 
+		/**
+		\brief Schedules the parallel rigid body solver by sub-islands instead of partitions.
+
+		Large islands are solved in parallel partition by partition, and all worker threads wait for a partition to be completed before they start on the next one.
+		With this flag the constraint batches of each partition are cut into chunks, and a chunk only waits for the chunks that last touched one of its bodies. This reduces
+		the time workers spend waiting and the traffic on the shared solver counters, the results are identical.
+
+		\note Only used with PxFrictionType::ePATCH, and for islands without articulations.
+		\note This flag is not mutable, and must be set in PxSceneDesc at scene creation.
+
+		<b>Default:</b> false
+		*/
+		eENABLE_SOLVER_SUB_ISLAND_SCHEDULING = (1 << 13),
+
 		/**
 		\brief Enables additional stabilization pass in solver
 
@@ -265,7 +334,39 @@ struct PxSceneFlag
 
 		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
 		*/
-		eENABLE_AVERAGE_POINT = (1 << 15)
+		eENABLE_AVERAGE_POINT = (1 << 15),
+
+		/**
+		\brief Lets the narrow phase allocate 16K contact data blocks beyond PxSceneDesc::maxNbContactDataBlocks
+
+		By default contacts are dropped and a warning is issued when all permitted 16K blocks are in use. With this flag set, maxNbContactDataBlocks 
+		becomes a soft limit: further blocks are allocated on demand, and blocks above the limit are freed again as soon as they are released, so 
+		memory only stays above the limit for the duration of the spike. The number of blocks over the limit is reported in 
+		PxSimulationStatistics::nbContactDataBlocksOverLimit.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default:</b> false
+
+		@see PxSceneDesc.maxNbContactDataBlocks PxSimulationStatistics.nbContactDataBlocks
+		*/
+		eENABLE_CONTACT_DATA_BLOCK_GROWTH = (1 << 7),
+
+		/**
+		\brief Lets the SAP broad-phase park the bounds of objects that have not moved for a few frames
+
+		Bounds that have not been updated for a few simulation steps (sleeping bodies and static shapes) are taken out of the sorted 
+		axis lists of the sweep-and-prune and only tested against the bounds that move, until they are updated again. With many sleeping 
+		or static objects, the cost of a broad-phase update then mostly depends on the number of moving objects. The reported pairs are 
+		the same as without the flag.
+
+		Note that this flag is not mutable and must be set in PxSceneDesc at scene creation. It only applies to PxBroadPhaseType::eSAP.
+
+		<b>Default:</b> false
+
+		@see PxBroadPhaseType
+		*/
+		eENABLE_BROADPHASE_PARKING = (1 << 8)
 
 	};
 };
@@ -572,7 +673,8 @@ public:
 	/**
 	\brief Defines the structure used to store static objects.
 
-	\note Only PxPruningStructure::eSTATIC_AABB_TREE and PxPruningStructure::eDYNAMIC_AABB_TREE are allowed here.
+	\note Only PxPruningStructure::eSTATIC_AABB_TREE, PxPruningStructure::eSTATIC_QUANTIZED_AABB_TREE, PxPruningStructure::eDYNAMIC_AABB_TREE
+	and PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE are allowed here.
 	*/
 	PxPruningStructure::Enum	staticStructure;
 
@@ -590,7 +692,8 @@ public:
 	structure will get more and more outdated the longer the rebuild takes (which can make
 	scene queries less efficient).
 
-	\note Only used for #PxPruningStructure::eDYNAMIC_AABB_TREE pruning structure.
+	\note Only used for #PxPruningStructure::eDYNAMIC_AABB_TREE and #PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE pruning structures.
+	The latter only goes through a rebuild when one is needed, see #dynamicTreeRebuildQualityThreshold.
 
 	\note This parameter gives only a hint. The rebuild process might still take more or less time depending on the
 	number of objects involved.
@@ -600,6 +703,18 @@ public:
 	*/
 	PxU32					dynamicTreeRebuildRateHint;
 
+	/**
+	\brief Tree quality at which a #PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE pruning structure starts a rebuild.
+
+	The quality is the SAH cost of the tree divided by its cost right after it was built, see #PxPruningStructureStatistics::treeQuality.
+	Refits let the tree degrade as objects move, rotations recover part of it. Once the quality exceeds this value, a new tree
+	is built over #dynamicTreeRebuildRateHint frames.
+
+	<b>Range:</b> [1, PX_MAX_F32)<br>
+	<b>Default:</b> 1.5
+	*/
+	PxReal					dynamicTreeRebuildQualityThreshold;
+
 	/**
 	\brief Will be copied to PxScene::userData.
 
@@ -645,7 +760,7 @@ public:
 	allocated. This variable controls the maximum number of blocks that the SDK can allocate.
 
 	In the case that the scene is sufficiently complex that all the permitted 16K blocks are used, contacts will be dropped and 
-	a warning passed to the error stream.
+	a warning passed to the error stream, unless PxSceneFlag::eENABLE_CONTACT_DATA_BLOCK_GROWTH is set.
 
 	If a warning is reported to the error stream to indicate the number of 16K blocks is insufficient for the scene complexity 
 	then the choices are either (i) re-tune the number of 16K data blocks until a number is found that is sufficient for the scene complexity,
@@ -800,6 +915,7 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 	staticStructure						(PxPruningStructure::eDYNAMIC_AABB_TREE),
 	dynamicStructure					(PxPruningStructure::eDYNAMIC_AABB_TREE),
 	dynamicTreeRebuildRateHint			(100),
+	dynamicTreeRebuildQualityThreshold	(1.5f),
 
 	userData							(NULL),
 
@@ -839,12 +955,16 @@ PX_INLINE bool PxSceneDesc::isValid() const
 	if(!limits.isValid())
 		return false;
 
-	if(staticStructure!=PxPruningStructure::eSTATIC_AABB_TREE && staticStructure!=PxPruningStructure::eDYNAMIC_AABB_TREE)
+	if(staticStructure!=PxPruningStructure::eSTATIC_AABB_TREE && staticStructure!=PxPruningStructure::eSTATIC_QUANTIZED_AABB_TREE && staticStructure!=PxPruningStructure::eDYNAMIC_AABB_TREE
+		&& staticStructure!=PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE)
 		return false;
 
 	if(dynamicTreeRebuildRateHint < 4)
 		return false;
 
+	if(!(dynamicTreeRebuildQualityThreshold >= 1.0f))
+		return false;
+
 	if(meshContactMargin < 0.0f)
 		return false;
 	if(contactCorrelationDistance < 0.0f)
@@ -60,6 +60,15 @@ public:
 		eVOLUME_COUNT
 	};
 
+	enum
+	{
+		/**
+		\brief Number of entries of the solver partition size histogram.
+		@see nbSolverPartitionsBySize
+		*/
+		eSOLVER_PARTITION_SIZE_BUCKETS = 12
+	};
+
 	/**
 	\brief Different types of rigid body collision pair statistics.
 	@see getRbPairStats
@@ -96,6 +105,45 @@ public:
 		eTRIGGER_PAIRS
 	};
 
+	/**
+	\brief The simulation phases that get timed for each simulation step.
+	@see getPhaseTime getNbPhaseTasks getPhaseWorkerUtilization
+	*/
+	enum PhaseType
+	{
+		/**
+		\brief Bounds update, broadphase and creation/destruction of the resulting pairs.
+		*/
+		eBROAD_PHASE,
+
+		/**
+		\brief Contact generation for the rigid body pairs.
+		*/
+		eNARROW_PHASE,
+
+		/**
+		\brief Island generation, including the narrowphase of pairs woken up by it.
+		*/
+		eISLAND_GEN,
+
+		/**
+		\brief Constraint preparation, the constraint solver and integration.
+		*/
+		eSOLVER,
+
+		/**
+		\brief Merging of the solver results, joint projection, sleep checks and touch updates.
+		*/
+		ePOST_SOLVER,
+
+		/**
+		\brief All CCD (continuous collision detection) passes. Only timed if PxSceneFlag::eENABLE_CCD is set.
+		*/
+		eCCD,
+
+		ePHASE_COUNT
+	};
+
 
 //objects:
 	/**
@@ -157,6 +205,120 @@ public:
 	*/
 	PxU32   peakConstraintMemory;
 
+	/**
+	\brief The number of 16K contact data blocks allocated by the scene at the end of the current simulation step.
+
+	@see PxSceneDesc.maxNbContactDataBlocks PxScene.getMaxNbContactDataBlocksUsed
+	*/
+	PxU32	nbContactDataBlocks;
+
+	/**
+	\brief The number of 16K contact data blocks that were allocated above PxSceneDesc::maxNbContactDataBlocks in the current simulation step.
+
+	Only non-zero if PxSceneFlag::eENABLE_CONTACT_DATA_BLOCK_GROWTH is set, without that flag the contacts that did not fit are dropped instead.
+	*/
+	PxU32	nbContactDataBlocksOverLimit;
+
+	/**
+	\brief The largest amount of memory (in bytes) reserved by a single narrow phase thread for contacts and contact caches in the current simulation step.
+	*/
+	PxU32	peakNarrowPhaseThreadMemory;
+
+	/**
+	\brief The number of constraint partitions used by the solver in the current simulation step, summed over all solver islands.
+
+	Constraints of the same partition share no dynamic body and are solved in parallel, the partitions of an island are solved one after the other.
+	*/
+	PxU32	nbSolverPartitions;
+
+	/**
+	\brief The number of constraints in the largest solver partition of the current simulation step.
+	*/
+	PxU32	maxSolverPartitionSize;
+
+	/**
+	\brief Histogram of the solver partition sizes in the current simulation step.
+
+	Entry i is the number of partitions with 2^i to 2^(i+1)-1 constraints, the last entry also counts all larger partitions.
+
+	@see nbSolverPartitions
+	*/
+	PxU32	nbSolverPartitionsBySize[eSOLVER_PARTITION_SIZE_BUCKETS];
+
+//timings:
+	/**
+	\brief The number of worker threads of the CPU dispatcher during the current simulation step.
+	*/
+	PxU32	nbWorkerThreads;
+
+	/**
+	\brief Get the wall clock time (in seconds) spent in a simulation phase for the current simulation step.
+
+	\param[in] phase The phase for which to get the time
+	\return Time between the start and the end of the phase, 0 if the phase did not run.
+
+	@see PhaseType
+	*/
+	PxReal getPhaseTime(PhaseType phase) const
+	{
+		if (phase != ePHASE_COUNT)
+			return phaseTime[phase];
+		else
+		{
+			PX_ASSERT(false);
+			return 0.0f;
+		}
+	}
+
+	/**
+	\brief Get the number of SDK tasks that ran during a simulation phase for the current simulation step.
+
+	\note The tasks are counted per process, tasks of other scenes simulating at the same time are included.
+
+	\param[in] phase The phase for which to get the number
+	\return Number of tasks that ran between the start and the end of the phase.
+
+	@see PhaseType
+	*/
+	PxU32 getNbPhaseTasks(PhaseType phase) const
+	{
+		if (phase != ePHASE_COUNT)
+			return nbPhaseTasks[phase];
+		else
+		{
+			PX_ASSERT(false);
+			return 0;
+		}
+	}
+
+	/**
+	\brief Get the fraction of the available threads that was busy running SDK tasks during a simulation phase for the current simulation step.
+
+	The available threads are the worker threads of the CPU dispatcher or, if it has none, the thread that calls simulate().
+
+	\note The tasks are counted per process, tasks of other scenes simulating at the same time are included.
+
+	\param[in] phase The phase for which to get the utilization
+	\return Time spent in tasks during the phase divided by the phase time times the number of threads, in the range [0, 1].
+
+	@see PhaseType nbWorkerThreads
+	*/
+	PxReal getPhaseWorkerUtilization(PhaseType phase) const
+	{
+		if (phase == ePHASE_COUNT)
+		{
+			PX_ASSERT(false);
+			return 0.0f;
+		}
+
+		const PxReal capacity = phaseTime[phase] * PxReal(nbWorkerThreads ? nbWorkerThreads : 1);
+		if (capacity <= 0.0f)
+			return 0.0f;
+
+		const PxReal utilization = phaseTaskTime[phase] / capacity;
+		return utilization < 1.0f ? utilization : 1.0f;
+	}
+
 //broadphase:
 	/**
 	\brief Get number of broadphase volumes of a certain type added for the current simulation step.
@@ -272,12 +434,28 @@ public:
 		compressedContactSize = 0;
 		requiredContactConstraintMemory = 0;
 		peakConstraintMemory = 0;
+		nbContactDataBlocks = 0;
+		nbContactDataBlocksOverLimit = 0;
+		peakNarrowPhaseThreadMemory = 0;
 
 		nbAxisSolverConstraints = 0;
 
+		nbSolverPartitions = 0;
+		maxSolverPartitionSize = 0;
+		for(PxU32 i=0; i < eSOLVER_PARTITION_SIZE_BUCKETS; i++)
+			nbSolverPartitionsBySize[i] = 0;
+
 		particlesGpuMeshCacheSize = 0;
 		particlesGpuMeshCacheUsed = 0;
 		particlesGpuMeshCacheHitrate = 0.0f;
+
+		nbWorkerThreads = 0;
+		for(PxU32 i=0; i < ePHASE_COUNT; i++)
+		{
+			phaseTime[i] = 0.0f;
+			nbPhaseTasks[i] = 0;
+			phaseTaskTime[i] = 0.0f;
+		}
 	}
 
 
@@ -299,6 +477,11 @@ public:
 	PxU32	particlesGpuMeshCacheSize;
 	PxU32	particlesGpuMeshCacheUsed;
 	PxReal	particlesGpuMeshCacheHitrate;
+
+//timings:
+	PxReal	phaseTime[ePHASE_COUNT];
+	PxU32	nbPhaseTasks[ePHASE_COUNT];
+	PxReal	phaseTaskTime[ePHASE_COUNT];
 };
 
 #ifndef PX_DOXYGEN
@@ -18,6 +18,7 @@
 */
 
 #include "characterkinematic/PxCharacter.h"
+#include "characterkinematic/PxController.h"
 
 #include "PxPhysXConfig.h"
 #include "foundation/PxFlags.h"
@@ -36,6 +37,7 @@ class PxController;
 class PxControllerDesc;
 class PxObstacleContext;
 class PxControllerFilterCallback;
+class PxCpuDispatcher;
 
 /**
 \brief specifies debug-rendering flags
@@ -186,6 +188,44 @@ public:
 	*/
 	virtual	void				computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb=NULL) = 0;
 
+	/**
+	\brief Moves an array of characters with tasks submitted to a cpu dispatcher.
+
+	Each controller is moved as with PxController::move(), using the corresponding displacement and the shared minDist, elapsedTime,
+	filters and obstacles. The controllers are split into chunks that are moved by tasks submitted to the dispatcher and by the
+	calling thread. The call returns once all controllers have moved.
+
+	CCT-vs-CCT interactions do not depend on the order in which the controllers are moved: each controller collides against the
+	other characters at the positions they had when the call was made. Characters moving towards each other can thus end up
+	overlapping, which computeInteractions() resolves on the next frame as usual. The results do not depend on the number of
+	worker threads.
+
+	\note The kinematic actors of the controllers are updated and the hits are reported to each controller's
+	PxUserControllerHitReport on the calling thread once all moves are complete, in the order of the controllers array.
+
+	\note Filtering callbacks and PxControllerBehaviorCallback are called from the tasks, so they must be thread-safe and must not write to the scene.
+
+	\note Each controller must belong to this manager and appear at most once in the array. The scene must not be written to during the call.
+
+	\note If the scene uses PxSceneFlag::eREQUIRE_RW_LOCK, or if there are too few controllers to be worth splitting, all controllers
+	are moved on the calling thread, with the same results.
+
+	\param[in] nbControllers	Number of controllers to move
+	\param[in] controllers		Array of nbControllers controllers to move
+	\param[in] displacements	Array of nbControllers displacement vectors, one per controller
+	\param[in] minDist			The minimum travelled distance to consider. See PxController::move().
+	\param[in] elapsedTime		Time elapsed since last call
+	\param[in] filters			User-defined filters for this move, shared by all controllers
+	\param[in] obstacles		Potential additional obstacles the CCTs should collide with.
+	\param[out] collisionFlags	Array of nbControllers collision flags (see PxControllerCollisionFlag), one per controller. A NULL pointer is permitted.
+	\param[in] dispatcher		The cpu dispatcher that runs the tasks. If NULL, the cpu dispatcher of the manager's scene is used.
+
+	@see PxController.move() computeInteractions() PxControllerFilters PxObstacleContext
+	*/
+	virtual	void				moveAll(PxU32 nbControllers, PxController* const* controllers, const PxVec3* displacements, PxF32 minDist, PxF32 elapsedTime,
+										const PxControllerFilters& filters, const PxObstacleContext* obstacles=NULL, PxControllerCollisionFlags* collisionFlags=NULL,
+										PxCpuDispatcher* dispatcher=NULL) = 0;
+
 	/**
 	\brief Enables or disables runtime tessellation.
 
@@ -25,6 +25,33 @@ namespace physx
 {
 #endif
 
+/**
+\brief Scheduling strategies of the default CPU dispatcher.
+
+@see PxDefaultCpuDispatcherCreate()
+*/
+struct PxDefaultCpuDispatcherMode
+{
+	enum Enum
+	{
+		/**
+		\brief All tasks go through one shared queue and all idle workers wake up on every submission.
+
+		Well suited for low worker counts.
+		*/
+		eSHARED_QUEUE,
+
+		/**
+		\brief Every worker owns a task deque.
+
+		Tasks submitted from a worker thread are pushed onto its own deque and popped in LIFO order,
+		idle workers steal from randomly chosen victims and spin for a while before going to sleep.
+		Tasks submitted from other threads go through a shared queue. Scales better on high core counts.
+		*/
+		eWORK_STEALING
+	};
+};
+
 /**
 \brief A default implementation for a CPU task dispatcher.
 
@@ -65,13 +92,14 @@ public:
 
 \param[in] numThreads Number of worker threads the dispatcher should use.
 \param[in] affinityMasks Array with affinity mask for each thread. If not defined, default masks will be used.
+\param[in] mode Scheduling strategy used to distribute tasks among the worker threads.
 
 \note numThreads may be zero in which case no worker thread are initialized and
 simulation tasks will be executed on the thread that calls PxScene::simulate()
 
-@see PxDefaultCpuDispatcher
+@see PxDefaultCpuDispatcher PxDefaultCpuDispatcherMode
 */
-PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL);
+PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks = NULL, PxDefaultCpuDispatcherMode::Enum mode = PxDefaultCpuDispatcherMode::eSHARED_QUEUE);
 
 #ifndef PX_DOXYGEN
 } // namespace physx
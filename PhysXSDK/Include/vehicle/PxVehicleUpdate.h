@@ -32,6 +32,7 @@ namespace physx
 	class PxVehicleWheels;
 	class PxVehicleDrivableSurfaceToTireFrictionPairs;
 	class PxVehicleTelemetryData;
+	class PxCpuDispatcher;
 
 	/**
 	\brief Structure containing data describing the non-persistent state of each suspension/wheel/tire unit.
@@ -321,11 +322,50 @@ namespace physx
 	to the position of the base of the wheel at maximum droop.  Raycasts that start inside a PxShape are subsequently ignored by the
 	corresponding vehicle.
 
+	\note Vehicles with a non-zero PxVehicleWheelsDynData::setSuspensionQueryValidityRadius skip the raycasts of each block of 4 wheels 
+	that has stayed within the validity radius of its pose at the most recent query and reuse the cached hit planes instead.  The 
+	results of the blocks that do issue raycasts are packed contiguously at the start of sceneQueryResults, so sceneQueryResults 
+	must not be indexed by wheel.  Use the PxWheelQueryResult of each wheel filled by PxVehicleUpdates to read the contact of a wheel.
+
 	@see PxVehicleDrive4W::setToRestState, PxVehicleDriveNW::setToRestState, PxVehicleDriveTank::setToRestState, PxVehicleNoDrive::setToRestState
 	*/
 	void PxVehicleSuspensionRaycasts
 		(PxBatchQuery* batchQuery, const PxU32 nbVehicles, PxVehicleWheels** vehicles, const PxU32 nbSceneQueryResults, PxRaycastQueryResult* sceneQueryResults, const bool* vehiclesToRaycast = NULL);
 
+	/**
+	\brief Perform sweeps of the wheel shapes along all suspension lines for all vehicles.
+
+	\param[in] batchQuery is a PxBatchQuery instance used to specify shader data and functions for the sweep scene queries.
+
+	\param[in] nbVehicles is the number of vehicles in the vehicles array.
+
+	\param[in] vehicles is an array of all vehicles that are to have a sweep issued from each wheel. 
+
+	\param[in] nbSceneQueryResults must be greater than or equal to the total number of wheels of all the vehicles in the vehicles array; that is,
+	sceneQueryResults must have dimensions large enough for one sweep hit result per wheel for all the vehicles in the vehicles array.
+
+	\param[in] sceneQueryResults must persist without being overwritten until the end of the next PxVehicleUpdates call. 
+
+	\param[in] vehiclesToSweep is an array of bools of length nbVehicles that is used to decide if sweeps will be performed for the corresponding vehicle
+	in the vehicles array.  It has the same meaning as vehiclesToRaycast in PxVehicleSuspensionRaycasts.
+
+	\note Each sweep moves the geometry of the wheel shape along the suspension travel direction from the position of the wheel at maximum 
+	suspension compression to the position of the wheel at maximum droop.  Unlike a raycast, a sweep detects kerbs and steps in front of or behind the 
+	base of the wheel so the wheel rides up onto them instead of popping up when the suspension line reaches them.
+
+	\note The wheel shape is found with PxVehicleWheelsSimData::getWheelShapeMapping.  Wheels without a shape or with a shape that is not a 
+	convex mesh, sphere, capsule or box sweep a sphere with the radius of the wheel.
+
+	\note Sweeps that start inside a PxShape are subsequently ignored by the corresponding vehicle.
+
+	\note Hit planes are cached and reused in exactly the same way as for PxVehicleSuspensionRaycasts.  Raycasts and sweeps may be mixed 
+	freely from one update to the next.
+
+	@see PxVehicleSuspensionRaycasts, PxVehicleWheelsDynData::setSuspensionQueryValidityRadius
+	*/
+	void PxVehicleSuspensionSweeps
+		(PxBatchQuery* batchQuery, const PxU32 nbVehicles, PxVehicleWheels** vehicles, const PxU32 nbSceneQueryResults, PxSweepQueryResult* sceneQueryResults, const bool* vehiclesToSweep = NULL);
+
 
 	/**
 	\brief Update an array of vehicles by either applying an acceleration to the rigid body actor associated with 
@@ -356,6 +396,9 @@ namespace physx
 	
 	\note The vehicleWheelQueryResults buffer is left unmodified for vehicles with sleeping rigid bodies whose control inputs indicate they should remain inert.
 
+	\note The vehicleWheelQueryResults buffer is left unmodified for vehicles with PxVehicleUpdateLOD::eREDUCED_RATE or PxVehicleUpdateLOD::eSIMPLIFIED 
+	that are skipped because their LOD update interval has not elapsed.
+
 	\note If PxVehicleUpdates is called concurrently then vehicleConcurrentUpdates must be specified.  Do not specify vehicleConcurrentUpdates is PxVehicleUpdates
 	is not called concurrently.
 
@@ -393,6 +436,48 @@ namespace physx
 		const PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, const PxU32 nbVehicles, PxVehicleWheels** vehicles);
 
 
+	/**
+	\brief Update an array of vehicles with tasks submitted to a cpu dispatcher and then apply the post-updates of all vehicles.
+
+	The vehicles array is split into contiguous chunks of similar cost, with the cost of each vehicle estimated from its number of active 
+	wheels and its drive model.  The chunks are updated as with concurrent calls to PxVehicleUpdates by tasks submitted to the dispatcher and 
+	by the calling thread.  When all chunks are complete PxVehiclePostUpdates is applied to all vehicles on the calling thread.
+
+	\param[in] timestep is the timestep of the update
+
+	\param[in] gravity is the value of gravitational acceleration
+
+	\param[in] vehicleDrivableSurfaceToTireFrictionPairs describes the mapping between each PxMaterial ptr and an integer representing a 
+	surface type. It also stores the friction value for each combination of surface and tire type.
+
+	\param[in] nbVehicles is the number of vehicles pointers in the vehicles array
+
+	\param[in, out] vehicles is an array of length nbVehicles containing all vehicles to be updated by the specified timestep
+
+	\param[out] vehicleWheelQueryResults is an array of length nbVehicles storing the wheel query results of each corresponding vehicle and wheel in the 
+	vehicles array.  A NULL pointer is permitted.
+
+	\param[out] vehicleConcurrentUpdates is an array of length nbVehicles that stores the data computed by the tasks that is applied in the post-update.
+	It must be configured as for concurrent calls to PxVehicleUpdates.  A NULL pointer is not permitted.
+
+	\param[in] dispatcher is the cpu dispatcher that runs the update tasks.  This is typically the cpu dispatcher of the scene of the vehicles.
+
+	\note The update tasks must not run concurrently with any other write to the scene of the vehicles.  The call returns once all tasks are complete.
+
+	\note If the dispatcher has no worker threads or there are too few vehicles to be worth splitting then all vehicles are updated on the calling 
+	thread with PxVehicleUpdates, without any use of vehicleConcurrentUpdates.
+
+	\note Scene writes from different threads are not permitted, so the post-updates are applied sequentially on the calling thread.
+
+	@see PxVehicleUpdates, PxVehiclePostUpdates, PxVehicleConcurrentUpdateData
+	*/
+	void PxVehicleUpdatesParallel(
+		const PxReal timestep, const PxVec3& gravity, 
+		const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+		const PxU32 nbVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, 
+		PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, PxCpuDispatcher& dispatcher);
+
+
 	/**
 	\brief Shift the origin of vehicles by the specified vector.
 
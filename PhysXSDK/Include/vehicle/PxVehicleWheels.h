@@ -532,6 +532,30 @@ public:
 	*/
 	void copy(const PxVehicleWheelsDynData& src, const PxU32 srcWheel, const PxU32 trgWheel);
 
+	/**
+	\brief Set the radius of the volume around each wheel in which suspension query hits may be reused.
+	
+	With a radius greater than zero the suspension queries are lengthened by the radius and the hit planes found by them are cached.  
+	PxVehicleSuspensionRaycasts and PxVehicleSuspensionSweeps then skip the query for each block of 4 wheels
+	whose wheels, and the points where their suspension lines meet the cached hit planes, have not moved further than the radius 
+	since the most recent query.  PxVehicleUpdates reuses the cached hit planes of the skipped blocks.
+	Blocks that touched a PxRigidDynamic are always queried again.
+
+	\param[in] radius is the radius of the validity volume.  A value of zero (the default) disables query reuse.
+
+	\note Reusing hit planes misses geometry that enters the validity volume after the query.  Keep the radius small 
+	compared to the scale of the features of the drivable geometry.
+
+	@see getSuspensionQueryValidityRadius, PxVehicleSuspensionRaycasts, PxVehicleSuspensionSweeps
+	*/
+	void setSuspensionQueryValidityRadius(const PxReal radius);
+
+	/**
+	\brief Return the radius of the volume around each wheel in which suspension query hits may be reused.
+	@see setSuspensionQueryValidityRadius
+	*/
+	PxReal getSuspensionQueryValidityRadius() const {return mSuspensionQueryValidityRadius;}
+
 private:
 
     /**
@@ -565,7 +589,13 @@ private:
 	*/
 	PxU32 mNbActiveWheels;
 
-	PxU32 mPad[3];
+	/**
+	\brief Radius of the volume around each wheel in which suspension query hits may be reused.
+	@see setSuspensionQueryValidityRadius
+	*/
+	PxReal mSuspensionQueryValidityRadius;
+
+	PxU32 mPad[2];
 
 
 //serialization
@@ -578,6 +608,47 @@ public:
 };
 PX_COMPILE_TIME_ASSERT(0==(sizeof(PxVehicleWheelsDynData) & 15));
 
+/**
+\brief Level of detail used by PxVehicleUpdates to update a vehicle.
+@see PxVehicleWheels::setUpdateLOD, PxVehicleWheels::setLODUpdateInterval
+*/
+struct PxVehicleUpdateLOD
+{
+	enum Enum
+	{
+		/**
+		\brief The vehicle is updated with the full model each time PxVehicleUpdates is called.
+		*/
+		eFULL=0,
+
+		/**
+		\brief The vehicle is updated with the full model but only once per LOD update interval.
+		The elapsed time is accumulated across calls to PxVehicleUpdates and consumed in a single 
+		update when it reaches the LOD update interval.  The momentum change of that update is applied to 
+		the vehicle's actor, and to the actors hit by the wheels, over the timestep of the last call, so the 
+		timestep passed to PxVehicleUpdates must match the scene's timestep.
+		\note Calls to PxVehicleUpdates that skip the vehicle do not write its PxVehicleWheelQueryResult.  The results 
+		of the last update are only available if the same buffer is passed for the vehicle to each call.
+		*/
+		eREDUCED_RATE,
+
+		/**
+		\brief As eREDUCED_RATE but with a simplified model.  The engine, clutch and differential are not 
+		integrated: the engine is treated as rigidly coupled to the driven wheels through the current gear, 
+		the drive torque is split between the wheels with the differential's torque ratios and the engine 
+		rotation speed follows the speed of the driven wheels.  Tire forces are computed from the linear 
+		tire stiffnesses clamped to the friction circle instead of with the tire force shader of the vehicle.
+		\note Gear changes and the autobox still run.  With the engine rigidly coupled to the wheels the gear 
+		ratio sets the drive torque and the engine speed, so a vehicle held in the gear it had when it entered 
+		eSIMPLIFIED would be limited to the speed range of that gear.  The gear logic is bookkeeping on the 
+		current gear and costs nothing next to the wheels.
+		*/
+		eSIMPLIFIED,
+
+		eMAX_NB_UPDATE_LODS
+	};
+};
+
 /**
 \brief Data structure with instanced dynamics data and configuration data of a vehicle with just wheels
 @see PxVehicleDrive, PxVehicleDrive4W, PxVehicleDriveTank
@@ -623,6 +694,45 @@ public:
 	*/
 	PxReal computeSidewaysSpeed() const;
 
+	/**
+	\brief Set the level of detail used to update the vehicle.
+
+	\note The vehicle may be moved between levels of detail at any time.  The wheel rotation speeds, engine 
+	rotation speed and current gear are carried over so that the transition is smooth.  Any time that has 
+	been accumulated but not yet consumed by a reduced rate update is consumed by the next update of the 
+	vehicle, whichever the level of detail.
+
+	\note If a vehicle is not updated by a call to PxVehicleUpdates because the accumulated time has not 
+	yet reached the LOD update interval then its PxVehicleWheelQueryResult is left unchanged.
+
+	@see PxVehicleUpdateLOD, setLODUpdateInterval
+	*/
+	void setUpdateLOD(const PxVehicleUpdateLOD::Enum lod);
+
+	/**
+	\brief Return the level of detail used to update the vehicle.
+	@see setUpdateLOD
+	*/
+	PX_FORCE_INLINE PxVehicleUpdateLOD::Enum getUpdateLOD() const {return (PxVehicleUpdateLOD::Enum)mUpdateLOD;}
+
+	/**
+	\brief Set the minimum time that elapses between updates of the vehicle when the level of detail is 
+	PxVehicleUpdateLOD::eREDUCED_RATE or PxVehicleUpdateLOD::eSIMPLIFIED.
+
+	\note Default value is 0.05 (20 updates per second).
+
+	<b>Range:</b> (0, PX_MAX_F32)<br>
+
+	@see setUpdateLOD
+	*/
+	void setLODUpdateInterval(const PxReal interval);
+
+	/**
+	\brief Return the minimum time that elapses between updates of the vehicle with reduced levels of detail.
+	@see setLODUpdateInterval
+	*/
+	PX_FORCE_INLINE PxReal getLODUpdateInterval() const {return mLODUpdateInterval;}
+
 	/**
 	\brief Data describing the setup of all the wheels/suspensions/tires.
 	*/
@@ -690,11 +800,28 @@ protected:
 	\brief Vehicle type (eVehicleDriveTypes)
 	*/
 	PxU8 mType;
+
+	/**
+	\brief Level of detail used to update the vehicle (PxVehicleUpdateLOD)
+	*/
+	PxU8 mUpdateLOD;
+
+	PxU8 mPad0;
+
+	/**
+	\brief Minimum time between updates with reduced levels of detail.
+	*/
+	PxReal mLODUpdateInterval;
+
+	/**
+	\brief Time that has elapsed since the last update with reduced levels of detail.
+	*/
+	PxReal mLODAccumulatedTime;
 		
 #if defined(PX_P64)
-	PxU8 mPad[14];
+	PxU8 mPad[4];
 #else
-	PxU8 mPad[14];
+	PxU8 mPad[4];
 #endif
 
 //serialization
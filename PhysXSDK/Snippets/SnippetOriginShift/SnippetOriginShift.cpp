@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2008-2015, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+
+// ****************************************************************************
+// This snippet measures PxScene::shiftOrigin() on a scene with 100k actors.
+//
+// The scene is created twice, first with a CPU dispatcher without worker
+// threads, in which case the shift runs on the calling thread, then with one
+// worker thread per physical core, in which case the actors and the scene query
+// structures are shifted by tasks on the dispatcher.
+// ****************************************************************************
+
+#include <ctype.h>
+
+#include "PxPhysicsAPI.h"
+
+#include "../SnippetCommon/SnippetPrint.h"
+#include "../SnippetUtils/SnippetUtils.h"
+
+
+using namespace physx;
+
+PxDefaultAllocator		gAllocator;
+PxDefaultErrorCallback	gErrorCallback;
+
+PxFoundation*			gFoundation = NULL;
+PxPhysics*				gPhysics	= NULL;
+
+PxDefaultCpuDispatcher*	gDispatcher = NULL;
+PxScene*				gScene		= NULL;
+
+PxMaterial*				gMaterial	= NULL;
+
+const PxU32				gGridSize	= 224;		// gGridSize*gGridSize*2 ~= 100k actors
+const PxReal			gSpacing	= 4.0f;
+const PxU32				gShiftCount	= 20;
+
+
+void createActors()
+{
+	PxShape* boxShape = gPhysics->createShape(PxBoxGeometry(1.0f, 1.0f, 1.0f), *gMaterial);
+	PxShape* sphereShape = gPhysics->createShape(PxSphereGeometry(0.5f), *gMaterial);
+
+	// one static box and one dynamic sphere per grid cell, far enough apart to never touch
+	PxActor** actors = new PxActor*[gGridSize*gGridSize*2];
+	PxU32 nbActors = 0;
+	for(PxU32 i=0; i<gGridSize; i++)
+	{
+		for(PxU32 j=0; j<gGridSize; j++)
+		{
+			const PxVec3 pos(PxReal(i)*gSpacing, 0.0f, PxReal(j)*gSpacing);
+
+			PxRigidStatic* box = gPhysics->createRigidStatic(PxTransform(pos));
+			box->attachShape(*boxShape);
+			actors[nbActors++] = box;
+
+			PxRigidDynamic* sphere = gPhysics->createRigidDynamic(PxTransform(pos + PxVec3(0.0f, 2.0f, 0.0f)));
+			sphere->attachShape(*sphereShape);
+			PxRigidBodyExt::updateMassAndInertia(*sphere, 1.0f);
+			actors[nbActors++] = sphere;
+		}
+	}
+	gScene->addActors(actors, nbActors);
+	delete[] actors;
+
+	boxShape->release();
+	sphereShape->release();
+}
+
+void initPhysics(PxU32 nbThreads)
+{
+	gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
+	gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale());
+
+	PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
+	sceneDesc.gravity = PxVec3(0.0f);
+	gDispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+	sceneDesc.cpuDispatcher	= gDispatcher;
+	sceneDesc.filterShader	= PxDefaultSimulationFilterShader;
+	gScene = gPhysics->createScene(sceneDesc);
+
+	gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+
+	createActors();
+
+	// one step so that the broadphase, the contact caches and the scene query trees are populated
+	gScene->simulate(1.0f/60.0f);
+	gScene->fetchResults(true);
+}
+
+void cleanupPhysics()
+{
+	gScene->release();
+	gDispatcher->release();
+	gPhysics->release();
+	gFoundation->release();
+}
+
+void runShifts(PxU32 nbThreads)
+{
+	initPhysics(nbThreads);
+
+	// shift back and forth so that the scene ends where it started
+	const PxVec3 shift(1000.0f, 0.0f, -1000.0f);
+	const PxU64 start = SnippetUtils::getCurrentTimeCounterValue();
+	for(PxU32 i=0; i<gShiftCount; i++)
+		gScene->shiftOrigin((i&1) ? -shift : shift);
+	const PxU64 end = SnippetUtils::getCurrentTimeCounterValue();
+
+	printf("%d actors, %d worker threads: %.3f ms per shiftOrigin().\n", gScene->getNbActors(PxActorTypeSelectionFlag::eRIGID_STATIC|PxActorTypeSelectionFlag::eRIGID_DYNAMIC), nbThreads,
+		SnippetUtils::getElapsedTimeInMilliseconds(end - start)/PxReal(gShiftCount));
+
+	cleanupPhysics();
+}
+
+int snippetMain(int, const char*const*)
+{
+	runShifts(0);
+	runShifts(SnippetUtils::getNbPhysicalCores());
+
+	printf("SnippetOriginShift done.\n");
+
+	return 0;
+}
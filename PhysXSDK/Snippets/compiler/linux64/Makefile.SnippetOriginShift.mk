@@ -0,0 +1,456 @@
+# Makefile generated by XPJ for linux64
+-include Makefile.custom
+ProjectName = SnippetOriginShift
+SnippetOriginShift_cppfiles   += ./../../SnippetCommon/ClassicMain.cpp
+SnippetOriginShift_cppfiles   += ./../../SnippetOriginShift/SnippetOriginShift.cpp
+
+SnippetOriginShift_cpp_debug_dep    = $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.P, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_cc_debug_dep    = $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.debug.P, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_c_debug_dep      = $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.P, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_debug_dep      = $(SnippetOriginShift_cpp_debug_dep) $(SnippetOriginShift_cc_debug_dep) $(SnippetOriginShift_c_debug_dep)
+-include $(SnippetOriginShift_debug_dep)
+SnippetOriginShift_cpp_checked_dep    = $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.P, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_cc_checked_dep    = $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.checked.P, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_c_checked_dep      = $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.P, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_checked_dep      = $(SnippetOriginShift_cpp_checked_dep) $(SnippetOriginShift_cc_checked_dep) $(SnippetOriginShift_c_checked_dep)
+-include $(SnippetOriginShift_checked_dep)
+SnippetOriginShift_cpp_profile_dep    = $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.P, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_cc_profile_dep    = $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.profile.P, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_c_profile_dep      = $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.P, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_profile_dep      = $(SnippetOriginShift_cpp_profile_dep) $(SnippetOriginShift_cc_profile_dep) $(SnippetOriginShift_c_profile_dep)
+-include $(SnippetOriginShift_profile_dep)
+SnippetOriginShift_cpp_release_dep    = $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.P, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_cc_release_dep    = $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.release.P, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_c_release_dep      = $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.P, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_release_dep      = $(SnippetOriginShift_cpp_release_dep) $(SnippetOriginShift_cc_release_dep) $(SnippetOriginShift_c_release_dep)
+-include $(SnippetOriginShift_release_dep)
+SnippetOriginShift_debug_hpaths    := 
+SnippetOriginShift_debug_hpaths    += ./../../../Include
+SnippetOriginShift_debug_lpaths    := 
+SnippetOriginShift_debug_lpaths    += ./../../../Lib/linux64
+SnippetOriginShift_debug_lpaths    += ./../../lib/linux64
+SnippetOriginShift_debug_lpaths    += ./../../../Bin/linux64
+SnippetOriginShift_debug_lpaths    += ./../../lib/linux64
+SnippetOriginShift_debug_defines   := $(SnippetOriginShift_custom_defines)
+SnippetOriginShift_debug_defines   += PHYSX_PROFILE_SDK
+SnippetOriginShift_debug_defines   += RENDER_SNIPPET
+SnippetOriginShift_debug_defines   += _DEBUG
+SnippetOriginShift_debug_defines   += PX_DEBUG
+SnippetOriginShift_debug_defines   += PX_CHECKED
+SnippetOriginShift_debug_defines   += PX_SUPPORT_VISUAL_DEBUGGER
+SnippetOriginShift_debug_libraries := 
+SnippetOriginShift_debug_libraries += SnippetRenderDEBUG
+SnippetOriginShift_debug_libraries += SnippetUtilsDEBUG
+SnippetOriginShift_debug_libraries += PhysX3DEBUG_x64
+SnippetOriginShift_debug_libraries += PhysX3CommonDEBUG_x64
+SnippetOriginShift_debug_libraries += PhysX3CookingDEBUG_x64
+SnippetOriginShift_debug_libraries += PhysX3CharacterKinematicDEBUG_x64
+SnippetOriginShift_debug_libraries += PhysX3ExtensionsDEBUG
+SnippetOriginShift_debug_libraries += PhysX3VehicleDEBUG
+SnippetOriginShift_debug_libraries += PhysXProfileSDKDEBUG
+SnippetOriginShift_debug_libraries += PhysXVisualDebuggerSDKDEBUG
+SnippetOriginShift_debug_libraries += PxTaskDEBUG
+SnippetOriginShift_debug_libraries += SnippetUtilsDEBUG
+SnippetOriginShift_debug_libraries += SnippetRenderDEBUG
+SnippetOriginShift_debug_libraries += GL
+SnippetOriginShift_debug_libraries += GLU
+SnippetOriginShift_debug_libraries += glut
+SnippetOriginShift_debug_libraries += X11
+SnippetOriginShift_debug_libraries += rt
+SnippetOriginShift_debug_libraries += pthread
+SnippetOriginShift_debug_common_cflags	:= $(SnippetOriginShift_custom_cflags)
+SnippetOriginShift_debug_common_cflags    += -MMD
+SnippetOriginShift_debug_common_cflags    += $(addprefix -D, $(SnippetOriginShift_debug_defines))
+SnippetOriginShift_debug_common_cflags    += $(addprefix -I, $(SnippetOriginShift_debug_hpaths))
+SnippetOriginShift_debug_common_cflags  += -m64
+SnippetOriginShift_debug_common_cflags  += -Werror -m64 -fPIC -msse2 -mfpmath=sse -ffast-math -fno-exceptions -fno-rtti -fvisibility=hidden -fvisibility-inlines-hidden
+SnippetOriginShift_debug_common_cflags  += -Wall -Wextra -Wstrict-aliasing=2 -fdiagnostics-show-option
+SnippetOriginShift_debug_common_cflags  += -Wno-long-long
+SnippetOriginShift_debug_common_cflags  += -Wno-unknown-pragmas -Wno-invalid-offsetof -Wno-uninitialized
+SnippetOriginShift_debug_common_cflags  += -Wno-unused-parameter
+SnippetOriginShift_debug_common_cflags  += -g3 -gdwarf-2
+SnippetOriginShift_debug_cflags	:= $(SnippetOriginShift_debug_common_cflags)
+SnippetOriginShift_debug_cppflags	:= $(SnippetOriginShift_debug_common_cflags)
+SnippetOriginShift_debug_lflags    := $(SnippetOriginShift_custom_lflags)
+SnippetOriginShift_debug_lflags    += $(addprefix -L, $(SnippetOriginShift_debug_lpaths))
+SnippetOriginShift_debug_lflags    += -Wl,--start-group $(addprefix -l, $(SnippetOriginShift_debug_libraries)) -Wl,--end-group
+SnippetOriginShift_debug_lflags  += -lrt
+SnippetOriginShift_debug_lflags  += -Wl,-rpath ./
+SnippetOriginShift_debug_lflags  += -m64
+SnippetOriginShift_debug_objsdir  = $(OBJS_DIR)/SnippetOriginShift_debug
+SnippetOriginShift_debug_cpp_o    = $(addprefix $(SnippetOriginShift_debug_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.o, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_debug_cc_o    = $(addprefix $(SnippetOriginShift_debug_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.o, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_debug_c_o      = $(addprefix $(SnippetOriginShift_debug_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.o, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_debug_obj      = $(SnippetOriginShift_debug_cpp_o) $(SnippetOriginShift_debug_cc_o) $(SnippetOriginShift_debug_c_o)
+SnippetOriginShift_debug_bin      := ./../../../Bin/linux64/SnippetOriginShiftDEBUG
+
+clean_SnippetOriginShift_debug: 
+	@$(ECHO) clean SnippetOriginShift debug
+	@$(RMDIR) $(SnippetOriginShift_debug_objsdir)
+	@$(RMDIR) $(SnippetOriginShift_debug_bin)
+	@$(RMDIR) $(DEPSDIR)/SnippetOriginShift/debug
+
+build_SnippetOriginShift_debug: postbuild_SnippetOriginShift_debug
+postbuild_SnippetOriginShift_debug: mainbuild_SnippetOriginShift_debug
+mainbuild_SnippetOriginShift_debug: prebuild_SnippetOriginShift_debug $(SnippetOriginShift_debug_bin)
+prebuild_SnippetOriginShift_debug:
+
+$(SnippetOriginShift_debug_bin): $(SnippetOriginShift_debug_obj) build_SnippetRender_debug build_SnippetUtils_debug 
+	mkdir -p `dirname ./../../../Bin/linux64/SnippetOriginShiftDEBUG`
+	$(CCLD) $(SnippetOriginShift_debug_obj) $(SnippetOriginShift_debug_lflags) -o $(SnippetOriginShift_debug_bin) 
+	$(ECHO) building $@ complete!
+
+SnippetOriginShift_debug_DEPDIR = $(dir $(@))/$(*F)
+$(SnippetOriginShift_debug_cpp_o): $(SnippetOriginShift_debug_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling debug $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cppfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_debug_cppflags) -c $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cppfiles)) -o $@
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))))
+	cp $(SnippetOriginShift_debug_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_debug_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  rm -f $(SnippetOriginShift_debug_DEPDIR).d
+
+$(SnippetOriginShift_debug_cc_o): $(SnippetOriginShift_debug_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling debug $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_ccfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_debug_cppflags) -c $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_ccfiles)) -o $@
+	mkdir -p $(dir $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))))
+	cp $(SnippetOriginShift_debug_DEPDIR).d $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).debug.P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_debug_DEPDIR).d >> $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).debug.P; \
+	  rm -f $(SnippetOriginShift_debug_DEPDIR).d
+
+$(SnippetOriginShift_debug_c_o): $(SnippetOriginShift_debug_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling debug $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cfiles))...
+	mkdir -p $(dir $(@))
+	$(CC) $(SnippetOriginShift_debug_cflags) -c $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cfiles)) -o $@ 
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cfiles))))))
+	cp $(SnippetOriginShift_debug_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_debug_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/debug/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_debug_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  rm -f $(SnippetOriginShift_debug_DEPDIR).d
+
+SnippetOriginShift_checked_hpaths    := 
+SnippetOriginShift_checked_hpaths    += ./../../../Include
+SnippetOriginShift_checked_lpaths    := 
+SnippetOriginShift_checked_lpaths    += ./../../../Lib/linux64
+SnippetOriginShift_checked_lpaths    += ./../../lib/linux64
+SnippetOriginShift_checked_lpaths    += ./../../../Bin/linux64
+SnippetOriginShift_checked_lpaths    += ./../../lib/linux64
+SnippetOriginShift_checked_defines   := $(SnippetOriginShift_custom_defines)
+SnippetOriginShift_checked_defines   += PHYSX_PROFILE_SDK
+SnippetOriginShift_checked_defines   += RENDER_SNIPPET
+SnippetOriginShift_checked_defines   += NDEBUG
+SnippetOriginShift_checked_defines   += PX_CHECKED
+SnippetOriginShift_checked_defines   += PX_SUPPORT_VISUAL_DEBUGGER
+SnippetOriginShift_checked_libraries := 
+SnippetOriginShift_checked_libraries += SnippetRenderCHECKED
+SnippetOriginShift_checked_libraries += SnippetUtilsCHECKED
+SnippetOriginShift_checked_libraries += PhysX3CHECKED_x64
+SnippetOriginShift_checked_libraries += PhysX3CommonCHECKED_x64
+SnippetOriginShift_checked_libraries += PhysX3CookingCHECKED_x64
+SnippetOriginShift_checked_libraries += PhysX3CharacterKinematicCHECKED_x64
+SnippetOriginShift_checked_libraries += PhysX3ExtensionsCHECKED
+SnippetOriginShift_checked_libraries += PhysX3VehicleCHECKED
+SnippetOriginShift_checked_libraries += PhysXProfileSDKCHECKED
+SnippetOriginShift_checked_libraries += PhysXVisualDebuggerSDKCHECKED
+SnippetOriginShift_checked_libraries += PxTaskCHECKED
+SnippetOriginShift_checked_libraries += SnippetUtilsCHECKED
+SnippetOriginShift_checked_libraries += SnippetRenderCHECKED
+SnippetOriginShift_checked_libraries += GL
+SnippetOriginShift_checked_libraries += GLU
+SnippetOriginShift_checked_libraries += glut
+SnippetOriginShift_checked_libraries += X11
+SnippetOriginShift_checked_libraries += rt
+SnippetOriginShift_checked_libraries += pthread
+SnippetOriginShift_checked_common_cflags	:= $(SnippetOriginShift_custom_cflags)
+SnippetOriginShift_checked_common_cflags    += -MMD
+SnippetOriginShift_checked_common_cflags    += $(addprefix -D, $(SnippetOriginShift_checked_defines))
+SnippetOriginShift_checked_common_cflags    += $(addprefix -I, $(SnippetOriginShift_checked_hpaths))
+SnippetOriginShift_checked_common_cflags  += -m64
+SnippetOriginShift_checked_common_cflags  += -Werror -m64 -fPIC -msse2 -mfpmath=sse -ffast-math -fno-exceptions -fno-rtti -fvisibility=hidden -fvisibility-inlines-hidden
+SnippetOriginShift_checked_common_cflags  += -Wall -Wextra -Wstrict-aliasing=2 -fdiagnostics-show-option
+SnippetOriginShift_checked_common_cflags  += -Wno-long-long
+SnippetOriginShift_checked_common_cflags  += -Wno-unknown-pragmas -Wno-invalid-offsetof -Wno-uninitialized
+SnippetOriginShift_checked_common_cflags  += -Wno-unused-parameter
+SnippetOriginShift_checked_common_cflags  += -g3 -gdwarf-2 -O3 -fno-strict-aliasing
+SnippetOriginShift_checked_cflags	:= $(SnippetOriginShift_checked_common_cflags)
+SnippetOriginShift_checked_cppflags	:= $(SnippetOriginShift_checked_common_cflags)
+SnippetOriginShift_checked_lflags    := $(SnippetOriginShift_custom_lflags)
+SnippetOriginShift_checked_lflags    += $(addprefix -L, $(SnippetOriginShift_checked_lpaths))
+SnippetOriginShift_checked_lflags    += -Wl,--start-group $(addprefix -l, $(SnippetOriginShift_checked_libraries)) -Wl,--end-group
+SnippetOriginShift_checked_lflags  += -lrt
+SnippetOriginShift_checked_lflags  += -Wl,-rpath ./
+SnippetOriginShift_checked_lflags  += -m64
+SnippetOriginShift_checked_objsdir  = $(OBJS_DIR)/SnippetOriginShift_checked
+SnippetOriginShift_checked_cpp_o    = $(addprefix $(SnippetOriginShift_checked_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.o, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_checked_cc_o    = $(addprefix $(SnippetOriginShift_checked_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.o, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_checked_c_o      = $(addprefix $(SnippetOriginShift_checked_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.o, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_checked_obj      = $(SnippetOriginShift_checked_cpp_o) $(SnippetOriginShift_checked_cc_o) $(SnippetOriginShift_checked_c_o)
+SnippetOriginShift_checked_bin      := ./../../../Bin/linux64/SnippetOriginShiftCHECKED
+
+clean_SnippetOriginShift_checked: 
+	@$(ECHO) clean SnippetOriginShift checked
+	@$(RMDIR) $(SnippetOriginShift_checked_objsdir)
+	@$(RMDIR) $(SnippetOriginShift_checked_bin)
+	@$(RMDIR) $(DEPSDIR)/SnippetOriginShift/checked
+
+build_SnippetOriginShift_checked: postbuild_SnippetOriginShift_checked
+postbuild_SnippetOriginShift_checked: mainbuild_SnippetOriginShift_checked
+mainbuild_SnippetOriginShift_checked: prebuild_SnippetOriginShift_checked $(SnippetOriginShift_checked_bin)
+prebuild_SnippetOriginShift_checked:
+
+$(SnippetOriginShift_checked_bin): $(SnippetOriginShift_checked_obj) build_SnippetRender_checked build_SnippetUtils_checked 
+	mkdir -p `dirname ./../../../Bin/linux64/SnippetOriginShiftCHECKED`
+	$(CCLD) $(SnippetOriginShift_checked_obj) $(SnippetOriginShift_checked_lflags) -o $(SnippetOriginShift_checked_bin) 
+	$(ECHO) building $@ complete!
+
+SnippetOriginShift_checked_DEPDIR = $(dir $(@))/$(*F)
+$(SnippetOriginShift_checked_cpp_o): $(SnippetOriginShift_checked_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling checked $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cppfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_checked_cppflags) -c $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cppfiles)) -o $@
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))))
+	cp $(SnippetOriginShift_checked_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_checked_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  rm -f $(SnippetOriginShift_checked_DEPDIR).d
+
+$(SnippetOriginShift_checked_cc_o): $(SnippetOriginShift_checked_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling checked $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_ccfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_checked_cppflags) -c $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_ccfiles)) -o $@
+	mkdir -p $(dir $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))))
+	cp $(SnippetOriginShift_checked_DEPDIR).d $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).checked.P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_checked_DEPDIR).d >> $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).checked.P; \
+	  rm -f $(SnippetOriginShift_checked_DEPDIR).d
+
+$(SnippetOriginShift_checked_c_o): $(SnippetOriginShift_checked_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling checked $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cfiles))...
+	mkdir -p $(dir $(@))
+	$(CC) $(SnippetOriginShift_checked_cflags) -c $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cfiles)) -o $@ 
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cfiles))))))
+	cp $(SnippetOriginShift_checked_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_checked_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/checked/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_checked_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  rm -f $(SnippetOriginShift_checked_DEPDIR).d
+
+SnippetOriginShift_profile_hpaths    := 
+SnippetOriginShift_profile_hpaths    += ./../../../Include
+SnippetOriginShift_profile_lpaths    := 
+SnippetOriginShift_profile_lpaths    += ./../../../Lib/linux64
+SnippetOriginShift_profile_lpaths    += ./../../lib/linux64
+SnippetOriginShift_profile_lpaths    += ./../../../Bin/linux64
+SnippetOriginShift_profile_lpaths    += ./../../lib/linux64
+SnippetOriginShift_profile_defines   := $(SnippetOriginShift_custom_defines)
+SnippetOriginShift_profile_defines   += PHYSX_PROFILE_SDK
+SnippetOriginShift_profile_defines   += RENDER_SNIPPET
+SnippetOriginShift_profile_defines   += NDEBUG
+SnippetOriginShift_profile_defines   += PX_PROFILE
+SnippetOriginShift_profile_defines   += PX_SUPPORT_VISUAL_DEBUGGER
+SnippetOriginShift_profile_libraries := 
+SnippetOriginShift_profile_libraries += SnippetRenderPROFILE
+SnippetOriginShift_profile_libraries += SnippetUtilsPROFILE
+SnippetOriginShift_profile_libraries += PhysX3PROFILE_x64
+SnippetOriginShift_profile_libraries += PhysX3CommonPROFILE_x64
+SnippetOriginShift_profile_libraries += PhysX3CookingPROFILE_x64
+SnippetOriginShift_profile_libraries += PhysX3CharacterKinematicPROFILE_x64
+SnippetOriginShift_profile_libraries += PhysX3ExtensionsPROFILE
+SnippetOriginShift_profile_libraries += PhysX3VehiclePROFILE
+SnippetOriginShift_profile_libraries += PhysXProfileSDKPROFILE
+SnippetOriginShift_profile_libraries += PhysXVisualDebuggerSDKPROFILE
+SnippetOriginShift_profile_libraries += PxTaskPROFILE
+SnippetOriginShift_profile_libraries += SnippetUtilsPROFILE
+SnippetOriginShift_profile_libraries += SnippetRenderPROFILE
+SnippetOriginShift_profile_libraries += GL
+SnippetOriginShift_profile_libraries += GLU
+SnippetOriginShift_profile_libraries += glut
+SnippetOriginShift_profile_libraries += X11
+SnippetOriginShift_profile_libraries += rt
+SnippetOriginShift_profile_libraries += pthread
+SnippetOriginShift_profile_common_cflags	:= $(SnippetOriginShift_custom_cflags)
+SnippetOriginShift_profile_common_cflags    += -MMD
+SnippetOriginShift_profile_common_cflags    += $(addprefix -D, $(SnippetOriginShift_profile_defines))
+SnippetOriginShift_profile_common_cflags    += $(addprefix -I, $(SnippetOriginShift_profile_hpaths))
+SnippetOriginShift_profile_common_cflags  += -m64
+SnippetOriginShift_profile_common_cflags  += -Werror -m64 -fPIC -msse2 -mfpmath=sse -ffast-math -fno-exceptions -fno-rtti -fvisibility=hidden -fvisibility-inlines-hidden
+SnippetOriginShift_profile_common_cflags  += -Wall -Wextra -Wstrict-aliasing=2 -fdiagnostics-show-option
+SnippetOriginShift_profile_common_cflags  += -Wno-long-long
+SnippetOriginShift_profile_common_cflags  += -Wno-unknown-pragmas -Wno-invalid-offsetof -Wno-uninitialized
+SnippetOriginShift_profile_common_cflags  += -Wno-unused-parameter
+SnippetOriginShift_profile_common_cflags  += -O3 -fno-strict-aliasing
+SnippetOriginShift_profile_cflags	:= $(SnippetOriginShift_profile_common_cflags)
+SnippetOriginShift_profile_cppflags	:= $(SnippetOriginShift_profile_common_cflags)
+SnippetOriginShift_profile_lflags    := $(SnippetOriginShift_custom_lflags)
+SnippetOriginShift_profile_lflags    += $(addprefix -L, $(SnippetOriginShift_profile_lpaths))
+SnippetOriginShift_profile_lflags    += -Wl,--start-group $(addprefix -l, $(SnippetOriginShift_profile_libraries)) -Wl,--end-group
+SnippetOriginShift_profile_lflags  += -lrt
+SnippetOriginShift_profile_lflags  += -Wl,-rpath ./
+SnippetOriginShift_profile_lflags  += -m64
+SnippetOriginShift_profile_objsdir  = $(OBJS_DIR)/SnippetOriginShift_profile
+SnippetOriginShift_profile_cpp_o    = $(addprefix $(SnippetOriginShift_profile_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.o, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_profile_cc_o    = $(addprefix $(SnippetOriginShift_profile_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.o, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_profile_c_o      = $(addprefix $(SnippetOriginShift_profile_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.o, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_profile_obj      = $(SnippetOriginShift_profile_cpp_o) $(SnippetOriginShift_profile_cc_o) $(SnippetOriginShift_profile_c_o)
+SnippetOriginShift_profile_bin      := ./../../../Bin/linux64/SnippetOriginShiftPROFILE
+
+clean_SnippetOriginShift_profile: 
+	@$(ECHO) clean SnippetOriginShift profile
+	@$(RMDIR) $(SnippetOriginShift_profile_objsdir)
+	@$(RMDIR) $(SnippetOriginShift_profile_bin)
+	@$(RMDIR) $(DEPSDIR)/SnippetOriginShift/profile
+
+build_SnippetOriginShift_profile: postbuild_SnippetOriginShift_profile
+postbuild_SnippetOriginShift_profile: mainbuild_SnippetOriginShift_profile
+mainbuild_SnippetOriginShift_profile: prebuild_SnippetOriginShift_profile $(SnippetOriginShift_profile_bin)
+prebuild_SnippetOriginShift_profile:
+
+$(SnippetOriginShift_profile_bin): $(SnippetOriginShift_profile_obj) build_SnippetRender_profile build_SnippetUtils_profile 
+	mkdir -p `dirname ./../../../Bin/linux64/SnippetOriginShiftPROFILE`
+	$(CCLD) $(SnippetOriginShift_profile_obj) $(SnippetOriginShift_profile_lflags) -o $(SnippetOriginShift_profile_bin) 
+	$(ECHO) building $@ complete!
+
+SnippetOriginShift_profile_DEPDIR = $(dir $(@))/$(*F)
+$(SnippetOriginShift_profile_cpp_o): $(SnippetOriginShift_profile_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling profile $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cppfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_profile_cppflags) -c $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cppfiles)) -o $@
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))))
+	cp $(SnippetOriginShift_profile_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_profile_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  rm -f $(SnippetOriginShift_profile_DEPDIR).d
+
+$(SnippetOriginShift_profile_cc_o): $(SnippetOriginShift_profile_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling profile $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_ccfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_profile_cppflags) -c $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_ccfiles)) -o $@
+	mkdir -p $(dir $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))))
+	cp $(SnippetOriginShift_profile_DEPDIR).d $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).profile.P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_profile_DEPDIR).d >> $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).profile.P; \
+	  rm -f $(SnippetOriginShift_profile_DEPDIR).d
+
+$(SnippetOriginShift_profile_c_o): $(SnippetOriginShift_profile_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling profile $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cfiles))...
+	mkdir -p $(dir $(@))
+	$(CC) $(SnippetOriginShift_profile_cflags) -c $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cfiles)) -o $@ 
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cfiles))))))
+	cp $(SnippetOriginShift_profile_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_profile_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/profile/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_profile_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  rm -f $(SnippetOriginShift_profile_DEPDIR).d
+
+SnippetOriginShift_release_hpaths    := 
+SnippetOriginShift_release_hpaths    += ./../../../Include
+SnippetOriginShift_release_lpaths    := 
+SnippetOriginShift_release_lpaths    += ./../../../Lib/linux64
+SnippetOriginShift_release_lpaths    += ./../../lib/linux64
+SnippetOriginShift_release_lpaths    += ./../../../Bin/linux64
+SnippetOriginShift_release_lpaths    += ./../../lib/linux64
+SnippetOriginShift_release_defines   := $(SnippetOriginShift_custom_defines)
+SnippetOriginShift_release_defines   += PHYSX_PROFILE_SDK
+SnippetOriginShift_release_defines   += RENDER_SNIPPET
+SnippetOriginShift_release_defines   += NDEBUG
+SnippetOriginShift_release_libraries := 
+SnippetOriginShift_release_libraries += SnippetRender
+SnippetOriginShift_release_libraries += SnippetUtils
+SnippetOriginShift_release_libraries += PhysX3_x64
+SnippetOriginShift_release_libraries += PhysX3Common_x64
+SnippetOriginShift_release_libraries += PhysX3Cooking_x64
+SnippetOriginShift_release_libraries += PhysX3CharacterKinematic_x64
+SnippetOriginShift_release_libraries += PhysX3Extensions
+SnippetOriginShift_release_libraries += PhysX3Vehicle
+SnippetOriginShift_release_libraries += PhysXProfileSDK
+SnippetOriginShift_release_libraries += PhysXVisualDebuggerSDK
+SnippetOriginShift_release_libraries += PxTask
+SnippetOriginShift_release_libraries += SnippetUtils
+SnippetOriginShift_release_libraries += SnippetRender
+SnippetOriginShift_release_libraries += GL
+SnippetOriginShift_release_libraries += GLU
+SnippetOriginShift_release_libraries += glut
+SnippetOriginShift_release_libraries += X11
+SnippetOriginShift_release_libraries += rt
+SnippetOriginShift_release_libraries += pthread
+SnippetOriginShift_release_common_cflags	:= $(SnippetOriginShift_custom_cflags)
+SnippetOriginShift_release_common_cflags    += -MMD
+SnippetOriginShift_release_common_cflags    += $(addprefix -D, $(SnippetOriginShift_release_defines))
+SnippetOriginShift_release_common_cflags    += $(addprefix -I, $(SnippetOriginShift_release_hpaths))
+SnippetOriginShift_release_common_cflags  += -m64
+SnippetOriginShift_release_common_cflags  += -Werror -m64 -fPIC -msse2 -mfpmath=sse -ffast-math -fno-exceptions -fno-rtti -fvisibility=hidden -fvisibility-inlines-hidden
+SnippetOriginShift_release_common_cflags  += -Wall -Wextra -Wstrict-aliasing=2 -fdiagnostics-show-option
+SnippetOriginShift_release_common_cflags  += -Wno-long-long
+SnippetOriginShift_release_common_cflags  += -Wno-unknown-pragmas -Wno-invalid-offsetof -Wno-uninitialized
+SnippetOriginShift_release_common_cflags  += -Wno-unused-parameter
+SnippetOriginShift_release_common_cflags  += -O3 -fno-strict-aliasing
+SnippetOriginShift_release_cflags	:= $(SnippetOriginShift_release_common_cflags)
+SnippetOriginShift_release_cppflags	:= $(SnippetOriginShift_release_common_cflags)
+SnippetOriginShift_release_lflags    := $(SnippetOriginShift_custom_lflags)
+SnippetOriginShift_release_lflags    += $(addprefix -L, $(SnippetOriginShift_release_lpaths))
+SnippetOriginShift_release_lflags    += -Wl,--start-group $(addprefix -l, $(SnippetOriginShift_release_libraries)) -Wl,--end-group
+SnippetOriginShift_release_lflags  += -lrt
+SnippetOriginShift_release_lflags  += -Wl,-rpath ./
+SnippetOriginShift_release_lflags  += -m64
+SnippetOriginShift_release_objsdir  = $(OBJS_DIR)/SnippetOriginShift_release
+SnippetOriginShift_release_cpp_o    = $(addprefix $(SnippetOriginShift_release_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cpp, %.cpp.o, $(SnippetOriginShift_cppfiles)))))
+SnippetOriginShift_release_cc_o    = $(addprefix $(SnippetOriginShift_release_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.cc, %.cc.o, $(SnippetOriginShift_ccfiles)))))
+SnippetOriginShift_release_c_o      = $(addprefix $(SnippetOriginShift_release_objsdir)/, $(subst ./, , $(subst ../, , $(patsubst %.c, %.c.o, $(SnippetOriginShift_cfiles)))))
+SnippetOriginShift_release_obj      = $(SnippetOriginShift_release_cpp_o) $(SnippetOriginShift_release_cc_o) $(SnippetOriginShift_release_c_o)
+SnippetOriginShift_release_bin      := ./../../../Bin/linux64/SnippetOriginShift
+
+clean_SnippetOriginShift_release: 
+	@$(ECHO) clean SnippetOriginShift release
+	@$(RMDIR) $(SnippetOriginShift_release_objsdir)
+	@$(RMDIR) $(SnippetOriginShift_release_bin)
+	@$(RMDIR) $(DEPSDIR)/SnippetOriginShift/release
+
+build_SnippetOriginShift_release: postbuild_SnippetOriginShift_release
+postbuild_SnippetOriginShift_release: mainbuild_SnippetOriginShift_release
+mainbuild_SnippetOriginShift_release: prebuild_SnippetOriginShift_release $(SnippetOriginShift_release_bin)
+prebuild_SnippetOriginShift_release:
+
+$(SnippetOriginShift_release_bin): $(SnippetOriginShift_release_obj) build_SnippetRender_release build_SnippetUtils_release 
+	mkdir -p `dirname ./../../../Bin/linux64/SnippetOriginShift`
+	$(CCLD) $(SnippetOriginShift_release_obj) $(SnippetOriginShift_release_lflags) -o $(SnippetOriginShift_release_bin) 
+	$(ECHO) building $@ complete!
+
+SnippetOriginShift_release_DEPDIR = $(dir $(@))/$(*F)
+$(SnippetOriginShift_release_cpp_o): $(SnippetOriginShift_release_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling release $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cppfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_release_cppflags) -c $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cppfiles)) -o $@
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))))
+	cp $(SnippetOriginShift_release_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_release_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cpp.o,.cpp, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cppfiles))))).P; \
+	  rm -f $(SnippetOriginShift_release_DEPDIR).d
+
+$(SnippetOriginShift_release_cc_o): $(SnippetOriginShift_release_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling release $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_ccfiles))...
+	mkdir -p $(dir $(@))
+	$(CXX) $(SnippetOriginShift_release_cppflags) -c $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_ccfiles)) -o $@
+	mkdir -p $(dir $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))))
+	cp $(SnippetOriginShift_release_DEPDIR).d $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).release.P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_release_DEPDIR).d >> $(addprefix $(DEPSDIR)/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .cc.o,.cc, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_ccfiles))))).release.P; \
+	  rm -f $(SnippetOriginShift_release_DEPDIR).d
+
+$(SnippetOriginShift_release_c_o): $(SnippetOriginShift_release_objsdir)/%.o:
+	$(ECHO) SnippetOriginShift: compiling release $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cfiles))...
+	mkdir -p $(dir $(@))
+	$(CC) $(SnippetOriginShift_release_cflags) -c $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cfiles)) -o $@ 
+	@mkdir -p $(dir $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cfiles))))))
+	cp $(SnippetOriginShift_release_DEPDIR).d $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  sed -e 's/#.*//' -e 's/^[^:]*: *//' -e 's/ *\\$$//' \
+		-e '/^$$/ d' -e 's/$$/ :/' < $(SnippetOriginShift_release_DEPDIR).d >> $(addprefix $(DEPSDIR)/SnippetOriginShift/release/, $(subst ./, , $(subst ../, , $(filter %$(strip $(subst .c.o,.c, $(subst $(SnippetOriginShift_release_objsdir),, $@))), $(SnippetOriginShift_cfiles))))).P; \
+	  rm -f $(SnippetOriginShift_release_DEPDIR).d
+
+clean_SnippetOriginShift:  clean_SnippetOriginShift_debug clean_SnippetOriginShift_checked clean_SnippetOriginShift_profile clean_SnippetOriginShift_release
+	rm -rf $(DEPSDIR)
+
+export VERBOSE
+ifndef VERBOSE
+.SILENT:
+endif
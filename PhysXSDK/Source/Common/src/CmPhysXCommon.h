@@ -24,6 +24,10 @@
 // Enable simulation statistics generation
 #define PX_ENABLE_SIM_STATS 1
 
+// Enable timing of the individual SDK tasks for the per phase task statistics. This adds two counter
+// reads and two thread local additions per task.
+#define PX_ENABLE_TASK_STATS PX_ENABLE_SIM_STATS
+
 // PT: typical "invalid" value in various CD algorithms
 #define	PX_INVALID_U32		0xffffffff
 #define PX_INVALID_U16		0xffff
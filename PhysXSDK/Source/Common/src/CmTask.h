@@ -23,6 +23,8 @@
 #include "PsSync.h"
 #include "PxCpuDispatcher.h"
 #include "PsFPU.h"
+#include "PsTime.h"
+#include "CmTaskStatistics.h"
 
 #if !defined(__SPU__) && defined(PX_PS3)
 #include "PxSpuTask.h"
@@ -44,7 +46,13 @@ namespace Cm
 		virtual void run()
 		{
 			PX_SIMD_GUARD;
+#if PX_ENABLE_TASK_STATS
+			const PxU64 startCounter = Ps::Time::getCurrentCounterValue();
 			runInternal();
+			TaskStatistics::recordTask(startCounter);
+#else
+			runInternal();
+#endif
 		}
 
 		virtual void runInternal()=0;
@@ -59,7 +67,13 @@ namespace Cm
 		virtual void run()
 		{
 			PX_SIMD_GUARD;
+#if PX_ENABLE_TASK_STATS
+			const PxU64 startCounter = Ps::Time::getCurrentCounterValue();
 			runInternal();
+			TaskStatistics::recordTask(startCounter);
+#else
+			runInternal();
+#endif
 		}
 
 		virtual void runInternal()=0;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2008-2015, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#include "CmTaskStatistics.h"
+#include "PsAtomic.h"
+#include "PsTime.h"
+#include "PxMath.h"
+
+using namespace physx;
+using namespace Cm;
+
+#if PX_ENABLE_TASK_STATS
+
+#if defined(PX_WINDOWS) || defined(PX_WINMODERN) || defined(PX_X360) || defined(PX_XBOXONE)
+#define CM_THREAD_LOCAL __declspec(thread)
+#else
+#define CM_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+	// counters of a single thread, padded so that threads do not share cache lines
+	PX_ALIGN_PREFIX(128)
+	struct ThreadCounters
+	{
+		volatile PxI32	nbTasks;
+		volatile PxI32	taskTime;
+		PxU8			pad[128 - 2*sizeof(PxI32)];
+	}
+	PX_ALIGN_SUFFIX(128);
+
+	// threads beyond the first CM_MAX_TASK_STATS_THREADS-1 ones share the last slot and update it atomically
+	#define CM_MAX_TASK_STATS_THREADS 64
+	ThreadCounters gThreadCounters[CM_MAX_TASK_STATS_THREADS];
+	volatile PxI32 gNbThreadCounters = 0;
+
+	CM_THREAD_LOCAL PxI32 gThreadSlot = 0;	// slot index + 1, 0 until the thread ran its first task
+}
+
+TaskStatistics::Sample TaskStatistics::sample()
+{
+	const PxU32 nbSlots = PxMin(PxU32(gNbThreadCounters), PxU32(CM_MAX_TASK_STATS_THREADS));
+
+	Sample s;
+	s.nbTasks = 0;
+	s.taskTime = 0;
+	for(PxU32 i=0; i<nbSlots; i++)
+	{
+		s.nbTasks += PxU32(gThreadCounters[i].nbTasks);
+		s.taskTime += PxU32(gThreadCounters[i].taskTime);
+	}
+	return s;
+}
+
+void TaskStatistics::recordTask(PxU64 startCounter)
+{
+	const PxU64 ticks = Ps::Time::getCurrentCounterValue() - startCounter;
+	const PxU32 time = PxU32(Ps::Time::getBootCounterFrequency().toTensOfNanos(ticks));
+
+	if(!gThreadSlot)
+		gThreadSlot = Ps::atomicIncrement(&gNbThreadCounters);
+
+	if(gThreadSlot < CM_MAX_TASK_STATS_THREADS)
+	{
+		// only this thread writes to its slot
+		ThreadCounters& c = gThreadCounters[gThreadSlot-1];
+		c.nbTasks = PxI32(PxU32(c.nbTasks) + 1);
+		c.taskTime = PxI32(PxU32(c.taskTime) + time);
+	}
+	else
+	{
+		ThreadCounters& c = gThreadCounters[CM_MAX_TASK_STATS_THREADS-1];
+		Ps::atomicIncrement(&c.nbTasks);
+		Ps::atomicAdd(&c.taskTime, PxI32(time));
+	}
+}
+
+#else
+
+TaskStatistics::Sample TaskStatistics::sample()
+{
+	Sample s;
+	s.nbTasks = 0;
+	s.taskTime = 0;
+	return s;
+}
+
+void TaskStatistics::recordTask(PxU64)
+{
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2008-2015, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+
+#ifndef PX_PHYSICS_COMMON_TASK_STATISTICS
+#define PX_PHYSICS_COMMON_TASK_STATISTICS
+
+#include "CmPhysXCommon.h"
+#include "PxPhysXCommonConfig.h"
+
+namespace physx
+{
+namespace Cm
+{
+	// count of the internal tasks that ran and of the time spent in them, updated by Cm::Task and
+	// Cm::BaseTask when PX_ENABLE_TASK_STATS is set. Each thread accumulates into its own counters,
+	// sample() sums them up. Sampled at the start and end of the simulation phases to derive the
+	// per phase task statistics (see PxSimulationStatistics::getNbPhaseTasks()).
+	struct PX_PHYSX_COMMON_API TaskStatistics
+	{
+		struct Sample
+		{
+			PxU32	nbTasks;
+			PxU32	taskTime;	// in tens of nanoseconds, wraps around so only differences are meaningful
+		};
+
+		static	Sample	sample();
+		static	void	recordTask(PxU64 startCounter);
+	};
+
+} // namespace Cm
+
+}
+
+#endif
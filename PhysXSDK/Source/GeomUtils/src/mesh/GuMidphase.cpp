@@ -12,6 +12,7 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "PsIntrinsics.h"
+#include "PsBitUtils.h"
 #include "GuMidphase.h"
 #include "GuIntersectionRayBoxSIMD.h"
 #include "GuGeomUtilsInternal.h"
@@ -91,6 +92,94 @@ struct RayRTreeCallback : RTree::CallbackRaycast, RTree::Callback
 		}
 	}
 
+	// returns false if the traversal should be aborted
+	PX_FORCE_INLINE bool reportHit(
+		PxRaycastHit& tempHit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, const PxU32* vinds, PxF32& newMaxT)
+	{
+		tempHit.flags = PxHitFlag::ePOSITION|PxHitFlag::eDISTANCE;
+
+		#if MIDPHASE_TRACE
+		touchedLeaves.pushBack(tempHit.faceIndex);
+		#endif
+
+		// Intersection point is valid if dist < segment's length
+		// We know dist>0 so we can use integers
+		if (closestMode)
+		{
+			if(tempHit.distance < closestHit.distance)
+			{
+				PX_ASSERT(tempHit.distance >= 0.0f);
+				closestHit = tempHit;
+				newMaxT = PxMin(tempHit.distance, newMaxT);
+				cv0 = v0; cv1 = v1; cv2 = v2;
+				cis[0] = vinds[0]; cis[1] = vinds[1]; cis[2] = vinds[2];
+				hadClosestHit = true;
+			}
+		} else
+		{
+			PxReal shrunkMaxT = newMaxT;
+			//pxPrintf("calling processHit\n");
+			PxAgain again = outerCallback.processHit(tempHit, v0, v1, v2, shrunkMaxT, vinds);
+			if (!again)
+				return false;
+			if (shrunkMaxT < newMaxT)
+			{
+				newMaxT = shrunkMaxT;
+				maxT = shrunkMaxT;
+			}
+		}
+
+		return !outerCallback.inAnyMode(); // early out if in ANY mode
+	}
+
+#if !PX_IS_SPU
+	// Ray test path for a whole leaf: triangles are culled 4 at a time with SimpleRayTriOverlap::overlap4,
+	// and only the remaining candidates go through the exact scalar test.
+	PX_FORCE_INLINE bool processLeafRay4(PxU32 nbLeafTris, PxU32 baseLeafTriIndex, PxF32& newMaxT)
+	{
+		const PxVec3* verts = reinterpret_cast<PxVec3*>(*mVerts);
+		PX_ALIGN_PREFIX(16) PxF32 soa[9][4] PX_ALIGN_SUFFIX(16);
+		PxU32 inds[4][3];
+		PxRaycastHit tempHit;
+		for(PxU32 iTri = 0; iTri < nbLeafTris; iTri += 4)
+		{
+			const PxU32 count = PxMin<PxU32>(nbLeafTris-iTri, 4);
+			for(PxU32 jj = 0; jj < 4; jj++)
+			{
+				// unused lanes repeat the first triangle and are masked out below
+				const PxU32 src = jj < count ? jj : 0;
+				if (jj < count)
+					getVertIndices(baseLeafTriIndex+iTri+jj, inds[jj][0], inds[jj][1], inds[jj][2]);
+				for(PxU32 k = 0; k < 3; k++)
+				{
+					const PxVec3& p = verts[inds[src][k]];
+					soa[k*3+0][jj] = p.x; soa[k*3+1][jj] = p.y; soa[k*3+2][jj] = p.z;
+				}
+			}
+
+			const Vec4V v0[3] = { V4LoadA(soa[0]), V4LoadA(soa[1]), V4LoadA(soa[2]) };
+			const Vec4V v1[3] = { V4LoadA(soa[3]), V4LoadA(soa[4]), V4LoadA(soa[5]) };
+			const Vec4V v2[3] = { V4LoadA(soa[6]), V4LoadA(soa[7]), V4LoadA(soa[8]) };
+			const PxReal limit = closestMode ? PxMin(maxT, closestHit.distance) : maxT;
+			PxU32 candidates = rayCollider.overlap4(v0, v1, v2, limit) & ((1<<count)-1);
+
+			while (candidates)
+			{
+				const PxU32 jj = Ps::lowestSetBit(candidates);
+				candidates &= candidates-1;
+
+				const PxVec3& v0_ = verts[inds[jj][0]], &v1_ = verts[inds[jj][1]], &v2_ = verts[inds[jj][2]];
+				if (!rayCollider.overlap(v0_, v1_, v2_, tempHit) || tempHit.distance > maxT)
+					continue;
+				tempHit.faceIndex = baseLeafTriIndex+iTri+jj;
+				if (!reportHit(tempHit, v0_, v1_, v2_, inds[jj], newMaxT))
+					return false;
+			}
+		}
+		return true;
+	}
+#endif
+
 	virtual PX_FORCE_INLINE bool processResults(PxU32 NumTouched, PxU32* Touched, PxF32& newMaxT)
 	{
 		PX_ASSERT(NumTouched == 1);
@@ -106,6 +195,15 @@ struct RayRTreeCallback : RTree::CallbackRaycast, RTree::Callback
 			PxU32 nbLeafTris = currentLeaf.GetNbTriangles();			
 			PxU32 baseLeafTriIndex = currentLeaf.GetTriangleIndex();
 
+#if !PX_IS_SPU
+			if (tRayTest && !tInflate)
+			{
+				if (!processLeafRay4(nbLeafTris, baseLeafTriIndex, newMaxT))
+					return false;
+				continue;
+			}
+#endif
+
 #if PX_IS_SPU
 			// on SPU we fetch verts on 8 parallel DMA channels
 			const PxU32 N = 8;
@@ -165,40 +263,7 @@ struct RayRTreeCallback : RTree::CallbackRaycast, RTree::Callback
 						continue;
 				}
 				tempHit.faceIndex = triangleIndex;
-				tempHit.flags = PxHitFlag::ePOSITION|PxHitFlag::eDISTANCE;
-
-				#if MIDPHASE_TRACE
-				touchedLeaves.pushBack(tempHit.faceIndex);
-				#endif
-
-				// Intersection point is valid if dist < segment's length
-				// We know dist>0 so we can use integers
-				if (closestMode)
-				{
-					if(tempHit.distance < closestHit.distance)
-					{
-						PX_ASSERT(tempHit.distance >= 0.0f);
-						closestHit = tempHit;
-						newMaxT = PxMin(tempHit.distance, newMaxT);
-						cv0 = v0; cv1 = v1; cv2 = v2;
-						cis[0] = vinds[0]; cis[1] = vinds[1]; cis[2] = vinds[2];
-						hadClosestHit = true;
-					}
-				} else
-				{
-					PxReal shrunkMaxT = newMaxT;
-					//pxPrintf("calling processHit\n");
-					PxAgain again = outerCallback.processHit(tempHit, v0, v1, v2, shrunkMaxT, vinds);
-					if (!again)
-						return false;
-					if (shrunkMaxT < newMaxT)
-					{
-						newMaxT = shrunkMaxT;
-						maxT = shrunkMaxT;
-					}
-				}
-
-				if (outerCallback.inAnyMode()) // early out if in ANY mode
+				if (!reportHit(tempHit, v0, v1, v2, vinds, newMaxT))
 					return false;
 			}} // for SPU code sharing
 
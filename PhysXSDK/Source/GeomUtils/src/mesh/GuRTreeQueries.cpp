@@ -168,6 +168,16 @@ namespace
 	const Vec4V epsInflateFloat4 = Vec4VLoadXYZW(1e-7f, 1e-7f, 1e-7f, 1e-7f);
 }
 
+// 5 compare-and-swap sorting network for the 4 children of a page, by decreasing entry t
+static PX_FORCE_INLINE void sortChildrenFarToNear(const PxF32* tnear, PxU32* order)
+{
+	#define RTREE_CSWAP(a, b) if (tnear[order[a]] < tnear[order[b]]) { const PxU32 tmp = order[a]; order[a] = order[b]; order[b] = tmp; }
+	RTREE_CSWAP(0, 1) RTREE_CSWAP(2, 3)
+	RTREE_CSWAP(0, 2) RTREE_CSWAP(1, 3)
+	RTREE_CSWAP(1, 2)
+	#undef RTREE_CSWAP
+}
+
 /////////////////////////////////////////////////////////////////////////
 template <int inflate>
 void RTree::traverseRay(
@@ -179,9 +189,12 @@ void RTree::traverseRay(
 	PX_UNUSED(resultsPtr);
 	PX_UNUSED(maxResults);
 
+	// the stack also keeps the entry t of each node, so that nodes beyond a shrunk maxT are dropped when popped
 	const PxU32 maxStack = 128;
 	PxU32 stack1[maxStack];
 	PxU32* stack = stack1+1;
+	PxF32 stackT1[maxStack];
+	PxF32* stackT = stackT1+1;
 
 	PX_ASSERT(mPages);
 	PX_ASSERT((Cm::MemFetchPtr(mPages) & 127) == 0);
@@ -232,13 +245,19 @@ void RTree::traverseRay(
 
 	PxU32 stackPtr = 0;
 	for (PxI32 j = PxI32(mNumRootPages-1); j >= 0; j --)
+	{
+		stackT[stackPtr] = -PX_MAX_REAL;
 		stack[stackPtr++] = (mFlags & IS_DYNAMIC) ? pagePtrTo32Bits(mPages) : j*sizeof(RTreePage);
+	}
 
 	PX_ALIGN_PREFIX(16) PxU32 resa[4] PX_ALIGN_SUFFIX(16);
+	PX_ALIGN_PREFIX(16) PxF32 tneara[4] PX_ALIGN_SUFFIX(16);
 
 	while (stackPtr)
 	{
 		PxU32 top = stack[--stackPtr];
+		if (stackT[stackPtr] > maxT) // the ray was shortened after this node was pushed
+			continue;
 		if (top&1) // isLeaf test
 		{
 			top--;
@@ -314,13 +333,18 @@ void RTree::traverseRay(
 
 		// 1i
 		V4U32StoreAligned(resa4, (VecU32V*)resa);
+		V4StoreA(maxOfNeasa, tneara);
 
 		PxU32* ptrs = ((RTreePage *)tn)->ptrs;
 
-		stack[stackPtr] = ptrs[0]; stackPtr += (1+resa[0]); // AP scaffold TODO: use VecU32add
-		stack[stackPtr] = ptrs[1]; stackPtr += (1+resa[1]);
-		stack[stackPtr] = ptrs[2]; stackPtr += (1+resa[2]);
-		stack[stackPtr] = ptrs[3]; stackPtr += (1+resa[3]);
+		// push the children far to near, so that the nearest one is popped first and shrinks maxT early
+		PxU32 order[4] = { 0, 1, 2, 3 };
+		sortChildrenFarToNear(tneara, order);
+		for (PxU32 i = 0; i < 4; i++)
+		{
+			const PxU32 c = order[i];
+			stack[stackPtr] = ptrs[c]; stackT[stackPtr] = tneara[c]; stackPtr += (1+resa[c]);
+		}
 	}
 }
 
@@ -96,6 +96,52 @@ public:
 		return Ps::IntTrue;
 	}
 
+	// Conservative 4-wide version of overlap() for triangles in SoA form (v0[0] holds the x coordinates of 4 first vertices, etc).
+	// Returns a bit mask of the triangles that may be hit with a distance up to maxT. The arithmetic follows overlap(), but
+	// the tests are done on values scaled by det and with some slack, so every candidate has to be confirmed with overlap().
+	PX_FORCE_INLINE PxU32 overlap4(const Vec4V* v0, const Vec4V* v1, const Vec4V* v2, const PxReal maxT) const
+	{
+		const Vec4V zero = V4Zero();
+		const Vec4V eps = V4Load(mGeomEpsilon);
+		const Vec4V dirx = V4Load(mDir.x), diry = V4Load(mDir.y), dirz = V4Load(mDir.z);
+
+		const Vec4V e1x = V4Sub(v1[0], v0[0]), e1y = V4Sub(v1[1], v0[1]), e1z = V4Sub(v1[2], v0[2]);
+		const Vec4V e2x = V4Sub(v2[0], v0[0]), e2y = V4Sub(v2[1], v0[1]), e2z = V4Sub(v2[2], v0[2]);
+
+		// p = dir x e2, det = e1.p
+		const Vec4V px = V4Sub(V4Mul(diry, e2z), V4Mul(dirz, e2y));
+		const Vec4V py = V4Sub(V4Mul(dirz, e2x), V4Mul(dirx, e2z));
+		const Vec4V pz = V4Sub(V4Mul(dirx, e2y), V4Mul(diry, e2x));
+		const Vec4V det = V4Add(V4Add(V4Mul(e1x, px), V4Mul(e1y, py)), V4Mul(e1z, pz));
+
+		// t = origin - v0, u = t.p, q = t x e1, v = dir.q, d = e2.q
+		const Vec4V tx = V4Sub(V4Load(mOrigin.x), v0[0]), ty = V4Sub(V4Load(mOrigin.y), v0[1]), tz = V4Sub(V4Load(mOrigin.z), v0[2]);
+		const Vec4V u = V4Add(V4Add(V4Mul(tx, px), V4Mul(ty, py)), V4Mul(tz, pz));
+		const Vec4V qx = V4Sub(V4Mul(ty, e1z), V4Mul(tz, e1y));
+		const Vec4V qy = V4Sub(V4Mul(tz, e1x), V4Mul(tx, e1z));
+		const Vec4V qz = V4Sub(V4Mul(tx, e1y), V4Mul(ty, e1x));
+		const Vec4V v = V4Add(V4Add(V4Mul(dirx, qx), V4Mul(diry, qy)), V4Mul(dirz, qz));
+		const Vec4V d = V4Add(V4Add(V4Mul(e2x, qx), V4Mul(e2y, qy)), V4Mul(e2z, qz));
+
+		// flip the signs for back facing triangles so that both cases compare against |det|
+		const BoolV negDet = V4IsGrtr(zero, det);
+		const Vec4V absDet = V4Abs(det);
+		const Vec4V su = V4Sel(negDet, V4Neg(u), u);
+		const Vec4V sv = V4Sel(negDet, V4Neg(v), v);
+		const Vec4V sd = V4Sel(negDet, V4Neg(d), d);
+
+		// eps covers the one-sided test on unscaled u, v, eps*|det| the two-sided one, and the relative term the rounding
+		const Vec4V tol = V4Add(V4MulAdd(eps, absDet, eps), V4Mul(absDet, V4Load(1e-4f)));
+		const Vec4V detTol = V4Add(absDet, tol);
+
+		BoolV reject = mBothSides ? V4IsGrtr(eps, absDet) : V4IsGrtr(eps, det);
+		reject = BOr(reject, BOr(V4IsGrtr(V4Neg(tol), su), V4IsGrtr(su, detTol)));
+		reject = BOr(reject, BOr(V4IsGrtr(V4Neg(tol), sv), V4IsGrtr(V4Add(su, sv), detTol)));
+		reject = BOr(reject, BOr(V4IsGrtr(V4Neg(tol), sd), V4IsGrtr(sd, V4MulAdd(V4Load(maxT), absDet, tol))));
+
+		return ~BGetBitMask(reject) & 15;
+	}
+
 	PxVec3	mOrigin;
 	PxVec3	mDir;
 	bool	mBothSides;
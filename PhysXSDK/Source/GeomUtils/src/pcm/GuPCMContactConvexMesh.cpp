@@ -51,6 +51,8 @@ struct PCMConvexVsMeshContactGenerationCallback : PCMMeshContactGenerationCallba
 public:
 	PCMConvexVsMeshContactGeneration		mGeneration;
 	Gu::OBBTriangleTest						mObbTriTest;
+	Gu::MultiplePersistentContactManifold*	mMidphaseCache;	// if set, the indices of the reported triangles are recorded in it
+	PxU32									mNbReportedTriangles;
 
 	PCMConvexVsMeshContactGenerationCallback(
 		const Ps::aos::FloatVArg				contactDistance,
@@ -71,10 +73,21 @@ public:
 	) :
 		PCMMeshContactGenerationCallback<PCMConvexVsMeshContactGenerationCallback>(meshScaling, extraTriData, idtMeshScale),
 		mGeneration(contactDistance, replaceBreakingThreshold, convexTransform, meshTransform, multiManifold, contactBuffer, polyData, polyMap, delayedContacts, convexScaling, idtConvexScale),
-		mObbTriTest(box)
+		mObbTriTest(box),
+		mMidphaseCache(NULL),
+		mNbReportedTriangles(0)
 	{
 	}
 
+	virtual PxAgain processHit(
+		const PxRaycastHit& hit, const PxVec3& v0, const PxVec3& v1, const PxVec3& v2, PxReal& shrunkMaxT, const PxU32* vinds)
+	{
+		if(mMidphaseCache && mNbReportedTriangles < GU_MIDPHASE_CACHE_SIZE)
+			mMidphaseCache->mCachedTriangles[mNbReportedTriangles] = hit.faceIndex;
+		mNbReportedTriangles++;
+		return PCMMeshContactGenerationCallback<PCMConvexVsMeshContactGenerationCallback>::processHit(hit, v0, v1, v2, shrunkMaxT, vinds);
+	}
+
 	PX_FORCE_INLINE Ps::IntBool doTest(const PxVec3& v0, const PxVec3& v1, const PxVec3& v2)
 	{
 		return mObbTriTest.obbTriTest(v0, v1, v2);
@@ -159,8 +172,65 @@ bool Gu::PCMContactConvexMesh(const Gu::PolygonalData& polyData, Gu::SupportLoca
 			contactDist, replaceBreakingThreshold, convexTransform, meshTransform, multiManifold, contactBuffer,
 			polyData, polyMap, delayedContacts, convexScaling, idtConvexScale, meshScaling, extraData, idtMeshScale, hullOBB);
 
+#if PX_IS_SPU
 		MPT_SET_CONTEXT("pcxm", transform1, meshScaling);
 		MeshRayCollider::collideOBB(hullOBB, true, hmd, blockCallback);
+#else
+		// The midphase is run with a box inflated around the hull, and the triangles it reports are cached in the manifold.
+		// While the hull stays inside that box the cached triangles are replayed instead of querying the midphase again, the
+		// triangles that no longer touch the hull are rejected by the OBB-triangle test of the callback like before.
+		// When the inflated query returns more triangles than the cache holds, the pair falls back to the tight query with
+		// the hull box and only tries the inflated one again once the triangles around the hull would fit in the cache.
+		const PxVec3 hullExtents = hullOBB.computeAABBExtent();
+		if(multiManifold.mNumCachedTriangles && PxBounds3::centerExtents(hullOBB.center, hullExtents).isInside(multiManifold.mMidphaseBounds))
+		{
+			const PxVec3* PX_RESTRICT vertices = meshData->mVertices;
+			const bool has16BitIndices = (meshData->mFlags & PxTriangleMeshFlag::eHAS_16BIT_TRIANGLE_INDICES) != 0;
+			PxRaycastHit hit;
+			hit.flags = PxHitFlag::ePOSITION|PxHitFlag::eDISTANCE;
+			for(PxU32 i=0; i<multiManifold.mNumCachedTriangles; i++)
+			{
+				const PxU32 triangleIndex = multiManifold.mCachedTriangles[i];
+				PxU32 vinds[3];
+				if(has16BitIndices)
+				{
+					const PxU16* PX_RESTRICT tri = reinterpret_cast<const PxU16*>(meshData->mTriangles) + triangleIndex*3;
+					vinds[0] = tri[0]; vinds[1] = tri[1]; vinds[2] = tri[2];
+				}
+				else
+				{
+					const PxU32* PX_RESTRICT tri = reinterpret_cast<const PxU32*>(meshData->mTriangles) + triangleIndex*3;
+					vinds[0] = tri[0]; vinds[1] = tri[1]; vinds[2] = tri[2];
+				}
+				hit.faceIndex = triangleIndex;
+				PxReal maxT = PX_MAX_F32;
+				blockCallback.processHit(hit, vertices[vinds[0]], vertices[vinds[1]], vertices[vinds[2]], maxT, vinds);
+			}
+		}
+		else if(multiManifold.mMidphaseCacheOverflow)
+		{
+			MPT_SET_CONTEXT("pcxm", transform1, meshScaling);
+			MeshRayCollider::collideOBB(hullOBB, true, hmd, blockCallback);
+
+			// the inflated box covers about twice the volume of the hull box
+			multiManifold.mMidphaseCacheOverflow = blockCallback.mNbReportedTriangles > GU_MIDPHASE_CACHE_SIZE/2;
+		}
+		else
+		{
+			const PxVec3 queryExtents = hullExtents + PxVec3(hullExtents.maxElement() * 0.25f);
+			const Gu::Box queryBox(hullOBB.center, queryExtents, PxMat33(PxIdentity));
+			multiManifold.mMidphaseBounds = PxBounds3::centerExtents(hullOBB.center, queryExtents);
+			blockCallback.mMidphaseCache = &multiManifold;
+
+			MPT_SET_CONTEXT("pcxm", transform1, meshScaling);
+			MeshRayCollider::collideOBB(queryBox, true, hmd, blockCallback);
+
+			// too many triangles to cache, the next queries use the hull box
+			const bool overflow = blockCallback.mNbReportedTriangles > GU_MIDPHASE_CACHE_SIZE;
+			multiManifold.mNumCachedTriangles = overflow ? 0 : blockCallback.mNbReportedTriangles;
+			multiManifold.mMidphaseCacheOverflow = overflow;
+		}
+#endif
 
 		PX_ASSERT(multiManifold.mNumManifolds <= GU_MAX_MANIFOLD_SIZE);
 
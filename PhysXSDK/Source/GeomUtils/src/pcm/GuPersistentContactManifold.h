@@ -17,6 +17,7 @@
 #include "PsVecTransform.h"
 #include "PxUnionCast.h"
 #include "PxMemory.h"
+#include "PxBounds3.h"
 
 namespace physx
 {
@@ -31,6 +32,8 @@ namespace physx
 #define GU_SPHERE_MANIFOLD_CACHE_SIZE 1
 #define GU_CAPSULE_MANIFOLD_CACHE_SIZE 3
 #define GU_MAX_MANIFOLD_SIZE 4
+//This is the number of triangles a convex vs mesh pair can cache from its last midphase query
+#define GU_MIDPHASE_CACHE_SIZE 64
 
 namespace Cm
 {
@@ -461,7 +464,9 @@ struct MultiPersistentManifoldHeader
 {
 	Ps::aos::PsTransformV mRelativeTransform;//aToB
 	PxU32 mNumManifolds;
-	PxU32 pad[3];
+	PxU32 mNumCachedTriangles;//if non-zero, the midphase bounds and triangle indices follow the manifolds
+	PxU32 mMidphaseCacheOverflow;
+	PxU32 pad;
 };
 
 struct SingleManifoldHeader
@@ -479,7 +484,7 @@ PX_ALIGN_PREFIX(16)
 class MultiplePersistentContactManifold
 {
 public:
-	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0)
+	MultiplePersistentContactManifold():mNumManifolds(0), mNumTotalContacts(0), mNumCachedTriangles(0), mMidphaseCacheOverflow(0)
 	{
 		mRelativeTransform.Invalidate();
 	}
@@ -647,6 +652,8 @@ public:
 	{
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
+		mNumCachedTriangles = 0;
+		mMidphaseCacheOverflow = 0;
 		mRelativeTransform.Invalidate();
 		for(PxU8 i=0; i<GU_MAX_MANIFOLD_SIZE; ++i)
 		{
@@ -663,6 +670,8 @@ public:
 		}
 		mNumManifolds = 0;
 		mNumTotalContacts = 0;
+		mNumCachedTriangles = 0;
+		mMidphaseCacheOverflow = 0;
 		mRelativeTransform.Invalidate();
 	}
 
@@ -691,6 +700,8 @@ public:
 	//Code to load from a buffer and store to a buffer.
 	void fromBuffer(PxU8*  PX_RESTRICT buffer);
 	void toBuffer(PxU8*  PX_RESTRICT buffer);
+	//size of the buffer needed by toBuffer, a multiple of 16
+	PxU32 getBufferSize() const;
 
 	static void drawLine(Cm::RenderOutput& out, const Ps::aos::Vec3VArg p0, const Ps::aos::Vec3VArg p1, const PxU32 color = 0xff00ffff);
 	static void drawLine(Cm::RenderOutput& out, const PxVec3 p0, const PxVec3 p1, const PxU32 color = 0xff00ffff);
@@ -703,7 +714,14 @@ public:
 	PxU8 mNumManifolds;
 	PxU8 mNumTotalContacts;
 	SinglePersistentContactManifold mManifolds[GU_MAX_MANIFOLD_SIZE];
-	
+
+	//Midphase cache of convex vs mesh pairs: mCachedTriangles are the triangles found by a midphase query with mMidphaseBounds, in mesh vertex space.
+	//As long as the query volume of the pair stays inside these bounds, the cached triangles are a superset of what a new query would return.
+	//mMidphaseCacheOverflow is set when the triangles around the pair do not fit in the cache, the midphase then runs with the tight query volume.
+	PxBounds3 mMidphaseBounds;
+	PxU32 mNumCachedTriangles;
+	PxU32 mMidphaseCacheOverflow;
+	PxU32 mCachedTriangles[GU_MIDPHASE_CACHE_SIZE];
 	
 } PX_ALIGN_SUFFIX(16);
 
@@ -798,6 +816,9 @@ PX_INLINE void MultiplePersistentContactManifold::fromBuffer(PxU8*  PX_RESTRICT
 		numManifolds = header->mNumManifolds;
 		PX_ASSERT(numManifolds <= GU_MAX_MANIFOLD_SIZE);
 		mRelativeTransform = header->mRelativeTransform;
+		mNumCachedTriangles = header->mNumCachedTriangles;
+		mMidphaseCacheOverflow = header->mMidphaseCacheOverflow;
+		PX_ASSERT(mNumCachedTriangles <= GU_MIDPHASE_CACHE_SIZE);
 
 
 		for(PxU32 a = 0; a < numManifolds; ++a)
@@ -820,10 +841,18 @@ PX_INLINE void MultiplePersistentContactManifold::fromBuffer(PxU8*  PX_RESTRICT
 			}
 			buff += sizeof(Gu::CachedMeshPersistentContact) * numContacts;
 		}
+
+		if(mNumCachedTriangles)
+		{
+			PxMemCopy(&mMidphaseBounds, buff, sizeof(PxBounds3));
+			PxMemCopy(mCachedTriangles, buff + sizeof(PxBounds3), sizeof(PxU32) * mNumCachedTriangles);
+		}
 	}
 	else
 	{
 		mRelativeTransform.Invalidate();
+		mNumCachedTriangles = 0;
+		mMidphaseCacheOverflow = 0;
 	}
 	mNumManifolds = (PxU8)numManifolds;
 	for(PxU32 a = numManifolds; a < GU_MAX_MANIFOLD_SIZE; ++a)
@@ -846,6 +875,8 @@ PX_INLINE void MultiplePersistentContactManifold::toBuffer(PxU8*  PX_RESTRICT bu
 
 	PX_ASSERT(mNumManifolds <= GU_MAX_MANIFOLD_SIZE);
 	header->mNumManifolds = mNumManifolds;
+	header->mNumCachedTriangles = mNumCachedTriangles;
+	header->mMidphaseCacheOverflow = mMidphaseCacheOverflow;
 	header->mRelativeTransform = mRelativeTransform;
 
 	for(PxU32 a = 0; a < mNumManifolds; ++a)
@@ -868,6 +899,20 @@ PX_INLINE void MultiplePersistentContactManifold::toBuffer(PxU8*  PX_RESTRICT bu
 		}
 		buff += sizeof(CachedMeshPersistentContact) * manifold.mNumContacts;
 	}
+
+	if(mNumCachedTriangles)
+	{
+		PxMemCopy(buff, &mMidphaseBounds, sizeof(PxBounds3));
+		PxMemCopy(buff + sizeof(PxBounds3), mCachedTriangles, sizeof(PxU32) * mNumCachedTriangles);
+	}
+}
+
+PX_INLINE PxU32 MultiplePersistentContactManifold::getBufferSize() const
+{
+	const PxU32 midphaseCacheSize = mNumCachedTriangles ? ((sizeof(PxBounds3) + sizeof(PxU32) * mNumCachedTriangles + 15) & ~15) : 0;
+	return sizeof(MultiPersistentManifoldHeader) + 
+		mNumManifolds * sizeof(SingleManifoldHeader) +
+		mNumTotalContacts * sizeof(CachedMeshPersistentContact) + midphaseCacheSize;
 }
 
 #ifdef PX_PS3
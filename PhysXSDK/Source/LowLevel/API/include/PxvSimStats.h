@@ -37,6 +37,11 @@ Description: Containts statistics for the simulation.
 */
 struct PxvSimStats
 {
+	enum
+	{
+		eSOLVER_PARTITION_SIZE_BUCKETS = 12		// must match PxSimulationStatistics::eSOLVER_PARTITION_SIZE_BUCKETS
+	};
+
 	PxvSimStats() { clearAll(); }
 	void clearAll() { PxMemZero(this, sizeof(PxvSimStats)); }		// set counters to zero
 
@@ -81,6 +86,13 @@ struct PxvSimStats
 	PxU32 mTotalCompressedContactSize;
 	PxU32 mTotalConstraintSize;
 	PxU32 mPeakConstraintBlockAllocations;
+	PxU32 mNbContactDataBlocks;
+	PxU32 mNbContactDataBlocksOverLimit;
+	PxU32 mPeakNpThreadMemory;
+
+	PxU32 numSolverPartitions;
+	PxU32 maxSolverPartitionSize;
+	PxU32 numSolverPartitionsBySize[eSOLVER_PARTITION_SIZE_BUCKETS];
 };
 
 }
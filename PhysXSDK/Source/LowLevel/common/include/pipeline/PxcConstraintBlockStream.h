@@ -101,13 +101,15 @@ public:
 	PxcContactBlockStream(PxcNpMemBlockPool & blockPool):
 		mBlockPool(blockPool),
 		mBlock(NULL),
-		mUsed(0)
+		mUsed(0),
+		mReservedBytes(0)
 	{
 	}
 
 	PX_FORCE_INLINE	PxU8* reserve(PxU32 size)
 										{
 											size = (size+15)&~15;
+											mReservedBytes += size;
 
 											if(size>PxcNpMemBlock::SIZE)
 												return mBlockPool.acquireExceptionalConstraintMemory(size);
@@ -138,10 +140,15 @@ public:
 		return mBlockPool;
 	}
 
+	// bytes reserved since the last call to clearReservedBytes, unlike reset() this spans block boundaries
+	PX_FORCE_INLINE	PxU32				getReservedBytes()		const	{ return mReservedBytes;	}
+	PX_FORCE_INLINE	void				clearReservedBytes()			{ mReservedBytes = 0;		}
+
 private:
 			PxcNpMemBlockPool&			mBlockPool;
 			PxcNpMemBlock*				mBlock;	// current constraint block
 			PxU32						mUsed;	// number of bytes used in constraint block
+			PxU32						mReservedBytes;
 };
 
 }
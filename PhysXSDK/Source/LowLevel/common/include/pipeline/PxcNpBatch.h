@@ -38,6 +38,22 @@ void PxcDiscreteNarrowPhase(PxcNpThreadContext& context, PxcNpWorkUnit& n);
 void PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, PxcNpWorkUnit& n);
 void PxcSkipNarrowPhase(PxcNpWorkUnit& n);
 
+// Runs the discrete narrow phase for work units that all have the same pair of geometry types, see PxcNpWorkUnitGetPairTypeKey.
+// Sphere-sphere and sphere-plane pairs are processed four at a time in structure-of-arrays form with the math of the PCM contact methods,
+// other pairs one by one.
+void PxcDiscreteNarrowPhaseGroup(PxcNpThreadContext& context, PxcNpWorkUnit* const* units, PxU32 nbUnits);
+void PxcDiscreteNarrowPhaseGroupPCM(PxcNpThreadContext& context, PxcNpWorkUnit* const* units, PxU32 nbUnits);
+
+#define PXC_NP_PAIR_TYPE_KEY_COUNT	(PxGeometryType::eGEOMETRY_COUNT * PxGeometryType::eGEOMETRY_COUNT)
+
+// Identifies the unordered pair of geometry types of a work unit, less than PXC_NP_PAIR_TYPE_KEY_COUNT
+PX_FORCE_INLINE PxU32 PxcNpWorkUnitGetPairTypeKey(const PxcNpWorkUnit& n)
+{
+	const PxU32 g0 = n.geomType0;
+	const PxU32 g1 = n.geomType1;
+	return g0 < g1 ? g0 * PxGeometryType::eGEOMETRY_COUNT + g1 : g1 * PxGeometryType::eGEOMETRY_COUNT + g0;
+}
+
 struct PxcNpBatchEntry
 {
 	PxcNpWorkUnit*		workUnit;
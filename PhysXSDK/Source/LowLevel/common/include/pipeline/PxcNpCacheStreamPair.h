@@ -33,11 +33,16 @@ public:
 	// reserve can fail and return null.
 	PxU8*					reserve(PxU32 byteCount);
 	void					reset();
+
+	// bytes reserved since the last call to clearReservedBytes
+	PX_FORCE_INLINE	PxU32	getReservedBytes()		const	{ return mReservedBytes;	}
+	PX_FORCE_INLINE	void	clearReservedBytes()			{ mReservedBytes = 0;		}
 private:
 	PxcNpMemBlockPool&	mBlockPool;
 	PxU16				mBlockIndex;
 	PxcNpMemBlock*		mBlock;
 	PxU32				mUsed;
+	PxU32				mReservedBytes;
 private:
 	PxcNpCacheStreamPair& operator=(const PxcNpCacheStreamPair&);
 };
@@ -42,12 +42,16 @@ public:
 	PxcNpMemBlockPool(PxcScratchAllocator& allocator);
 	~PxcNpMemBlockPool();
 
-	void			init(PxU32 initial16KDataBlocks, PxU32 maxBlocks);
+	// with growable set, maxBlocks is a soft limit: blocks are still allocated above it, and freed again when released
+	void			init(PxU32 initial16KDataBlocks, PxU32 maxBlocks, bool growable = false);
 	void			flush();
 	void			setBlockCount(PxU32 count);
 	PxU32			getUsedBlockCount() const;
 	PxU32			getMaxUsedBlockCount() const;
 	PxU32			getPeakConstraintBlockCount() const;
+	PxU32			getAllocatedBlockCount() const;
+	PxU32			getPeakBlocksOverLimit() const;
+	void			resetPeakBlocksOverLimit();
 	void			releaseUnusedBlocks();
 
 	PxcNpMemBlock*	acquireConstraintBlock();
@@ -128,6 +132,8 @@ private:
 	PxU32					mInitialBlocks;
 	PxU32					mUsedBlocks;
 	PxU32					mMaxUsedBlocks;
+	PxU32					mPeakBlocksOverLimit;
+	bool					mGrowable;
 	PxcNpMemBlock*			mScratchBlockAddr;
 	PxU32					mNbScratchBlocks;
 	PxcScratchAllocator&	mScratchAllocator;
@@ -137,6 +143,7 @@ private:
 
 	PxcNpMemBlock*	acquire(PxcNpMemBlockArray& trackingArray, PxU32* allocationCount = NULL, PxU32* peakAllocationCount = NULL, bool isScratchAllocation = false);
 	void			release(PxcNpMemBlockArray& deadArray, PxU32* allocationCount = NULL);
+	void			recycle(PxcNpMemBlock* block);
 
 #ifdef PX_PS3
 	PxU32			mMaxSpuContactBlocks;
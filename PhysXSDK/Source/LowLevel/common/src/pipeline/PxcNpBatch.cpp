@@ -27,6 +27,7 @@
 #include "PxTriangleMesh.h"
 #include "PxsMaterialManager.h"
 #include "PxsTransformCache.h"
+#include "PsVecMath.h"
 
 using namespace physx;
 using namespace Gu;
@@ -270,9 +271,7 @@ void runNpPCMBatchPPU(	PxcNpThreadContext* context,
 		if(isMultiManifold)
 		{
 			//Store the manifold back...
-			const PxU32 size = (sizeof(MultiPersistentManifoldHeader) + 
-				manifold.mNumManifolds * sizeof(SingleManifoldHeader) +
-				manifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+			const PxU32 size = manifold.getBufferSize();
 			PxU8* buffer = context->mNpCacheStreamPair.reserve(size);
 
 			PX_ASSERT((reinterpret_cast<uintptr_t>(buffer) & 0xf) == 0);
@@ -818,9 +817,7 @@ void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, PxcNpWorkUnit
 	if(isMultiManifold)
 	{
 		//Store the manifold back...
-		const PxU32 size = (sizeof(MultiPersistentManifoldHeader) + 
-			manifold.mNumManifolds * sizeof(SingleManifoldHeader) +
-			manifold.mNumTotalContacts * sizeof(Gu::CachedMeshPersistentContact));
+		const PxU32 size = manifold.getBufferSize();
 
 		PxU8* buffer = context.mNpCacheStreamPair.reserve(size);
 
@@ -833,6 +830,265 @@ void physx::PxcDiscreteNarrowPhasePCM(PxcNpThreadContext& context, PxcNpWorkUnit
 	finishContacts(n, context, materialInfo);
 }
 
+namespace
+{
+	// Four pairs of the same geometry types in structure-of-arrays form. Shape 0 has the lower geometry type, like in the contact method tables.
+	struct PxcNpSoAPairs
+	{
+		enum { SIZE = 4 };
+
+		PX_ALIGN(16, PxF32 p0[3][SIZE]);
+		PX_ALIGN(16, PxF32 p1[3][SIZE]);
+		PX_ALIGN(16, PxF32 q1[4][SIZE]);
+		PX_ALIGN(16, PxF32 radius0[SIZE]);
+		PX_ALIGN(16, PxF32 radius1[SIZE]);
+		PX_ALIGN(16, PxF32 contactDistance[SIZE]);
+
+		PX_ALIGN(16, PxF32 point[3][SIZE]);
+		PX_ALIGN(16, PxF32 normal[3][SIZE]);
+		PX_ALIGN(16, PxF32 separation[SIZE]);
+		PxU32 hitMask;
+
+		PxcNpWorkUnit*	units[SIZE];
+		bool			flip[SIZE];
+	};
+}
+
+static PX_FORCE_INLINE bool needsContactGeneration(const PxcNpWorkUnit& n)
+{
+	if(!(n.flags & PxcNpWorkUnitFlag::eDETECT_DISCRETE_CONTACT))
+		return false;
+
+	const bool active0 = (n.flags & PxcNpWorkUnitFlag::eDYNAMIC_BODY0) && !(n.rigidCore0->mInternalFlags & PxsRigidCore::eFROZEN);
+	const bool active1 = (n.flags & PxcNpWorkUnitFlag::eDYNAMIC_BODY1) && !(n.rigidCore1->mInternalFlags & PxsRigidCore::eFROZEN);
+	return active0 || active1;
+}
+
+// PxcPCMContactSphereSphere for one pair per lane
+static void contactSphereSphere4(PxcNpSoAPairs& pairs)
+{
+	using namespace Ps::aos;
+
+	const Vec4V p0x = V4LoadA(pairs.p0[0]);
+	const Vec4V p0y = V4LoadA(pairs.p0[1]);
+	const Vec4V p0z = V4LoadA(pairs.p0[2]);
+	const Vec4V r0 = V4LoadA(pairs.radius0);
+	const Vec4V r1 = V4LoadA(pairs.radius1);
+
+	const Vec4V dx = V4Sub(p0x, V4LoadA(pairs.p1[0]));
+	const Vec4V dy = V4Sub(p0y, V4LoadA(pairs.p1[1]));
+	const Vec4V dz = V4Sub(p0z, V4LoadA(pairs.p1[2]));
+
+	const Vec4V distanceSq = V4Add(V4Add(V4Mul(dx, dx), V4Mul(dy, dy)), V4Mul(dz, dz));
+	const Vec4V radiusSum = V4Add(r0, r1);
+	const Vec4V inflatedSum = V4Add(radiusSum, V4LoadA(pairs.contactDistance));
+
+	pairs.hitMask = BGetBitMask(V4IsGrtr(V4Mul(inflatedSum, inflatedSum), distanceSq));
+	if(!pairs.hitMask)
+		return;
+
+	const Vec4V magn = V4Sqrt(distanceSq);
+	// exactly overlapping spheres get an arbitrary normal, the division is kept away from zero
+	const BoolV coincident = V4IsGrtrOrEq(V4Load(0.00001f), magn);
+	const Vec4V safeMagn = V4Sel(coincident, V4One(), magn);
+
+	const Vec4V nx = V4Sel(coincident, V4One(), V4Div(dx, safeMagn));
+	const Vec4V ny = V4Sel(coincident, V4Zero(), V4Div(dy, safeMagn));
+	const Vec4V nz = V4Sel(coincident, V4Zero(), V4Div(dz, safeMagn));
+
+	const Vec4V scale = V4Mul(V4Sub(V4Add(r0, magn), r1), V4Load(-0.5f));
+
+	V4StoreA(nx, pairs.normal[0]);
+	V4StoreA(ny, pairs.normal[1]);
+	V4StoreA(nz, pairs.normal[2]);
+	V4StoreA(V4MulAdd(nx, scale, p0x), pairs.point[0]);
+	V4StoreA(V4MulAdd(ny, scale, p0y), pairs.point[1]);
+	V4StoreA(V4MulAdd(nz, scale, p0z), pairs.point[2]);
+	V4StoreA(V4Sub(magn, radiusSum), pairs.separation);
+}
+
+// PxcPCMContactSpherePlane for one pair per lane
+static void contactSpherePlane4(PxcNpSoAPairs& pairs)
+{
+	using namespace Ps::aos;
+
+	const Vec4V p0x = V4LoadA(pairs.p0[0]);
+	const Vec4V p0y = V4LoadA(pairs.p0[1]);
+	const Vec4V p0z = V4LoadA(pairs.p0[2]);
+	const Vec4V qx = V4LoadA(pairs.q1[0]);
+	const Vec4V qy = V4LoadA(pairs.q1[1]);
+	const Vec4V qz = V4LoadA(pairs.q1[2]);
+	const Vec4V qw = V4LoadA(pairs.q1[3]);
+	const Vec4V r0 = V4LoadA(pairs.radius0);
+	const Vec4V two = V4Load(2.0f);
+
+	// x of the sphere center in plane space (QuatRotateInv), the plane is n=<1,0,0> d=0 there
+	const Vec4V vx = V4Sub(p0x, V4LoadA(pairs.p1[0]));
+	const Vec4V vy = V4Sub(p0y, V4LoadA(pairs.p1[1]));
+	const Vec4V vz = V4Sub(p0z, V4LoadA(pairs.p1[2]));
+	const Vec4V w2 = V4Sub(V4Mul(qw, qw), V4Load(0.5f));
+	const Vec4V dot = V4Add(V4Add(V4Mul(qx, vx), V4Mul(qy, vy)), V4Mul(qz, vz));
+	const Vec4V crossX = V4Sub(V4Mul(qy, vz), V4Mul(qz, vy));
+	const Vec4V centerX = V4Mul(V4MulAdd(qx, dot, V4NegMulSub(crossX, qw, V4Mul(vx, w2))), two);
+
+	const Vec4V separation = V4Sub(centerX, r0);
+	pairs.hitMask = BGetBitMask(V4IsGrtrOrEq(V4LoadA(pairs.contactDistance), separation));
+	if(!pairs.hitMask)
+		return;
+
+	// plane normal (QuatGetBasisVector0)
+	const Vec4V x2 = V4Mul(qx, two);
+	const Vec4V qw2 = V4Mul(qw, two);
+	const Vec4V nx = V4Sub(V4MulAdd(qx, x2, V4Mul(qw, qw2)), V4One());
+	const Vec4V ny = V4MulAdd(qy, x2, V4Mul(qz, qw2));
+	const Vec4V nz = V4MulAdd(qz, x2, V4Mul(V4Neg(qy), qw2));
+
+	V4StoreA(nx, pairs.normal[0]);
+	V4StoreA(ny, pairs.normal[1]);
+	V4StoreA(nz, pairs.normal[2]);
+	V4StoreA(V4NegMulSub(nx, r0, p0x), pairs.point[0]);
+	V4StoreA(V4NegMulSub(ny, r0, p0y), pairs.point[1]);
+	V4StoreA(V4NegMulSub(nz, r0, p0z), pairs.point[2]);
+	V4StoreA(separation, pairs.separation);
+}
+
+static void discreteNarrowPhaseSoA(PxcNpThreadContext& context, PxcNpSoAPairs& pairs, const PxU32 nbPairs, const PxGeometryType::Enum g0, const PxGeometryType::Enum g1)
+{
+	// pad with the first pair so that unused lanes compute valid numbers
+	for(PxU32 i=nbPairs;i<PxcNpSoAPairs::SIZE;i++)
+	{
+		for(PxU32 j=0;j<3;j++)
+		{
+			pairs.p0[j][i] = pairs.p0[j][0];
+			pairs.p1[j][i] = pairs.p1[j][0];
+		}
+		for(PxU32 j=0;j<4;j++)
+			pairs.q1[j][i] = pairs.q1[j][0];
+		pairs.radius0[i] = pairs.radius0[0];
+		pairs.radius1[i] = pairs.radius1[0];
+		pairs.contactDistance[i] = pairs.contactDistance[0];
+	}
+
+	if(g1 == PxGeometryType::eSPHERE)
+		contactSphereSphere4(pairs);
+	else
+		contactSpherePlane4(pairs);
+
+	const PxcGetMaterialMethod materialMethod = g_GetMaterialMethodTable[g0][g1];
+	PX_ASSERT(materialMethod);
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		PxcNpWorkUnit& n = *pairs.units[i];
+		const bool flip = pairs.flip[i];
+		const PxsShapeCore* shape0 = flip ? n.shapeCore1 : n.shapeCore0;
+		const PxsShapeCore* shape1 = flip ? n.shapeCore0 : n.shapeCore1;
+
+#if PX_ENABLE_SIM_STATS
+		context.discreteContactPairs[g0][g1]++;
+#endif
+		startContacts(n, context);
+
+		if(pairs.hitMask & (1<<i))
+		{
+			const PxVec3 point(pairs.point[0][i], pairs.point[1][i], pairs.point[2][i]);
+			const PxVec3 normal(pairs.normal[0][i], pairs.normal[1][i], pairs.normal[2][i]);
+			context.mContactBuffer.contact(point, normal, pairs.separation[i]);
+		}
+
+		PxsMaterialInfo materialInfo[ContactBuffer::MAX_CONTACTS];
+		materialMethod(shape0, shape1, context, materialInfo);
+
+		if(flip)
+			flipContacts(context, materialInfo);
+
+		finishContacts(n, context, materialInfo);
+	}
+}
+
+template<bool pcm>
+static void discreteNarrowPhaseGroup(PxcNpThreadContext& context, PxcNpWorkUnit* const* units, const PxU32 nbUnits)
+{
+	if(!nbUnits)
+		return;
+
+	PxGeometryType::Enum g0 = static_cast<PxGeometryType::Enum>(units[0]->geomType0);
+	PxGeometryType::Enum g1 = static_cast<PxGeometryType::Enum>(units[0]->geomType1);
+	if(g1 < g0)
+		Ps::swap(g0, g1);
+
+	const bool soa = g0 == PxGeometryType::eSPHERE && (g1 == PxGeometryType::eSPHERE || g1 == PxGeometryType::ePLANE);
+
+	PxcNpSoAPairs pairs;
+	PxU32 nbPairs = 0;
+	for(PxU32 i=0;i<nbUnits;i++)
+	{
+		PxcNpWorkUnit& n = *units[i];
+		PX_ASSERT(PxcNpWorkUnitGetPairTypeKey(n) == PxcNpWorkUnitGetPairTypeKey(*units[0]));
+
+		if(i+1 < nbUnits)
+		{
+			const PxcNpWorkUnit* nextUnit = units[i+1];
+			Ps::prefetchLine(nextUnit->rigidCore0);
+			Ps::prefetchLine(nextUnit->rigidCore1);
+			Ps::prefetchLine(nextUnit->shapeCore0);
+			Ps::prefetchLine(nextUnit->shapeCore1);
+		}
+
+		if(!soa || !needsContactGeneration(n))
+		{
+			if(pcm)
+				PxcDiscreteNarrowPhasePCM(context, n);
+			else
+				PxcDiscreteNarrowPhase(context, n);
+			continue;
+		}
+
+		const bool flip = n.geomType1 < n.geomType0;
+		const PxsShapeCore* shape0 = flip ? n.shapeCore1 : n.shapeCore0;
+		const PxsShapeCore* shape1 = flip ? n.shapeCore0 : n.shapeCore1;
+		const PxTransform& tm0 = context.mTransformCache->getTransformCache(flip ? n.mTransformCache1 : n.mTransformCache0);
+		const PxTransform& tm1 = context.mTransformCache->getTransformCache(flip ? n.mTransformCache0 : n.mTransformCache1);
+		PX_ASSERT(tm0.isSane() && tm1.isSane());
+
+		pairs.units[nbPairs] = &n;
+		pairs.flip[nbPairs] = flip;
+		pairs.p0[0][nbPairs] = tm0.p.x;
+		pairs.p0[1][nbPairs] = tm0.p.y;
+		pairs.p0[2][nbPairs] = tm0.p.z;
+		pairs.p1[0][nbPairs] = tm1.p.x;
+		pairs.p1[1][nbPairs] = tm1.p.y;
+		pairs.p1[2][nbPairs] = tm1.p.z;
+		pairs.q1[0][nbPairs] = tm1.q.x;
+		pairs.q1[1][nbPairs] = tm1.q.y;
+		pairs.q1[2][nbPairs] = tm1.q.z;
+		pairs.q1[3][nbPairs] = tm1.q.w;
+		pairs.radius0[nbPairs] = shape0->geometry.get<const PxSphereGeometry>().radius;
+		// the plane has no radius, the sphere-plane kernel does not read it
+		pairs.radius1[nbPairs] = g1 == PxGeometryType::eSPHERE ? shape1->geometry.get<const PxSphereGeometry>().radius : 0.0f;
+		pairs.contactDistance[nbPairs] = shape0->contactOffset + shape1->contactOffset;
+
+		if(++nbPairs == PxcNpSoAPairs::SIZE)
+		{
+			discreteNarrowPhaseSoA(context, pairs, nbPairs, g0, g1);
+			nbPairs = 0;
+		}
+	}
+
+	if(nbPairs)
+		discreteNarrowPhaseSoA(context, pairs, nbPairs, g0, g1);
+}
+
+void physx::PxcDiscreteNarrowPhaseGroup(PxcNpThreadContext& context, PxcNpWorkUnit* const* units, PxU32 nbUnits)
+{
+	discreteNarrowPhaseGroup<false>(context, units, nbUnits);
+}
+
+void physx::PxcDiscreteNarrowPhaseGroupPCM(PxcNpThreadContext& context, PxcNpWorkUnit* const* units, PxU32 nbUnits)
+{
+	discreteNarrowPhaseGroup<true>(context, units, nbUnits);
+}
+
 #ifdef PX_CHECKED
 #if SPU_NARROWPHASE
 
@@ -24,7 +24,7 @@ void PxcNpCacheStreamPair::reset()
 }
 
 PxcNpCacheStreamPair::PxcNpCacheStreamPair(PxcNpMemBlockPool& blockPool):
-  mBlockPool(blockPool), mBlock(NULL), mUsed(0)
+  mBlockPool(blockPool), mBlock(NULL), mUsed(0), mReservedBytes(0)
 {
 }
 
@@ -51,6 +51,7 @@ PxU8* PxcNpCacheStreamPair::reserve(PxU32 size)
 	{
 		ptr = mBlock->data+mUsed;
 		mUsed += size;
+		mReservedBytes += size;
 	}
 
 	return ptr;
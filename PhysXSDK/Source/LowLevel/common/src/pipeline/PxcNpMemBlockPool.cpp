@@ -25,6 +25,8 @@ PxcNpMemBlockPool::PxcNpMemBlockPool(PxcScratchAllocator& allocator):
   mMaxBlocks(0),
   mUsedBlocks(0),
   mMaxUsedBlocks(0),
+  mPeakBlocksOverLimit(0),
+  mGrowable(false),
   mScratchBlockAddr(0),
   mNbScratchBlocks(0),
   mScratchAllocator(allocator),
@@ -39,9 +41,10 @@ PxcNpMemBlockPool::PxcNpMemBlockPool(PxcScratchAllocator& allocator):
 {
 }
 
-void PxcNpMemBlockPool::init(PxU32 initialBlockCount, PxU32 maxBlocks)
+void PxcNpMemBlockPool::init(PxU32 initialBlockCount, PxU32 maxBlocks, bool growable)
 {
 	mMaxBlocks = maxBlocks;
+	mGrowable = growable;
 	mInitialBlocks = initialBlockCount;
 
 	PxU32 reserve = PxMax<PxU32>(initialBlockCount, 64);
@@ -73,6 +76,21 @@ PxU32 PxcNpMemBlockPool::getPeakConstraintBlockCount() const
 	return mPeakConstraintAllocations;
 }
 
+PxU32 PxcNpMemBlockPool::getAllocatedBlockCount() const
+{
+	return mAllocatedBlocks;
+}
+
+PxU32 PxcNpMemBlockPool::getPeakBlocksOverLimit() const
+{
+	return mPeakBlocksOverLimit;
+}
+
+void PxcNpMemBlockPool::resetPeakBlocksOverLimit()
+{
+	mPeakBlocksOverLimit = 0;
+}
+
 
 void PxcNpMemBlockPool::setBlockCount(PxU32 blockCount)
 {
@@ -142,7 +160,7 @@ void PxcNpMemBlockPool::releaseConstraintMemory()
 			mScratchBlocks.pushBack(block);
 		else
 		{
-			mUnused.pushBack(block);
+			recycle(block);
 			PX_ASSERT(mUsedBlocks>0);
 			mUsedBlocks--;
 		}
@@ -195,7 +213,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	}	
 
 
-	if(mAllocatedBlocks == mMaxBlocks)
+	if(mAllocatedBlocks >= mMaxBlocks && !mGrowable)
 	{
 #ifdef PX_CHECKED
 		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, 
@@ -214,6 +232,8 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 
 	// increment here so that if we hit the limit in separate threads we won't overallocated
 	mAllocatedBlocks++;
+	if(mAllocatedBlocks > mMaxBlocks)
+		mPeakBlocksOverLimit = PxMax<PxU32>(mAllocatedBlocks - mMaxBlocks, mPeakBlocksOverLimit);
 	
 	PxcNpMemBlock* block = reinterpret_cast<PxcNpMemBlock*>(PX_ALLOC(sizeof(PxcNpMemBlock), PX_DEBUG_EXP("PxcNpMemBlock")));
 
@@ -256,8 +276,21 @@ void PxcNpMemBlockPool::release(PxcNpMemBlockArray& deadArray, PxU32* allocation
 		{
 			PX_ASSERT(mUnused[a] != block);
 		}
-		mUnused.pushBack(block);
+		recycle(block);
+	}
+}
+
+// must be called with mLock held. Blocks allocated above the limit of a growable pool are freed right away, so
+// that the pool shrinks back to the limit once the spike that needed them is over.
+void PxcNpMemBlockPool::recycle(PxcNpMemBlock* block)
+{
+	if(mGrowable && mAllocatedBlocks > mMaxBlocks)
+	{
+		PX_FREE(block);
+		mAllocatedBlocks--;
 	}
+	else
+		mUnused.pushBack(block);
 }
 
 void PxcNpMemBlockPool::flushUnused()
@@ -297,7 +330,7 @@ void PxcNpMemBlockPool::releaseConstraintBlocks(PxcNpMemBlockArray& memBlocks)
 			mScratchBlocks.pushBack(block);
 		else
 		{
-			mUnused.pushBack(block);
+			recycle(block);
 			PX_ASSERT(mUsedBlocks>0);
 			mUsedBlocks--;
 		}
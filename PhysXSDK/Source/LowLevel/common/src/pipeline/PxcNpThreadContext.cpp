@@ -49,5 +49,7 @@ void PxcNpThreadContext::clearStats()
 	PxMemSet(discreteContactPairs, 0, sizeof(discreteContactPairs));
 	mCompressedCacheSize = 0;
 	mConstraintSize = 0;
+	mContactBlockStream.clearReservedBytes();
+	mNpCacheStreamPair.clearReservedBytes();
 }
 #endif
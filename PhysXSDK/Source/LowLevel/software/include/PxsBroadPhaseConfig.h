@@ -33,6 +33,12 @@ using namespace Ps::aos;
 //Maximum number of overlaps allowed on spu.
 #define MAX_NUM_BP_SPU_SAP_OVERLAPS 8192 //1024 for spu debug
 
+//Number of updates without being created or updated after which a box is parked (PxSceneFlag::eENABLE_BROADPHASE_PARKING).
+#define BP_SAP_PARKING_DELAY 4
+
+//Number of parked boxes per leaf of the parked tree.
+#define BP_SAP_PARKED_BUCKET_SIZE 16
+
 //////////////////////////
 //AGGREGATE MANAGER
 //////////////////////////
@@ -48,6 +54,25 @@ using namespace Ps::aos;
 #define PX_DEFAULT_BOX_ARRAY_CAPACITY 64
 #define	PX_DEFAULT_AGGREGATE_CAPACITY 0
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//AVX2 BOX PRUNING
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//The MBP and SAP box pruning loops have an AVX2 version, used when Ps::Cpu::hasAVX2() is true at runtime.
+//PX_BP_AVX2_TARGET lets the compiler emit AVX2 code for these functions only.
+#if (defined(PX_X86) || defined(PX_X64)) && !defined(PX_PS4) && !defined(PX_XBOXONE) && !defined(__SPU__)
+	#if defined(PX_VC) && (_MSC_VER >= 1700)
+		#define PX_BP_AVX2 1
+		#define PX_BP_AVX2_TARGET
+	#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		#define PX_BP_AVX2 1
+		#define PX_BP_AVX2_TARGET __attribute__((target("avx2")))
+	#endif
+#endif
+#ifndef PX_BP_AVX2
+	#define PX_BP_AVX2 0
+#endif
+
 }
 
 #endif //PXS_BROADPHASE_CONFIG_H
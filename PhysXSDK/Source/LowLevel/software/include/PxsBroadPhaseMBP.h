@@ -79,7 +79,8 @@ namespace physx
 				const PxcBpHandle*				mGroups;	// ### why are those 'handles'?
 
 				void							setUpdateData(const PxcBroadPhaseUpdateData& updateData);
-				void							updatePPU(PxBaseTask* continuation);
+				void							updatePPU(const PxU32 numCpuTasks, PxBaseTask* continuation);
+				void							updateRegionPPU(PxU32 regionIndex);
 				void							postUpdatePPU(PxBaseTask* continuation);
 #ifdef PX_PS3
 				bool							canRunOnSpu() const														{ return false;	}
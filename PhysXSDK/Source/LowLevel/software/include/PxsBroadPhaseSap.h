@@ -20,6 +20,7 @@
 #include "PxsBroadPhaseConfig.h"
 #include "PxcPool.h"
 #include "CmPhysXCommon.h"
+#include "PsArray.h"
 #include "PxsSAPTasks.h"
 
 //KS - This has been tested and found to work on PS3. It will only take effect on PPU fallbacks but can offer better performance in degenerate cases
@@ -108,10 +109,10 @@ public:
 	friend class SapUpdateWorkTask;
 	friend class SapPostUpdateWorkTask;
 
-										PxsBroadPhaseContextSap(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler);
+										PxsBroadPhaseContextSap(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler, bool parkIdleBoxes);
 	virtual								~PxsBroadPhaseContextSap();
 
-	static PxsBroadPhaseContextSap*		create(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler);
+	static PxsBroadPhaseContextSap*		create(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler, bool parkIdleBoxes);
 	virtual	void						destroy();
 
 	virtual	PxBroadPhaseType::Enum		getType()																			const	{ return PxBroadPhaseType::eSAP;	}
@@ -178,6 +179,9 @@ private:
 			PxU32						mDataSize;
 			PxU32						mDataCapacity;
 
+	//AVX2 box pruning of the new boxes, see performBoxPruningNewNew() and performBoxPruningNewOld().
+			bool						mUseAVX2;
+
 	//All current box-box overlap pairs.
 			SapPairManager				mPairs;
 
@@ -189,6 +193,24 @@ private:
 			PxU32						mDeletedPairsSize;
 			PxU32						mDeletedPairsCapacity;
 
+	//Parked boxes (PxSceneFlag::eENABLE_BROADPHASE_PARKING).
+	//Boxes that have not been created or updated for BP_SAP_PARKING_DELAY updates are taken out of the sorted end point arrays
+	//and only tested against the boxes that are created or updated, until they are updated or removed.
+	//The pair manager keeps the pairs of the parked boxes: a pair with a parked box exists if its parked bounds overlap the other box.
+			bool						mParkingEnabled;
+			PxU32						mUpdateCount;										//Number of updates so far.
+			Ps::Array<PxU32>			mBoxLastActive;										//Update count when each box was last created or updated (needs to have mBoxesCapacity).
+			Ps::Array<PxU32>			mBoxParkedIndex;									//Position of each box in the parked arrays or PX_INVALID_U32 (needs to have mBoxesCapacity).
+			Ps::Array<PxcBpHandle>		mActiveBoxes[BP_SAP_PARKING_DELAY];					//Boxes created or updated by the last updates.
+			Ps::Array<IntegerAABB>		mParkedBounds;										//Bounds of the parked boxes sorted by min x.
+			Ps::Array<PxcBpHandle>		mParkedHandles;										//Owner of each parked bounds.
+			Ps::Array<PxcBPValType>		mParkedTree;										//Largest max x of the parked bounds below each node of a binary tree over buckets of the parked arrays.
+			PxU32						mParkedTreeLeaves;									//Number of leaves of the parked tree (a power of two).
+			PxU32						mParkedTreeDirtyIndex;								//First parked index changed since the parked tree was built or PX_INVALID_U32.
+			Ps::Array<PxcBpHandle>		mUnparked;											//Parked boxes updated by this update.
+			Ps::Array<PxcBpHandle>		mRemovedParked;										//Parked boxes removed by this update.
+			Ps::Array<PxcBpHandle>		mRemovedSorted;										//Removed boxes that are in the sorted arrays.
+
 			bool						setUpdateData(const PxcBroadPhaseUpdateData& updateData);
 			void						updatePPU(PxBaseTask* continuation);
 			void						postUpdatePPU(PxBaseTask* continuation);
@@ -198,11 +220,32 @@ private:
 			void						postUpdateSPU(const PxU32 numSpus, PxBaseTask* continuation);
 #endif
 
+			void						growEndPoints(const PxU32 newEndPointsCapacity);
+
 	//Batch create/remove/update.
 			void						batchCreate();
 			void						batchRemove();
 			void						batchUpdate();
 
+			void						insertEndPoints(const PxcBpHandle* PX_RESTRICT handles, const IntegerAABB* PX_RESTRICT bounds, const PxU32 numBoxes);
+			void						removeEndPoints(const PxcBpHandle* PX_RESTRICT handles, const PxU32 numBoxes);
+
+	//Parking.
+			void						partitionParkedBoxes();
+			void						unparkBoxes();
+			void						unparkAllBoxes();
+			void						updateParkedPairs();
+			void						createParkedPairs();
+			void						parkIdleBoxes();
+			void						removeParkedBoxes(const PxcBpHandle* PX_RESTRICT handles, const PxU32 numHandles, IntegerAABB* PX_RESTRICT bounds);
+			void						updateParkedTree();
+			void						findParkedOverlaps(const IntegerAABB* PX_RESTRICT boxes, const PxU32 numBoxes, Ps::Array<PxU32>& overlaps);
+
+			PX_FORCE_INLINE	bool		isParked(const PxcBpHandle handle) const 
+			{
+				return handle<mBoxParkedIndex.size() && mBoxParkedIndex[handle]!=PX_INVALID_U32;
+			}
+
 			void						batchUpdate(const PxU32 Axis, PxcBroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
 #if BP_UPDATE_BEFORE_SWAP
 			void						batchUpdateFewUpdates(const PxU32 Axis, PxcBroadPhasePair*& pairs, PxU32& pairsSize, PxU32& pairsCapacity);
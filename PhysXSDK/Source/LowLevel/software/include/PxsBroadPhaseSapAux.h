@@ -331,7 +331,7 @@ void performBoxPruningNewNew
 (const Gu::Axes& axes,
  const PxcBpHandle* PX_RESTRICT newBoxIndicesSorted, const PxU32 newBoxIndicesCount,  const bool allNewBoxesStatics,
  PxcBpHandle* PX_RESTRICT minPosList0,
- SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds, 
+ SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds, const bool useAVX2,
 #ifndef __SPU__
  SapPairManager& pairManager, PxcBpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity);
 #else
@@ -342,7 +342,7 @@ void performBoxPruningNewOld
 (const Gu::Axes& axes,
  const PxcBpHandle* PX_RESTRICT newBoxIndicesSorted, const PxU32 newBoxIndicesCount, const PxcBpHandle* PX_RESTRICT oldBoxIndicesSorted, const PxU32 oldBoxIndicesCount,
  PxcBpHandle* PX_RESTRICT minPosListNew,  PxcBpHandle* PX_RESTRICT minPosListOld,
- SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds,
+ SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds, const bool useAVX2,
 #ifndef __SPU__
  SapPairManager& pairManager, PxcBpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity);
 #else
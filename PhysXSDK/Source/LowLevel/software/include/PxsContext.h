@@ -190,6 +190,7 @@ public:
 	PX_FORCE_INLINE		bool					getPCM()					const	{ return mPCM;														}
 	PX_FORCE_INLINE		bool					getContactCacheFlag()		const	{ return mContactCache;												}
 	PX_FORCE_INLINE		bool					getCreateAveragePoint()		const	{ return mCreateAveragePoint;										}
+	PX_FORCE_INLINE		bool					getSolverSubIslandScheduling()	const	{ return mSolverSubIslandScheduling;						}
 
 	// Contact manager related
 						void					markActive(PxsContactManager* cm);	
@@ -424,6 +425,7 @@ private:
 						bool					mPCM;
 						bool					mContactCache;
 						bool					mCreateAveragePoint;
+						bool					mSolverSubIslandScheduling;
 
 						PxI32					mNumFastMovingShapes;
 						
@@ -43,6 +43,7 @@ struct PxcArticulationSolverDesc;
 struct PxsBodyCore;
 struct PxsDynamicsStats;
 struct PxsIslandObjects;
+struct PxsSolverChunkGraph;
 class PxsIslandIndices;
 struct PxsIndexedInteraction;
 struct PxcSolverConstraintDesc;
@@ -81,7 +82,8 @@ class PxsMaterialManager;
 	Ps::Array<PxU32>& accumulatedHeadersPerPartition,				\
 	Ps::Array<PxU32>& accumulatedFrictionHeadersPerPartition,		\
 	PxsRigidBody** PX_RESTRICT rigidBodies,							\
-	const PxU32 batchSize
+	const PxU32 batchSize,											\
+	const PxsSolverChunkGraph* chunkGraph
 
 typedef	void (*PxsSolveParallelMethod)(SOLVER_PARALLEL_METHOD_ARGS);
 extern PxsSolveParallelMethod solveParallel[3];
@@ -188,6 +190,11 @@ public:
 	*/
  	PX_FORCE_INLINE void				setSolverBatchSize(PxU32 f)				{ mSolverBatchSize = f;		}
 	/**
+	\brief Returns true if pairs of block contact batches can be solved 8 at a time with AVX
+	\return True if the 8-wide contact kernels are compiled in and supported by the CPU.
+	*/
+	PX_FORCE_INLINE bool					getSolveContactBlocksAVX()		const	{ return mSolveContactBlocksAVX;	}
+	/**
 	\brief Returns the current frame's timestep
 	\return The current frame's timestep.
 	*/
@@ -360,6 +367,7 @@ protected:
 	\param[in] accumulatedHeadersPerPartition Counts of the number of batch headers per-partition.
 	\param[inout] rigidBodies Array of PxsRigidBody pointers used to store results of integration.
 	\param[in] batchSize Defines the batch size. This is computed based on the number of threads and constraints to minimize atomic operation overhead.
+	\param[in] chunkGraph Work chunks and their dependencies if the island is scheduled by sub-islands, NULL to wait for each partition to complete.
 	*/
 	void								solveParallel(const PxU32 positionIterations, const PxU32 velocityIterations, 
 											 PxcSolverBody* PX_RESTRICT atomListStart, PxcSolverBodyData* PX_RESTRICT atomDataList, 
@@ -370,7 +378,8 @@ protected:
 											 Cm::SpatialVector* motionVelocityArray, PxsBodyCore*const* bodyArray, Cm::BitMap& localChangedActors,
 											 PxsArticulation*const* PX_RESTRICT articulations, PxU32 numArtics, volatile PxI32* numObjectsIntegrated,
 											 Ps::Array<PxsConstraintBatchHeader>& contactBlocks,  Ps::Array<PxsConstraintBatchHeader>& frictionBlocks,
-											Ps::Array<PxU32>& accumulatedHeadersPerPartition, PxsRigidBody** PX_RESTRICT rigidBodies, const PxU32 batchSize);
+											Ps::Array<PxU32>& accumulatedHeadersPerPartition, PxsRigidBody** PX_RESTRICT rigidBodies, const PxU32 batchSize,
+											const PxsSolverChunkGraph* chunkGraph);
 
 /**
 	\brief Solves an island in parallel using the 1D/2D friction models.
@@ -482,6 +491,10 @@ protected:
 	*/
 	PxU32						mSolverBatchSize;
 	/**
+	\brief True if the CPU supports AVX, batches of 4 block contacts are then merged into batches of 8 after constraint prep.
+	*/
+	bool						mSolveContactBlocksAVX;
+	/**
 	\brief The total number of kinematic bodies in the scene
 	*/
 	PxU32						mKinematicCount;
@@ -19,6 +19,7 @@
 #include "PxcScratchAllocator.h"
 #include "PxsIslandManagerAux.h"
 #include "CmPhysXCommon.h"
+#include "CmTask.h"
 #include "PxTask.h"
 
 namespace physx
@@ -44,6 +45,30 @@ namespace Cm
 class IslandGenSpuTask;
 #endif
 
+class PxsIslandManager;
+
+//Links a range of the edges of the islands that are rebuilt in PxsIslandManager::updateIslands.
+class PxsIslandGenLinkTask : public Cm::Task
+{
+public:
+	PxsIslandGenLinkTask() : mIslandManager(NULL), mStartEdge(0), mEndEdge(0) {}
+
+	void set(PxsIslandManager* islandManager, const PxU32 startEdge, const PxU32 endEdge)
+	{
+		mIslandManager=islandManager;
+		mStartEdge=startEdge;
+		mEndEdge=endEdge;
+	}
+
+	virtual void runInternal();
+	virtual const char* getName() const { return "PxsIslandManager.linkIslands"; }
+
+private:
+	PxsIslandManager* mIslandManager;
+	PxU32 mStartEdge;
+	PxU32 mEndEdge;
+};
+
 class PxsIslandManager
 {
 	PX_NOCOPY(PxsIslandManager)
@@ -184,8 +209,13 @@ public:
 	}
 
 	//Update all the islands.
+	//Islands with a broken edge are rebuilt by linking their edges on several tasks if there are worker threads, the
+	//update then completes in a task that runs before continuation.
 	void updateIslands(PxBaseTask* continuation, const PxU32 numSpus);
 
+	//Link the edges [startEdge, endEdge) of the islands rebuilt in updateIslands.  Called from PxsIslandGenLinkTask.
+	void linkIslandEdges(const PxU32 startEdge, const PxU32 endEdge);
+
 	//Update the islands that were woken up in the primary update because they might need to be split further up.
 	//The necessary information is only available after the second narrowphase ran on the created contact managers.
 	void updateIslandsSecondPass(PxBaseTask* continuation, const PxU32 numSpus);
@@ -316,7 +346,8 @@ private:
 	void cleanupEdgeEvents();
 	void clearEdgeCreatedFlags();
 	void clearDeletedNodeStateChanges();
-	void updateIslands();
+	void updateIslandsBegin();
+	void updateIslandsEnd(PxBaseTask* continuation);
 	void updateIslandsSecondPass(Cm::BitMap& affectedIslandsBitmap);
 #ifdef PX_PS3
 	bool mPPUFallback;
@@ -327,6 +358,16 @@ private:
 	bool isValid();
 #endif
 
+	//Tasks used to rebuild islands with a broken edge in parallel.
+	enum
+	{
+		eMAX_NB_LINK_TASKS = 32,
+		eMIN_NB_EDGES_PER_LINK_TASK = 1024
+	};
+	PxsIslandGenLinkTask mLinkTasks[eMAX_NB_LINK_TASKS];
+	typedef Cm::DelegateTask<PxsIslandManager, &PxsIslandManager::updateIslandsEnd> UpdateIslandsEndTask;
+	UpdateIslandsEndTask mUpdateIslandsEndTask;
+
 #ifdef PX_PS3
 	IslandGenSpuTask* mIslandGenSpuTask;
 	IslandGenSpuTask* mIslandGenSecondPassSpuTask;
@@ -1320,6 +1320,12 @@ struct IslandManagerUpdateWorkBuffers
 	//Buffers to store graph of island merging.
 	IslandType* mGraphStartIslands;
 	IslandType* mGraphNextIslands;
+
+	//Buffers to store a copy of the nodes and edges of all islands with a broken edge.
+	NodeType* mGraphNodes;
+	PxU32 mNumGraphNodes;
+	EdgeType* mGraphEdges;
+	PxU32 mNumGraphEdges;
 };
 
 // necessary because else the Wii U linker fails (function call is too far away). Revisit when new compiler version is out
@@ -1353,6 +1359,34 @@ void updateIslandsMain
  IslandManagerUpdateWorkBuffers& workBuffers,
  Cm::EventProfiler* eventProfiler=NULL);
 
+//updateIslandsMain is updateIslandsMainBegin, linkBrokenEdgeIslandNodes over all gathered edges and updateIslandsMainEnd.
+//The split allows the edges to be linked by several threads in between.
+void updateIslandsMainBegin
+(const NodeType* PX_RESTRICT deletedNodes, const PxU32 numDeletedNodes,
+ const NodeType* PX_RESTRICT createdNodes, const PxU32 numCreatedNodes,
+ const EdgeType* PX_RESTRICT deletedEdges, const PxU32 numDeletedEdges,
+ const EdgeType* PX_RESTRICT brokenEdges, const PxU32 numBrokenEdges,
+ const EdgeType* PX_RESTRICT joinedEdges, const PxU32 numJoinedEdges,
+ const Cm::BitMap& kinematicNodesBitmap, const Cm::BitMap& kinematicChangeNodesBitmap, const PxU32 numKinematics,
+ const Cm::BitMap& notReadyForSleepingNodesBitmap, const Cm::BitMap& notReadyForSleepingChangeNodesBitmap,
+ NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands,
+ IslandManagerUpdateWorkBuffers& workBuffers,
+ Cm::EventProfiler* eventProfiler=NULL);
+
+void updateIslandsMainEnd
+(const PxU32 rigidBodyOffset,
+ NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands, ArticulationRootManager& articulationRootManager,
+ ProcessSleepingIslandsComputeData& psicData,
+ IslandManagerUpdateWorkBuffers& workBuffers,
+ Cm::EventProfiler* eventProfiler=NULL);
+
+#ifndef __SPU__
+//Join the nodes of the gathered edges [startEdge, endEdge) of the islands being rebuilt.
+//Different ranges may be linked concurrently (not with 16 bit handles), the result doesn't depend on the order the edges are linked in.
+void linkBrokenEdgeIslandNodes
+(const EdgeManager& edgeManager, IslandManagerUpdateWorkBuffers& workBuffers, const PxU32 startEdge, const PxU32 endEdge);
+#endif
+
 void updateIslandsSecondPassMain
 (const PxU32 rigidBodyOffset, Cm::BitMap& affectedIslandsBitmap,
  const EdgeType* PX_RESTRICT brokenEdges, const PxU32 numBrokenEdges,
@@ -118,6 +118,24 @@ namespace physx
 #endif
 	};
 
+	// Box pruning of a single MBP region. MBPUpdateWorkTask spawns one of these per region with updated objects when
+	// there is more than one worker thread, MBPPostUpdateWorkTask then merges the overlaps found by each region.
+	class MBPRegionWorkTask : public MBPTask
+	{
+	public:
+										MBPRegionWorkTask() : mRegionIndex(0)	{}
+
+		PX_FORCE_INLINE	void			setRegion(PxU32 regionIndex)				{ mRegionIndex = regionIndex;	}
+
+		// BaseTask
+		virtual void					runInternal();
+		virtual const char*				getName() const { return "PxsMBP.regionWork"; }
+		//~BaseTask
+
+	private:
+						PxU32				mRegionIndex;
+	};
+
 	class MBPPostUpdateWorkTask : public MBPTask
 	{
 	public:
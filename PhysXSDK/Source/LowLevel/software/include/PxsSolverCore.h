@@ -38,6 +38,11 @@ struct PxsConstraintBatchHeader;
 struct PxcSolverContext;
 class PxsArticulation;
 
+namespace Cm
+{
+	class SpatialVector;
+}
+
 
 typedef void (*WriteBackMethod)(const PxcSolverConstraintDesc& desc, PxcSolverContext& cache, PxcSolverBodyData& sbd0, PxcSolverBodyData& sbd1);
 typedef void (*SolveMethod)(const PxcSolverConstraintDesc& desc, PxcSolverContext& cache);
@@ -146,6 +151,25 @@ PX_INLINE void WaitForProgressCount(volatile PxI32* pGlobalIndex, const PxI32 ta
 
 
 
+/*!
+Work chunks of the parallel solver and their dependencies, built by constructSolverChunks when PxSceneFlag::eENABLE_SOLVER_SUB_ISLAND_SCHEDULING is set.
+A chunk is a range of batch headers of a single partition. Instead of waiting for the whole previous partition, a chunk waits for the chunks that
+last touched one of its bodies, earlier in the same solver pass or later in the previous pass.
+*/
+struct PxsSolverChunkGraph
+{
+	enum
+	{
+		ePROGRESS_STRIDE = 16	//progress counters of different chunks are kept a cache line apart
+	};
+
+	const PxU32*	chunkStarts;		//first batch header of every chunk, numChunks+1 entries
+	const PxU32*	dependencyStarts;	//first dependency of every chunk, numChunks+1 entries
+	const PxU32*	dependencies;		//indices of the chunks a chunk depends on
+	PxI32*			progress;			//number of solver passes completed by every chunk, ePROGRESS_STRIDE apart
+	PxU32			numChunks;
+};
+
 /*!
 Interface to constraint solver cores
 
@@ -189,7 +213,7 @@ public:
 		 PxcThresholdStreamElement* PX_RESTRICT thresholdStream, const PxU32 thresholdStreamLength, PxI32* outThresholdPairs,
 		 const Ps::Array<PxsConstraintBatchHeader>& constraintBatchHeaders, const Ps::Array<PxsConstraintBatchHeader>& frictionBatchHeaders,
 		 const Ps::Array<PxU32>& headersPerPartition, Cm::SpatialVector* PX_RESTRICT motionVelocityArray, PxI32& normalIterations,
-		 const PxU32 batchSize) const = 0;
+		 const PxU32 batchSize, const PxsSolverChunkGraph* chunkGraph) const = 0;
 
 	virtual void solveVCoulombParallelAndWriteBack
 		(const PxReal dt, const PxU32 _positionIterations, const PxU32 _velocityIterations, 
@@ -99,6 +99,25 @@ void contactPreBlock_WriteBack(const PxcSolverConstraintDesc* PX_RESTRICT desc,
 void writeBack1D4Block(const PxcSolverConstraintDesc* PX_RESTRICT desc, const PxU32 constraintCount, PxcSolverContext& cache,
 										PxcThresholdStreamElement* PX_RESTRICT thresholdStream, const PxU32 thresholdStreamLength, PxI32* outThresholdPairs);
 
+//The contact pre-block functions above also accept two batches of 4 as a single batch of 8 (constraintCount == 8), solved with AVX.
+//Such batches are only built by PxsSolverSetupSolveTask when the CPU supports AVX and contactPreBlocksHaveSameLayout() is true
+//for the two batches, i.e. their constraint streams have the same sequence of headers with the same numbers of contacts and frictions.
+bool contactPreBlocksHaveSameLayout(const PxcSolverConstraintDesc* PX_RESTRICT desc0, const PxcSolverConstraintDesc* PX_RESTRICT desc1);
+
+//PX_SOLVER_AVX_TARGET lets the compiler emit AVX code for the 8-wide contact kernels only.
+#if (defined(PX_X86) || defined(PX_X64)) && !defined(PX_PS4) && !defined(PX_XBOXONE) && !defined(__SPU__)
+	#if defined(PX_VC) && (_MSC_VER >= 1700)
+		#define PX_SOLVER_AVX 1
+		#define PX_SOLVER_AVX_TARGET
+	#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		#define PX_SOLVER_AVX 1
+		#define PX_SOLVER_AVX_TARGET __attribute__((target("avx")))
+	#endif
+#endif
+#ifndef PX_SOLVER_AVX
+	#define PX_SOLVER_AVX 0
+#endif
+
 
 
 
@@ -456,7 +475,7 @@ public:
 		 PxcThresholdStreamElement* PX_RESTRICT thresholdStream, const PxU32 thresholdStreamLength, PxI32* outThresholdPairs,
 		 const Ps::Array<PxsConstraintBatchHeader>& constraintBatchHeaders, const Ps::Array<PxsConstraintBatchHeader>& frictionConstraintBatches,
 		 const Ps::Array<PxU32>& headersPerPartition, Cm::SpatialVector* PX_RESTRICT motionVelocityArray, PxI32& normalIterations,
-		 const PxU32 batchSize) const;
+		 const PxU32 batchSize, const PxsSolverChunkGraph* chunkGraph) const;
 
 	virtual void solveVCoulombParallelAndWriteBack
 		(const PxReal dt, const PxU32 _positionIterations, const PxU32 _velocityIterations, 
@@ -15,6 +15,8 @@
 #define PXS_CONTACTCACHE_H
 
 #include "PxvConfig.h"
+#include "PxvSimStats.h"
+#include "PxsSolverCore.h"
 #include "CmBitMap.h"
 #include "PxTransform.h"
 #include "CmMatrix34.h"
@@ -61,6 +63,9 @@ public:
 			numActiveDynamicBodies = 0;
 			numActiveKinematicBodies = 0;
 			numAxisSolverConstraints = 0;
+			numSolverPartitions = 0;
+			maxSolverPartitionSize = 0;
+			PxMemZero(numSolverPartitionsBySize, sizeof(numSolverPartitionsBySize));
 #endif
 		}
 
@@ -68,6 +73,9 @@ public:
 		PxU32 numActiveDynamicBodies;
 		PxU32 numActiveKinematicBodies;
 		PxU32 numAxisSolverConstraints;
+		PxU32 numSolverPartitions;
+		PxU32 maxSolverPartitionSize;
+		PxU32 numSolverPartitionsBySize[PxvSimStats::eSOLVER_PARTITION_SIZE_BUCKETS];
 
 	};
 
@@ -114,6 +122,12 @@ public:
 	Ps::Array<PxU32>					mConstraintsPerPartition;
 	Ps::Array<PxU32>					mFrictionConstraintsPerPartition;
 	Ps::Array<PxU32>					mPartitionNormalizationBitmap;
+	Ps::Array<PxU32>					mSolverChunkStarts;
+	Ps::Array<PxU32>					mSolverChunkDependencyStarts;
+	Ps::Array<PxU32>					mSolverChunkDependencies;
+	Ps::Array<PxI32>					mSolverChunkProgress;
+	Ps::Array<PxU32>					mSolverChunkScratch;
+	PxsSolverChunkGraph					mSolverChunkGraph;
 	Ps::Array<PxsBodyCore*>				bodyCoreArray;
 	Ps::Array<Cm::SpatialVector>		accelerationArray;
 	Ps::Array<Cm::SpatialVector>		motionVelocityArray;
@@ -17,6 +17,12 @@
 #include "PxsAABBManager.h"
 #include "CmUtils.h"
 #include "CmEventProfiler.h"
+#include "PxsBroadPhaseConfig.h"
+#include "PsBitUtils.h"
+#include "PsCpu.h"
+#if PX_BP_AVX2
+	#include <immintrin.h>
+#endif
 
 //#define CHECK_NB_OVERLAPS
 //#define USE_SINGLE_THREADED_REFERENCE_CODE
@@ -494,6 +500,32 @@ void BitArray::resize(PxU32 nbBits)
 						void				reserveMemory(PxU32 memSize);
 	};
 
+	// Overlaps found by a single BoxPruner when regions are pruned in parallel. Each region task fills its own buffer,
+	// and the buffers are then merged into the MBP_PairManager in region order. This issues exactly the same sequence
+	// of addPair() calls as the single-threaded code path, so the results do not depend on task scheduling.
+	class MBP_PairBuffer
+	{
+		public:
+		PX_FORCE_INLINE	void				addPair(PxU32 id0, PxU32 id1, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* objects)
+											{
+												PX_ASSERT(id0!=INVALID_ID);
+												PX_ASSERT(id1!=INVALID_ID);
+												if(groups)
+												{
+													const PxcBpHandle object0 = objects[DecodeHandle_Index(id0)].mUserID;
+													const PxcBpHandle object1 = objects[DecodeHandle_Index(id1)].mUserID;
+													if(groups[object0] == groups[object1])
+														return;
+												}
+												mIDs.pushBack(id0);
+												mIDs.pushBack(id1);
+											}
+
+						void				flush(MBP_PairManager& pairManager);
+
+						Ps::Array<PxU32>	mIDs;	// id0/id1 pairs
+	};
+
 	///////////////////////////////////////////////////////////////////////////
 
 	#define STACK_BUFFER_SIZE	256
@@ -587,7 +619,8 @@ void BitArray::resize(PxU32 nbBits)
 		void				findOverlaps(MBP_PairManager& pairManager, MBPOS_TmpBuffers& buffers);
 #endif
 		void				prepareOverlapsMT();
-		void				findOverlapsMT(MBP_PairManager& pairManager, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* PX_RESTRICT mbpObjects);
+		template<class PairOutputT>
+		void				findOverlapsMT(PairOutputT& pairOutput, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* PX_RESTRICT mbpObjects, bool useAVX2);
 
 //		private:
 		BoxPruning_Input	PX_ALIGN(16, mInput);
@@ -613,6 +646,10 @@ void BitArray::resize(PxU32 nbBits)
 				
 		MBPOS_TmpBuffers	mTmpBuffers;
 
+		// Used when regions are pruned in parallel, see MBP::findRegionOverlapsMT()
+		MBP_PairBuffer		mOverlaps;
+		MBPRegionWorkTask	mRegionTask;
+
 		void				optimizeMemory();
 		void				resizeObjects();
 		void				staticSort();
@@ -649,6 +686,11 @@ void BitArray::resize(PxU32 nbBits)
 #endif
 						void				prepareOverlapsMT();
 						void				findOverlapsMT(const PxcBpHandle* PX_RESTRICT groups);
+						// Parallel version of findOverlapsMT(): spawns one task per region with updated boxes. The overlaps
+						// are buffered per region and merged by mergeRegionOverlaps() once all tasks have completed.
+						PxU32				spawnRegionTasks(PxsBroadPhaseMBP* mbp, PxBaseTask* continuation);
+						void				findRegionOverlapsMT(PxU32 regionIndex, const PxcBpHandle* PX_RESTRICT groups);
+						void				mergeRegionOverlaps();
 						PxU32				finalize(PxsBroadPhaseMBP* mbp);
 						void				shiftOrigin(const PxVec3& shift);
 //		private:
@@ -676,6 +718,7 @@ void BitArray::resize(PxU32 nbBits)
 #endif
 						void				populateNewRegion(const MBP_AABB& box);
 						PxsAABBManager*		mManager;
+						bool				mUseAVX2;	// AVX2 box pruning, see overlap8_AVX2()
 	};
 
 #ifdef MBP_SIMD_OVERLAP
@@ -882,6 +925,18 @@ MBP_Pair* MBP_PairManager::addPair(PxU32 id0, PxU32 id1, const PxcBpHandle* PX_R
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void MBP_PairBuffer::flush(MBP_PairManager& pairManager)
+{
+	// groups have been tested already in addPair()
+	const PxU32 nb = mIDs.size();
+	const PxU32* PX_RESTRICT ids = mIDs.begin();
+	for(PxU32 i=0;i<nb;i+=2)
+		pairManager.addPair(ids[i], ids[i+1]);
+	mIDs.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void MBP_PairManager::removePair(PxU32 /*id0*/, PxU32 /*id1*/, PxU32 hashValue, PxU32 pairIndex)
 {
 	// Walk the hash table to fix mNext
@@ -1101,6 +1156,57 @@ void MBP_PairManager::reserveMemory(PxU32 memSize)
 	#define SIMD_OVERLAP_PRELOAD_BOX0
 #endif
 
+#if PX_BP_AVX2
+	// Tests box0 against the 8 consecutive boxes starting at 'boxes', sorted along X. Returns in bits 0-7 the boxes that
+	// start before 'limit' on X and overlap box0 on Y and Z, and in bits 8-15 the boxes that start after 'limit'. Since
+	// the boxes are sorted, the latter are always the last ones and end the sweep.
+	static PX_BP_AVX2_TARGET PxU32 overlap8_AVX2(const MBP_AABB& box0, const MBP_AABB* PX_RESTRICT boxes, PxU32 limit)
+	{
+		// the encoded bounds are shifted right by one (see initFrom2) so signed comparisons are safe
+		const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(int(sizeof(MBP_AABB)/sizeof(PxU32))));
+		const __m256i minX = _mm256_i32gather_epi32((const int*)&boxes->mMinX, offsets, 4);
+		const __m256i minY = _mm256_i32gather_epi32((const int*)&boxes->mMinY, offsets, 4);
+		const __m256i minZ = _mm256_i32gather_epi32((const int*)&boxes->mMinZ, offsets, 4);
+		const __m256i maxY = _mm256_i32gather_epi32((const int*)&boxes->mMaxY, offsets, 4);
+		const __m256i maxZ = _mm256_i32gather_epi32((const int*)&boxes->mMaxZ, offsets, 4);
+
+		const __m256i outside = _mm256_cmpgt_epi32(minX, _mm256_set1_epi32(int(limit)));
+		__m256i separated = _mm256_or_si256(outside, _mm256_cmpgt_epi32(minY, _mm256_set1_epi32(int(box0.mMaxY))));
+		separated = _mm256_or_si256(separated, _mm256_cmpgt_epi32(_mm256_set1_epi32(int(box0.mMinY)), maxY));
+		separated = _mm256_or_si256(separated, _mm256_cmpgt_epi32(minZ, _mm256_set1_epi32(int(box0.mMaxZ))));
+		separated = _mm256_or_si256(separated, _mm256_cmpgt_epi32(_mm256_set1_epi32(int(box0.mMinZ)), maxZ));
+
+		const PxU32 overlapMask = ~PxU32(_mm256_movemask_ps(_mm256_castsi256_ps(separated))) & 0xff;
+		const PxU32 outsideMask = PxU32(_mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+		return overlapMask | (outsideMask<<8);
+	}
+
+	// Runs the sweep loop 8 boxes at a time while at least 8 boxes are left, the scalar loop that follows does the rest.
+	// 'output' is evaluated for each box overlapping box0, whose index is 'candidate'. Pairs are reported in the same
+	// order as with the scalar loop.
+	#define MBP_AVX2_SWEEP(boxes, nbBoxes, output)									\
+	if(useAVX2)																		\
+	{																				\
+		while(index1+8<=nbBoxes)													\
+		{																			\
+			const PxU32 mask8 = overlap8_AVX2(box0, boxes+index1, limit);			\
+			for(PxU32 bits=mask8&0xff; bits; bits&=bits-1)							\
+			{																		\
+				const PxU32 candidate = index1 + Ps::lowestSetBit(bits);			\
+				output;																\
+			}																		\
+			if(mask8>>8)															\
+			{																		\
+				index1 += Ps::lowestSetBit(mask8>>8);								\
+				break;																\
+			}																		\
+			index1 += 8;															\
+		}																			\
+	}
+#else
+	#define MBP_AVX2_SWEEP(boxes, nbBoxes, output)
+#endif
+
 
 
 
@@ -1680,8 +1786,9 @@ static void endBits()
 }
 #endif
 
+template<class PairOutputT>
 static PX_FORCE_INLINE void outputPair_DynamicDynamic(
-												MBP_PairManager& pairManager,
+												PairOutputT& pairManager,
 												PxU32 index0, PxU32 index1,
 												const MBP_Index* PX_RESTRICT inToOut_Dynamic,
 												const MBPEntry* PX_RESTRICT objects,
@@ -1784,8 +1891,9 @@ static PX_FORCE_INLINE void outputPair_DynamicDynamic(
 	pairManager.addPair(id0, id1, groups, mbpObjects);
 }
 
+template<class PairOutputT>
 static PX_FORCE_INLINE void outputPair_DynamicStatic(
-												MBP_PairManager& pairManager,
+												PairOutputT& pairManager,
 												PxU32 index0, PxU32 index1,
 												const MBP_Index* PX_RESTRICT inToOut_Dynamic, const MBP_Index* PX_RESTRICT inToOut_Static,
 												const MBPEntry* PX_RESTRICT objects,
@@ -2097,8 +2205,10 @@ void BoxPruner::prepareBIPPruning(const MBPOS_TmpBuffers& buffers)
 	mInput.mBIPInput.mNeeded			= true;
 }
 
-static void DoCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const BoxPruning_Input& input, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* mbpObjects)
+template<class PairOutputT>
+static void DoCompleteBoxPruning(PairOutputT* PX_RESTRICT pairManager, const BoxPruning_Input& input, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* mbpObjects, bool useAVX2)
 {
+	PX_UNUSED(useAVX2);
 	const MBPEntry* PX_RESTRICT objects						= input.mObjects;
 	const MBP_AABB* PX_RESTRICT updatedDynamicBoxes			= input.mUpdatedDynamicBoxes;
 	const MBP_AABB* PX_RESTRICT sleepingDynamicBoxes		= input.mSleepingDynamicBoxes;
@@ -2139,6 +2249,8 @@ static void DoCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 				runningIndex1++;
 
 			PxU32 index1 = runningIndex1;
+			MBP_AVX2_SWEEP(sleepingDynamicBoxes, lastSortedIndex1,
+				outputPair_DynamicStatic(*pairManager, index0, candidate, inToOut_Dynamic, inToOut_Dynamic_Sleeping, objects, groups, mbpObjects));
 
 			while(
 #ifndef MBP_USE_SENTINELS
@@ -2194,6 +2306,8 @@ static void DoCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 				runningIndex0++;
 
 			PxU32 index1 = runningIndex0;
+			MBP_AVX2_SWEEP(updatedDynamicBoxes, lastSortedIndex0,
+				outputPair_DynamicStatic(*pairManager, candidate, index0, inToOut_Dynamic, inToOut_Dynamic_Sleeping, objects, groups, mbpObjects));
 
 			while(updatedDynamicBoxes[index1].mMinX<=limit)
 			{
@@ -2247,6 +2361,8 @@ static void DoCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 		if(runningIndex<lastSortedIndex)
 		{
 			PxU32 index1 = runningIndex;
+			MBP_AVX2_SWEEP(updatedDynamicBoxes, lastSortedIndex,
+				outputPair_DynamicDynamic(*pairManager, index0, candidate, inToOut_Dynamic, objects, groups, mbpObjects));
 			while(updatedDynamicBoxes[index1].mMinX<=limit)
 			{
 				MBP_OVERLAP_TEST(updatedDynamicBoxes[index1])
@@ -2279,8 +2395,10 @@ static void DoCompleteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const
 
 #define TWO_AT_A_TIME
 
-static void DoBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, const BIP_Input& input, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* mbpObjects)
+template<class PairOutputT>
+static void DoBipartiteBoxPruning(PairOutputT* PX_RESTRICT pairManager, const BIP_Input& input, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* mbpObjects, bool useAVX2)
 {
+	PX_UNUSED(useAVX2);
 	// ### crashes because the code expects the dynamic array to be sorted, but mDynamicBoxes is not
 	// ### we should instead modify mNbUpdatedBoxes so that mNbUpdatedBoxes == mNbDynamicBoxes, and
 	// ### then the proper sorting happens in CompleteBoxPruning (right?)
@@ -2328,6 +2446,8 @@ static void DoBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 			runningIndex1++;
 
 		PxU32 index1 = runningIndex1;
+		MBP_AVX2_SWEEP(staticBoxes, lastSortedIndex1,
+			outputPair_DynamicStatic(*pairManager, index0, candidate, inToOut_Dynamic, inToOut_Static, mObjects, groups, mbpObjects));
 
 		while(
 #ifndef MBP_USE_SENTINELS
@@ -2384,6 +2504,8 @@ static void DoBipartiteBoxPruning(MBP_PairManager* PX_RESTRICT pairManager, cons
 			runningIndex0++;
 
 		PxU32 index1 = runningIndex0;
+		MBP_AVX2_SWEEP(dynamicBoxes, lastSortedIndex0,
+			outputPair_DynamicStatic(*pairManager, candidate, index0, inToOut_Dynamic, inToOut_Static, mObjects, groups, mbpObjects));
 
 		while(dynamicBoxes[index1].mMinX<=limit)
 		{
@@ -2507,17 +2629,18 @@ void BoxPruner::findOverlaps(MBP_PairManager& pairManager, MBPOS_TmpBuffers& buf
 }
 #endif
 
-void BoxPruner::findOverlapsMT(MBP_PairManager& pairManager, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* PX_RESTRICT mbpObjects)
+template<class PairOutputT>
+void BoxPruner::findOverlapsMT(PairOutputT& pairManager, const PxcBpHandle* PX_RESTRICT groups, const MBP_Object* PX_RESTRICT mbpObjects, bool useAVX2)
 {
 	PX_ASSERT(!mNeedsSorting);
 	if(!mNbUpdatedBoxes)
 		return;
 
 	if(mInput.mNeeded)
-		DoCompleteBoxPruning(&pairManager, mInput, groups, mbpObjects);
+		DoCompleteBoxPruning(&pairManager, mInput, groups, mbpObjects, useAVX2);
 
 	if(mInput.mBIPInput.mNeeded)
-		DoBipartiteBoxPruning(&pairManager, mInput.mBIPInput, groups, mbpObjects);
+		DoBipartiteBoxPruning(&pairManager, mInput.mBIPInput, groups, mbpObjects, useAVX2);
 
 	mNbUpdatedBoxes = 0;
 }
@@ -2543,7 +2666,8 @@ MBP::MBP(PxsAABBManager* manager) :
 	mNbBoxPruners		(0),
 	mFirstFreeIndex		(INVALID_ID),
 	mFirstFreeIndexBP	(INVALID_ID),
-	mManager			(manager)
+	mManager			(manager),
+	mUseAVX2			(PX_BP_AVX2 && Ps::Cpu::hasAVX2())
 {
 	for(PxU32 i=0;i<MAX_NB_MBP+1;i++)
 		mFirstFree[i] = INVALID_ID;
@@ -3302,7 +3426,49 @@ void MBP::findOverlapsMT(const PxcBpHandle* PX_RESTRICT groups)
 	for(PxU32 i=0;i<nb;i++)
 	{
 		if(boxPruners[i].mBP)
-			boxPruners[i].mBP->findOverlapsMT(mPairManager, groups, objects);
+			boxPruners[i].mBP->findOverlapsMT(mPairManager, groups, objects, mUseAVX2);
+	}
+}
+
+PxU32 MBP::spawnRegionTasks(PxsBroadPhaseMBP* mbp, PxBaseTask* continuation)
+{
+	const PxU32 nb = mNbBoxPruners;
+	const BoxPrunerData* PX_RESTRICT boxPruners = (const BoxPrunerData*)mBoxPruners.GetEntries();
+	PxU32 nbTasks = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		BoxPruner* bp = boxPruners[i].mBP;
+		if(bp && bp->mNbUpdatedBoxes)
+		{
+			bp->mRegionTask.setBroadphase(mbp);
+			bp->mRegionTask.setRegion(i);
+			bp->mRegionTask.setContinuation(continuation);
+			bp->mRegionTask.removeReference();
+			nbTasks++;
+		}
+	}
+	return nbTasks;
+}
+
+void MBP::findRegionOverlapsMT(PxU32 regionIndex, const PxcBpHandle* PX_RESTRICT groups)
+{
+	PX_ASSERT(regionIndex<mNbBoxPruners);
+	const BoxPrunerData* PX_RESTRICT boxPruners = (const BoxPrunerData*)mBoxPruners.GetEntries();
+	BoxPruner* bp = boxPruners[regionIndex].mBP;
+	PX_ASSERT(bp);
+	PX_ASSERT(!bp->mOverlaps.mIDs.size());
+	const MBP_Object* objects = (const MBP_Object*)mMBP_Objects.GetEntries();
+	bp->findOverlapsMT(bp->mOverlaps, groups, objects, mUseAVX2);
+}
+
+void MBP::mergeRegionOverlaps()
+{
+	const PxU32 nb = mNbBoxPruners;
+	const BoxPrunerData* PX_RESTRICT boxPruners = (const BoxPrunerData*)mBoxPruners.GetEntries();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(boxPruners[i].mBP)
+			boxPruners[i].mBP->mOverlaps.flush(mPairManager);
 	}
 }
 
@@ -3680,22 +3846,41 @@ void PxsBroadPhaseMBP::setUpdateData(const PxcBroadPhaseUpdateData& updateData)
 #endif
 }
 
-void PxsBroadPhaseMBP::updatePPU(PxBaseTask* /*continuation*/)
+void PxsBroadPhaseMBP::updatePPU(const PxU32 numCpuTasks, PxBaseTask* continuation)
 {
 #ifndef USE_SINGLE_THREADED_REFERENCE_CODE
 	#ifdef CHECK_NB_OVERLAPS
 	gNbOverlaps = 0;
 	#endif
-	mMBP->findOverlapsMT(mGroups);
+	// Regions are pruned independently, so with several worker threads each of them gets its own task.
+	// The continuation (MBPPostUpdateWorkTask) merges their results.
+	if(numCpuTasks>1 && continuation)
+		mMBP->spawnRegionTasks(this, continuation);
+	else
+		mMBP->findOverlapsMT(mGroups);
 	#ifdef CHECK_NB_OVERLAPS
 	printf("PPU: %d overlaps\n", gNbOverlaps);
 	#endif
+#else
+	PX_UNUSED(numCpuTasks);
+	PX_UNUSED(continuation);
+#endif
+}
+
+void PxsBroadPhaseMBP::updateRegionPPU(PxU32 regionIndex)
+{
+#ifndef USE_SINGLE_THREADED_REFERENCE_CODE
+	mMBP->findRegionOverlapsMT(regionIndex, mGroups);
+#else
+	PX_UNUSED(regionIndex);
 #endif
 }
 
 void PxsBroadPhaseMBP::postUpdatePPU(PxBaseTask* /*continuation*/)
 {
 #ifndef USE_SINGLE_THREADED_REFERENCE_CODE
+	mMBP->mergeRegionOverlaps();
+
 	{
 		PxU32 Nb = mMBP->mNbBoxPruners;
 		const BoxPrunerData* PX_RESTRICT boxPruners = (const BoxPrunerData*)mMBP->mBoxPruners.GetEntries();
@@ -21,6 +21,7 @@
 #include "GuRevisitedRadixBuffered.h"
 #include "CmEventProfiler.h"
 #include "PxProfileEventId.h"
+#include "PsCpu.h"
 #ifdef PX_PS3
 #include "CellComputeAABBTask.h"
 #include "CellTimerMarker.h"
@@ -449,9 +450,14 @@ public:
 
 #define ALIGN_SIZE_16(size) (((unsigned)(size)+15)&((unsigned)~15))
 
-PxsBroadPhaseContextSap::PxsBroadPhaseContextSap(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler)  
+PxsBroadPhaseContextSap::PxsBroadPhaseContextSap(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler, bool parkIdleBoxes)  
 : mScratchAllocator(scratchAllocator),
-  mEventProfiler(eventProfiler)
+  mEventProfiler(eventProfiler),
+  mUseAVX2(PX_BP_AVX2 && Ps::Cpu::hasAVX2()),
+  mParkingEnabled(parkIdleBoxes),
+  mUpdateCount(0),
+  mParkedTreeLeaves(0),
+  mParkedTreeDirtyIndex(PX_INVALID_U32)
 {
 	//Boxes
 	mBoxesSize=0;
@@ -585,13 +591,13 @@ void PxsBroadPhaseContextSap::destroy()
 	PX_FREE(this);
 }
 
-PxsBroadPhaseContextSap* PxsBroadPhaseContextSap::create(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler)
+PxsBroadPhaseContextSap* PxsBroadPhaseContextSap::create(PxcScratchAllocator& scratchAllocator, Cm::EventProfiler& eventProfiler, bool parkIdleBoxes)
 {	
 	PxsBroadPhaseContextSap* bpc = reinterpret_cast<PxsBroadPhaseContextSap*>(PX_ALLOC(sizeof(PxsBroadPhaseContextSap), PX_DEBUG_EXP("PxsBroadPhaseContextSap")));
 
 	if(bpc)
 	{
-		new(bpc) PxsBroadPhaseContextSap(scratchAllocator, eventProfiler);
+		new(bpc) PxsBroadPhaseContextSap(scratchAllocator, eventProfiler, parkIdleBoxes);
 	}
 	return bpc;
 }
@@ -685,6 +691,14 @@ void PxsBroadPhaseContextSap::shiftOrigin(const PxVec3& shift)
 	//       the correct one and does not require too many swaps.
 	//
 
+	//The parked bounds can't be shifted on their own without changing which of them touch the shifted sorted boxes.
+	//Put them back in the sorted arrays so that the order is preserved for them as well. They will get parked again
+	//once they stop being updated.
+	if(mParkedHandles.size())
+	{
+		unparkAllBoxes();
+	}
+
 	if(0==mBoxesSize)
 	{
 		return;
@@ -781,6 +795,12 @@ bool PxsBroadPhaseContextSap::isValid(const PxcBroadPhaseUpdateData& updateData)
 	{
 		const PxcBpHandle id=created[i];
 
+		//A parked box has been added already but without being removed.
+		if(isParked(id))
+		{
+			return false;
+		}
+
 		//If id >=mBoxesCapacity then we need to resize to add this id, meaning that the id must be new.
 		if(id<mBoxesCapacity)
 		{
@@ -818,6 +838,12 @@ bool PxsBroadPhaseContextSap::isValid(const PxcBroadPhaseUpdateData& updateData)
 	{
 		const PxcBpHandle id = updated[i];
 
+		//Parked boxes have no end points in the sorted arrays.
+		if(isParked(id))
+		{
+			continue;
+		}
+
 		for(PxU32 j=0;j<3;j++)
 		{
 			const SapBox1D& box1d=mBoxEndPts[j][id];
@@ -852,6 +878,12 @@ bool PxsBroadPhaseContextSap::isValid(const PxcBroadPhaseUpdateData& updateData)
 	{
 		const PxcBpHandle id = removed[i];
 
+		//Parked boxes have no end points in the sorted arrays.
+		if(isParked(id))
+		{
+			continue;
+		}
+
 		for(PxU32 j=0;j<3;j++)
 		{
 			const SapBox1D& box1d=mBoxEndPts[j][id];
@@ -893,6 +925,62 @@ void PxsBroadPhaseContextSap::update( const PxU32 numCpuTasks, const PxU32 numSp
 	}
 }
 
+void PxsBroadPhaseContextSap::growEndPoints(const PxU32 newEndPointsCapacity)
+{
+	PX_ASSERT(newEndPointsCapacity > mEndPointsCapacity);
+
+	PxcBPValType* newEndPointValuesX = (PxcBPValType*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBPValType)*(newEndPointsCapacity))), PX_DEBUG_EXP("BPValType"));
+	PxcBPValType* newEndPointValuesY = (PxcBPValType*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBPValType)*(newEndPointsCapacity))), PX_DEBUG_EXP("BPValType"));
+	PxcBPValType* newEndPointValuesZ = (PxcBPValType*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBPValType)*(newEndPointsCapacity))), PX_DEBUG_EXP("BPValType"));
+	PxcBpHandle* newEndPointDatasX = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*(newEndPointsCapacity))), PX_DEBUG_EXP("PxBpHandle"));
+	PxcBpHandle* newEndPointDatasY = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*(newEndPointsCapacity))), PX_DEBUG_EXP("PxBpHandle"));
+	PxcBpHandle* newEndPointDatasZ = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*(newEndPointsCapacity))), PX_DEBUG_EXP("PxBpHandle"));
+
+#if BP_UPDATE_BEFORE_SWAP
+	PX_FREE(mListNext);
+	PX_FREE(mListPrev);
+
+	mListNext = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*newEndPointsCapacity)), PX_DEBUG_EXP("NextList"));
+	mListPrev = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*newEndPointsCapacity)), PX_DEBUG_EXP("Prev"));
+
+
+	for(PxU32 a = 1; a < newEndPointsCapacity; ++a)
+	{
+		mListNext[a-1] = (PxcBpHandle)a;
+		mListPrev[a] = (PxcBpHandle)(a-1);
+	}
+	mListNext[newEndPointsCapacity-1] = (PxcBpHandle)(newEndPointsCapacity-1);
+	mListPrev[0] = 0;
+#endif
+
+	PxMemCopy(newEndPointValuesX, mEndPointValues[0], sizeof(PxcBPValType)*(mBoxesSize*2+NUM_SENTINELS));
+	PxMemCopy(newEndPointValuesY, mEndPointValues[1], sizeof(PxcBPValType)*(mBoxesSize*2+NUM_SENTINELS));
+	PxMemCopy(newEndPointValuesZ, mEndPointValues[2], sizeof(PxcBPValType)*(mBoxesSize*2+NUM_SENTINELS));
+	PxMemCopy(newEndPointDatasX, mEndPointDatas[0], sizeof(PxcBpHandle)*(mBoxesSize*2+NUM_SENTINELS));
+	PxMemCopy(newEndPointDatasY, mEndPointDatas[1], sizeof(PxcBpHandle)*(mBoxesSize*2+NUM_SENTINELS));
+	PxMemCopy(newEndPointDatasZ, mEndPointDatas[2], sizeof(PxcBpHandle)*(mBoxesSize*2+NUM_SENTINELS));
+	PX_FREE(mEndPointValues[0]);
+	PX_FREE(mEndPointValues[1]);
+	PX_FREE(mEndPointValues[2]);
+	PX_FREE(mEndPointDatas[0]);
+	PX_FREE(mEndPointDatas[1]);
+	PX_FREE(mEndPointDatas[2]);
+	mEndPointValues[0] = newEndPointValuesX;
+	mEndPointValues[1] = newEndPointValuesY;
+	mEndPointValues[2] = newEndPointValuesZ;
+	mEndPointDatas[0] = newEndPointDatasX;
+	mEndPointDatas[1] = newEndPointDatasY;
+	mEndPointDatas[2] = newEndPointDatasZ;
+	mEndPointsCapacity = newEndPointsCapacity;
+
+#if BP_UPDATE_BEFORE_SWAP
+	PX_FREE(mSortedUpdateElements);
+	PX_FREE(mActivityPockets);
+	mSortedUpdateElements = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*newEndPointsCapacity)), PX_DEBUG_EXP("SortedUpdateElements"));
+	mActivityPockets = (PxsBroadPhaseActivityPocket*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxsBroadPhaseActivityPocket)*newEndPointsCapacity)), PX_DEBUG_EXP("PxsBroadPhaseActivityPocket"));
+#endif
+}
+
 bool PxsBroadPhaseContextSap::setUpdateData(const PxcBroadPhaseUpdateData& updateData) 
 {
 	PX_ASSERT(0==mCreatedPairsSize);
@@ -961,62 +1049,16 @@ bool PxsBroadPhaseContextSap::setUpdateData(const PxcBroadPhaseUpdateData& updat
 #endif
 	}
 
-	//Do we need more memory for the array of sorted boxes?
-	if(2*(mBoxesSize + mCreatedSize) + NUM_SENTINELS > mEndPointsCapacity)
+	//Boxes that are parked and updated are put back in the sorted arrays by this update.
+	if(mParkingEnabled)
 	{
-		const PxU32 newEndPointsCapacity = 2*(mBoxesSize + mCreatedSize) + NUM_SENTINELS;
-
-		PxcBPValType* newEndPointValuesX = (PxcBPValType*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBPValType)*(newEndPointsCapacity))), PX_DEBUG_EXP("BPValType"));
-		PxcBPValType* newEndPointValuesY = (PxcBPValType*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBPValType)*(newEndPointsCapacity))), PX_DEBUG_EXP("BPValType"));
-		PxcBPValType* newEndPointValuesZ = (PxcBPValType*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBPValType)*(newEndPointsCapacity))), PX_DEBUG_EXP("BPValType"));
-		PxcBpHandle* newEndPointDatasX = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*(newEndPointsCapacity))), PX_DEBUG_EXP("PxBpHandle"));
-		PxcBpHandle* newEndPointDatasY = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*(newEndPointsCapacity))), PX_DEBUG_EXP("PxBpHandle"));
-		PxcBpHandle* newEndPointDatasZ = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*(newEndPointsCapacity))), PX_DEBUG_EXP("PxBpHandle"));
-
-#if BP_UPDATE_BEFORE_SWAP
-		PX_FREE(mListNext);
-		PX_FREE(mListPrev);
-
-		mListNext = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*newEndPointsCapacity)), PX_DEBUG_EXP("NextList"));
-		mListPrev = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*newEndPointsCapacity)), PX_DEBUG_EXP("Prev"));
-
-
-		for(PxU32 a = 1; a < newEndPointsCapacity; ++a)
-		{
-			mListNext[a-1] = (PxcBpHandle)a;
-			mListPrev[a] = (PxcBpHandle)(a-1);
-		}
-		mListNext[newEndPointsCapacity-1] = (PxcBpHandle)(newEndPointsCapacity-1);
-		mListPrev[0] = 0;
-#endif
-
-		PxMemCopy(newEndPointValuesX, mEndPointValues[0], sizeof(PxcBPValType)*(mBoxesSize*2+NUM_SENTINELS));
-		PxMemCopy(newEndPointValuesY, mEndPointValues[1], sizeof(PxcBPValType)*(mBoxesSize*2+NUM_SENTINELS));
-		PxMemCopy(newEndPointValuesZ, mEndPointValues[2], sizeof(PxcBPValType)*(mBoxesSize*2+NUM_SENTINELS));
-		PxMemCopy(newEndPointDatasX, mEndPointDatas[0], sizeof(PxcBpHandle)*(mBoxesSize*2+NUM_SENTINELS));
-		PxMemCopy(newEndPointDatasY, mEndPointDatas[1], sizeof(PxcBpHandle)*(mBoxesSize*2+NUM_SENTINELS));
-		PxMemCopy(newEndPointDatasZ, mEndPointDatas[2], sizeof(PxcBpHandle)*(mBoxesSize*2+NUM_SENTINELS));
-		PX_FREE(mEndPointValues[0]);
-		PX_FREE(mEndPointValues[1]);
-		PX_FREE(mEndPointValues[2]);
-		PX_FREE(mEndPointDatas[0]);
-		PX_FREE(mEndPointDatas[1]);
-		PX_FREE(mEndPointDatas[2]);
-		mEndPointValues[0] = newEndPointValuesX;
-		mEndPointValues[1] = newEndPointValuesY;
-		mEndPointValues[2] = newEndPointValuesZ;
-		mEndPointDatas[0] = newEndPointDatasX;
-		mEndPointDatas[1] = newEndPointDatasY;
-		mEndPointDatas[2] = newEndPointDatasZ;
-		mEndPointsCapacity = newEndPointsCapacity;
-
-#if BP_UPDATE_BEFORE_SWAP
-		PX_FREE(mSortedUpdateElements);
-		PX_FREE(mActivityPockets);
-		mSortedUpdateElements = (PxcBpHandle*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxcBpHandle)*newEndPointsCapacity)), PX_DEBUG_EXP("SortedUpdateElements"));
-		mActivityPockets = (PxsBroadPhaseActivityPocket*)PX_ALLOC(ALIGN_SIZE_16((sizeof(PxsBroadPhaseActivityPocket)*newEndPointsCapacity)), PX_DEBUG_EXP("PxsBroadPhaseActivityPocket"));
-#endif
+		partitionParkedBoxes();
+	}
 
+	//Do we need more memory for the array of sorted boxes?
+	if(2*(mBoxesSize + mCreatedSize + mUnparked.size()) + NUM_SENTINELS > mEndPointsCapacity)
+	{
+		growEndPoints(2*(mBoxesSize + mCreatedSize + mUnparked.size()) + NUM_SENTINELS);
 	}
 
 #if BP_UPDATE_BEFORE_SWAP
@@ -1045,6 +1087,7 @@ bool PxsBroadPhaseContextSap::canRunOnSpu() const
 	return 
 	(
 		(mCreatedSize > 0 || mUpdatedSize > 0 || mRemovedSize > 0) &&
+		!mParkingEnabled &&
 		mBoxesCapacity<=MAX_NUM_BP_SPU_SAP_AABB && 
 		mBoxesSize<=MAX_NUM_BP_SPU_SAP_AABB && 
 		mPairs.mHashCapacity<=MAX_NUM_BP_SPU_SAP_OVERLAPS && 
@@ -1149,6 +1192,11 @@ void PxsBroadPhaseContextSap::postUpdatePPU(PxBaseTask* /*continuation*/)
 
 	batchCreate();
 
+	if(mParkingEnabled)
+	{
+		createParkedPairs();
+	}
+
 	//Compute the lists of created and deleted overlap pairs.
 
 	ComputeCreatedDeletedPairsLists(
@@ -1159,6 +1207,11 @@ void PxsBroadPhaseContextSap::postUpdatePPU(PxBaseTask* /*continuation*/)
 		mPairs);
 
 	PX_ASSERT(isSelfConsistent());
+
+	if(mParkingEnabled)
+	{
+		parkIdleBoxes();
+	}
 	mBoxesSizePrev=mBoxesSize;
 
 #ifdef PX_PROFILE
@@ -1189,6 +1242,12 @@ void PxsBroadPhaseContextSap::updatePPU(PxBaseTask* continuation)
 
 	batchRemove();
 
+	if(mParkingEnabled)
+	{
+		unparkBoxes();
+		updateParkedPairs();
+	}
+
 	//Check that the overlap pairs per axis have been reset.
 	PX_ASSERT(0==mBatchUpdateTasks[0].getPairsSize());
 	PX_ASSERT(0==mBatchUpdateTasks[1].getPairsSize());
@@ -1217,59 +1276,15 @@ void PxsBroadPhaseContextSap::batchCreate()
 	//Array of newly-created box indices.
 	const PxcBpHandle* PX_RESTRICT created = mCreated;
 
-	//Arrays of min and max coords for each box for each axis.
-	const IntegerAABB* PX_RESTRICT minMax = mBoxBoundsMinMax;
-
 	//Insert new boxes into sorted endpoints lists.
 	{
-		const PxU32 numEndPoints = numNewBoxes*2;
-
-		Cm::TmpMem<PxcBPValType, 32> nepsv(numEndPoints), bv(numEndPoints);
-		Cm::TmpMem<PxcBpHandle, 32> nepsd(numEndPoints), bd(numEndPoints);
-
-		PxcBPValType* newEPSortedValues = nepsv.getBase();
-		PxcBpHandle* newEPSortedDatas = nepsd.getBase();
-		PxcBPValType* bufferValues = bv.getBase();
-		PxcBpHandle* bufferDatas = bd.getBase();
-
-		Gu::RadixSortBuffered RS;
-
-		for(PxU32 Axis=0;Axis<3;Axis++)
+		Cm::TmpMem<IntegerAABB, 8> boundsMem(numNewBoxes);
+		IntegerAABB* bounds = boundsMem.getBase();
+		for(PxU32 i=0;i<numNewBoxes;i++)
 		{
-			for(PxU32 i=0;i<numNewBoxes;i++)
-			{
-				const PxU32 boxIndex = (PxU32)created[i];
-				PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_REMOVED_BP_HANDLE);
-				PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_REMOVED_BP_HANDLE);
-
-				const PxcBPValType minValue = minMax[boxIndex].getMin(Axis);
-				const PxcBPValType maxValue = minMax[boxIndex].getMax(Axis);
-				
-				newEPSortedValues[i*2+0]=minValue;
-				setData(newEPSortedDatas[i*2+0],boxIndex, false);
-				newEPSortedValues[i*2+1]=maxValue;
-				setData(newEPSortedDatas[i*2+1], boxIndex, true);
-			}
-
-			// Sort endpoints backwards
-			{
-				PxU32* keys = (PxU32*)bufferValues;
-				for(PxU32 i=0;i<numEndPoints;i++)
-				{
-					keys[i] = newEPSortedValues[i];
-				}
-
-				const PxU32* Sorted = RS.Sort(keys, numEndPoints, Gu::RADIX_UNSIGNED).GetRanks();
-
-				for(PxU32 i=0;i<numEndPoints;i++)
-				{
-					bufferValues[i] = newEPSortedValues[Sorted[numEndPoints-1-i]];
-					bufferDatas[i] = newEPSortedDatas[Sorted[numEndPoints-1-i]];
-				}
-			}
-
-			InsertEndPoints(bufferValues, bufferDatas, numEndPoints, mEndPointValues[Axis], mEndPointDatas[Axis], 2*(mBoxesSize-mCreatedSize)+NUM_SENTINELS, mBoxEndPts[Axis]);
+			bounds[i] = mBoxBoundsMinMax[created[i]];
 		}
+		insertEndPoints(created, bounds, numNewBoxes);
 	}
 
 	//Some debug tests.
@@ -1299,6 +1314,58 @@ void PxsBroadPhaseContextSap::batchCreate()
 	performBoxPruning(axes);
 }
 
+void PxsBroadPhaseContextSap::insertEndPoints(const PxcBpHandle* PX_RESTRICT handles, const IntegerAABB* PX_RESTRICT bounds, const PxU32 numBoxes)
+{
+	const PxU32 numEndPoints = numBoxes*2;
+
+	Cm::TmpMem<PxcBPValType, 32> nepsv(numEndPoints), bv(numEndPoints);
+	Cm::TmpMem<PxcBpHandle, 32> nepsd(numEndPoints), bd(numEndPoints);
+
+	PxcBPValType* newEPSortedValues = nepsv.getBase();
+	PxcBpHandle* newEPSortedDatas = nepsd.getBase();
+	PxcBPValType* bufferValues = bv.getBase();
+	PxcBpHandle* bufferDatas = bd.getBase();
+
+	Gu::RadixSortBuffered RS;
+
+	for(PxU32 Axis=0;Axis<3;Axis++)
+	{
+		for(PxU32 i=0;i<numBoxes;i++)
+		{
+			const PxU32 boxIndex = (PxU32)handles[i];
+			PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_REMOVED_BP_HANDLE);
+			PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_REMOVED_BP_HANDLE);
+
+			const PxcBPValType minValue = bounds[i].getMin(Axis);
+			const PxcBPValType maxValue = bounds[i].getMax(Axis);
+			
+			newEPSortedValues[i*2+0]=minValue;
+			setData(newEPSortedDatas[i*2+0],boxIndex, false);
+			newEPSortedValues[i*2+1]=maxValue;
+			setData(newEPSortedDatas[i*2+1], boxIndex, true);
+		}
+
+		// Sort endpoints backwards
+		{
+			PxU32* keys = (PxU32*)bufferValues;
+			for(PxU32 i=0;i<numEndPoints;i++)
+			{
+				keys[i] = newEPSortedValues[i];
+			}
+
+			const PxU32* Sorted = RS.Sort(keys, numEndPoints, Gu::RADIX_UNSIGNED).GetRanks();
+
+			for(PxU32 i=0;i<numEndPoints;i++)
+			{
+				bufferValues[i] = newEPSortedValues[Sorted[numEndPoints-1-i]];
+				bufferDatas[i] = newEPSortedDatas[Sorted[numEndPoints-1-i]];
+			}
+		}
+
+		InsertEndPoints(bufferValues, bufferDatas, numEndPoints, mEndPointValues[Axis], mEndPointDatas[Axis], 2*mBoxesSizePrev+NUM_SENTINELS, mBoxEndPts[Axis]);
+	}
+}
+
 void PxsBroadPhaseContextSap::performBoxPruning(const Gu::Axes axes)
 {
 	const PxU32 axis0=axes.mAxis0;
@@ -1347,7 +1414,7 @@ void PxsBroadPhaseContextSap::performBoxPruning(const Gu::Axes axes)
 		performBoxPruningNewNew
 			(axes,
 			 newBoxesIndicesSorted,newBoxCount,allNewBoxesStatics,
-			 minPosListNew,mBoxEndPts,mBoxGroups,
+			 minPosListNew,mBoxEndPts,mBoxGroups,mUseAVX2,
 			 mPairs,mData,mDataSize,mDataCapacity);
 
 		// the old boxes are not the first ones in the array
@@ -1359,40 +1426,32 @@ void PxsBroadPhaseContextSap::performBoxPruning(const Gu::Axes axes)
 				(axes,
 				 newBoxesIndicesSorted,newBoxCount,oldBoxesIndicesSorted,oldBoxCount,
 				 minPosListNew,minPosListOld,
-				 mBoxEndPts,mBoxGroups,
+				 mBoxEndPts,mBoxGroups,mUseAVX2,
 				 mPairs,mData,mDataSize,mDataCapacity);
 		}
 	}
 }
 
-void PxsBroadPhaseContextSap::batchRemove()
+void PxsBroadPhaseContextSap::removeEndPoints(const PxcBpHandle* PX_RESTRICT handles, const PxU32 numBoxes)
 {
-	if(!mRemovedSize)	return;	// Early-exit if no object has been removed
-
-	//The box count is incremented when boxes are added to the create list but these boxes
-	//haven't yet been added to the pair manager or the sorted axis lists.  We need to 
-	//pretend that the box count is the value it was when the bp was last updated.
-	//Then, at the end, we need to set the box count to the number that includes the boxes
-	//in the create list and subtract off the boxes that have been removed.
-	PxU32 currBoxesSize=mBoxesSize;
-	mBoxesSize=mBoxesSizePrev;
+	PX_ASSERT(numBoxes>0);
 
 	for(PxU32 Axis=0;Axis<3;Axis++)
 	{
 		PxcBPValType* const BaseEPValue = mEndPointValues[Axis];
 		PxcBpHandle* const BaseEPData = mEndPointDatas[Axis];
 		PxU32 MinMinIndex = PX_MAX_U32;
-		for(PxU32 i=0;i<mRemovedSize;i++)
+		for(PxU32 i=0;i<numBoxes;i++)
 		{
-			PX_ASSERT(mRemoved[i]<mBoxesCapacity);
+			PX_ASSERT(handles[i]<mBoxesCapacity);
 
-			const PxU32 MinIndex = mBoxEndPts[Axis][mRemoved[i]].mMinMax[0];
+			const PxU32 MinIndex = mBoxEndPts[Axis][handles[i]].mMinMax[0];
 			PX_ASSERT(MinIndex<mBoxesCapacity*2+2);
-			PX_ASSERT(getOwner(BaseEPData[MinIndex])==mRemoved[i]);
+			PX_ASSERT(getOwner(BaseEPData[MinIndex])==handles[i]);
 
-			const PxU32 MaxIndex = mBoxEndPts[Axis][mRemoved[i]].mMinMax[1];
+			const PxU32 MaxIndex = mBoxEndPts[Axis][handles[i]].mMinMax[1];
 			PX_ASSERT(MaxIndex<mBoxesCapacity*2+2);
-			PX_ASSERT(getOwner(BaseEPData[MaxIndex])==mRemoved[i]);
+			PX_ASSERT(getOwner(BaseEPData[MaxIndex])==handles[i]);
 
 			PX_ASSERT(MinIndex<MaxIndex);
 
@@ -1435,9 +1494,9 @@ void PxsBroadPhaseContextSap::batchRemove()
 		}
 	}
 
-	for(PxU32 i=0;i<mRemovedSize;i++)
+	for(PxU32 i=0;i<numBoxes;i++)
 	{
-		const PxU32 handle=mRemoved[i];
+		const PxU32 handle=handles[i];
 		mBoxEndPts[0][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
 		mBoxEndPts[0][handle].mMinMax[1]=PX_REMOVED_BP_HANDLE;
 		mBoxEndPts[1][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
@@ -1445,6 +1504,21 @@ void PxsBroadPhaseContextSap::batchRemove()
 		mBoxEndPts[2][handle].mMinMax[0]=PX_REMOVED_BP_HANDLE;
 		mBoxEndPts[2][handle].mMinMax[1]=PX_REMOVED_BP_HANDLE;
 	}
+}
+
+void PxsBroadPhaseContextSap::batchRemove()
+{
+	if(!mRemovedSize)	return;	// Early-exit if no object has been removed
+
+	//The box count is incremented when boxes are added to the create list but these boxes
+	//haven't yet been added to the pair manager or the sorted axis lists.  We need to 
+	//pretend that the box count is the value it was when the bp was last updated.
+	//Then, at the end, we need to set the box count to the number that includes the boxes
+	//in the create list and subtract off the boxes that have been removed.
+	PxU32 currBoxesSize=mBoxesSize;
+	mBoxesSize=mBoxesSizePrev;
+
+	removeEndPoints(mRemoved, mRemovedSize);
 
 	const PxU32 bitmapWordCount=1+(mBoxesCapacity>>5);
 	Cm::TmpMem<PxU32, 128> bitmapWords(bitmapWordCount);
@@ -1465,6 +1539,465 @@ void PxsBroadPhaseContextSap::batchRemove()
 	mBoxesSizePrev=mBoxesSize-mCreatedSize;
 }
 
+PX_FORCE_INLINE static bool intersectsYZ(const IntegerAABB& a, const IntegerAABB& b)
+{
+	return (a.getMinY() <= b.getMaxY() && b.getMinY() <= a.getMaxY() &&
+			a.getMinZ() <= b.getMaxZ() && b.getMinZ() <= a.getMaxZ());
+}
+
+//The parked tree is an implicit binary tree over the parked arrays (node 1 is the root, the children of node n are 2n and 2n+1).
+//Each leaf is a bucket of BP_SAP_PARKED_BUCKET_SIZE consecutive parked boxes, the leaves are padded to a power of two.
+//Each node stores the largest max x of the parked bounds below it.
+//Only the nodes above the parked indices that changed since the last query are recomputed.
+void PxsBroadPhaseContextSap::updateParkedTree()
+{
+	if(PX_INVALID_U32==mParkedTreeDirtyIndex)	return;
+
+	const IntegerAABB* PX_RESTRICT parkedBounds = mParkedBounds.begin();
+	const PxU32 numParked = mParkedHandles.size();
+	const PxU32 numBuckets = (numParked + BP_SAP_PARKED_BUCKET_SIZE - 1)/BP_SAP_PARKED_BUCKET_SIZE;
+
+	PxU32 numLeaves = 1;
+	while(numLeaves<numBuckets)
+	{
+		numLeaves<<=1;
+	}
+
+	PxU32 firstBucket = mParkedTreeDirtyIndex/BP_SAP_PARKED_BUCKET_SIZE;
+	if(numLeaves!=mParkedTreeLeaves)
+	{
+		mParkedTree.resizeUninitialized(2*numLeaves);
+		mParkedTreeLeaves = numLeaves;
+		firstBucket = 0;
+	}
+	mParkedTreeDirtyIndex = PX_INVALID_U32;
+
+	PxcBPValType* PX_RESTRICT tree = mParkedTree.begin();
+	for(PxU32 i=firstBucket;i<numLeaves;i++)
+	{
+		PxcBPValType maxX = 0;
+		const PxU32 endIndex = PxMin((i+1)*BP_SAP_PARKED_BUCKET_SIZE, numParked);
+		for(PxU32 j=i*BP_SAP_PARKED_BUCKET_SIZE;j<endIndex;j++)
+		{
+			maxX = PxMax(maxX, parkedBounds[j].getMaxX());
+		}
+		tree[numLeaves+i] = maxX;
+	}
+	for(PxU32 firstNode=(numLeaves+firstBucket)>>1, lastNode=numLeaves-1; firstNode; firstNode>>=1, lastNode>>=1)
+	{
+		for(PxU32 node=firstNode;node<=lastNode;node++)
+		{
+			tree[node] = PxMax(tree[2*node], tree[2*node+1]);
+		}
+	}
+}
+
+//Bipartite box pruning of boxes against the parked boxes.
+//The boxes are sorted by min x. The parked boxes that start along x before a box ends are found with an exponential search in the 
+//parked arrays (sorted by min x) from where the previous box stopped, then the parked tree skips the buckets of these that end before 
+//the box starts. The cost per box is logarithmic in the number of parked boxes plus the number of parked boxes that overlap the box along x.
+//Each overlap is written to the overlaps array as the index of the box followed by the index of the parked box.
+void PxsBroadPhaseContextSap::findParkedOverlaps(const IntegerAABB* PX_RESTRICT boxes, const PxU32 numBoxes, Ps::Array<PxU32>& overlaps)
+{
+	updateParkedTree();
+
+	const IntegerAABB* PX_RESTRICT parkedBounds = mParkedBounds.begin();
+	const PxU32 numParked = mParkedHandles.size();
+	const PxcBPValType* PX_RESTRICT tree = mParkedTree.begin();
+	const PxU32 numLeaves = mParkedTreeLeaves;
+
+	Cm::TmpMem<PxU32, 32> keysMem(numBoxes);
+	PxU32* keys = keysMem.getBase();
+	for(PxU32 i=0;i<numBoxes;i++)
+	{
+		keys[i] = boxes[i].getMaxX();
+	}
+	Gu::RadixSortBuffered RS;
+	const PxU32* PX_RESTRICT sorted = RS.Sort(keys, numBoxes, Gu::RADIX_UNSIGNED).GetRanks();
+
+	PxU32 endIndex = 0;
+	for(PxU32 i=0;i<numBoxes;i++)
+	{
+		const PxU32 boxIndex = sorted[i];
+		const IntegerAABB& box = boxes[boxIndex];
+		const PxcBPValType minX = box.getMinX();
+		const PxcBPValType maxX = box.getMaxX();
+
+		//The parked boxes [0, endIndex) start along x before the box ends.
+		//The boxes are sorted by max x so endIndex only grows: bracket it with doubling steps, then binary search the bracket.
+		PxU32 step = 1;
+		while(endIndex+step<=numParked && parkedBounds[endIndex+step-1].getMinX()<=maxX)
+		{
+			endIndex += step;
+			step <<= 1;
+		}
+		PxU32 count = PxMin(step, numParked-endIndex);
+		while(count)
+		{
+			const PxU32 half = count>>1;
+			if(parkedBounds[endIndex+half].getMinX()<=maxX)
+			{
+				endIndex += half+1;
+				count -= half+1;
+			}
+			else
+			{
+				count = half;
+			}
+		}
+		if(!endIndex)
+		{
+			continue;
+		}
+
+		//Depth first walk of the subtrees that start before endIndex and hold a parked box that ends along x after the box starts.
+		//Each stack entry is a node and the number of leaves below it; the stack holds at most two nodes per level.
+		PxU32 stack[2*64];
+		PxU32 stackSize = 0;
+		stack[stackSize++] = 1;
+		stack[stackSize++] = numLeaves;
+		while(stackSize)
+		{
+			const PxU32 size = stack[--stackSize];
+			const PxU32 node = stack[--stackSize];
+			const PxU32 firstIndex = (node*size - numLeaves)*BP_SAP_PARKED_BUCKET_SIZE;
+			if(firstIndex>=endIndex || tree[node]<minX)
+			{
+				continue;
+			}
+
+			if(1==size)
+			{
+				const PxU32 lastIndex = PxMin(firstIndex + BP_SAP_PARKED_BUCKET_SIZE, endIndex);
+				for(PxU32 j=firstIndex;j<lastIndex;j++)
+				{
+					if(parkedBounds[j].getMaxX()>=minX && intersectsYZ(box, parkedBounds[j]))
+					{
+						overlaps.pushBack(boxIndex);
+						overlaps.pushBack(j);
+					}
+				}
+			}
+			else
+			{
+				stack[stackSize++] = 2*node+1;
+				stack[stackSize++] = size>>1;
+				stack[stackSize++] = 2*node;
+				stack[stackSize++] = size>>1;
+			}
+		}
+	}
+}
+
+void PxsBroadPhaseContextSap::partitionParkedBoxes()
+{
+	if(mBoxParkedIndex.size()<mBoxesCapacity)
+	{
+		mBoxParkedIndex.resize(mBoxesCapacity, PX_INVALID_U32);
+		mBoxLastActive.resize(mBoxesCapacity, 0);
+	}
+
+	mUnparked.clear();
+	for(PxU32 i=0;i<mUpdatedSize;i++)
+	{
+		if(isParked(mUpdated[i]))
+		{
+			mUnparked.pushBack(mUpdated[i]);
+		}
+	}
+
+	//Parked boxes have no end points for batchRemove to remove.
+	mRemovedParked.clear();
+	mRemovedSorted.clear();
+	for(PxU32 i=0;i<mRemovedSize;i++)
+	{
+		if(isParked(mRemoved[i]))
+		{
+			mRemovedParked.pushBack(mRemoved[i]);
+		}
+		else
+		{
+			mRemovedSorted.pushBack(mRemoved[i]);
+		}
+	}
+	if(mRemovedParked.size())
+	{
+		mRemoved = mRemovedSorted.begin();
+		mRemovedSize = mRemovedSorted.size();
+	}
+}
+
+void PxsBroadPhaseContextSap::removeParkedBoxes(const PxcBpHandle* PX_RESTRICT handles, const PxU32 numHandles, IntegerAABB* PX_RESTRICT bounds)
+{
+	IntegerAABB* PX_RESTRICT parkedBounds = mParkedBounds.begin();
+	PxcBpHandle* PX_RESTRICT parkedHandles = mParkedHandles.begin();
+	const PxU32 numParked = mParkedHandles.size();
+
+	PxU32 firstIndex = numParked;
+	for(PxU32 i=0;i<numHandles;i++)
+	{
+		const PxU32 index = mBoxParkedIndex[handles[i]];
+		PX_ASSERT(index<numParked && parkedHandles[index]==handles[i]);
+		if(bounds)
+		{
+			bounds[i] = parkedBounds[index];
+		}
+		parkedHandles[index] = PX_INVALID_BP_HANDLE;
+		mBoxParkedIndex[handles[i]] = PX_INVALID_U32;
+		firstIndex = PxMin(firstIndex, index);
+	}
+
+	PxU32 writeIndex = firstIndex;
+	for(PxU32 readIndex=firstIndex;readIndex<numParked;readIndex++)
+	{
+		const PxcBpHandle handle = parkedHandles[readIndex];
+		if(handle!=PX_INVALID_BP_HANDLE)
+		{
+			parkedBounds[writeIndex] = parkedBounds[readIndex];
+			parkedHandles[writeIndex] = handle;
+			mBoxParkedIndex[handle] = writeIndex;
+			writeIndex++;
+		}
+	}
+	mParkedBounds.forceSize_Unsafe(writeIndex);
+	mParkedHandles.forceSize_Unsafe(writeIndex);
+	mParkedTreeDirtyIndex = PxMin(mParkedTreeDirtyIndex, firstIndex);
+}
+
+void PxsBroadPhaseContextSap::unparkBoxes()
+{
+	//Removed parked boxes: only their pairs are left.
+	if(mRemovedParked.size())
+	{
+		removeParkedBoxes(mRemovedParked.begin(), mRemovedParked.size(), NULL);
+
+		const PxU32 bitmapWordCount=1+(mBoxesCapacity>>5);
+		Cm::TmpMem<PxU32, 128> bitmapWords(bitmapWordCount);
+		PxMemZero(bitmapWords.getBase(),sizeof(PxU32)*bitmapWordCount);
+		Cm::BitMap bitmap;
+		bitmap.setWords(bitmapWords.getBase(),bitmapWordCount);
+		for(PxU32 i=0;i<mRemovedParked.size();i++)
+		{
+			bitmap.set(mRemovedParked[i]);
+		}
+		mPairs.RemovePairs(bitmap);
+	}
+
+	//Updated parked boxes go back to the sorted arrays with their parked bounds, batchUpdate then moves them to their new bounds.
+	const PxU32 numUnparked = mUnparked.size();
+	if(numUnparked)
+	{
+		Cm::TmpMem<IntegerAABB, 8> boundsMem(numUnparked);
+		removeParkedBoxes(mUnparked.begin(), numUnparked, boundsMem.getBase());
+		insertEndPoints(mUnparked.begin(), boundsMem.getBase(), numUnparked);
+		mBoxesSizePrev += numUnparked;
+		mBoxesSize += numUnparked;
+	}
+}
+
+void PxsBroadPhaseContextSap::unparkAllBoxes()
+{
+	PX_ASSERT(mBoxesSize==mBoxesSizePrev);
+
+	const PxU32 numParked = mParkedHandles.size();
+	if(2*(mBoxesSize + numParked) + NUM_SENTINELS > mEndPointsCapacity)
+	{
+		growEndPoints(2*(mBoxesSize + numParked) + NUM_SENTINELS);
+	}
+
+	//Count the boxes as active in the last update so that parkIdleBoxes parks them again if they are not updated.
+	PX_ASSERT(mUpdateCount>0);
+	const PxU32 lastUpdate = mUpdateCount-1;
+	Ps::Array<PxcBpHandle>& activeBoxes = mActiveBoxes[lastUpdate % BP_SAP_PARKING_DELAY];
+	for(PxU32 i=0;i<numParked;i++)
+	{
+		const PxcBpHandle handle = mParkedHandles[i];
+		mBoxParkedIndex[handle] = PX_INVALID_U32;
+		mBoxLastActive[handle] = lastUpdate;
+		activeBoxes.pushBack(handle);
+	}
+	insertEndPoints(mParkedHandles.begin(), mParkedBounds.begin(), numParked);
+	mBoxesSizePrev += numParked;
+	mBoxesSize += numParked;
+
+	mParkedBounds.clear();
+	mParkedHandles.clear();
+	mParkedTreeDirtyIndex = 0;
+}
+
+void PxsBroadPhaseContextSap::updateParkedPairs()
+{
+	const PxU32 numParked = mParkedHandles.size();
+	if(!numParked || !mUpdatedSize)	return;
+
+	const IntegerAABB* PX_RESTRICT parkedBounds = mParkedBounds.begin();
+	const PxcBpHandle* PX_RESTRICT parkedHandles = mParkedHandles.begin();
+
+	//The end points of the updated boxes still hold the bounds of the previous update.
+	//Test the parked boxes against the union of the previous and new bounds, then compare the previous and new overlaps.
+	Cm::TmpMem<IntegerAABB, 8> prevBoundsMem(mUpdatedSize), sweptBoundsMem(mUpdatedSize);
+	IntegerAABB* prevBounds = prevBoundsMem.getBase();
+	IntegerAABB* sweptBounds = sweptBoundsMem.getBase();
+	for(PxU32 i=0;i<mUpdatedSize;i++)
+	{
+		const PxcBpHandle handle = mUpdated[i];
+		for(PxU32 Axis=0;Axis<3;Axis++)
+		{
+			prevBounds[i].mMinMax[IntegerAABB::MIN_X+Axis] = mEndPointValues[Axis][mBoxEndPts[Axis][handle].mMinMax[0]];
+			prevBounds[i].mMinMax[IntegerAABB::MAX_X+Axis] = mEndPointValues[Axis][mBoxEndPts[Axis][handle].mMinMax[1]];
+		}
+		sweptBounds[i] = prevBounds[i];
+		sweptBounds[i].include(mBoxBoundsMinMax[handle]);
+	}
+
+	Ps::Array<PxU32> overlaps;
+	findParkedOverlaps(sweptBounds, mUpdatedSize, overlaps);
+
+	for(PxU32 i=0;i<overlaps.size();i+=2)
+	{
+		const PxU32 boxIndex = overlaps[i];
+		const PxU32 parkedIndex = overlaps[i+1];
+		const PxcBpHandle handle = mUpdated[boxIndex];
+		const PxcBpHandle parkedHandle = parkedHandles[parkedIndex];
+		if(mBoxGroups[handle]==mBoxGroups[parkedHandle])
+		{
+			continue;
+		}
+
+		const bool prevOverlap = prevBounds[boxIndex].intersects(parkedBounds[parkedIndex]);
+		const bool overlap = mBoxBoundsMinMax[handle].intersects(parkedBounds[parkedIndex]);
+		if(overlap && !prevOverlap)
+		{
+			AddPair(handle, parkedHandle, mPairs, mData, mDataSize, mDataCapacity);
+		}
+		else if(prevOverlap && !overlap)
+		{
+			RemovePair(handle, parkedHandle, mPairs, mData, mDataSize, mDataCapacity);
+		}
+	}
+}
+
+void PxsBroadPhaseContextSap::createParkedPairs()
+{
+	const PxU32 numParked = mParkedHandles.size();
+	if(!numParked || !mCreatedSize)	return;
+
+	Cm::TmpMem<IntegerAABB, 8> boundsMem(mCreatedSize);
+	IntegerAABB* bounds = boundsMem.getBase();
+	for(PxU32 i=0;i<mCreatedSize;i++)
+	{
+		bounds[i] = mBoxBoundsMinMax[mCreated[i]];
+	}
+
+	Ps::Array<PxU32> overlaps;
+	findParkedOverlaps(bounds, mCreatedSize, overlaps);
+
+	for(PxU32 i=0;i<overlaps.size();i+=2)
+	{
+		const PxcBpHandle handle = mCreated[overlaps[i]];
+		const PxcBpHandle parkedHandle = mParkedHandles[overlaps[i+1]];
+		if(mBoxGroups[handle]!=mBoxGroups[parkedHandle])
+		{
+			AddPair(handle, parkedHandle, mPairs, mData, mDataSize, mDataCapacity);
+		}
+	}
+}
+
+void PxsBroadPhaseContextSap::parkIdleBoxes()
+{
+	const PxU32 updateCount = mUpdateCount++;
+	for(PxU32 i=0;i<mCreatedSize;i++)
+	{
+		mBoxLastActive[mCreated[i]] = updateCount;
+	}
+	for(PxU32 i=0;i<mUpdatedSize;i++)
+	{
+		mBoxLastActive[mUpdated[i]] = updateCount;
+	}
+
+	//The boxes created or updated BP_SAP_PARKING_DELAY updates ago are idle if they have not been active since.
+	//Skip the boxes that have been removed or parked already (a box can be listed twice).
+	Ps::Array<PxcBpHandle>& activeBoxes = mActiveBoxes[updateCount % BP_SAP_PARKING_DELAY];
+	PxU32 numIdle = 0;
+	for(PxU32 i=0;i<activeBoxes.size();i++)
+	{
+		const PxcBpHandle handle = activeBoxes[i];
+		if(	mBoxLastActive[handle]==updateCount-BP_SAP_PARKING_DELAY && !isParked(handle) &&
+			mBoxEndPts[0][handle].mMinMax[0]!=PX_INVALID_BP_HANDLE && mBoxEndPts[0][handle].mMinMax[0]!=PX_REMOVED_BP_HANDLE)
+		{
+			mBoxParkedIndex[handle] = 0;
+			activeBoxes[numIdle++] = handle;
+		}
+	}
+
+	if(numIdle)
+	{
+		const PxcBpHandle* PX_RESTRICT idleBoxes = activeBoxes.begin();
+
+		//Park the current end point values: the pairs of the boxes have been computed with these, not with mBoxBoundsMinMax.
+		Cm::TmpMem<IntegerAABB, 8> boundsMem(numIdle);
+		IntegerAABB* bounds = boundsMem.getBase();
+		Cm::TmpMem<PxU32, 32> keysMem(numIdle);
+		PxU32* keys = keysMem.getBase();
+		for(PxU32 i=0;i<numIdle;i++)
+		{
+			const PxcBpHandle handle = idleBoxes[i];
+			for(PxU32 Axis=0;Axis<3;Axis++)
+			{
+				bounds[i].mMinMax[IntegerAABB::MIN_X+Axis] = mEndPointValues[Axis][mBoxEndPts[Axis][handle].mMinMax[0]];
+				bounds[i].mMinMax[IntegerAABB::MAX_X+Axis] = mEndPointValues[Axis][mBoxEndPts[Axis][handle].mMinMax[1]];
+			}
+			keys[i] = bounds[i].getMinX();
+		}
+
+		removeEndPoints(idleBoxes, numIdle);
+		mBoxesSize -= numIdle;
+
+		//Merge the new parked boxes with the parked boxes, from the end.
+		Gu::RadixSortBuffered RS;
+		const PxU32* PX_RESTRICT sorted = RS.Sort(keys, numIdle, Gu::RADIX_UNSIGNED).GetRanks();
+
+		const PxU32 numParked = mParkedHandles.size();
+		mParkedBounds.resizeUninitialized(numParked + numIdle);
+		mParkedHandles.resizeUninitialized(numParked + numIdle);
+		IntegerAABB* PX_RESTRICT parkedBounds = mParkedBounds.begin();
+		PxcBpHandle* PX_RESTRICT parkedHandles = mParkedHandles.begin();
+
+		PxU32 readIndex = numParked;
+		PxU32 newIndex = numIdle;
+		PxU32 writeIndex = numParked + numIdle;
+		while(newIndex)
+		{
+			writeIndex--;
+			const PxU32 newBox = sorted[newIndex-1];
+			if(readIndex && parkedBounds[readIndex-1].getMinX() > bounds[newBox].getMinX())
+			{
+				readIndex--;
+				parkedBounds[writeIndex] = parkedBounds[readIndex];
+				parkedHandles[writeIndex] = parkedHandles[readIndex];
+			}
+			else
+			{
+				newIndex--;
+				parkedBounds[writeIndex] = bounds[newBox];
+				parkedHandles[writeIndex] = idleBoxes[newBox];
+			}
+			mBoxParkedIndex[parkedHandles[writeIndex]] = writeIndex;
+		}
+		mParkedTreeDirtyIndex = PxMin(mParkedTreeDirtyIndex, writeIndex);
+	}
+
+	activeBoxes.clear();
+	for(PxU32 i=0;i<mCreatedSize;i++)
+	{
+		activeBoxes.pushBack(mCreated[i]);
+	}
+	for(PxU32 i=0;i<mUpdatedSize;i++)
+	{
+		activeBoxes.pushBack(mUpdated[i]);
+	}
+}
+
 PX_FORCE_INLINE bool intersect2D(	const SapBox1D*const* PX_RESTRICT c,
 									const SapBox1D*const* PX_RESTRICT boxEndPts,
 									PxU32 ownerId,
@@ -15,6 +15,11 @@
 #include "PxsBroadPhaseCommon.h"
 #include "PxsBroadPhaseConfig.h"
 #include "GuRevisitedRadixBuffered.h"
+#include "PsBitUtils.h"
+#include "PsCpu.h"
+#if PX_BP_AVX2
+	#include <immintrin.h>
+#endif
 
 using namespace physx;
 
@@ -704,11 +709,79 @@ void physx::ComputeSortedLists
 	PX_ASSERT(oldBoxIndicesCount<=((numSortedEndPoints-NUM_SENTINELS)/2));
 }
 
+#if PX_BP_AVX2 && !PX_USE_16_BIT_HANDLES && !defined(__SPU__)
+	#define SAP_AVX2 1
+
+// Tests box0 against the 8 consecutive boxes boxIds[0..7], sorted along the primary axis with their min positions in
+// minPosList[0..7]. Returns in bits 0-7 the boxes that start before 'limit' on the primary axis, overlap box0 on the
+// other two axes and are in a different group, and in bits 8-15 the boxes that start after 'limit'. Since the boxes are
+// sorted, the latter are always the last ones and end the sweep.
+static PX_BP_AVX2_TARGET PxU32 overlap8_AVX2
+(const SapBox1D& box0_1, const SapBox1D& box0_2, const PxcBpHandle group0, const PxcBpHandle limit,
+ const PxcBpHandle* PX_RESTRICT boxIds, const PxcBpHandle* PX_RESTRICT minPosList,
+ const SapBox1D* PX_RESTRICT boxes1, const SapBox1D* PX_RESTRICT boxes2, const PxcBpHandle* PX_RESTRICT groups)
+{
+	PX_COMPILE_TIME_ASSERT(sizeof(SapBox1D)==2*sizeof(int));
+
+	// endpoint indices are below 2^30 (see PX_INVALID_BP_HANDLE) so signed comparisons are safe
+	const __m256i ids = _mm256_loadu_si256((const __m256i*)boxIds);
+	const __m256i minMaxIds = _mm256_slli_epi32(ids, 1);
+	const __m256i min1 = _mm256_i32gather_epi32((const int*)&boxes1->mMinMax[0], minMaxIds, 4);
+	const __m256i max1 = _mm256_i32gather_epi32((const int*)&boxes1->mMinMax[1], minMaxIds, 4);
+	const __m256i min2 = _mm256_i32gather_epi32((const int*)&boxes2->mMinMax[0], minMaxIds, 4);
+	const __m256i max2 = _mm256_i32gather_epi32((const int*)&boxes2->mMinMax[1], minMaxIds, 4);
+
+	const __m256i outside = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)minPosList), _mm256_set1_epi32(int(limit)));
+	__m256i separated = _mm256_or_si256(outside, _mm256_cmpgt_epi32(min1, _mm256_set1_epi32(int(box0_1.mMinMax[1]))));
+	separated = _mm256_or_si256(separated, _mm256_cmpgt_epi32(_mm256_set1_epi32(int(box0_1.mMinMax[0])), max1));
+	separated = _mm256_or_si256(separated, _mm256_cmpgt_epi32(min2, _mm256_set1_epi32(int(box0_2.mMinMax[1]))));
+	separated = _mm256_or_si256(separated, _mm256_cmpgt_epi32(_mm256_set1_epi32(int(box0_2.mMinMax[0])), max2));
+#if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
+	separated = _mm256_or_si256(separated, _mm256_cmpeq_epi32(_mm256_i32gather_epi32((const int*)groups, ids, 4), _mm256_set1_epi32(int(group0))));
+#else
+	PX_UNUSED(groups);
+	PX_UNUSED(group0);
+#endif
+
+	const PxU32 overlapMask = ~PxU32(_mm256_movemask_ps(_mm256_castsi256_ps(separated))) & 0xff;
+	const PxU32 outsideMask = PxU32(_mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+	return overlapMask | (outsideMask<<8);
+}
+
+// Runs the sweep loop of box0 8 boxes at a time while at least 8 boxes are left, and returns the index from which the
+// scalar loop has to continue. Pairs are added in the same order as with the scalar loop.
+static PxU32 sweepAVX2
+(const PxcBpHandle boxId0, const PxcBpHandle limit,
+ const PxcBpHandle* PX_RESTRICT boxIndicesSorted, const PxcBpHandle* PX_RESTRICT minPosList, PxU32 index1, const PxU32 nbBoxes,
+ const Gu::Axes& axes, SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds,
+ SapPairManager& pairManager, PxcBpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity)
+{
+	const SapBox1D* PX_RESTRICT boxes1 = asapBoxes[axes.mAxis1];
+	const SapBox1D* PX_RESTRICT boxes2 = asapBoxes[axes.mAxis2];
+	while(index1+8<=nbBoxes)
+	{
+		const PxU32 mask8 = overlap8_AVX2(boxes1[boxId0], boxes2[boxId0], asapBoxGroupIds[boxId0], limit,
+			boxIndicesSorted+index1, minPosList+index1, boxes1, boxes2, asapBoxGroupIds);
+		for(PxU32 bits=mask8&0xff; bits; bits&=bits-1)
+		{
+			const PxcBpHandle boxId1 = boxIndicesSorted[index1 + Ps::lowestSetBit(bits)];
+			AddPair(boxId0,boxId1,pairManager,dataArray,dataArraySize,dataArrayCapacity);
+		}
+		if(mask8>>8)
+			return index1 + Ps::lowestSetBit(mask8>>8);
+		index1 += 8;
+	}
+	return index1;
+}
+#else
+	#define SAP_AVX2 0
+#endif
+
 void physx::performBoxPruningNewNew
 (const Gu::Axes& axes,
  const PxcBpHandle* PX_RESTRICT newBoxIndicesSorted, const PxU32 newBoxIndicesCount, const bool allNewBoxesStatics,
  PxcBpHandle* PX_RESTRICT minPosList0,
- SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds, 
+ SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds, const bool useAVX2,
 #ifndef __SPU__
  SapPairManager& pairManager, PxcBpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity)
 #else
@@ -732,6 +805,10 @@ void physx::performBoxPruningNewNew
 
 	if(allNewBoxesStatics) return;
 
+#if !SAP_AVX2
+	PX_UNUSED(useAVX2);
+#endif
+
 	// 2) Prune the list
 
 	const PxU32 LastSortedIndex = newBoxIndicesCount;
@@ -749,6 +826,10 @@ void physx::performBoxPruningNewNew
 		if(RunningIndex<LastSortedIndex)
 		{
 			PxU32 RunningIndex2 = RunningIndex;
+#if SAP_AVX2
+			if(useAVX2)
+				RunningIndex2 = sweepAVX2(boxId0, Limit, newBoxIndicesSorted, minPosList0, RunningIndex2, LastSortedIndex, axes, asapBoxes, asapBoxGroupIds, pairManager, dataArray, dataArraySize, dataArrayCapacity);
+#endif
 
 			PxU32 Index1;
 			while(RunningIndex2<LastSortedIndex && minPosList0[Index1 = RunningIndex2++] <= Limit)
@@ -783,7 +864,7 @@ void physx::performBoxPruningNewOld
 (const Gu::Axes& axes,
  const PxcBpHandle* PX_RESTRICT newBoxIndicesSorted, const PxU32 newBoxIndicesCount, const PxcBpHandle* PX_RESTRICT oldBoxIndicesSorted, const PxU32 oldBoxIndicesCount,
  PxcBpHandle* PX_RESTRICT minPosListNew,  PxcBpHandle* PX_RESTRICT minPosListOld,
- SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds,
+ SapBox1D** PX_RESTRICT asapBoxes, const PxcBpHandle* PX_RESTRICT asapBoxGroupIds, const bool useAVX2,
 #ifndef __SPU__
  SapPairManager& pairManager, PxcBpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity)
 #else
@@ -814,6 +895,10 @@ void physx::performBoxPruningNewOld
 		minPosList1[i] = asapBoxes[Axis0][boxId].mMinMax[0];
 	}
 
+#if !SAP_AVX2
+	PX_UNUSED(useAVX2);
+#endif
+
 	// 3) Prune the lists
 	const PxU32 LastSortedIndex0 = newBoxIndicesCount;
 	const PxU32 LastSortedIndex1 = oldBoxIndicesCount;
@@ -833,6 +918,10 @@ void physx::performBoxPruningNewOld
 			RunningIndex1++;
 
 		PxU32 RunningIndex2_1 = RunningIndex1;
+#if SAP_AVX2
+		if(useAVX2)
+			RunningIndex2_1 = sweepAVX2(boxId0, Limit, oldBoxIndicesSorted, minPosList1, RunningIndex2_1, LastSortedIndex1, axes, asapBoxes, asapBoxGroupIds, pairManager, dataArray, dataArraySize, dataArrayCapacity);
+#endif
 
 		PxU32 Index1;
 		while(RunningIndex2_1<LastSortedIndex1 && minPosList1[Index1 = RunningIndex2_1++] <= Limit)
@@ -873,6 +962,10 @@ void physx::performBoxPruningNewOld
 			RunningIndex0++;
 
 		PxU32 RunningIndex2_0 = RunningIndex0;
+#if SAP_AVX2
+		if(useAVX2)
+			RunningIndex2_0 = sweepAVX2(boxId0, Limit, newBoxIndicesSorted, minPosList0, RunningIndex2_0, LastSortedIndex0, axes, asapBoxes, asapBoxGroupIds, pairManager, dataArray, dataArraySize, dataArrayCapacity);
+#endif
 
 		PxU32 Index1;
 		while(RunningIndex2_0<LastSortedIndex0 && minPosList0[Index1 = RunningIndex2_0++] <= Limit)
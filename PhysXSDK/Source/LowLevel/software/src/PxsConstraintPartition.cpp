@@ -1060,6 +1060,76 @@ void constructBatchHeaders(PxcSolverConstraintDesc* eaOrderedConstraintDescripto
 	}
 }
 
+void constructSolverChunks(const PxsConstraintBatchHeader* PX_RESTRICT headers, const PxU32* PX_RESTRICT headersPerPartition, const PxU32 numPartitions,
+						   const PxcSolverConstraintDesc* PX_RESTRICT constraintDescriptors, const PxcSolverBody* PX_RESTRICT atoms, const PxU32 numAtoms, const PxU32 chunkSize,
+						   Ps::Array<PxU32>& chunkStarts, Ps::Array<PxU32>& dependencyStarts, Ps::Array<PxU32>& dependencies, Ps::Array<PxU32>& scratch)
+{
+	PX_ASSERT(chunkSize > 0);
+
+	//Split every partition into chunks of equal size
+	chunkStarts.forceSize_Unsafe(0);
+	PxU32 numHeaders = 0;
+	for(PxU32 a = 0; a < numPartitions; ++a)
+	{
+		const PxU32 numHeadersInPartition = headersPerPartition[a];
+		const PxU32 numChunksInPartition = (numHeadersInPartition + chunkSize - 1)/chunkSize;
+		for(PxU32 b = 0; b < numChunksInPartition; ++b)
+			chunkStarts.pushBack(numHeaders + (b * numHeadersInPartition)/numChunksInPartition);
+		numHeaders += numHeadersInPartition;
+	}
+	const PxU32 numChunks = chunkStarts.size();
+	chunkStarts.pushBack(numHeaders);
+
+	//lastChunk is the last chunk that touched each body, lastDependent the last chunk that recorded a dependency on each chunk
+	scratch.reserve(numAtoms + numChunks);
+	scratch.forceSize_Unsafe(numAtoms + numChunks);
+	PxU32* lastChunk = scratch.begin();
+	PxU32* lastDependent = scratch.begin() + numAtoms;
+	for(PxU32 a = 0; a < numChunks; ++a)
+		lastDependent[a] = 0xffffffff;
+
+	//The first sweep only records the last chunk of every body, the second sweep then also sees the dependencies on the previous solver pass.
+	//Kinematic and static bodies are not written by the solver and are skipped like in the partitioning.
+	dependencyStarts.forceSize_Unsafe(0);
+	dependencies.forceSize_Unsafe(0);
+	for(PxU32 sweep = 0; sweep < 2; ++sweep)
+	{
+		for(PxU32 a = 0; a < numChunks; ++a)
+		{
+			if(sweep == 1)
+				dependencyStarts.pushBack(dependencies.size());
+
+			for(PxU32 b = chunkStarts[a]; b < chunkStarts[a+1]; ++b)
+			{
+				const PxsConstraintBatchHeader& header = headers[b];
+				for(PxU32 c = 0; c < header.mStride; ++c)
+				{
+					const PxcSolverConstraintDesc& desc = constraintDescriptors[header.mStartIndex + c];
+					const uintptr_t bodies[2] = { (uintptr_t)(desc.bodyA - atoms), (uintptr_t)(desc.bodyB - atoms) };
+					for(PxU32 d = 0; d < 2; ++d)
+					{
+						const uintptr_t body = bodies[d];
+						if(body >= numAtoms)
+							continue;
+
+						if(sweep == 1)
+						{
+							const PxU32 dependency = lastChunk[body];
+							if(lastDependent[dependency] != a)
+							{
+								lastDependent[dependency] = a;
+								dependencies.pushBack(dependency);
+							}
+						}
+						lastChunk[body] = a;
+					}
+				}
+			}
+		}
+	}
+	dependencyStarts.pushBack(dependencies.size());
+}
+
 } // namespace physx
  
 //#endif // PX_CONSTRAINT_PARTITIONINC
@@ -53,6 +53,11 @@ void constructBatchHeaders(PxcSolverConstraintDesc* eaOrderedConstraintDescripto
 						   Ps::Array<PxsConstraintBatchHeader>& batches);
 
 
+//Cuts the batch headers of every partition into chunks of up to chunkSize headers and finds the chunks each chunk depends on, see PxsSolverChunkGraph
+void constructSolverChunks(const PxsConstraintBatchHeader* PX_RESTRICT headers, const PxU32* PX_RESTRICT headersPerPartition, const PxU32 numPartitions,
+						   const PxcSolverConstraintDesc* PX_RESTRICT constraintDescriptors, const PxcSolverBody* PX_RESTRICT atoms, const PxU32 numAtoms, const PxU32 chunkSize,
+						   Ps::Array<PxU32>& chunkStarts, Ps::Array<PxU32>& dependencyStarts, Ps::Array<PxU32>& dependencies, Ps::Array<PxU32>& scratch);
+
 PxU32 postProcessConstraintPartitioning(PxcSolverBody* atoms, const PxU32 numAtoms, PxcArticulationSolverDesc* articulationDescs, const PxU32 numArticulations,
 									   PxcSolverConstraintDesc* eaOrderedConstraintDescriptors, const PxU32 numConstraintDescriptors, 
 									   PxcFsSelfConstraintBlock* selfConstraintBlocks, PxU32 numSelfConstraintBlocks);
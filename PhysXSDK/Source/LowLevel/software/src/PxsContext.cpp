@@ -72,7 +72,7 @@ static PxvBroadPhase* createBroadPhase(PxcScratchAllocator& scratchAllocator, Cm
 	}
 	else
 	{
-		return PxsBroadPhaseContextSap::create(scratchAllocator, eventProfiler);
+		return PxsBroadPhaseContextSap::create(scratchAllocator, eventProfiler, desc.flags & PxSceneFlag::eENABLE_BROADPHASE_PARKING);
 	}
 }
 
@@ -114,6 +114,7 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 	mPCM						(desc.flags & PxSceneFlag::eENABLE_PCM),
 	mContactCache				(false),
 	mCreateAveragePoint			(desc.flags & PxSceneFlag::eENABLE_AVERAGE_POINT),
+	mSolverSubIslandScheduling	(desc.flags & PxSceneFlag::eENABLE_SOLVER_SUB_ISLAND_SCHEDULING),
 	mNumFastMovingShapes		(0)
 {
 	clearManagerTouchEvents();
@@ -139,7 +140,7 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 	}
 #endif
 
-	mNpMemBlockPool.init(desc.nbContactDataBlocks, desc.maxNbContactDataBlocks);
+	mNpMemBlockPool.init(desc.nbContactDataBlocks, desc.maxNbContactDataBlocks, desc.flags & PxSceneFlag::eENABLE_CONTACT_DATA_BLOCK_GROWTH);
 }
 
 PxsContext::~PxsContext()
@@ -678,90 +679,61 @@ public:
 		const PxU32 nb = mCmCount;
 		PxsContactManager** PX_RESTRICT cmArray = mCmArray;
 
-		if(pcm)
+		// Group the contact managers by pair of geometry types so that each contact method runs over all its pairs in a row.
+		// This keeps the instruction cache warm and lets the primitive pairs run in SIMD batches.
+		PxU32 groupStarts[PXC_NP_PAIR_TYPE_KEY_COUNT + 1];
+		PxMemZero(groupStarts, sizeof(groupStarts));
+		for(PxU32 i=0;i<nb;i++)
+			groupStarts[PxcNpWorkUnitGetPairTypeKey(cmArray[i]->getWorkUnit()) + 1]++;
+		for(PxU32 i=0;i<PXC_NP_PAIR_TYPE_KEY_COUNT;i++)
+			groupStarts[i+1] += groupStarts[i];
+
+		PxcNpWorkUnit* sortedUnits[BATCH_SIZE];
+		PxU16 oldTouch[BATCH_SIZE];
 		{
+			PxU32 groupOffsets[PXC_NP_PAIR_TYPE_KEY_COUNT];
+			PxMemCopy(groupOffsets, groupStarts, sizeof(groupOffsets));
 			for(PxU32 i=0;i<nb;i++)
 			{
-				const PxU32 prefetch1 = PxMin(i + 1, nb - 1);
-				const PxU32 prefetch2 = PxMin(i + 2, nb - 1);
-
-				PxcNpWorkUnit* nextUnit = &cmArray[prefetch1]->getWorkUnit();
-				Ps::prefetchLine(nextUnit->rigidCore0);
-				Ps::prefetchLine(nextUnit->rigidCore1);
-				Ps::prefetchLine(nextUnit->rigidCore0,128);
-				Ps::prefetchLine(nextUnit->rigidCore1,128);
-				Ps::prefetchLine(nextUnit->shapeCore0);
-				Ps::prefetchLine(nextUnit->shapeCore1);
-	
-				Ps::prefetchLine(cmArray[prefetch2]);
-				Ps::prefetchLine(cmArray[prefetch2],128);
-				
-				PxU16 oldTouch = cmArray[i]->getTouchStatus();
+				if(i+1 < nb)
+					Ps::prefetchLine(cmArray[i+1], 128);
 
 				PxcNpWorkUnit& n = cmArray[i]->getWorkUnit();
-
-				PxcDiscreteNarrowPhasePCM(*threadContext, n);
-
-				PxU16 newTouch = cmArray[i]->getTouchStatus();
-
-				if(newTouch ^ oldTouch)
-				{
-					localChangeTouchCM.growAndSet(cmArray[i]->getIndex());
-					if(newTouch)
-						newTouchCMCount++;
-					else
-						lostTouchCMCount++;
-				}
+				sortedUnits[groupOffsets[PxcNpWorkUnitGetPairTypeKey(n)]++] = &n;
+				oldTouch[i] = cmArray[i]->getTouchStatus();
 			}
-
-			threadContext->addLocalNewTouchCount(newTouchCMCount);
-			threadContext->addLocalLostTouchCount(lostTouchCMCount);
-
-			mContext->putThreadContext(threadContext);
 		}
-		else
-		{
-			for(PxU32 i=0;i<nb;i++)
-			{
-				// PT: still a lot to do here. We should prefetch the PxsBodyShape/PxsRigidBody...
-
-				/*if(i!=nb-1)
-					Ps::prefetch(cmArray[i+1]);*/
-				const PxU32 prefetch1 = PxMin(i + 1, nb - 1);
-				const PxU32 prefetch2 = PxMin(i + 2, nb - 1);
-
-				PxcNpWorkUnit* nextUnit = &cmArray[prefetch1]->getWorkUnit();
-				Ps::prefetchLine(nextUnit->rigidCore0);
-				Ps::prefetchLine(nextUnit->rigidCore1);
-				Ps::prefetchLine(nextUnit->shapeCore0);
-				Ps::prefetchLine(nextUnit->shapeCore1);
-				
-				Ps::prefetchLine(cmArray[prefetch2]);
-				Ps::prefetchLine(cmArray[prefetch2],128);
-				
-				PxU16 oldTouch = cmArray[i]->getTouchStatus();
 
-				PxcNpWorkUnit& n = cmArray[i]->getWorkUnit();
+		for(PxU32 i=0;i<PXC_NP_PAIR_TYPE_KEY_COUNT;i++)
+		{
+			const PxU32 groupSize = groupStarts[i+1] - groupStarts[i];
+			if(!groupSize)
+				continue;
 
-				PxcDiscreteNarrowPhase(*threadContext, n);
+			if(pcm)
+				PxcDiscreteNarrowPhaseGroupPCM(*threadContext, sortedUnits + groupStarts[i], groupSize);
+			else
+				PxcDiscreteNarrowPhaseGroup(*threadContext, sortedUnits + groupStarts[i], groupSize);
+		}
 
-				PxU16 newTouch = cmArray[i]->getTouchStatus();
+		for(PxU32 i=0;i<nb;i++)
+		{
+			const PxU16 newTouch = cmArray[i]->getTouchStatus();
 
-				if(newTouch ^ oldTouch)
-				{
-					localChangeTouchCM.growAndSet(cmArray[i]->getIndex());
-					if(newTouch)
-						newTouchCMCount++;
-					else
-						lostTouchCMCount++;
-				}
+			if(newTouch ^ oldTouch[i])
+			{
+				localChangeTouchCM.growAndSet(cmArray[i]->getIndex());
+				if(newTouch)
+					newTouchCMCount++;
+				else
+					lostTouchCMCount++;
 			}
+		}
 
-			threadContext->addLocalNewTouchCount(newTouchCMCount);
-			threadContext->addLocalLostTouchCount(lostTouchCMCount);
+		threadContext->addLocalNewTouchCount(newTouchCMCount);
+		threadContext->addLocalLostTouchCount(lostTouchCMCount);
 
-			mContext->putThreadContext(threadContext);
-		}
+		mContext->putThreadContext(threadContext);
 	}
 
 	virtual const char* getName() const
@@ -1027,6 +999,8 @@ void PxsContext::mergeCMDiscreteUpdateResults(PxBaseTask* /*continuation*/)
 
 		mSimStats.mTotalCompressedContactSize += threadContext->mCompressedCacheSize;
 		mSimStats.mTotalConstraintSize += threadContext->mConstraintSize;
+		mSimStats.mPeakNpThreadMemory = PxMax(mSimStats.mPeakNpThreadMemory, 
+			threadContext->mContactBlockStream.getReservedBytes() + threadContext->mNpCacheStreamPair.getReservedBytes());
 		threadContext->clearStats();
 #endif
 
@@ -1368,6 +1342,7 @@ void PxsContext::beginUpdate()
 #if PX_ENABLE_SIM_STATS
 	mSimStats.clearAll();
 #endif
+	mNpMemBlockPool.resetPeakBlocksOverLimit();
 }
 
 // PX_ENABLE_SIM_STATS
@@ -1378,6 +1353,10 @@ void PxsContext::addThreadStats(const PxsThreadContext::ThreadSimStats& stats)
 	mSimStats.numActiveDynamicBodies += stats.numActiveDynamicBodies;
 	mSimStats.numActiveKinematicBodies += stats.numActiveKinematicBodies;
 	mSimStats.numAxisSolverConstraints += stats.numAxisSolverConstraints;
+	mSimStats.numSolverPartitions += stats.numSolverPartitions;
+	mSimStats.maxSolverPartitionSize = PxMax(mSimStats.maxSolverPartitionSize, stats.maxSolverPartitionSize);
+	for(PxU32 i = 0; i < PxvSimStats::eSOLVER_PARTITION_SIZE_BUCKETS; ++i)
+		mSimStats.numSolverPartitionsBySize[i] += stats.numSolverPartitionsBySize[i];
 #endif
 }
 
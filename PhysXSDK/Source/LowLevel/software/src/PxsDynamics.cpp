@@ -13,6 +13,8 @@
 
 #include "PsTime.h"
 #include "PsAtomic.h"
+#include "PsCpu.h"
+#include "PsBitUtils.h"
 #include "PxvDynamics.h"
 
 #include "PxsContext.h"
@@ -138,7 +140,8 @@ PxsDynamicsContext::PxsDynamicsContext(PxsContext* context) :
 	mDt							(1.0f), 
 	mInvDt						(1.0f),
 	mBounceThreshold			(-2.0f),
-	mSolverBatchSize			(32)
+	mSolverBatchSize			(32),
+	mSolveContactBlocksAVX		(PX_SOLVER_AVX && Ps::Cpu::hasAVX())
 	//mMergeTask					(this, "PxsDynamicsContext::mergeResults")
 {
 	mWorldSolverBodyData.solverBody = &mWorldSolverBody;
@@ -338,7 +341,7 @@ public:
 		PxsBodyCore*const* PX_RESTRICT pBodyArray, Cm::BitMap& localChangedActors, PxsArticulation*const* PX_RESTRICT pArticulations, PxU32 numArtics,
 		volatile PxI32* pRunningThreads, Ps::Array<PxsConstraintBatchHeader>& _contactBlocks, Ps::Array<PxsConstraintBatchHeader>& _frictionBlocks,
 		PxsRigidBody** PX_RESTRICT rigidBodies, Ps::Array<PxU32>& _accumulatedHeadersPerPartition, Ps::Array<PxU32>& _accumulatedFrictionHeadersPerPartition,
-		const PxU32 batchSize)
+		const PxU32 batchSize, const PxsSolverChunkGraph* chunkGraph)
 		: contactBlocks(_contactBlocks)
 		, frictionBlocks(_frictionBlocks)
 		, accumulatedHeadersPerPartition(_accumulatedHeadersPerPartition)
@@ -374,6 +377,7 @@ public:
 		, m_FrictionType(frictionType)
 		, mRigidBodies(rigidBodies)
 		, mBatchSize(batchSize)
+		, mChunkGraph(chunkGraph)
 	{
 	}
 
@@ -384,7 +388,7 @@ public:
 				m_BodyCount, m_pArticulationDescArray, m_ArticulationDescArraySize,	m_pContactDescArray,m_ContactDescArraySize, m_pFrictionDescArray, m_FrictionDescArraySize, 
 				m_pConstraintIteration, m_pConstraintIteration2, m_pFrictionIteration, m_pAtomIteration, m_pAtomIteration2, m_pAtomIntegrationIteration, m_pThresholdStream, 
 				m_ContactManagers, m_pThresholdPairsOut, m_pMotionVelocityArray, m_pBodyArray, m_LocalChangedActors, m_pArticulations, m_NumArtics, m_pRunningThreads, 
-				contactBlocks, frictionBlocks, accumulatedHeadersPerPartition, accumulatedFrictionHeadersPerPartition, mRigidBodies, mBatchSize);
+				contactBlocks, frictionBlocks, accumulatedHeadersPerPartition, accumulatedFrictionHeadersPerPartition, mRigidBodies, mBatchSize, mChunkGraph);
 		}
 	}
 
@@ -431,6 +435,7 @@ public:
 	PxFrictionType::Enum					m_FrictionType;
 	PxsRigidBody** PX_RESTRICT				mRigidBodies;
 	PxU32									mBatchSize;
+	const PxsSolverChunkGraph*				mChunkGraph;
 
 };
 
@@ -1300,6 +1305,25 @@ private:
 	const PxU32					mSolverBodyOffset;
 };
 
+#if PX_ENABLE_SIM_STATS
+//Adds the partitions of an island to the partition statistics, constraintsPerPartition holds the accumulated partition sizes
+static void recordPartitionStats(PxsThreadContext::ThreadSimStats& stats, const PxU32* constraintsPerPartition, const PxU32 numPartitions)
+{
+	PxU32 prevAccumulation = 0;
+	for(PxU32 a = 0; a < numPartitions; ++a)
+	{
+		const PxU32 size = constraintsPerPartition[a] - prevAccumulation;
+		prevAccumulation = constraintsPerPartition[a];
+		if(size == 0)
+			continue;
+
+		stats.numSolverPartitions++;
+		stats.maxSolverPartitionSize = PxMax(stats.maxSolverPartitionSize, size);
+		stats.numSolverPartitionsBySize[PxMin(Ps::highestSetBit(size), PxU32(PxvSimStats::eSOLVER_PARTITION_SIZE_BUCKETS - 1))]++;
+	}
+}
+#endif
+
 class PxsSolverConstraintPartitionTask : public Cm::Task
 {
 	PxsSolverConstraintPartitionTask& operator=(const PxsSolverConstraintPartitionTask&);
@@ -1475,6 +1499,9 @@ public:
 			args.mBitField = &mThreadContext.mPartitionNormalizationBitmap;
 			
 			mThreadContext.mMaxPartitions = partitionContactConstraints(args);
+#if PX_ENABLE_SIM_STATS
+			recordPartitionStats(mThreadContext.getSimStats(), mThreadContext.mConstraintsPerPartition.begin(), mThreadContext.mMaxPartitions);
+#endif
 			mThreadContext.mNumDifferentBodyConstraints = args.mNumDifferentBodyConstraints;
 			mThreadContext.mNumSelfConstraints = args.mNumSelfConstraints;
 			mThreadContext.mNumSelfConstraintBlocks = args.mNumSelfConstraintBlocks;
@@ -2100,6 +2127,9 @@ public:
 		//while(i<totalConstraintCount)
 		PxU32 numBatches = 0;
 
+		//The Coulomb friction extraction below expects block contact batches of 4
+		const bool mergeContactBlocks = mContext.getSolveContactBlocksAVX() && mThreadContext.mFrictionType == PxFrictionType::ePATCH;
+
 		PxU32 currIndex = 0;
 		for(PxU32 a = 0; a < mThreadContext.mConstraintsPerPartition.size(); ++a)
 		{
@@ -2148,6 +2178,21 @@ public:
 						}
 					}
 
+					//Batches of the same partition share no dynamic bodies, so two consecutive batches of 4 block contacts
+					//with the same stream layout can be solved as one batch of 8 by the AVX kernels.
+					if(mergeContactBlocks && numBatchesInPartition != 0 && newStride == 4
+						&& (type == PXS_SC_TYPE_BLOCK_RB_CONTACT || type == PXS_SC_TYPE_BLOCK_STATIC_RB_CONTACT))
+					{
+						PxsConstraintBatchHeader& prevHeader = mThreadContext.contactConstraintBatchHeaders[numBatches-1];
+						if(prevHeader.mStride == 4 && prevHeader.mConstraintType == type
+							&& contactPreBlocksHaveSameLayout(contactDescBegin + prevHeader.mStartIndex, contactDescBegin + startIndex))
+						{
+							PX_ASSERT(prevHeader.mStartIndex + 4 == startIndex);
+							prevHeader.mStride = 8;
+							continue;
+						}
+					}
+
 					mThreadContext.contactConstraintBatchHeaders[numBatches].mConstraintType = type;
 					numBatches++;
 					numBatchesInPartition++;
@@ -2476,6 +2521,29 @@ public:
 				if(numTasks > 1)
 				{
 					const PxU32 idealBatchSize = PxMax(unrollSize, idealThreads*unrollSize/(numTasks*2));
+
+					//Sub-island scheduling: the partitions are cut into chunks of idealBatchSize headers that only wait for the chunks they share bodies with
+					const PxsSolverChunkGraph* chunkGraph = NULL;
+					if(mContext.getContext()->getSolverSubIslandScheduling() && mThreadContext.mFrictionType == PxFrictionType::ePATCH && mCounts.articulations == 0)
+					{
+						constructSolverChunks(mThreadContext.contactConstraintBatchHeaders.begin(), mThreadContext.mConstraintsPerPartition.begin(), 
+							mThreadContext.mConstraintsPerPartition.size(), pContactDescs, solverBodies, mCounts.bodies, idealBatchSize, 
+							mThreadContext.mSolverChunkStarts, mThreadContext.mSolverChunkDependencyStarts, mThreadContext.mSolverChunkDependencies, 
+							mThreadContext.mSolverChunkScratch);
+
+						const PxU32 numChunks = mThreadContext.mSolverChunkStarts.size() - 1;
+						mThreadContext.mSolverChunkProgress.resize(numChunks * PxsSolverChunkGraph::ePROGRESS_STRIDE);
+						PxMemZero(mThreadContext.mSolverChunkProgress.begin(), sizeof(PxI32) * numChunks * PxsSolverChunkGraph::ePROGRESS_STRIDE);
+
+						PxsSolverChunkGraph& graph = mThreadContext.mSolverChunkGraph;
+						graph.chunkStarts = mThreadContext.mSolverChunkStarts.begin();
+						graph.dependencyStarts = mThreadContext.mSolverChunkDependencyStarts.begin();
+						graph.dependencies = mThreadContext.mSolverChunkDependencies.begin();
+						graph.progress = mThreadContext.mSolverChunkProgress.begin();
+						graph.numChunks = numChunks;
+						chunkGraph = &graph;
+					}
+
 					for(PxU32 a = 1; a < numTasks; ++a)
 					{
 						void* tsk = mContext.getContext()->getTaskPool().allocate(sizeof(PxsParallelSolverTask));
@@ -2514,7 +2582,8 @@ public:
 							const_cast<PxsRigidBody**>(mObjects.bodies),
 							mThreadContext.mConstraintsPerPartition,
 							mThreadContext.mFrictionConstraintsPerPartition,
-							idealBatchSize);
+							idealBatchSize,
+							chunkGraph);
 
 						//Force to complete before merge task!
 						pTask->setContinuation(mCont);
@@ -2560,7 +2629,8 @@ public:
 							mThreadContext.mConstraintsPerPartition,
 							mThreadContext.mFrictionConstraintsPerPartition,
 							const_cast<PxsRigidBody**>(mObjects.bodies),
-							idealBatchSize);
+							idealBatchSize,
+							chunkGraph);
 					}
 					const PxI32 numAtomsPlusArtics = (PxI32)( mCounts.bodies + mCounts.articulations );
 
@@ -3449,12 +3519,14 @@ void physx::solveParallelDefaultFriction(SOLVER_PARALLEL_METHOD_ARGS)
 		atomListStart, atomDataList, solverBodyOffset, atomListSize, articulationListStart, articulationListSize, constraintList, constraintListSize,
 		pConstraintIndex, pConstraintIndex2, pAtomListIndex, pAtomListIndex2, pAtomIntegrationListIndex, thresholdStream, thresholdStreamLength, outThresholdPairs, 
 		motionVelocityArray, bodyArray, localChangedActors, articulations, _numArtics, pNumObjectsIntegrated, contactBlocks, frictionBlocks, accumulatedHeadersPerPartition, 
-		rigidBodies, batchSize);
+		rigidBodies, batchSize, chunkGraph);
 }
 
 
 void physx::solveParallelCouloumFriction(SOLVER_PARALLEL_METHOD_ARGS)
 {
+	PX_UNUSED(chunkGraph);
+
 	context.solveParallelCoulomb(positionIterations, velocityIterations, 
 		atomListStart, atomDataList, solverBodyOffset, atomListSize, articulationListStart, articulationListSize, constraintList, constraintListSize,
 		frictionConstraintList, frictionConstraintListSize, pConstraintIndex, pConstraintIndex2, pFrictionConstraintIndex, pAtomListIndex, pAtomListIndex2, 
@@ -3479,14 +3551,15 @@ void PxsDynamicsContext::solveParallel(const PxU32 positionIterations, const PxU
 										 Cm::SpatialVector* motionVelocityArray, PxsBodyCore*const* bodyArray, Cm::BitMap& localChangedActors,
 										 PxsArticulation*const* PX_RESTRICT /*articulations*/, PxU32 _numArtics, volatile PxI32* pNumObjectsIntegrated,
 										 Ps::Array<PxsConstraintBatchHeader>& contactBlocks, Ps::Array<PxsConstraintBatchHeader>& frictionBlocks,
-										 Ps::Array<PxU32>& accumulatedHeadersPerPartition, PxsRigidBody** PX_RESTRICT rigidBodies, const PxU32 batchSize)
+										 Ps::Array<PxU32>& accumulatedHeadersPerPartition, PxsRigidBody** PX_RESTRICT rigidBodies, const PxU32 batchSize,
+										 const PxsSolverChunkGraph* chunkGraph)
 {
 	PxI32 normalIterations = 0;
 
 	{
 		mSolverCore->solveVParallelAndWriteBack(mDt, positionIterations, velocityIterations, atomListStart, atomDataList, solverBodyOffset, atomListSize, articulationListStart, articulationListSize,
 				constraintList, constraintListSize, pConstraintIndex, pConstraintIndex2, pAtomListIndex, pAtomListIndex2, thresholdStream, thresholdStreamLength,
-				outThresholdPairs, contactBlocks, frictionBlocks, accumulatedHeadersPerPartition, motionVelocityArray, normalIterations, batchSize);
+				outThresholdPairs, contactBlocks, frictionBlocks, accumulatedHeadersPerPartition, motionVelocityArray, normalIterations, batchSize, chunkGraph);
 	}
 	
 	const PxI32 unrollCount = 128;
@@ -257,7 +257,8 @@ public:
 PxsIslandManager::PxsIslandManager(const PxU32 rigidBodyOffset, PxcScratchAllocator& scratchAllocator, Cm::EventProfiler* eventProfiler)
 : mRigidBodyOffset(rigidBodyOffset),
   mScratchAllocator(scratchAllocator),
-  mEventProfiler(eventProfiler)
+  mEventProfiler(eventProfiler),
+  mUpdateIslandsEndTask(this, "PxsIslandManager.updateIslandsEnd")
 {
 
 	mNumAddedRBodies=0;
@@ -288,6 +289,10 @@ PxsIslandManager::PxsIslandManager(const PxU32 rigidBodyOffset, PxcScratchAlloca
 	mIslandManagerUpdateWorkBuffers.mGraphNextNodes=NULL;
 	mIslandManagerUpdateWorkBuffers.mGraphStartIslands=NULL;
 	mIslandManagerUpdateWorkBuffers.mGraphNextIslands=NULL;
+	mIslandManagerUpdateWorkBuffers.mGraphNodes=NULL;
+	mIslandManagerUpdateWorkBuffers.mNumGraphNodes=0;
+	mIslandManagerUpdateWorkBuffers.mGraphEdges=NULL;
+	mIslandManagerUpdateWorkBuffers.mNumGraphEdges=0;
 
 	mProcessSleepingIslandsComputeData.mDataBlock=NULL;
 	mProcessSleepingIslandsComputeData.mDataBlockSize=0;
@@ -620,6 +625,8 @@ void PxsIslandManager::freeBuffers()
 	mIslandManagerUpdateWorkBuffers.mGraphNextNodes=NULL;
 	mIslandManagerUpdateWorkBuffers.mGraphStartIslands=NULL;
 	mIslandManagerUpdateWorkBuffers.mGraphNextIslands=NULL;
+	mIslandManagerUpdateWorkBuffers.mGraphNodes=NULL;
+	mIslandManagerUpdateWorkBuffers.mGraphEdges=NULL;
 
 	mProcessSleepingIslandsComputeData.mDataBlock=NULL;
 	mProcessSleepingIslandsComputeData.mBodiesToWakeOrSleep=NULL;
@@ -975,6 +982,8 @@ void PxsIslandManager::resizeArrays()
 	const PxU32 graphNextNodesByteSize = alignSize16(sizeof(NodeType)*allNodesCapacity);
 	const PxU32 graphStartIslandsByteSize = alignSize16(sizeof(IslandType)*allNodesCapacity);
 	const PxU32 graphNextIslandsByteSize = alignSize16(sizeof(IslandType)*allNodesCapacity);
+	const PxU32 graphNodesByteSize = alignSize16(sizeof(NodeType)*allNodesCapacity);
+	const PxU32 graphEdgesByteSize = alignSize16(sizeof(EdgeType)*allEdgesCapacity);
 
 	const PxU32 solverDataByteSize=
 		bodiesToWakeOrSleepByteSize + 
@@ -998,7 +1007,9 @@ void PxsIslandManager::resizeArrays()
 		islandWordsByteSize*IslandManagerUpdateWorkBuffers::eMAX_NB_BITMAPS+
 		graphNextNodesByteSize+
 		graphStartIslandsByteSize+
-		graphNextIslandsByteSize;
+		graphNextIslandsByteSize+
+		graphNodesByteSize+
+		graphEdgesByteSize;
 
 	const PxU32 byteSize=persistentWorkbufferByteSize+nonPersistentworkBufferByteSize;
 
@@ -1151,6 +1162,14 @@ void PxsIslandManager::resizeArrays()
 	mIslandManagerUpdateWorkBuffers.mGraphNextIslands = (IslandType*)(newBuffer + offset);
 	offset += graphNextIslandsByteSize;
 
+	//Arrays for a copy of the nodes and edges of islands with a broken edge.
+	PX_ASSERT(NULL==mIslandManagerUpdateWorkBuffers.mGraphNodes);
+	mIslandManagerUpdateWorkBuffers.mGraphNodes = (NodeType*)(newBuffer + offset);
+	offset += graphNodesByteSize;
+	PX_ASSERT(NULL==mIslandManagerUpdateWorkBuffers.mGraphEdges);
+	mIslandManagerUpdateWorkBuffers.mGraphEdges = (EdgeType*)(newBuffer + offset);
+	offset += graphEdgesByteSize;
+
 	PX_ASSERT(byteSize>=offset);
 
 
@@ -1578,18 +1597,35 @@ void PxsIslandManager::updateIslandsSecondPassSPU(PxBaseTask* continuation, cons
 }
 #endif
 
-void PxsIslandManager::updateIslands()
+void PxsIslandGenLinkTask::runInternal()
 {
-	updateIslandsMain(
-		mRigidBodyOffset,
+	mIslandManager->linkIslandEdges(mStartEdge, mEndEdge);
+}
+
+void PxsIslandManager::linkIslandEdges(const PxU32 startEdge, const PxU32 endEdge)
+{
+	linkBrokenEdgeIslandNodes(mEdgeManager, mIslandManagerUpdateWorkBuffers, startEdge, endEdge);
+}
+
+void PxsIslandManager::updateIslandsBegin()
+{
+	updateIslandsMainBegin(
 		mNodeChangeManager.getDeletedNodes(),mNodeChangeManager.getNumDeletedNodes(),
 		mNodeChangeManager.getCreatedNodes(),mNodeChangeManager.getNumCreatedNodes(),
 		mEdgeChangeManager.getDeletedEdges(),mEdgeChangeManager.getNumDeletedEdges(),
-		mEdgeChangeManager.getCreatedEdges(),mEdgeChangeManager.getNumCreatedEdges(),
 		mEdgeChangeManager.getBrokenEdges(),mEdgeChangeManager.getNumBrokenEdges(),
 		mEdgeChangeManager.getJoinedEdges(),mEdgeChangeManager.getNumJoinedEdges(),
 		mNodeManager.getBitmap(NodeManager::eKINEMATIC), mNodeManager.getBitmap(NodeManager::eKINEMATIC_CHANGE), mNumAddedKinematics,
 		mNodeManager.getBitmap(NodeManager::eNOT_READY_FOR_SLEEPING), mNodeManager.getBitmap(NodeManager::eNOT_READY_FOR_SLEEPING_CHANGE),
+		mNodeManager,mEdgeManager,mIslands,
+		mIslandManagerUpdateWorkBuffers,
+		mEventProfiler);
+}
+
+void PxsIslandManager::updateIslandsEnd(PxBaseTask*)
+{
+	updateIslandsMainEnd(
+		mRigidBodyOffset,
 		mNodeManager,mEdgeManager,mIslands,mRootArticulationManager,
 		mProcessSleepingIslandsComputeData,
 		mIslandManagerUpdateWorkBuffers,
@@ -1746,8 +1782,45 @@ void PxsIslandManager::updateIslands(PxBaseTask* continuation, const PxU32 numSp
 	else
 #endif
 	{
-		updateIslands();
-		PX_ASSERT(isValid());
+		updateIslandsBegin();
+
+		//The union-find over the edges of the islands with a broken edge is the only part of the update
+		//that can be split up.  The islands are only created after all edges have been linked and the result
+		//is the same whatever the number of tasks.
+		const PxU32 numGraphEdges=mIslandManagerUpdateWorkBuffers.mNumGraphEdges;
+		PxU32 numLinkTasks=1;
+#if !PX_USE_16_BIT_HANDLES
+		if(continuation && numGraphEdges>=2*eMIN_NB_EDGES_PER_LINK_TASK)
+		{
+			const PxU32 numWorkers=continuation->getTaskManager()->getCpuDispatcher()->getWorkerCount();
+			numLinkTasks=PxMin(PxMin(numWorkers, numGraphEdges/eMIN_NB_EDGES_PER_LINK_TASK), PxU32(eMAX_NB_LINK_TASKS));
+		}
+#endif
+
+		if(numLinkTasks>1)
+		{
+			mUpdateIslandsEndTask.setContinuation(continuation);
+
+			const PxU32 numEdgesPerTask=(numGraphEdges+numLinkTasks-1)/numLinkTasks;
+			for(PxU32 i=0;i<numLinkTasks;i++)
+			{
+				const PxU32 startEdge=i*numEdgesPerTask;
+				const PxU32 endEdge=PxMin(startEdge+numEdgesPerTask, numGraphEdges);
+				mLinkTasks[i].set(this, startEdge, endEdge);
+				mLinkTasks[i].setContinuation(&mUpdateIslandsEndTask);
+			}
+			for(PxU32 i=0;i<numLinkTasks;i++)
+			{
+				mLinkTasks[i].removeReference();
+			}
+
+			mUpdateIslandsEndTask.removeReference();
+		}
+		else
+		{
+			linkIslandEdges(0, numGraphEdges);
+			updateIslandsEnd(continuation);
+		}
 	}
 }
 
@@ -19,6 +19,7 @@ using namespace physx;
 #include "PxsArticulation.h"
 #include "CmEventProfiler.h"
 #include "PxProfileEventId.h"
+#include "PsAtomic.h"
 
 #ifndef __SPU__
 void EdgeChangeManager::cleanupEdgeEvents(PxI32* edgeEventWorkBuffer, const PxU32 entryCapacity)
@@ -1170,6 +1171,8 @@ static void duplicateKinematicNodes
 	}
 }
 
+#ifdef __SPU__
+
 static void processBrokenEdgeIslands2
 (const IslandType* islandsToUpdate, const PxU32 numIslandsToUpdate,
  NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands,
@@ -1433,6 +1436,210 @@ static void processBrokenEdgeIslands
 								affectedIslandsBitmap);
 }
 
+#else
+
+/**
+\brief Find the root of a node in the union-find forest built by linkBrokenEdgeIslandNodes.
+Nodes are always linked to a node with a smaller id so a node's parent never has a larger id than the node itself.
+The path is halved on the way up: this only ever replaces a parent with one of its ancestors so it is safe
+to do while other threads are linking nodes.
+*/
+static PX_FORCE_INLINE NodeType findGraphRoot(volatile NodeType* PX_RESTRICT graphParents, NodeType nodeId)
+{
+	NodeType parent=graphParents[nodeId];
+	while(parent!=nodeId)
+	{
+		const NodeType grandParent=graphParents[parent];
+		if(grandParent!=parent)
+		{
+			graphParents[nodeId]=grandParent;
+		}
+		nodeId=grandParent;
+		parent=graphParents[nodeId];
+	}
+	return nodeId;
+}
+
+/**
+\brief All islands that have been marked as having a broken edge need to be rebuilt.  Gather the nodes
+and edges of all these islands in workBuffers.mGraphNodes and workBuffers.mGraphEdges, make each node the
+root of its own tree in workBuffers.mGraphNextNodes and release the islands.
+linkBrokenEdgeIslandNodes then joins the trees of all nodes connected by an edge and rebuildBrokenEdgeIslands
+creates one island per tree.
+\param[in] brokenEdgeIslandsBitmap is a bitmap of all islands marked as needing rebuilt.
+\param[in] nodeManager is a managed collection of nodes.
+\param[in] edgeManager is a managed collection of edges.
+\param[in] islands is a managed collection of islands.  All islands in brokenEdgeIslandsBitmap are released.
+\param[in,out] workBuffers stores the gathered nodes and edges.
+\param[in,out] affectedIslandsBitmap is a bitmap of islands that have changed during the update.  Released islands
+are removed from the bitmap.
+*/
+static void gatherBrokenEdgeIslands
+(const Cm::BitMap& brokenEdgeIslandsBitmap,
+ const NodeManager& nodeManager, const EdgeManager& edgeManager, IslandManager& islands,
+ IslandManagerUpdateWorkBuffers& workBuffers,
+ Cm::BitMap& affectedIslandsBitmap)
+{
+	const NodeType* PX_RESTRICT nextNodeIds=nodeManager.getNextNodeIds();
+	const EdgeType* PX_RESTRICT nextEdgeIds=edgeManager.getNextEdgeIds();
+	NodeType* PX_RESTRICT graphParents=workBuffers.mGraphNextNodes;
+	IslandType* PX_RESTRICT graphRootIslands=workBuffers.mGraphStartIslands;
+	NodeType* PX_RESTRICT graphNodes=workBuffers.mGraphNodes;
+	EdgeType* PX_RESTRICT graphEdges=workBuffers.mGraphEdges;
+	PX_UNUSED(nodeManager);
+
+	PxU32 numGraphNodes=0;
+	PxU32 numGraphEdges=0;
+	const PxU32 lastSetBit = brokenEdgeIslandsBitmap.findLast();
+	for(PxU32 w = 0; w <= lastSetBit >> 5; ++w)
+	{
+		for(PxU32 b = brokenEdgeIslandsBitmap.getWords()[w]; b; b &= b-1)
+		{
+			const IslandType islandId = (IslandType)(w<<5|Ps::lowestSetBit(b));
+			if(!islands.getBitmap().test(islandId))
+				continue;
+
+			const Island& island=islands.get(islandId);
+
+			NodeType nextNode=island.mStartNodeId;
+			while(nextNode!=INVALID_NODE)
+			{
+				PX_ASSERT(numGraphNodes<nodeManager.getCapacity());
+				graphNodes[numGraphNodes++]=nextNode;
+				graphParents[nextNode]=nextNode;
+				graphRootIslands[nextNode]=INVALID_ISLAND;
+				nextNode=nextNodeIds[nextNode];
+			}
+
+			EdgeType nextEdge=island.mStartEdgeId;
+			while(nextEdge!=INVALID_EDGE)
+			{
+				PX_ASSERT(numGraphEdges<edgeManager.getCapacity());
+				graphEdges[numGraphEdges++]=nextEdge;
+				nextEdge=nextEdgeIds[nextEdge];
+			}
+
+			releaseIsland(islandId,islands);
+			affectedIslandsBitmap.reset(islandId);
+		}
+	}
+
+	workBuffers.mNumGraphNodes=numGraphNodes;
+	workBuffers.mNumGraphEdges=numGraphEdges;
+}
+
+void physx::linkBrokenEdgeIslandNodes
+(const EdgeManager& edgeManager, IslandManagerUpdateWorkBuffers& workBuffers, const PxU32 startEdge, const PxU32 endEdge)
+{
+	const Edge* PX_RESTRICT allEdges=edgeManager.getAll();
+	const EdgeType* PX_RESTRICT graphEdges=workBuffers.mGraphEdges;
+	volatile NodeType* PX_RESTRICT graphParents=workBuffers.mGraphNextNodes;
+	PX_ASSERT(endEdge<=workBuffers.mNumGraphEdges);
+
+	for(PxU32 i=startEdge;i<endEdge;i++)
+	{
+		//Get the current edge.
+		const EdgeType edgeId=graphEdges[i];
+		PX_ASSERT(edgeId<edgeManager.getCapacity());
+		const Edge& edge=allEdges[edgeId];
+
+		//Check the edge is legal.
+		PX_ASSERT(edge.getIsConnected());
+		PX_ASSERT(!edge.getIsRemoved());
+		PX_ASSERT(edge.getNode1()!=INVALID_NODE || edge.getNode2()!=INVALID_NODE);
+
+		//An edge with a single node doesn't join anything.
+		const NodeType nodeId1=edge.getNode1();
+		const NodeType nodeId2=edge.getNode2();
+		if(INVALID_NODE==nodeId1 || INVALID_NODE==nodeId2)
+			continue;
+
+		//Always link the root with the larger id to the root with the smaller id so that the root of a tree
+		//is its smallest node id.  The trees and their roots are then the same whatever order the edges are linked in.
+		NodeType root1=findGraphRoot(graphParents,nodeId1);
+		NodeType root2=findGraphRoot(graphParents,nodeId2);
+		while(root1!=root2)
+		{
+			const NodeType rootLo=PxMin(root1,root2);
+			const NodeType rootHi=PxMax(root1,root2);
+#if PX_USE_16_BIT_HANDLES
+			graphParents[rootHi]=rootLo;
+			break;
+#else
+			//rootHi might have been linked by another thread since we found it.
+			if(PxI32(rootHi)==Ps::atomicCompareExchange((volatile PxI32*)&graphParents[rootHi],PxI32(rootLo),PxI32(rootHi)))
+				break;
+			root1=findGraphRoot(graphParents,rootHi);
+			root2=findGraphRoot(graphParents,rootLo);
+#endif
+		}
+	}
+}
+
+/**
+\brief Create one island for each tree built by linkBrokenEdgeIslandNodes and add the gathered nodes and edges to their islands.
+Islands are created in the order their first node was gathered so the result doesn't depend on how the edges were linked.
+\param[in] nodeManager is a managed collection of nodes.
+\param[in] edgeManager is a managed collection of edges.
+\param[in] islands is a managed collection of islands.
+\param[in] workBuffers stores the nodes and edges gathered by gatherBrokenEdgeIslands.
+\param[in,out] affectedIslandsBitmap is a bitmap of islands that have changed during the update.  All created
+islands are added to the bitmap.
+*/
+static void rebuildBrokenEdgeIslands
+(NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands,
+ IslandManagerUpdateWorkBuffers& workBuffers,
+ Cm::BitMap& affectedIslandsBitmap)
+{
+	Node* PX_RESTRICT allNodes=nodeManager.getAll();
+	const PxU32 allNodesCapacity=nodeManager.getCapacity();
+	const Edge* PX_RESTRICT allEdges=edgeManager.getAll();
+	const PxU32 allEdgesCapacity=edgeManager.getCapacity();
+	NodeType* PX_RESTRICT nextNodeIds=nodeManager.getNextNodeIds();
+	EdgeType* PX_RESTRICT nextEdgeIds=edgeManager.getNextEdgeIds();
+	NodeType* PX_RESTRICT graphParents=workBuffers.mGraphNextNodes;
+	IslandType* PX_RESTRICT graphRootIslands=workBuffers.mGraphStartIslands;
+	const NodeType* PX_RESTRICT graphNodes=workBuffers.mGraphNodes;
+	const EdgeType* PX_RESTRICT graphEdges=workBuffers.mGraphEdges;
+
+	//Add all the nodes to the island of their root.
+	const PxU32 numGraphNodes=workBuffers.mNumGraphNodes;
+	for(PxU32 i=0;i<numGraphNodes;i++)
+	{
+		const NodeType nodeId=graphNodes[i];
+		const NodeType rootId=findGraphRoot(graphParents,nodeId);
+		IslandType islandId=graphRootIslands[rootId];
+		if(INVALID_ISLAND==islandId)
+		{
+			islandId=getNewIsland(islands);
+			graphRootIslands[rootId]=islandId;
+			affectedIslandsBitmap.set(islandId);
+		}
+		addNodeToIsland(islandId,nodeId,allNodes,nextNodeIds,allNodesCapacity,islands);
+	}
+
+	//Now add all the edges to the islands.
+	const PxU32 numGraphEdges=workBuffers.mNumGraphEdges;
+	for(PxU32 i=0;i<numGraphEdges;i++)
+	{
+		const EdgeType edgeId=graphEdges[i];
+		PX_ASSERT(edgeId<allEdgesCapacity);
+		const Edge& edge=allEdges[edgeId];
+
+		const NodeType nodeId1=edge.getNode1();
+		const NodeType nodeId2=edge.getNode2();
+		PX_ASSERT(INVALID_NODE!=nodeId1 || INVALID_NODE!=nodeId2);
+		const NodeType nodeId=(INVALID_NODE!=nodeId1 ? nodeId1 : nodeId2);
+		PX_ASSERT(nodeId<allNodesCapacity);
+		const IslandType islandId=allNodes[nodeId].getIslandId();
+		PX_ASSERT(INVALID_ISLAND!=islandId);
+		PX_ASSERT(INVALID_NODE==nodeId1 || INVALID_NODE==nodeId2 || allNodes[nodeId1].getIslandId()==allNodes[nodeId2].getIslandId());
+		addEdgeToIsland(islandId,edgeId,nextEdgeIds,allEdgesCapacity,islands);
+	}
+}
+
+#endif //__SPU__
+
 /**
 \brief All edges that are marked as deleted are prepared for re-use.
 \param[in] deletedEdges is an array of ids of all deleted edges.
@@ -2390,18 +2597,15 @@ bool verifyKinaticNodeBitmap(const Cm::BitMap& kinematicBitmap, const NodeManage
 #define ISLANDGEN_PROFILE 0
 #endif
 
-void physx::updateIslandsMain
-(const PxU32 rigidBodyOffset,
- const NodeType* PX_RESTRICT deletedNodes, const PxU32 numDeletedNodes,
+void physx::updateIslandsMainBegin
+(const NodeType* PX_RESTRICT deletedNodes, const PxU32 numDeletedNodes,
  const NodeType* PX_RESTRICT createdNodes, const PxU32 numCreatedNodes,
  const EdgeType* PX_RESTRICT deletedEdges, const PxU32 numDeletedEdges,
- const EdgeType* PX_RESTRICT /*createdEdges*/, const PxU32 /*numCreatedEdges*/,
  const EdgeType* PX_RESTRICT brokenEdges, const PxU32 numBrokenEdges,
  const EdgeType* PX_RESTRICT joinedEdges, const PxU32 numJoinedEdges,
  const Cm::BitMap& kinematicNodesBitmap, const Cm::BitMap& kinematicChangeNodesBitmap, const PxU32 numKinematics,
  const Cm::BitMap& notReadyForSleepingNodesBitmap, const Cm::BitMap& notReadyForSleepingChangeNodesBitmap,
- NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands, ArticulationRootManager& articulationRootManager,
- ProcessSleepingIslandsComputeData& psicData,
+ NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands,
  IslandManagerUpdateWorkBuffers& workBuffers,
  Cm::EventProfiler* profiler)
 {
@@ -2677,12 +2881,15 @@ void physx::updateIslandsMain
 	//*********************************************************************************
 	//(g)  All islands in brokenEdgeIslandsBitmap are recomputed from their edge lists.
 	//All islands generated by this process is recorded in processIslandsBitmap.
+	//Away from spu the nodes and edges of the islands are gathered here, joined with
+	//linkBrokenEdgeIslandNodes and put into their new islands in updateIslandsMainEnd.
 	//*********************************************************************************
 	{
 #if ISLANDGEN_PROFILE
 		CM_PROFILE_START(profiler, Cm::ProfileEventId::IslandGen::GetbrokenEdgeIslands());
 #endif
 
+#ifdef __SPU__
 		//Acceleration data.
 		NodeType* graphNextNodes=workBuffers.mGraphNextNodes;
 		IslandType* graphStartIslands=workBuffers.mGraphStartIslands;
@@ -2693,11 +2900,53 @@ void physx::updateIslandsMain
 			nodeManager,edgeManager,islands,
 			graphNextNodes,graphStartIslands,graphNextIslands,
 			processIslandsBitmap);
+#else
+		gatherBrokenEdgeIslands(
+			brokenEdgeIslandsBitmap,
+			nodeManager,edgeManager,islands,
+			workBuffers,
+			processIslandsBitmap);
+#endif
 
 #if ISLANDGEN_PROFILE
 		CM_PROFILE_STOP(profiler, Cm::ProfileEventId::IslandGen::GetbrokenEdgeIslands());
 #endif
 	}
+}
+
+void physx::updateIslandsMainEnd
+(const PxU32 rigidBodyOffset,
+ NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands, ArticulationRootManager& articulationRootManager,
+ ProcessSleepingIslandsComputeData& psicData,
+ IslandManagerUpdateWorkBuffers& workBuffers,
+ Cm::EventProfiler* profiler)
+{
+#if PX_IS_SPU || !(defined(PX_CHECKED) || defined(PX_PROFILE) || defined(PX_DEBUG))
+	PX_UNUSED(profiler);
+#endif
+
+	Cm::BitMap& processIslandsBitmap = *workBuffers.mBitmap[IslandManagerUpdateWorkBuffers::ePROCESS_ISLANDS];
+	const Cm::BitMap& nodeStateChangeBitmap = *workBuffers.mBitmap[IslandManagerUpdateWorkBuffers::eCHANGED_NODES];
+
+#ifndef __SPU__
+	//*********************************************************************************
+	//(g)  Create the islands of the nodes joined by linkBrokenEdgeIslandNodes.
+	//*********************************************************************************
+	{
+#if ISLANDGEN_PROFILE
+		CM_PROFILE_START(profiler, Cm::ProfileEventId::IslandGen::GetbrokenEdgeIslands());
+#endif
+
+		rebuildBrokenEdgeIslands(
+			nodeManager,edgeManager,islands,
+			workBuffers,
+			processIslandsBitmap);
+
+#if ISLANDGEN_PROFILE
+		CM_PROFILE_STOP(profiler, Cm::ProfileEventId::IslandGen::GetbrokenEdgeIslands());
+#endif
+	}
+#endif
 
 	//*********************************************************************************
 	//Stage (h) - The list of islands to parse in processSleepingIslands is recomputed 
@@ -2731,6 +2980,45 @@ void physx::updateIslandsMain
 	}
 }
 
+void physx::updateIslandsMain
+(const PxU32 rigidBodyOffset,
+ const NodeType* PX_RESTRICT deletedNodes, const PxU32 numDeletedNodes,
+ const NodeType* PX_RESTRICT createdNodes, const PxU32 numCreatedNodes,
+ const EdgeType* PX_RESTRICT deletedEdges, const PxU32 numDeletedEdges,
+ const EdgeType* PX_RESTRICT /*createdEdges*/, const PxU32 /*numCreatedEdges*/,
+ const EdgeType* PX_RESTRICT brokenEdges, const PxU32 numBrokenEdges,
+ const EdgeType* PX_RESTRICT joinedEdges, const PxU32 numJoinedEdges,
+ const Cm::BitMap& kinematicNodesBitmap, const Cm::BitMap& kinematicChangeNodesBitmap, const PxU32 numKinematics,
+ const Cm::BitMap& notReadyForSleepingNodesBitmap, const Cm::BitMap& notReadyForSleepingChangeNodesBitmap,
+ NodeManager& nodeManager, EdgeManager& edgeManager, IslandManager& islands, ArticulationRootManager& articulationRootManager,
+ ProcessSleepingIslandsComputeData& psicData,
+ IslandManagerUpdateWorkBuffers& workBuffers,
+ Cm::EventProfiler* profiler)
+{
+	updateIslandsMainBegin(
+		deletedNodes, numDeletedNodes,
+		createdNodes, numCreatedNodes,
+		deletedEdges, numDeletedEdges,
+		brokenEdges, numBrokenEdges,
+		joinedEdges, numJoinedEdges,
+		kinematicNodesBitmap, kinematicChangeNodesBitmap, numKinematics,
+		notReadyForSleepingNodesBitmap, notReadyForSleepingChangeNodesBitmap,
+		nodeManager, edgeManager, islands,
+		workBuffers,
+		profiler);
+
+#ifndef __SPU__
+	linkBrokenEdgeIslandNodes(edgeManager, workBuffers, 0, workBuffers.mNumGraphEdges);
+#endif
+
+	updateIslandsMainEnd(
+		rigidBodyOffset,
+		nodeManager, edgeManager, islands, articulationRootManager,
+		psicData,
+		workBuffers,
+		profiler);
+}
+
 void physx::updateIslandsSecondPassMain
 (const PxU32 rigidBodyOffset, Cm::BitMap& processIslandsBitmap,
  const EdgeType* PX_RESTRICT brokenEdges, const PxU32 numBrokenEdges,
@@ -2775,6 +3063,7 @@ void physx::updateIslandsSecondPassMain
 		CM_PROFILE_START(profiler, Cm::ProfileEventId::IslandGen::GetbrokenEdgeIslands());
 #endif
 
+#ifdef __SPU__
 		NodeType* graphNextNodes=workBuffers.mGraphNextNodes;
 		IslandType* graphStartIslands=workBuffers.mGraphStartIslands;
 		IslandType* graphNextIslands=workBuffers.mGraphNextIslands;
@@ -2784,6 +3073,20 @@ void physx::updateIslandsSecondPassMain
 			nodeManager,edgeManager,islands,
 			graphNextNodes,graphStartIslands,graphNextIslands,
 			processIslandsBitmap);
+#else
+		gatherBrokenEdgeIslands(
+			brokenEdgeIslandsBitmap,
+			nodeManager,edgeManager,islands,
+			workBuffers,
+			processIslandsBitmap);
+
+		linkBrokenEdgeIslandNodes(edgeManager, workBuffers, 0, workBuffers.mNumGraphEdges);
+
+		rebuildBrokenEdgeIslands(
+			nodeManager,edgeManager,islands,
+			workBuffers,
+			processIslandsBitmap);
+#endif
 
 #if ISLANDGEN_PROFILE
 		CM_PROFILE_STOP(profiler, Cm::ProfileEventId::IslandGen::GetbrokenEdgeIslands());
@@ -166,7 +166,7 @@ void MBPUpdateWorkTask::runInternal()
 #endif
 #endif
 
-		mMBP->updatePPU(getContinuation());
+		mMBP->updatePPU(mNumCpuTasks, getContinuation());
 
 
 #ifdef PX_PROFILE
@@ -184,6 +184,11 @@ void MBPUpdateWorkTask::runInternal()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void MBPRegionWorkTask::runInternal()
+{
+	mMBP->updateRegionPPU(mRegionIndex);
+}
+
 void MBPPostUpdateWorkTask::runInternal()
 {
 #ifdef PX_PROFILE
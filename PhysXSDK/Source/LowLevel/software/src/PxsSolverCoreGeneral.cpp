@@ -637,6 +637,59 @@ void PxsSolverCoreGeneral::solveVCoulomb_Blocks
 	outThresholdPairs = (PxU32)cache.mThresholdStreamIndex;
 }
 
+//Solves the chunks claimed by this thread until the global chunk index reaches endChunk. Chunks are numbered pass by pass, each chunk only waits
+//for the chunks it shares bodies with instead of for the whole previous partition. Returns the number of batch headers solved.
+static PxI32 solveChunksParallel(const PxsSolverChunkGraph& chunkGraph, PxI32& chunkIndex, PxI32* pChunkIndex, const PxI32 endChunk, 
+								 const PxI32 positionIterations, const PxI32 numPasses, PxcSolverConstraintDesc* PX_RESTRICT constraintList, const PxI32 batchCount,
+								 PxcSolverContext& cache, PxsBatchIterator& iterator, PxcThresholdStreamElement* PX_RESTRICT thresholdStream, 
+								 const PxU32 thresholdStreamLength, PxI32* outThresholdPairs)
+{
+	const PxI32 numChunks = (PxI32)chunkGraph.numChunks;
+	PxI32 nbSolved = 0;
+	while(chunkIndex < endChunk)
+	{
+		const PxI32 pass = chunkIndex / numChunks;
+		const PxU32 chunk = PxU32(chunkIndex - pass * numChunks);
+
+		//Chunks before this one have to be done with this pass, the others with the previous pass
+		for(PxU32 a = chunkGraph.dependencyStarts[chunk]; a < chunkGraph.dependencyStarts[chunk+1]; ++a)
+		{
+			const PxU32 dependency = chunkGraph.dependencies[a];
+			PxI32* progress = chunkGraph.progress + dependency * PxsSolverChunkGraph::ePROGRESS_STRIDE;
+			const PxI32 requiredProgress = dependency < chunk ? pass + 1 : pass;
+			WAIT_FOR_PROGRESS_NO_TIMER(progress, requiredProgress);
+		}
+
+		const PxI32 startHeader = (PxI32)chunkGraph.chunkStarts[chunk];
+		const PxI32 numHeaders = (PxI32)chunkGraph.chunkStarts[chunk+1] - startHeader;
+		if(pass < positionIterations)
+		{
+			cache.doFriction = (positionIterations - pass) <= 3;
+			SolveBlockParallel<false>(constraintList, numHeaders, startHeader + pass * batchCount, batchCount, cache, iterator, 
+				pass == positionIterations - 1 ? gVTableSolveConcludeBlock : gVTableSolveBlock, pass, 0, pass);
+		}
+		else if(pass < numPasses - 1)
+		{
+			cache.doFriction = true;
+			SolveBlockParallel<false>(constraintList, numHeaders, startHeader + pass * batchCount, batchCount, cache, iterator, 
+				gVTableSolveBlock, pass, 0, pass);
+		}
+		else
+		{
+			cache.doFriction = true;
+			cache.writeBackIteration = true;
+			SolveWriteBackBlockParallel<false>(constraintList, numHeaders, startHeader + pass * batchCount, batchCount, cache, 
+				thresholdStream, thresholdStreamLength, outThresholdPairs, iterator, pass, 0, pass, gVTableSolveWriteBackBlock);
+		}
+
+		Ps::memoryBarrier();
+		chunkGraph.progress[chunk * PxsSolverChunkGraph::ePROGRESS_STRIDE] = pass + 1;
+		nbSolved += numHeaders;
+		chunkIndex = physx::shdfnd::atomicAdd(pChunkIndex, 1) - 1;
+	}
+	return nbSolved;
+}
+
 void PxsSolverCoreGeneral::solveVParallelAndWriteBack
 (const PxReal /*dt*/, const PxU32 _positionIterations, const PxU32 _velocityIterations, 
  PxcSolverBody* PX_RESTRICT atomListStart, PxcSolverBodyData* PX_RESTRICT atomDataList, const PxU32 /*solverBodyOffset*/, const PxU32 _atomListSize,
@@ -646,7 +699,7 @@ void PxsSolverCoreGeneral::solveVParallelAndWriteBack
  PxcThresholdStreamElement* PX_RESTRICT thresholdStream, const PxU32 thresholdStreamLength, PxI32* outThresholdPairs,
  const Ps::Array<PxsConstraintBatchHeader>& contactConstraintBatches, const Ps::Array<PxsConstraintBatchHeader>& /*frictionConstraintBatches*/,
  const Ps::Array<PxU32>& headersPerPartition, Cm::SpatialVector* PX_RESTRICT motionVelocityArray, PxI32& _normalIterations,
- const PxU32 batchSize) const
+ const PxU32 batchSize, const PxsSolverChunkGraph* chunkGraph) const
 {
 #if PX_PROFILE_SOLVE_STALLS
 	PxU64 startTime = readTimer();
@@ -679,8 +732,9 @@ void PxsSolverCoreGeneral::solveVParallelAndWriteBack
 	PX_ASSERT(velocityIterations >= 1);
 	PX_ASSERT(positionIterations >= 1);
 
+	//In chunk mode, pConstraintIndex hands out single chunks instead of batchSize headers
 	PxI32 endIndexCount = UnrollCount;
-	PxI32 index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+	PxI32 index = chunkGraph ? physx::shdfnd::atomicAdd(pConstraintIndex, 1) - 1 : physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
 	
 	PxsBatchIterator contactIter(contactConstraintBatches);
 
@@ -690,42 +744,57 @@ void PxsSolverCoreGeneral::solveVParallelAndWriteBack
 	PxI32 frictionIteration = 0;
 	PxU32 a = 0;
 	PxI32 targetConstraintIndex = 0;
-	for(PxU32 i = 0; i < 2; ++i)
+	if(chunkGraph)
 	{
-		physx::SolveBlockMethod* solveTable = i == 0 ? gVTableSolveBlock : gVTableSolveConcludeBlock;
-		//physx::SolveBlockMethod* solveTable = gVTableSolveBlock;
-		for(; a < positionIterations - 1 + i; ++a)
+		const PxI32 nbSolved = solveChunksParallel(*chunkGraph, index, pConstraintIndex, positionIterations * (PxI32)chunkGraph->numChunks, positionIterations,
+			positionIterations + velocityIterations, contactConstraintList, batchCount, cache, contactIter, thresholdStream, thresholdStreamLength, outThresholdPairs);
+		if(nbSolved)
 		{
-			cache.doFriction = (positionIterations - a) <= 3;
-			for(PxU32 b = 0; b < headersPerPartition.size(); ++b)
+			Ps::memoryBarrier();
+			physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
+		}
+		targetConstraintIndex = batchCount * positionIterations;
+		normalIteration = positionIterations;
+	}
+	else
+	{
+		for(PxU32 i = 0; i < 2; ++i)
+		{
+			physx::SolveBlockMethod* solveTable = i == 0 ? gVTableSolveBlock : gVTableSolveConcludeBlock;
+			//physx::SolveBlockMethod* solveTable = gVTableSolveBlock;
+			for(; a < positionIterations - 1 + i; ++a)
 			{
-				WAIT_FOR_PROGRESS(pConstraintIndex2, targetConstraintIndex);
+				cache.doFriction = (positionIterations - a) <= 3;
+				for(PxU32 b = 0; b < headersPerPartition.size(); ++b)
+				{
+					WAIT_FOR_PROGRESS(pConstraintIndex2, targetConstraintIndex);
 
-				maxNormalIndex += headersPerPartition[b];
+					maxNormalIndex += headersPerPartition[b];
 				
-				PxI32 nbSolved = 0;
-				while(index < maxNormalIndex)
-				{
-					const PxI32 remainder = PxMin(maxNormalIndex - index, endIndexCount);
-					SolveBlockParallel<false>(contactConstraintList, remainder, index, batchCount, cache, contactIter, solveTable, 
-						normalIteration, frictionIteration, normalIteration);
-					index += remainder;
-					endIndexCount -= remainder;
-					nbSolved += remainder;
-					if(endIndexCount == 0)
+					PxI32 nbSolved = 0;
+					while(index < maxNormalIndex)
 					{
-						endIndexCount = UnrollCount;
-						index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+						const PxI32 remainder = PxMin(maxNormalIndex - index, endIndexCount);
+						SolveBlockParallel<false>(contactConstraintList, remainder, index, batchCount, cache, contactIter, solveTable, 
+							normalIteration, frictionIteration, normalIteration);
+						index += remainder;
+						endIndexCount -= remainder;
+						nbSolved += remainder;
+						if(endIndexCount == 0)
+						{
+							endIndexCount = UnrollCount;
+							index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+						}
 					}
+					if(nbSolved)
+					{
+						Ps::memoryBarrier();
+						physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
+					}
+					targetConstraintIndex += headersPerPartition[b]; //Increment target constraint index by batch count
 				}
-				if(nbSolved)
-				{
-					Ps::memoryBarrier();
-					physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
-				}
-				targetConstraintIndex += headersPerPartition[b]; //Increment target constraint index by batch count
+				++normalIteration;
 			}
-			++normalIteration;
 		}
 	}
 
@@ -793,88 +862,103 @@ void PxsSolverCoreGeneral::solveVParallelAndWriteBack
 
 	WAIT_FOR_PROGRESS(pAtomListIndex2, (atomListSize + articulationListSize));
 
-	a = 1;
-	for(; a < _velocityIterations; ++a)
+	if(chunkGraph)
 	{
-		for(PxU32 b = 0; b < headersPerPartition.size(); ++b)
+		const PxI32 nbSolved = solveChunksParallel(*chunkGraph, index, pConstraintIndex, (positionIterations + velocityIterations) * (PxI32)chunkGraph->numChunks, 
+			positionIterations, positionIterations + velocityIterations, contactConstraintList, batchCount, cache, contactIter, thresholdStream, 
+			thresholdStreamLength, outThresholdPairs);
+		if(nbSolved)
 		{
-			WAIT_FOR_PROGRESS(pConstraintIndex2, targetConstraintIndex);
+			Ps::memoryBarrier();
+			physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
+		}
+		normalIteration += velocityIterations;
+	}
+	else
+	{
+		a = 1;
+		for(; a < _velocityIterations; ++a)
+		{
+			for(PxU32 b = 0; b < headersPerPartition.size(); ++b)
+			{
+				WAIT_FOR_PROGRESS(pConstraintIndex2, targetConstraintIndex);
 
-			maxNormalIndex += headersPerPartition[b];
+				maxNormalIndex += headersPerPartition[b];
 			
-			PxI32 nbSolved = 0;
-			while(index < maxNormalIndex)
-			{
-				const PxI32 remainder = PxMin(maxNormalIndex - index, endIndexCount);
-				SolveBlockParallel<false>(contactConstraintList, remainder, index, batchCount, cache, contactIter, gVTableSolveBlock, 
-					normalIteration, 0, normalIteration);
-				index += remainder;
-				endIndexCount -= remainder;
-				nbSolved += remainder;
-				if(endIndexCount == 0)
+				PxI32 nbSolved = 0;
+				while(index < maxNormalIndex)
 				{
-					endIndexCount = UnrollCount;
-					index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+					const PxI32 remainder = PxMin(maxNormalIndex - index, endIndexCount);
+					SolveBlockParallel<false>(contactConstraintList, remainder, index, batchCount, cache, contactIter, gVTableSolveBlock, 
+						normalIteration, 0, normalIteration);
+					index += remainder;
+					endIndexCount -= remainder;
+					nbSolved += remainder;
+					if(endIndexCount == 0)
+					{
+						endIndexCount = UnrollCount;
+						index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+					}
 				}
+				if(nbSolved)
+				{
+					Ps::memoryBarrier();
+					physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
+				}
+				targetConstraintIndex += headersPerPartition[b]; //Increment target constraint index by batch count
 			}
-			if(nbSolved)
-			{
-				Ps::memoryBarrier();
-				physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
-			}
-			targetConstraintIndex += headersPerPartition[b]; //Increment target constraint index by batch count
+			++normalIteration;
 		}
-		++normalIteration;
-	}
 
-	//Last iteration - do writeback as well!
-	//for(; a < velocityIterations; ++a)
-	cache.writeBackIteration = true;
-	{
-		for(PxU32 b = 0; b < headersPerPartition.size(); ++b)
+		//Last iteration - do writeback as well!
+		//for(; a < velocityIterations; ++a)
+		cache.writeBackIteration = true;
 		{
-			WAIT_FOR_PROGRESS(pConstraintIndex2, targetConstraintIndex);
+			for(PxU32 b = 0; b < headersPerPartition.size(); ++b)
+			{
+				WAIT_FOR_PROGRESS(pConstraintIndex2, targetConstraintIndex);
 
-			maxNormalIndex += headersPerPartition[b];
+				maxNormalIndex += headersPerPartition[b];
 			
-			PxI32 nbSolved = 0;
-			while(index < maxNormalIndex)
-			{
-				const PxI32 remainder = PxMin(maxNormalIndex - index, endIndexCount);
-				SolveWriteBackBlockParallel<false>(contactConstraintList, remainder, index, 
-					batchCount, cache, thresholdStream, thresholdStreamLength, outThresholdPairs, 
-					contactIter, normalIteration, 0, normalIteration, gVTableSolveWriteBackBlock);
+				PxI32 nbSolved = 0;
+				while(index < maxNormalIndex)
+				{
+					const PxI32 remainder = PxMin(maxNormalIndex - index, endIndexCount);
+					SolveWriteBackBlockParallel<false>(contactConstraintList, remainder, index, 
+						batchCount, cache, thresholdStream, thresholdStreamLength, outThresholdPairs, 
+						contactIter, normalIteration, 0, normalIteration, gVTableSolveWriteBackBlock);
 
-				index += remainder;
-				endIndexCount -= remainder;
-				nbSolved += remainder;
-				if(endIndexCount == 0)
+					index += remainder;
+					endIndexCount -= remainder;
+					nbSolved += remainder;
+					if(endIndexCount == 0)
+					{
+						endIndexCount = UnrollCount;
+						index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+					}
+				}
+				if(nbSolved)
 				{
-					endIndexCount = UnrollCount;
-					index = physx::shdfnd::atomicAdd(pConstraintIndex, UnrollCount) - UnrollCount;
+					Ps::memoryBarrier();
+					physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
 				}
+				targetConstraintIndex += headersPerPartition[b]; //Increment target constraint index by batch count
 			}
-			if(nbSolved)
-			{
-				Ps::memoryBarrier();
-				physx::shdfnd::atomicAdd(pConstraintIndex2, nbSolved);
-			}
-			targetConstraintIndex += headersPerPartition[b]; //Increment target constraint index by batch count
+
+			++normalIteration;
+
 		}
+	}
 
-		if(cache.mThresholdStreamIndex > 0)
+	if(cache.mThresholdStreamIndex > 0)
+	{
+		//Write back to global buffer
+		PxI32 threshIndex = physx::shdfnd::atomicAdd(outThresholdPairs, (PxI32)cache.mThresholdStreamIndex) - (PxI32)cache.mThresholdStreamIndex;
+		for(PxU32 b = 0; b < cache.mThresholdStreamIndex; ++b)
 		{
-			//Write back to global buffer
-			PxI32 threshIndex = physx::shdfnd::atomicAdd(outThresholdPairs, (PxI32)cache.mThresholdStreamIndex) - (PxI32)cache.mThresholdStreamIndex;
-			for(PxU32 b = 0; b < cache.mThresholdStreamIndex; ++b)
-			{
-				thresholdStream[b + threshIndex] = cache.mThresholdStream[b];
-			}
-			cache.mThresholdStreamIndex = 0;
+			thresholdStream[b + threshIndex] = cache.mThresholdStream[b];
 		}
-
-		++normalIteration;
-
+		cache.mThresholdStreamIndex = 0;
 	}
 	_normalIterations = normalIteration;
 
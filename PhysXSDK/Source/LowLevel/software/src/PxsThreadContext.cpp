@@ -30,6 +30,11 @@ PxsThreadContext::PxsThreadContext(PxsContext* context):
 	mConstraintsPerPartition(PX_DEBUG_EXP("PxsThreadContext::mConstraintsPerPartition")),
 	mFrictionConstraintsPerPartition(PX_DEBUG_EXP("PxsThreadContext::frictionsConstraintsPerPartition")),
 	mPartitionNormalizationBitmap(PX_DEBUG_EXP("PxsThreadContext::mPartitionNormalizationBitmap")),
+	mSolverChunkStarts(PX_DEBUG_EXP("PxsThreadContext::mSolverChunkStarts")),
+	mSolverChunkDependencyStarts(PX_DEBUG_EXP("PxsThreadContext::mSolverChunkDependencyStarts")),
+	mSolverChunkDependencies(PX_DEBUG_EXP("PxsThreadContext::mSolverChunkDependencies")),
+	mSolverChunkProgress(PX_DEBUG_EXP("PxsThreadContext::mSolverChunkProgress")),
+	mSolverChunkScratch(PX_DEBUG_EXP("PxsThreadContext::mSolverChunkScratch")),
 	bodyCoreArray(PX_DEBUG_EXP("PxsThreadContext::bodyCoreArray")),
 	accelerationArray(PX_DEBUG_EXP("PxsThreadContext::accelerationArray")),
 	motionVelocityArray(PX_DEBUG_EXP("PxsThreadContext::motionVelocityArray")),
@@ -19,6 +19,8 @@
 #include "PsAtomic.h"
 #include "PsFoundation.h"
 #include "PsUtilities.h"
+#include "PxMemory.h"
+#include "CmTask.h"
 #include "NpScene.h"
 
 using namespace physx;
@@ -204,6 +206,52 @@ void writeStatus(ResultType* aRes, const PxHitBuffer<HitType>& hits, void* userD
 	}
 }
 
+#if !PX_IS_SPU
+// Raycasts without touch buffer or cache are queued and run in packets of up to SQ_RAY_PACKET_SIZE rays,
+// so that the static pruner can process a whole packet in a single traversal (see NpSceneQueries::multiRaycastPacket).
+// These raycasts never write to the touch buffer, so running them later does not change the results of other queries.
+struct RaycastPacket
+{
+	RaycastPacketQuery		queries[SQ_RAY_PACKET_SIZE];
+	PxRaycastBuffer			hits[SQ_RAY_PACKET_SIZE];
+	PxRaycastQueryResult*	results[SQ_RAY_PACKET_SIZE];
+	void*					userData[SQ_RAY_PACKET_SIZE];
+	PxU32					size;
+
+	RaycastPacket() : size(0) {}
+
+	// queues the raycast if it can be part of a packet, and runs the packet once it is full
+	bool add(const NpSceneQueries& scene, const MultiQueryInput& input, const BatchStreamHeader& h, PxRaycastQueryResult*& result, BatchQueryFilterData& bfd)
+	{
+		if (h.maxTouchHits || h.cache)
+			return false;
+
+		PX_ASSERT(size < SQ_RAY_PACKET_SIZE);
+		RaycastPacketQuery& q = queries[size];
+		q.input = &input;
+		q.hits = &hits[size];
+		q.hitFlags = h.hitFlags;
+		q.filterData = &h.fd;
+		results[size] = result++;
+		userData[size] = h.userData;
+		if (++size == SQ_RAY_PACKET_SIZE)
+			flush(scene, bfd);
+		return true;
+	}
+
+	void flush(const NpSceneQueries& scene, BatchQueryFilterData& bfd)
+	{
+		if(!size)
+			return;
+
+		scene.multiRaycastPacket(queries, size, &bfd);
+		for(PxU32 i=0;i<size;i++)
+			writeStatus<PxRaycastQueryResult, PxRaycastHit>(results[i], hits[i], userData[i], false);
+		size = 0;
+	}
+};
+#endif
+
 void NpBatchQuery::resetResultBuffers()
 {
 	for (PxU32 i = 0; i<mNbRaycasts; i++)
@@ -291,8 +339,50 @@ struct PxOverflowBuffer : PxHitBuffer<HitType>
 	}
 };
 
+namespace physx
+{
+// current positions in the user result and touch buffers while executing the query stream
+struct BatchQueryOutput
+{
+	PxRaycastHit*			raycastHits;
+	PxRaycastHit*			raycastHitsEnd;
+	PxRaycastQueryResult*	raycastResults;
+	PxOverlapHit*			overlapHits;
+	PxOverlapHit*			overlapHitsEnd;
+	PxOverlapQueryResult*	overlapResults;
+	PxSweepHit*				sweepHits;
+	PxSweepHit*				sweepHitsEnd;
+	PxSweepQueryResult*		sweepResults;
+};
+} // namespace physx
+
+template<typename ResultType, typename HitType>
+static PX_FORCE_INLINE void runQuery(
+	NpScene* scene, const BatchStreamHeader& h, const MultiQueryInput& input, BatchQueryFilterData& bfd,
+	HitType*& touches, HitType* touchesEnd, ResultType*& results)
+{
+	PX_ASSERT(touches <= touchesEnd);
+	const PxU32 hitsSpaceLeft = PxU32(touchesEnd - touches);
+	PxOverflowBuffer<HitType> hits(touches, PxMin<PxU32>(h.maxTouchHits, hitsSpaceLeft));
+	scene->NpScene::multiQuery<HitType>(input, hits, h.hitFlags, h.cache, h.fd, NULL, &bfd);
+	hits.overflow |= (hitsSpaceLeft == 0 && h.maxTouchHits > 0); // report overflow if 0 space left and maxTouchHits>0
+	writeStatus<ResultType, HitType>(results++, hits, h.userData, hits.overflow);
+	touches += hits.nbTouches;
+}
+
 void NpBatchQuery::execute()
 {
+	executeInternal(1);
+}
+
+void NpBatchQuery::executeParallel(PxU32 maxNbTasks)
+{
+	executeInternal(maxNbTasks);
+}
+
+void NpBatchQuery::executeInternal(PxU32 maxNbTasks)
+{
+	PX_UNUSED(maxNbTasks);
 	NP_READ_CHECK(mNpScene);
 
 	if(mNbRaycasts)
@@ -372,20 +462,28 @@ void NpBatchQuery::execute()
 	// else fall through to PPU. could be because of eNONE pruning structure
 	// also so that a shared breakpoint can be set in PS3 debugger
 
+#if !PX_IS_SPU
+	// PVD records the queries in execution order, so they have to run serially when it is connected
+	if (maxNbTasks != 1 && !isSqCollectorLocked && mPrevOffset != eTERMINAL && executeTasks(maxNbTasks))
+	{
+		finalizeExecute();
+		return;
+	}
+#endif
+
 	PxClientID clientId = mDesc.ownerClient;
 
 	// setup local pointers to user provided output buffers
-	PxRaycastHit* raycastHits = mDesc.queryMemory.userRaycastTouchBuffer;					PX_UNUSED(raycastHits);
-	PxRaycastQueryResult* raycastResults = mDesc.queryMemory.userRaycastResultBuffer;		PX_UNUSED(raycastResults);
-	PxU32 raycastHitsSize = mDesc.queryMemory.raycastTouchBufferSize;						PX_UNUSED(raycastHitsSize);
-
-	PxOverlapHit* overlapHits = mDesc.queryMemory.userOverlapTouchBuffer;					PX_UNUSED(overlapHits);
-	PxOverlapQueryResult* overlapResults = mDesc.queryMemory.userOverlapResultBuffer;		PX_UNUSED(overlapResults);
-	PxU32 overlapHitsSize = mDesc.queryMemory.overlapTouchBufferSize;						PX_UNUSED(overlapHitsSize);
-
-	PxSweepHit* sweepHits = mDesc.queryMemory.userSweepTouchBuffer;							PX_UNUSED(sweepHits);
-	PxSweepQueryResult* sweepResults = mDesc.queryMemory.userSweepResultBuffer;				PX_UNUSED(sweepResults);
-	PxU32 sweepHitsSize = mDesc.queryMemory.sweepTouchBufferSize;							PX_UNUSED(sweepHitsSize);
+	BatchQueryOutput output;
+	output.raycastHits = mDesc.queryMemory.userRaycastTouchBuffer;
+	output.raycastHitsEnd = output.raycastHits + mDesc.queryMemory.raycastTouchBufferSize;
+	output.raycastResults = mDesc.queryMemory.userRaycastResultBuffer;
+	output.overlapHits = mDesc.queryMemory.userOverlapTouchBuffer;
+	output.overlapHitsEnd = output.overlapHits + mDesc.queryMemory.overlapTouchBufferSize;
+	output.overlapResults = mDesc.queryMemory.userOverlapResultBuffer;
+	output.sweepHits = mDesc.queryMemory.userSweepTouchBuffer;
+	output.sweepHitsEnd = output.sweepHits + mDesc.queryMemory.sweepTouchBufferSize;
+	output.sweepResults = mDesc.queryMemory.userSweepResultBuffer;
 
 	BatchQueryFilterData bfd(mDesc.filterShaderData, mDesc.filterShaderDataSize, mDesc.preFilterShader, mDesc.postFilterShader);
 
@@ -405,7 +503,9 @@ void NpBatchQuery::execute()
 	// fetch the first buffer
 	char* dmaPtr = memFetchAsync<char>(buffers[chanIdx], MemFetchPtr(mStream.begin()+curQueryOffset), bufSize, channels[chanIdx]);
 
-	PxU32 hitsSpaceLeft; PX_UNUSED(hitsSpaceLeft);
+#if !PX_IS_SPU
+	RaycastPacket raycastPacket;
+#endif
 
 	// ====================== parse and execute the batch query memory stream ====================== 
 	PxU32 queryCount = 0;
@@ -433,41 +533,23 @@ void NpBatchQuery::execute()
 			// =============== Current query is a raycast =====================
 			case QTypeROS::eRAYCAST: if ((!PX_IS_SPU | IS_SPU_RAYCAST) && runOnPPU[0])
 			{
-				PxU32 nbRaycastHits = PxU32(raycastHits - mDesc.queryMemory.userRaycastTouchBuffer);
-				PX_ASSERT(nbRaycastHits <= raycastHitsSize);
-				hitsSpaceLeft = raycastHitsSize - nbRaycastHits;
-				PxOverflowBuffer<PxRaycastHit> hits(raycastHits, PxMin<PxU32>(h.maxTouchHits, hitsSpaceLeft));
-				mNpScene->NpScene::multiQuery<PxRaycastHit>(input, hits, h.hitFlags, h.cache, h.fd, NULL, &bfd);
-				hits.overflow |= (hitsSpaceLeft == 0 && h.maxTouchHits > 0); // report overflow if 0 space left and maxTouchHits>0
-				writeStatus<PxRaycastQueryResult, PxRaycastHit>(raycastResults++, hits, h.userData, hits.overflow);
-				raycastHits += hits.nbTouches;
+				#if !PX_IS_SPU
+				if (raycastPacket.add(*mNpScene, input, h, output.raycastResults, bfd))
+					break;
+				#endif
+				runQuery<PxRaycastQueryResult, PxRaycastHit>(mNpScene, h, input, bfd, output.raycastHits, output.raycastHitsEnd, output.raycastResults);
 			} break;
 
 			// ================ Current query is an overlap ====================
 			case QTypeROS::eOVERLAP: if ((!PX_IS_SPU | IS_SPU_OVERLAP) && runOnPPU[1])
 			{
-				PxU32 nbOverlapHits = PxU32(overlapHits - mDesc.queryMemory.userOverlapTouchBuffer);
-				PX_ASSERT(nbOverlapHits <= overlapHitsSize);
-				hitsSpaceLeft = overlapHitsSize - nbOverlapHits;
-				PxOverflowBuffer<PxOverlapHit> hits(overlapHits, PxMin<PxU32>(h.maxTouchHits, hitsSpaceLeft));
-				mNpScene->NpScene::multiQuery<PxOverlapHit>(input, hits, h.hitFlags, h.cache, h.fd, NULL, &bfd);
-				hits.overflow |= (hitsSpaceLeft == 0 && h.maxTouchHits > 0); // report overflow if 0 space left and maxTouchHits>0
-				writeStatus<PxOverlapQueryResult, PxOverlapHit>(overlapResults++, hits, h.userData, hits.overflow);
-				overlapHits += hits.nbTouches;
+				runQuery<PxOverlapQueryResult, PxOverlapHit>(mNpScene, h, input, bfd, output.overlapHits, output.overlapHitsEnd, output.overlapResults);
 			} break;
 
 			// ================== Current query is a sweep =========================
 			case QTypeROS::eSWEEP: if ((!PX_IS_SPU | IS_SPU_SWEEP) && runOnPPU[2])
 			{
-
-				PxU32 nbSweepHits = PxU32(sweepHits - mDesc.queryMemory.userSweepTouchBuffer);
-				PX_ASSERT(nbSweepHits <= sweepHitsSize);
-				hitsSpaceLeft = sweepHitsSize - nbSweepHits;
-				PxOverflowBuffer<PxSweepHit> hits(sweepHits, PxMin<PxU32>(h.maxTouchHits, hitsSpaceLeft));
-				mNpScene->NpScene::multiQuery<PxSweepHit>(input, hits, h.hitFlags, h.cache, h.fd, NULL, &bfd);
-				hits.overflow |= (hitsSpaceLeft == 0 && h.maxTouchHits > 0); // report overflow if 0 space left and maxTouchHits>0
-				writeStatus<PxSweepQueryResult, PxSweepHit>(sweepResults++, hits, h.userData, hits.overflow);
-				sweepHits += hits.nbTouches;
+				runQuery<PxSweepQueryResult, PxSweepHit>(mNpScene, h, input, bfd, output.sweepHits, output.sweepHitsEnd, output.sweepResults);
 			} break;
 			default:
 				PX_ALWAYS_ASSERT_MESSAGE("Unexpected batch query type (raycast/overlap/sweep).");
@@ -482,6 +564,10 @@ void NpBatchQuery::execute()
 		#undef MULTIQ
 		queryCount++;
 	} while (queryCount < 1000000);
+
+#if !PX_IS_SPU
+	raycastPacket.flush(*mNpScene, bfd);
+#endif
 	//PX_ASSERT(queryCount == mNbRaycasts*IS_SPU_RAYCAST + mNbOverlaps*IS_SPU_OVERLAP + mNbSweeps*IS_SPU_SWEEP);
 
 #if PX_SUPPORT_VISUAL_DEBUGGER
@@ -504,6 +590,187 @@ void NpBatchQuery::execute()
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+#if !PX_IS_SPU
+namespace physx
+{
+class BatchQueryTask : public Cm::Task
+{
+public:
+	BatchQueryTask() : mBatchQuery(NULL), mQueryOffset(0), mNbQueries(0)	{}
+
+	virtual void runInternal()
+	{
+		mBatchQuery->executeRange(mQueryOffset, mNbQueries, mOutput);
+	}
+
+	virtual const char* getName() const { return "NpBatchQuery.execute"; }
+
+	NpBatchQuery*		mBatchQuery;
+	PxU32				mQueryOffset;
+	PxU32				mNbQueries;
+	BatchQueryOutput	mOutput;
+};
+} // namespace physx
+
+class BatchQueryCompletionTask : public Cm::Task
+{
+	PX_NOCOPY(BatchQueryCompletionTask)
+public:
+	BatchQueryCompletionTask(Ps::Sync& sync) : mSync(sync)	{}
+
+	virtual void runInternal()	{}
+	virtual void release()		{ mSync.set(); }
+
+	virtual const char* getName() const { return "NpBatchQuery.executeCompletion"; }
+
+	Ps::Sync&	mSync;
+};
+
+// moves the touches of the results next to each other, in the same place as a serial execute would have written them
+template<typename ResultType, typename HitType>
+static void compactTouches(ResultType* results, PxU32 nbResults, HitType* touches)
+{
+	for (PxU32 i = 0; i < nbResults; i++)
+	{
+		ResultType& res = results[i];
+		if (!res.touches) // overflow without touches
+			continue;
+		if (res.touches != touches)
+			PxMemMove(touches, res.touches, sizeof(HitType)*res.nbTouches);
+		res.touches = touches;
+		touches += res.nbTouches;
+	}
+}
+
+// Each task runs a contiguous range of the query stream and writes to its own ranges of the result and touch buffers.
+// The touch buffer range of a query is reserved for its maxTouchHits. That is only possible if the buffers cannot overflow,
+// and then the touches of a query do not depend on the queries before it, so the results match a serial execute once the
+// touches have been compacted.
+bool NpBatchQuery::executeTasks(PxU32 maxNbTasks)
+{
+	PxTaskManager* taskManager = mNpScene->getTaskManager();
+	PxCpuDispatcher* dispatcher = taskManager ? taskManager->getCpuDispatcher() : NULL;
+	if (!dispatcher)
+		return false;
+
+	const PxU32 minQueriesPerTask = 32;
+	const PxU32 nbQueries = mNbRaycasts + mNbOverlaps + mNbSweeps;
+	if (!maxNbTasks)
+		maxNbTasks = dispatcher->getWorkerCount() + 1;
+	const PxU32 nbTasks = PxMin(maxNbTasks, nbQueries/minQueriesPerTask);
+	if (nbTasks < 2)
+		return false;
+
+	PxU32 nbTouches[3] = { 0, 0, 0 };
+	for (PxU32 offset = 0; offset != eTERMINAL; )
+	{
+		const BatchStreamHeader& h = *reinterpret_cast<const BatchStreamHeader*>(mStream.begin() + offset);
+		nbTouches[PxU32(h.hitTypeId)] += h.maxTouchHits;
+		offset = h.nextQueryOffset;
+	}
+	if (nbTouches[QTypeROS::eRAYCAST] > mDesc.queryMemory.raycastTouchBufferSize ||
+		nbTouches[QTypeROS::eOVERLAP] > mDesc.queryMemory.overlapTouchBufferSize ||
+		nbTouches[QTypeROS::eSWEEP] > mDesc.queryMemory.sweepTouchBufferSize)
+		return false;
+
+	// the tasks must not update the pruners while the others run queries
+	mNpScene->getSceneQueryManagerFast().flushUpdates();
+
+	Ps::Array<BatchQueryTask> tasks;
+	tasks.resize(nbTasks);
+
+	BatchQueryOutput output;
+	output.raycastHits = mDesc.queryMemory.userRaycastTouchBuffer;
+	output.raycastResults = mDesc.queryMemory.userRaycastResultBuffer;
+	output.overlapHits = mDesc.queryMemory.userOverlapTouchBuffer;
+	output.overlapResults = mDesc.queryMemory.userOverlapResultBuffer;
+	output.sweepHits = mDesc.queryMemory.userSweepTouchBuffer;
+	output.sweepResults = mDesc.queryMemory.userSweepResultBuffer;
+
+	PxU32 offset = 0;
+	for (PxU32 i = 0; i < nbTasks; i++)
+	{
+		BatchQueryTask& task = tasks[i];
+		task.mBatchQuery = this;
+		task.mQueryOffset = offset;
+		task.mNbQueries = (nbQueries*(i+1))/nbTasks - (nbQueries*i)/nbTasks;
+		task.mOutput = output;
+
+		// skip over the range to find where the next task starts in each buffer
+		for (PxU32 j = 0; j < task.mNbQueries; j++)
+		{
+			const BatchStreamHeader& h = *reinterpret_cast<const BatchStreamHeader*>(mStream.begin() + offset);
+			switch (h.hitTypeId)
+			{
+				case QTypeROS::eRAYCAST:	output.raycastHits += h.maxTouchHits;	output.raycastResults++;	break;
+				case QTypeROS::eOVERLAP:	output.overlapHits += h.maxTouchHits;	output.overlapResults++;	break;
+				case QTypeROS::eSWEEP:		output.sweepHits += h.maxTouchHits;		output.sweepResults++;		break;
+				default:
+					PX_ALWAYS_ASSERT_MESSAGE("Unexpected batch query type (raycast/overlap/sweep).");
+			}
+			offset = h.nextQueryOffset;
+		}
+		task.mOutput.raycastHitsEnd = output.raycastHits;
+		task.mOutput.overlapHitsEnd = output.overlapHits;
+		task.mOutput.sweepHitsEnd = output.sweepHits;
+	}
+	PX_ASSERT(offset == eTERMINAL);
+
+	// the first range runs on the calling thread while it would otherwise wait
+	Ps::Sync sync;
+	BatchQueryCompletionTask completion(sync);
+	completion.setContinuation(*taskManager, NULL);
+	for (PxU32 i = 1; i < nbTasks; i++)
+		tasks[i].setContinuation(&completion);
+	for (PxU32 i = 1; i < nbTasks; i++)
+		tasks[i].removeReference();
+	completion.removeReference();
+
+	tasks[0].runInternal();
+	sync.wait();
+
+	compactTouches(mDesc.queryMemory.userRaycastResultBuffer, mNbRaycasts, mDesc.queryMemory.userRaycastTouchBuffer);
+	compactTouches(mDesc.queryMemory.userOverlapResultBuffer, mNbOverlaps, mDesc.queryMemory.userOverlapTouchBuffer);
+	compactTouches(mDesc.queryMemory.userSweepResultBuffer, mNbSweeps, mDesc.queryMemory.userSweepTouchBuffer);
+	return true;
+}
+
+void NpBatchQuery::executeRange(PxU32 queryOffset, PxU32 nbQueries, BatchQueryOutput& output)
+{
+	PX_SIMD_GUARD;
+
+	BatchQueryFilterData bfd(mDesc.filterShaderData, mDesc.filterShaderDataSize, mDesc.preFilterShader, mDesc.postFilterShader);
+	bfd.updatesFlushed = true; // executeTasks() flushed before dispatching the ranges
+	RaycastPacket raycastPacket;
+	for (PxU32 i = 0; i < nbQueries; i++)
+	{
+		BatchQueryStreamReader reader(mStream.begin() + queryOffset);
+		BatchStreamHeader& h = *reader.read<BatchStreamHeader>();
+		if (h.fd.clientId == 0)
+			h.fd.clientId = mDesc.ownerClient; // override a zero clientId with PxBatchQueryDesc.ownerClient
+		queryOffset = h.nextQueryOffset;
+
+		MultiQueryInput& input = *readQueryInput(reader);
+		switch (h.hitTypeId)
+		{
+			case QTypeROS::eRAYCAST:
+				if (!raycastPacket.add(*mNpScene, input, h, output.raycastResults, bfd))
+					runQuery<PxRaycastQueryResult, PxRaycastHit>(mNpScene, h, input, bfd, output.raycastHits, output.raycastHitsEnd, output.raycastResults);
+				break;
+			case QTypeROS::eOVERLAP:
+				runQuery<PxOverlapQueryResult, PxOverlapHit>(mNpScene, h, input, bfd, output.overlapHits, output.overlapHitsEnd, output.overlapResults);
+				break;
+			case QTypeROS::eSWEEP:
+				runQuery<PxSweepQueryResult, PxSweepHit>(mNpScene, h, input, bfd, output.sweepHits, output.sweepHitsEnd, output.sweepResults);
+				break;
+			default:
+				PX_ALWAYS_ASSERT_MESSAGE("Unexpected batch query type (raycast/overlap/sweep).");
+		}
+	}
+	raycastPacket.flush(*mNpScene, bfd);
+}
+#endif
+
 void NpBatchQuery::writeBatchHeader(const BatchStreamHeader& h)
 {
 	PxU32 streamPos = (PxU32)mStream.getPos(); // save the stream pos before we write the header
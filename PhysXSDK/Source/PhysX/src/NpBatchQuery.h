@@ -29,6 +29,8 @@ namespace physx
 
 class NpSceneQueryManager;
 struct BatchStreamHeader;
+struct BatchQueryOutput;
+class BatchQueryTask;
 class NpScene;
 
 namespace Sq
@@ -106,6 +108,7 @@ public:
 
 	// PxBatchQuery interface
 	virtual	void							execute();
+	virtual	void							executeParallel(PxU32 maxNbTasks);
 	virtual void							release();
 	virtual	PxBatchQueryPreFilterShader		getPreFilterShader() const;
 	virtual	PxBatchQueryPostFilterShader	getPostFilterShader() const;
@@ -138,6 +141,9 @@ public:
 	// sync object for batch query completion wait
 	shdfnd::Sync							mSync;
 private:
+			void							executeInternal(PxU32 maxNbTasks);
+			bool							executeTasks(PxU32 maxNbTasks); // returns false if the queries have to run serially
+			void							executeRange(PxU32 queryOffset, PxU32 nbQueries, BatchQueryOutput& output);
 			void							resetResultBuffers();
 			void							finalizeExecute(); // shared PPU execute() finalization code; differs on PPU & SPU
 			void							checkForSPUErrors();
@@ -157,6 +163,7 @@ private:
 						bool				mHasMtdSweep;
 
 	friend class physx::Sq::SceneQueryManager;
+	friend class physx::BatchQueryTask;
 };
 
 }
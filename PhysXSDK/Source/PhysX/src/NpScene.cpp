@@ -42,6 +42,7 @@
 
 #include "ScbNpDeps.h"
 #include "CmCollection.h"
+#include "CmTask.h"
 
 #if PX_SUPPORT_GPU_PHYSX
 #include "PxGpuDispatcher.h"
@@ -415,11 +416,9 @@ void NpScene::addActorInternal(PxActor& actor)
 }
 
 
-void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& scbActor, NpShapeManager& shapeManager, bool actorDynamic, PxBounds3* bounds)
+void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& scbActor, NpShapeManager& shapeManager, PxBounds3* bounds, Ps::Array<Sq::ShapeInsertion>& sqShapes)
 {
 	// all the things Scb does in non-buffered insertion
-	Sq::SceneQueryManager& sqManager = getSceneQueryManagerFast();
-
 	scbActor.setScbScene(&getScene());
 	scbActor.setControlState(Scb::ControlState::eIN_SCENE);
 	NpShape*const * shapes = shapeManager.getShapes();
@@ -439,17 +438,22 @@ void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Acto
 
 		if(shapeFlags & PxShapeFlag::eSCENE_QUERY_SHAPE)
 		{
-			Sq::ActorShape* data = sqManager.addShape(*shapes[i], rigidActor, actorDynamic, shapeFlags&(PxShapeFlag::eSIMULATION_SHAPE|PxShapeFlag::eTRIGGER_SHAPE)? bounds+i : NULL);
-			shapeManager.setSceneQueryData(i, data);
+			Sq::ShapeInsertion& sq = sqShapes.insert();
+			sq.shape = shapes[i];
+			sq.actor = &rigidActor;
+			sq.data = shapeManager.getSceneQueryDataLocation(i);
+			sq.hasBounds = (shapeFlags&(PxShapeFlag::eSIMULATION_SHAPE|PxShapeFlag::eTRIGGER_SHAPE)) ? true : false;
+			if(sq.hasBounds)
+				sq.bounds = bounds[i];
 		}
 	}			
 }
 
 
-PX_FORCE_INLINE	void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, bool actorDynamic, PxBounds3* bounds)
+PX_FORCE_INLINE	void NpScene::updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, PxBounds3* bounds, Ps::Array<Sq::ShapeInsertion>& sqShapes)
 {
 	body.initBufferedState();
-	updateScbStateAndSetupSq(rigidActor, static_cast<Scb::Actor&>(body), shapeManager, actorDynamic, bounds);
+	updateScbStateAndSetupSq(rigidActor, static_cast<Scb::Actor&>(body), shapeManager, bounds, sqShapes);
 }
 
 
@@ -480,6 +484,7 @@ void NpScene::addActors(PxActor*const* PX_RESTRICT actors, PxU32 nbActors)
 	scState.shapeOffset				= (ptrdiff_t)NpShapeGetScPtrOffset();
 
 	Ps::InlineArray<PxBounds3, 8> shapeBounds;
+	Ps::Array<Sq::ShapeInsertion> sqShapes[2];	// static, dynamic
 	for(actorsDone=0; actorsDone<nbActors; actorsDone++)
 	{
 		if(actorsDone+1<nbActors)
@@ -509,7 +514,7 @@ void NpScene::addActors(PxActor*const* PX_RESTRICT actors, PxU32 nbActors)
 			{
 				shapeBounds.resizeUninitialized(a.NpRigidStatic::getNbShapes());
 				scScene.addStatic(&a, scState, shapeBounds.begin());
-				updateScbStateAndSetupSq(a, a.getScbActorFast(), a.getShapeManager(), false, shapeBounds.begin());
+				updateScbStateAndSetupSq(a, a.getScbActorFast(), a.getShapeManager(), shapeBounds.begin(), sqShapes[0]);
 				a.setRigidActorArrayIndex(mRigidActorArray.size());
 				mRigidActorArray.pushBack(&a);
 				a.addConstraintsToScene();
@@ -528,7 +533,7 @@ void NpScene::addActors(PxActor*const* PX_RESTRICT actors, PxU32 nbActors)
 			{
 				shapeBounds.resizeUninitialized(a.NpRigidDynamic::getNbShapes());
 				scScene.addBody(&a, scState, shapeBounds.begin());
-				updateScbStateAndSetupSq(a, a.getScbBodyFast(), a.getShapeManager(), true, shapeBounds.begin());
+				updateScbStateAndSetupSq(a, a.getScbBodyFast(), a.getShapeManager(), shapeBounds.begin(), sqShapes[1]);
 				a.setRigidActorArrayIndex(mRigidActorArray.size());
 				mRigidActorArray.pushBack(&a);
 				a.addConstraintsToScene();
@@ -549,6 +554,10 @@ void NpScene::addActors(PxActor*const* PX_RESTRICT actors, PxU32 nbActors)
 	}
 	scScene.finishBatchInsertion(scState);
 
+	// scene query shapes of all inserted actors go to the pruners in one batch each
+	getSceneQueryManagerFast().addShapes(sqShapes[0].begin(), sqShapes[0].size(), false);
+	getSceneQueryManagerFast().addShapes(sqShapes[1].begin(), sqShapes[1].size(), true);
+
 	// if we failed, still complete everything for the successful inserted actors before backing out	
 #if PX_SUPPORT_VISUAL_DEBUGGER
 	for(PxU32 i=0;i<actorsDone;i++)
@@ -2583,6 +2592,12 @@ void NpScene::forceDynamicTreeRebuild(bool rebuildStaticStructure, bool rebuildD
 	mSceneQueryManager.forceDynamicTreeRebuild(rebuildStaticStructure, rebuildDynamicStructure);
 }
 
+void NpScene::getPruningStructureStatistics(PxPruningStructureStatistics& staticStats, PxPruningStructureStatistics& dynamicStats) const
+{
+	NP_READ_CHECK(this);
+	mSceneQueryManager.getPruningStructureStatistics(staticStats, dynamicStats);
+}
+
 void NpScene::setSolverBatchSize(PxU32 solverBatchSize)
 {
 	NP_WRITE_CHECK(this);
@@ -2992,21 +3007,9 @@ static PX_FORCE_INLINE void shiftRigidActor(PxRigidActor* a, const PxVec3& shift
 }
 
 
-void NpScene::shiftOrigin(const PxVec3& shift)
+static void shiftRigidActors(PxRigidActor*const* actors, PxU32 rigidCount, const PxVec3& shift)
 {
-	CM_PROFILE_ZONE_WITH_SUBSYSTEM(mScene,API,shiftOrigin);
-	NP_WRITE_CHECK(this);
-
-	if(mScene.isPhysicsBuffering())
-	{
-		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, "PxScene::shiftOrigin() not allowed while simulation is running. Call will be ignored.");
-		return;
-	}
-	
-	PX_SIMD_GUARD;
-
 	const PxU32 prefetchLookAhead = 4;
-	PxU32 rigidCount = mRigidActorArray.size();
 	PxU32 batchIterCount = rigidCount / prefetchLookAhead;
 	
 	PxU32 idx = 0;
@@ -3015,27 +3018,27 @@ void NpScene::shiftOrigin(const PxVec3& shift)
 		// prefetch elements for next batch
 		if (i < (batchIterCount-1))
 		{
-			Ps::prefetchLine(mRigidActorArray[idx + prefetchLookAhead]);
-			Ps::prefetchLine(((PxU8*)mRigidActorArray[idx + prefetchLookAhead]) + 128);  // for the buffered pose
-			Ps::prefetchLine(mRigidActorArray[idx + prefetchLookAhead + 1]);
-			Ps::prefetchLine(((PxU8*)mRigidActorArray[idx + prefetchLookAhead + 1]) + 128);
-			Ps::prefetchLine(mRigidActorArray[idx + prefetchLookAhead + 2]);
-			Ps::prefetchLine(((PxU8*)mRigidActorArray[idx + prefetchLookAhead + 2]) + 128);
-			Ps::prefetchLine(mRigidActorArray[idx + prefetchLookAhead + 3]);
-			Ps::prefetchLine(((PxU8*)mRigidActorArray[idx + prefetchLookAhead + 3]) + 128);
+			Ps::prefetchLine(actors[idx + prefetchLookAhead]);
+			Ps::prefetchLine(((PxU8*)actors[idx + prefetchLookAhead]) + 128);  // for the buffered pose
+			Ps::prefetchLine(actors[idx + prefetchLookAhead + 1]);
+			Ps::prefetchLine(((PxU8*)actors[idx + prefetchLookAhead + 1]) + 128);
+			Ps::prefetchLine(actors[idx + prefetchLookAhead + 2]);
+			Ps::prefetchLine(((PxU8*)actors[idx + prefetchLookAhead + 2]) + 128);
+			Ps::prefetchLine(actors[idx + prefetchLookAhead + 3]);
+			Ps::prefetchLine(((PxU8*)actors[idx + prefetchLookAhead + 3]) + 128);
 		}
 		else
 		{
 			for(PxU32 k=(idx + prefetchLookAhead); k < rigidCount; k++)
 			{
-				Ps::prefetchLine(mRigidActorArray[k]);
-				Ps::prefetchLine(((PxU8*)mRigidActorArray[k]) + 128);
+				Ps::prefetchLine(actors[k]);
+				Ps::prefetchLine(((PxU8*)actors[k]) + 128);
 			}
 		}
 
 		for(PxU32 j=idx; j < (idx + prefetchLookAhead); j++)
 		{
-			shiftRigidActor(mRigidActorArray[j], shift);
+			shiftRigidActor(actors[j], shift);
 		}
 
 		idx += prefetchLookAhead;
@@ -3043,10 +3046,67 @@ void NpScene::shiftOrigin(const PxVec3& shift)
 	// process remaining objects
 	for(PxU32 i=idx; i < rigidCount; i++)
 	{
-		shiftRigidActor(mRigidActorArray[i], shift);
+		shiftRigidActor(actors[i], shift);
 	}
+}
 
+namespace
+{
+	// shifts a contiguous range of the rigid actor array
+	class OriginShiftActorsTask : public Cm::Task
+	{
+	public:
+		OriginShiftActorsTask() : mActors(NULL), mNbActors(0), mShift(PxVec3(0.0f))	{}
 
+		virtual void runInternal()
+		{
+			PX_SIMD_GUARD;
+			shiftRigidActors(mActors, mNbActors, mShift);
+		}
+
+		virtual const char* getName() const { return "NpScene.shiftOriginActors"; }
+
+		PxRigidActor*const*	mActors;
+		PxU32				mNbActors;
+		PxVec3				mShift;
+	};
+
+	class OriginShiftSceneQueryTask : public Cm::Task
+	{
+		PX_NOCOPY(OriginShiftSceneQueryTask)
+	public:
+		OriginShiftSceneQueryTask(Sq::SceneQueryManager& sqManager, const PxVec3& shift) : mSqManager(sqManager), mShift(shift)	{}
+
+		virtual void runInternal()
+		{
+			PX_SIMD_GUARD;
+			mSqManager.shiftOrigin(mShift);
+		}
+
+		virtual const char* getName() const { return "NpScene.shiftOriginSceneQuery"; }
+
+		Sq::SceneQueryManager&	mSqManager;
+		const PxVec3			mShift;
+	};
+
+	class OriginShiftCompletionTask : public Cm::Task
+	{
+		PX_NOCOPY(OriginShiftCompletionTask)
+	public:
+		OriginShiftCompletionTask(Ps::Sync& sync) : mSync(sync)	{}
+
+		virtual void runInternal()	{}
+		virtual void release()		{ mSync.set(); }
+
+		virtual const char* getName() const { return "NpScene.shiftOriginCompletion"; }
+
+		Ps::Sync&	mSync;
+	};
+}
+
+
+void NpScene::shiftOriginArticulationsAndScene(const PxVec3& shift)
+{
 	for(PxU32 i=0; i < mArticulations.size(); i++)
 	{
 		NpArticulation* np = static_cast<NpArticulation*>(mArticulations[i]);
@@ -3060,12 +3120,68 @@ void NpScene::shiftOrigin(const PxVec3& shift)
 
 
 	mScene.shiftOrigin(shift);
+}
 
+void NpScene::shiftOrigin(const PxVec3& shift)
+{
+	CM_PROFILE_ZONE_WITH_SUBSYSTEM(mScene,API,shiftOrigin);
+	NP_WRITE_CHECK(this);
 
-	//
-	// shift scene query related data structures
-	//
-	mSceneQueryManager.shiftOrigin(shift);
+	if(mScene.isPhysicsBuffering())
+	{
+		Ps::getFoundation().error(PxErrorCode::eDEBUG_WARNING, __FILE__, __LINE__, "PxScene::shiftOrigin() not allowed while simulation is running. Call will be ignored.");
+		return;
+	}
+	
+	PX_SIMD_GUARD;
+
+	// The actors, the scene query structures and the simulation controller only write data they own, so large scenes
+	// shift the actor ranges and the scene query structures on the dispatcher while this thread does the rest.
+	const PxU32 minActorsPerTask = 1024;
+	const PxU32 rigidCount = mRigidActorArray.size();
+	PxTaskManager* taskManager = getTaskManager();
+	PxCpuDispatcher* dispatcher = taskManager ? taskManager->getCpuDispatcher() : NULL;
+	const PxU32 nbTasks = dispatcher ? PxMin(dispatcher->getWorkerCount() + 1, rigidCount/minActorsPerTask) : 0;
+
+	if(nbTasks < 2)
+	{
+		shiftRigidActors(mRigidActorArray.begin(), rigidCount, shift);
+		shiftOriginArticulationsAndScene(shift);
+
+		//
+		// shift scene query related data structures
+		//
+		mSceneQueryManager.shiftOrigin(shift);
+	}
+	else
+	{
+		Ps::Array<OriginShiftActorsTask> tasks;
+		tasks.resize(nbTasks);
+		for(PxU32 i=0; i < nbTasks; i++)
+		{
+			const PxU32 start = (rigidCount*i)/nbTasks;
+			tasks[i].mActors = mRigidActorArray.begin() + start;
+			tasks[i].mNbActors = (rigidCount*(i+1))/nbTasks - start;
+			tasks[i].mShift = shift;
+		}
+		OriginShiftSceneQueryTask sqTask(mSceneQueryManager, shift);
+
+		// the first actor range runs on the calling thread, after the parts that are not split into tasks
+		Ps::Sync sync;
+		OriginShiftCompletionTask completion(sync);
+		completion.setContinuation(*taskManager, NULL);
+		sqTask.setContinuation(&completion);
+		for(PxU32 i=1; i < nbTasks; i++)
+			tasks[i].setContinuation(&completion);
+		sqTask.removeReference();
+		for(PxU32 i=1; i < nbTasks; i++)
+			tasks[i].removeReference();
+		completion.removeReference();
+
+		shiftOriginArticulationsAndScene(shift);
+		tasks[0].runInternal();
+		sync.wait();
+	}
 
 	Ps::HashSet<NpVolumeCache*>::Iterator it = mVolumeCaches.getIterator();
 	while (!it.done())
@@ -210,6 +210,7 @@ class NpScene : public NpSceneQueries, public Ps::UserAllocated
 	virtual			void							setDynamicTreeRebuildRateHint(PxU32 dynamicTreeRebuildRateHint);
 	virtual			PxU32							getDynamicTreeRebuildRateHint() const;
 	virtual			void							forceDynamicTreeRebuild(bool rebuildStaticStructure, bool rebuildDynamicStructure);
+	virtual			void							getPruningStructureStatistics(PxPruningStructureStatistics& staticStats, PxPruningStructureStatistics& dynamicStats) const;
 
 	virtual			void							setSolverBatchSize(PxU32 solverBatchSize);
 	virtual			PxU32							getSolverBatchSize(void) const;
@@ -376,8 +377,12 @@ private:
 
 					void							fireCallBacksPreSync();
 
-					void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& actor, NpShapeManager& shapeManager, bool actorDynamic, PxBounds3* bounds);
-	PX_FORCE_INLINE	void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, bool actorDynamic, PxBounds3* bounds);
+					// the parts of shiftOrigin() that stay on the calling thread: articulation links and the simulation controller
+					void							shiftOriginArticulationsAndScene(const PxVec3& shift);
+
+					// the scene query shapes are queued in sqShapes, to be added with Sq::SceneQueryManager::addShapes()
+					void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Actor& actor, NpShapeManager& shapeManager, PxBounds3* bounds, Ps::Array<Sq::ShapeInsertion>& sqShapes);
+	PX_FORCE_INLINE	void							updateScbStateAndSetupSq(const PxRigidActor& rigidActor, Scb::Body& body, NpShapeManager& shapeManager, PxBounds3* bounds, Ps::Array<Sq::ShapeInsertion>& sqShapes);
 
 					Cm::RenderBuffer				mRenderBuffer;
 
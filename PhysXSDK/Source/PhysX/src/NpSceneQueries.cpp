@@ -741,7 +741,8 @@ bool NpSceneQueries::multiQuery(
 		// this function is logically const for the SDK user, as flushUpdates() will not have an API-visible effect on this object
 		// internally however, flushUpdates() changes the states of the Pruners in mSceneQueryManager
 		// because here is the only place we need this, const_cast instead of making SQM mutable
-		const_cast<NpSceneQueries*>(this)->mSceneQueryManager.flushUpdates();
+		if (!bfd || !bfd->updatesFlushed)
+			const_cast<NpSceneQueries*>(this)->mSceneQueryManager.flushUpdates();
 	#endif
 
 	#if PX_SUPPORT_VISUAL_DEBUGGER
@@ -847,6 +848,89 @@ bool NpSceneQueries::multiQuery(
 	}
 }
 
+//========================================================================================================================
+#if !PX_IS_SPU
+#ifdef PX_CHECKED
+// the input checks of multiQuery() for a raycast, returns false if the ray has to be skipped
+static bool checkPacketRay(const MultiQueryInput& input)
+{
+	PX_CHECK_AND_RETURN_VAL(input.getOrigin().isFinite(), "NpSceneQueries::raycast pose is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(input.getDir().isFinite(), "NpSceneQueries multiQuery input check: unitDir is not valid.", false);
+	PX_CHECK_AND_RETURN_VAL(input.getDir().isNormalized(), "NpSceneQueries multiQuery input check: direction must be normalized", false);
+	PX_CHECK_AND_RETURN_VAL(input.maxDistance > 0.0f, "NpSceneQueries::multiQuery input check: distance cannot be negative or zero", false);
+	return true;
+}
+#endif
+
+void NpSceneQueries::multiRaycastPacket(const RaycastPacketQuery* queries, PxU32 nbQueries, BatchQueryFilterData* bfd) const
+{
+	PX_ASSERT(nbQueries <= SQ_RAY_PACKET_SIZE);
+
+	if (!bfd || !bfd->updatesFlushed)
+		const_cast<NpSceneQueries*>(this)->mSceneQueryManager.flushUpdates();
+
+	// MultiQueryCallback holds references to the query, so the callbacks of the packet are constructed in place
+	PX_ALIGN_PREFIX(16) PxU8 callbackBuffer[SQ_RAY_PACKET_SIZE][sizeof(MultiQueryCallback<PxRaycastHit>)] PX_ALIGN_SUFFIX(16);
+	MultiQueryCallback<PxRaycastHit>* callbacks[SQ_RAY_PACKET_SIZE];
+	PrunerCallback* pcbs[SQ_RAY_PACKET_SIZE];
+	PxVec3 origins[SQ_RAY_PACKET_SIZE];
+	PxVec3 unitDirs[SQ_RAY_PACKET_SIZE];
+	PxReal distances[SQ_RAY_PACKET_SIZE];
+	PxU32 staticRays = 0;
+	PxU32 validRays = (1<<nbQueries)-1;
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		const RaycastPacketQuery& q = queries[i];
+		PX_ASSERT(q.hits->maxNbTouches == 0);
+		q.hits->hasBlock = false;
+		q.hits->nbTouches = 0;
+
+		#ifdef PX_CHECKED
+		if(!checkPacketRay(*q.input))
+		{
+			validRays &= ~(1<<i);
+			continue;
+		}
+		#endif
+
+		const bool anyHit = (q.filterData->flags & PxQueryFlag::eANY_HIT) == PxQueryFlag::eANY_HIT;
+		callbacks[i] = PX_PLACEMENT_NEW(callbackBuffer[i], MultiQueryCallback<PxRaycastHit>)(
+			*this, *q.input, anyHit, *q.hits, q.hitFlags, *q.filterData, NULL, q.input->maxDistance, bfd);
+		pcbs[i] = callbacks[i];
+		origins[i] = q.input->getOrigin();
+		unitDirs[i] = q.input->getDir();
+		distances[i] = q.input->maxDistance;
+		if(q.filterData->flags & PxQueryFlag::eSTATIC)
+			staticRays |= 1<<i;
+	}
+
+	const Pruner* staticPruner = mSceneQueryManager.getStaticPruner();
+	const Pruner* dynamicPruner = mSceneQueryManager.getDynamicPruner();
+
+	const PxU32 staticAgain = staticRays ? staticPruner->raycastPacket(origins, unitDirs, distances, pcbs, staticRays) : 0;
+
+	// the dynamic pruner and the hit callbacks run per ray, in the same way as in multiQuery()
+	for(PxU32 i=0;i<nbQueries;i++)
+	{
+		if(!(validRays & (1<<i)))
+			continue;
+
+		const RaycastPacketQuery& q = queries[i];
+		MultiQueryCallback<PxRaycastHit>& pcb = *callbacks[i];
+		{
+			#if PX_SUPPORT_VISUAL_DEBUGGER
+			CapturePvdOnReturn<PxRaycastHit> pvdCapture(this, *q.input, q.hitFlags, NULL, *q.filterData, NULL, bfd, *q.hits);
+			#endif
+
+			IssueCallbacksOnReturn<PxRaycastHit> cbr(*q.hits);
+			const bool again = !(staticRays & (1<<i)) || (staticAgain & (1<<i));
+			if(again && (q.filterData->flags & PxQueryFlag::eDYNAMIC))
+				cbr.again = dynamicPruner->raycast(q.input->getOrigin(), q.input->getDir(), pcb.shrunkDistance, pcb);
+		}
+		pcb.~MultiQueryCallback<PxRaycastHit>();
+	}
+}
+#endif
 
 // explicit instantiations for multiQuery to fix link errors on android
 #if !(PX_IS_WINDOWS | PX_IS_X360 | PX_IS_SPU)
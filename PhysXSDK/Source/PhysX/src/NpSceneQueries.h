@@ -116,11 +116,12 @@ struct BatchQueryFilterData
 	PxU32							filterShaderDataSize;
 	PxBatchQueryPreFilterShader		preFilterShader;	
 	PxBatchQueryPostFilterShader	postFilterShader;	
+	bool							updatesFlushed; // the caller already flushed the scene query updates, skip the flush per query
 	#if PX_SUPPORT_VISUAL_DEBUGGER
 	Pvd::PvdSceneQueryCollector*	collector; // gets set to bq collector
 	#endif
 	BatchQueryFilterData(void* fsData, PxU32 fsSize, PxBatchQueryPreFilterShader preFs, PxBatchQueryPostFilterShader postFs)
-		: filterShaderData(fsData), filterShaderDataSize(fsSize), preFilterShader(preFs), postFilterShader(postFs)
+		: filterShaderData(fsData), filterShaderDataSize(fsSize), preFilterShader(preFs), postFilterShader(postFs), updatesFlushed(false)
 	{
 		#if PX_SUPPORT_VISUAL_DEBUGGER
 		collector = NULL;
@@ -128,6 +129,15 @@ struct BatchQueryFilterData
 	}
 };
 
+// One raycast of a packet passed to NpSceneQueries::multiRaycastPacket()
+struct RaycastPacketQuery
+{
+	const MultiQueryInput*			input;
+	PxHitCallback<PxRaycastHit>*	hits;	// without touch buffer
+	PxHitFlags						hitFlags;
+	const PxQueryFilterData*		filterData;
+};
+
 class PxGeometry;
 
 class NpSceneQueries : public PxScene
@@ -145,6 +155,10 @@ public:
 														const PxQueryFilterData& filterData, PxQueryFilterCallback* filterCall,
 														BatchQueryFilterData* bqFd = NULL) const;
 
+	// Same as calling multiQuery() for each raycast in turn, except that the static pruner is traversed once for the whole
+	// packet (see Pruner::raycastPacket()). Only for batched raycasts without touch buffer or cache.
+					void							multiRaycastPacket(const RaycastPacketQuery* queries, PxU32 nbQueries, BatchQueryFilterData* bfd) const;
+
 	// Synchronous scene queries
 	virtual			bool							raycast(
 														const PxVec3& origin, const PxVec3& unitDir, const PxReal distance,	// Ray data
@@ -74,6 +74,13 @@ public:
 						mSceneQueryData.getPtrs()[index] = data;
 					}
 
+					// for batch insertion, the SQ manager writes the ActorShape here once the whole batch has been added
+					PX_FORCE_INLINE Sq::ActorShape** getSceneQueryDataLocation(PxU32 index)
+					{
+						PX_ASSERT(index<getNbShapes());
+						return getSqDataInternal()+index;
+					}
+
 					void			setupAllSceneQuery(const PxRigidActor& actor);
 					void			teardownAllSceneQuery(Sq::SceneQueryManager& sqManager);
 					void			markAllSceneQueryForUpdate(Sq::SceneQueryManager& shapeManager);
@@ -37,6 +37,7 @@ namespace Cct
 		virtual	PxF32								getHalfHeightInternal()				const					{ return mRadius+mHeight*0.5f;			}
 		virtual	bool								getWorldBox(PxExtendedBounds3& box) const;
 		virtual	PxController*						getPxController()											{ return this;							}
+		virtual	PxControllerCollisionFlags			moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveScratch& scratch, bool batched);
 		//~Controller
 
 		// PxController
@@ -2135,7 +2135,7 @@ bool Controller::rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirect
 	return standingOnMoving;
 }
 
-PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode)
+PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode, MoveScratch& scratch, bool batched)
 {
 	const bool lockWrite = mManager->mLockingEnabled;
 	if(lockWrite)
@@ -2144,7 +2144,8 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	mGlobalTime += elapsedTime;
 
 	// Init CCT with per-controller settings
-	Cm::RenderBuffer* renderBuffer									= mManager->mRenderBuffer;
+	// Batched moves run concurrently, so they render to their own buffer
+	Cm::RenderBuffer* renderBuffer									= mManager->mRenderBuffer && batched ? scratch.mRenderBuffer : mManager->mRenderBuffer;
 	const PxU32 debugRenderFlags									= mManager->mDebugRenderingFlags;
 	mCctModule.mRenderBuffer										= renderBuffer;
 	mCctModule.mRenderFlags											= debugRenderFlags;
@@ -2233,10 +2234,10 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 //	printf("standingOnMoving: %d\n", standingOnMoving);
 
 	///////////
-	Ps::Array<const void*>&			boxUserData		= mManager->mBoxUserData;
-	Ps::Array<PxExtendedBox>&		boxes			= mManager->mBoxes;
-	Ps::Array<const void*>&			capsuleUserData	= mManager->mCapsuleUserData;
-	Ps::Array<PxExtendedCapsule>&	capsules		= mManager->mCapsules;
+	Ps::Array<const void*>&			boxUserData		= scratch.mBoxUserData;
+	Ps::Array<PxExtendedBox>&		boxes			= scratch.mBoxes;
+	Ps::Array<const void*>&			capsuleUserData	= scratch.mCapsuleUserData;
+	Ps::Array<PxExtendedCapsule>&	capsules		= scratch.mCapsules;
 	PX_ASSERT(!boxUserData.size());
 	PX_ASSERT(!boxes.size());
 	PX_ASSERT(!capsuleUserData.size());
@@ -2262,9 +2263,17 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				if(currentController->mType==PxControllerShapeType::eBOX)
 				{
 					// PT: TODO: optimize this
-					BoxController* BC = static_cast<BoxController*>(currentController);
 					PxExtendedBox obb;
-					BC->getOBB(obb);
+					if(batched)
+					{
+						// Other controllers may be moving concurrently, use their volume from the start of the batch
+						obb = mManager->mBatchBoxes[i];
+					}
+					else
+					{
+						BoxController* BC = static_cast<BoxController*>(currentController);
+						BC->getOBB(obb);
+					}
 
 					boxes.pushBack(obb);
 
@@ -2284,11 +2293,17 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 				}
 				else if(currentController->mType==PxControllerShapeType::eCAPSULE)
 				{
-					CapsuleController* CC = static_cast<CapsuleController*>(currentController);
-
 					// PT: TODO: optimize this
 					PxExtendedCapsule worldCapule;
-					CC->getCapsule(worldCapule);
+					if(batched)
+					{
+						worldCapule = mManager->mBatchCapsules[i];
+					}
+					else
+					{
+						CapsuleController* CC = static_cast<CapsuleController*>(currentController);
+						CC->getCapsule(worldCapule);
+					}
 					capsules.pushBack(worldCapule);
 
 					const size_t code = encodeUserObject(i, USER_OBJECT_CCT);
@@ -2382,6 +2397,7 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	PxInternalCBData_OnHit userHitData;
 	userHitData.controller	= this;
 	userHitData.obstacles	= obstacles;
+	userHitData.deferredHits	= batched ? &scratch.mDeferredHits : NULL;
 
 	///////////
 
@@ -2421,10 +2437,24 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	// Copy results back
 	mPosition = volume.mCenter;
 
-	// Update kinematic actor
+	// Update kinematic actor. This writes to the scene, so batched moves leave it to the manager once all moves are complete.
+	if(!batched)
+		updateKinematicTarget(Backup);
+
+	scratch.resetObstacles();
+
+	if (lockWrite)
+		mWriteLock.unlock();
+
+	return collisionFlags;
+}
+
+
+void Controller::updateKinematicTarget(const PxExtendedVec3& previousPosition)
+{
 	if(mKineActor)
 	{
-		const PxVec3 delta = Backup - volume.mCenter;
+		const PxVec3 delta = previousPosition - mPosition;
 		const PxF32 deltaM2 = delta.magnitudeSquared();
 		if(deltaM2!=0.0f)
 		{
@@ -2434,17 +2464,14 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 			mKineActor->setKinematicTarget(targetPose);
 		}
 	}
-
-	mManager->resetObstaclesBuffers();
-
-	if (lockWrite)
-		mWriteLock.unlock();
-
-	return collisionFlags;
 }
 
-
 PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
+{
+	return moveInternal(disp, minDist, elapsedTime, filters, obstacles, mManager->mMoveScratch, false);
+}
+
+PxControllerCollisionFlags BoxController::moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveScratch& scratch, bool batched)
 {
 	PX_SIMD_GUARD;
 
@@ -2453,10 +2480,15 @@ PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist
 	sweptBox.mCenter		= mPosition;
 	sweptBox.mExtents		= PxVec3(mHalfHeight, mHalfSideExtent, mHalfForwardExtent);
 	sweptBox.mHalfHeight	= mHalfHeight;	// UBI
-	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false);
+	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false, scratch, batched);
 }
 
 PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
+{
+	return moveInternal(disp, minDist, elapsedTime, filters, obstacles, mManager->mMoveScratch, false);
+}
+
+PxControllerCollisionFlags CapsuleController::moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveScratch& scratch, bool batched)
 {
 	PX_SIMD_GUARD;
 
@@ -2466,5 +2498,5 @@ PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 min
 	sweptCapsule.mRadius		= mRadius;
 	sweptCapsule.mHeight		= mHeight;
 	sweptCapsule.mHalfHeight	= mHeight*0.5f + mRadius;	// UBI
-	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED);
+	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED, scratch, batched);
 }
@@ -983,9 +983,25 @@ static void fillCCTHit(PxControllerHit& hit, const SweptContact& contact, const
 
 static const PxU32 defaultBehaviorFlags = 0;
 
+// Batched moves run concurrently, so their hits are recorded and reported by the manager once all moves are complete
+static PX_FORCE_INLINE DeferredHit& deferHit(Ps::Array<DeferredHit>& deferredHits, const PxControllerHit& hit, DeferredHit::Type type, PxUserControllerHitReport* reportCallback)
+{
+	DeferredHit& deferred = deferredHits.insert();
+	static_cast<PxControllerHit&>(deferred.mHit) = hit;
+	deferred.mHit.shape				= NULL;
+	deferred.mHit.actor				= NULL;
+	deferred.mHit.triangleIndex		= 0;
+	deferred.mOther					= NULL;
+	deferred.mObstacleUserData		= NULL;
+	deferred.mReportCallback		= reportCallback;
+	deferred.mType					= type;
+	return deferred;
+}
+
 PxU32 Cct::shapeHitCallback(const InternalCBData_OnHit* userData, const SweptContact& contact, const PxVec3& dir, float length)
 {
-	Controller* controller = static_cast<const PxInternalCBData_OnHit*>(userData)->controller;
+	const PxInternalCBData_OnHit* internalData = static_cast<const PxInternalCBData_OnHit*>(userData);
+	Controller* controller = internalData->controller;
 
 	PxControllerShapeHit hit;
 	fillCCTHit(hit, contact, dir, length, controller);
@@ -995,7 +1011,12 @@ PxU32 Cct::shapeHitCallback(const InternalCBData_OnHit* userData, const SweptCon
 	hit.triangleIndex	= contact.mTriangleIndex;
 
 	if(controller->mReportCallback)
-		controller->mReportCallback->onShapeHit(hit);
+	{
+		if(internalData->deferredHits)
+			deferHit(*internalData->deferredHits, hit, DeferredHit::eSHAPE, controller->mReportCallback).mHit = hit;
+		else
+			controller->mReportCallback->onShapeHit(hit);
+	}
 
 	PxControllerBehaviorCallback* behaviorCB = controller->mBehaviorCallback;
 	return behaviorCB ? behaviorCB->getBehaviorFlags(*hit.shape, *hit.actor) : defaultBehaviorFlags;
@@ -1010,7 +1031,12 @@ static PX_FORCE_INLINE PxU32 handleObstacleHit(const PxObstacle& touchedObstacle
 	const_cast<PxInternalCBData_OnHit*>(internalData)->touchedObstacleHandle = obstacleHandle;
 
 	if(controller->mReportCallback)
-		controller->mReportCallback->onObstacleHit(hit);
+	{
+		if(internalData->deferredHits)
+			deferHit(*internalData->deferredHits, hit, DeferredHit::eOBSTACLE, controller->mReportCallback).mObstacleUserData = hit.userData;
+		else
+			controller->mReportCallback->onObstacleHit(hit);
+	}
 
 	PxControllerBehaviorCallback* behaviorCB = controller->mBehaviorCallback;
 	return behaviorCB ? behaviorCB->getBehaviorFlags(touchedObstacle) : defaultBehaviorFlags;
@@ -1037,7 +1063,12 @@ PxU32 Cct::userHitCallback(const InternalCBData_OnHit* userData, const SweptCont
 		hit.other = other->getPxController();
 
 		if(controller->mReportCallback)
-			controller->mReportCallback->onControllerHit(hit);
+		{
+			if(internalData->deferredHits)
+				deferHit(*internalData->deferredHits, hit, DeferredHit::eCONTROLLER, controller->mReportCallback).mOther = hit.other;
+			else
+				controller->mReportCallback->onControllerHit(hit);
+		}
 
 		PxControllerBehaviorCallback* behaviorCB = controller->mBehaviorCallback;
 		return behaviorCB ? behaviorCB->getBehaviorFlags(*hit.other) : defaultBehaviorFlags;
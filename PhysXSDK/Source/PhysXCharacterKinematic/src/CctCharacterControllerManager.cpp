@@ -21,6 +21,11 @@
 #include "PsMathUtils.h"
 #include "PxRigidDynamic.h"
 #include "PxScene.h"
+#include "pxtask/PxTask.h"
+#include "pxtask/PxCpuDispatcher.h"
+#include "PsSync.h"
+#include "PsAtomic.h"
+#include "PsInlineArray.h"
 
 using namespace physx;
 using namespace Cct;
@@ -49,6 +54,9 @@ CharacterControllerManager::~CharacterControllerManager()
 		delete mRenderBuffer;
 		mRenderBuffer = 0;
 	}
+
+	for(PxU32 i=0;i<mBatchScratches.size();i++)
+		PX_DELETE(mBatchScratches[i]);
 }
 
 void CharacterControllerManager::release() 
@@ -260,7 +268,16 @@ void resetOrClear(T& a)
 		a.reset();
 }
 
-void CharacterControllerManager::resetObstaclesBuffers()
+MoveScratch::~MoveScratch()
+{
+	if(mRenderBuffer)
+	{
+		delete mRenderBuffer;
+		mRenderBuffer = 0;
+	}
+}
+
+void MoveScratch::resetObstacles()
 {
 	resetOrClear(mBoxUserData);
 	resetOrClear(mBoxes);
@@ -315,8 +332,8 @@ void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 		mRenderBuffer->shift(-shift);
 
 	// assumption is that these are just used for temporary stuff
-	PX_ASSERT(!mBoxes.size());
-	PX_ASSERT(!mCapsules.size());
+	PX_ASSERT(!mMoveScratch.mBoxes.size());
+	PX_ASSERT(!mMoveScratch.mCapsules.size());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -661,6 +678,265 @@ void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxContro
 	PX_FREE(boxes);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static PX_FORCE_INLINE Controller* toController(PxController* controller)
+{
+	if(controller->getType()==PxControllerShapeType::eBOX)
+		return static_cast<BoxController*>(controller);
+	PX_ASSERT(controller->getType()==PxControllerShapeType::eCAPSULE);
+	return static_cast<CapsuleController*>(controller);
+}
+
+namespace
+{
+	// Deferred hits of one chunk of controllers, stored in the scratch buffers of the thread that moved them
+	struct ChunkHits
+	{
+		MoveScratch*	scratch;
+		PxU32			start;
+		PxU32			end;
+	};
+
+	// Data shared by all tasks of a call to moveAll.
+	// Each task repeatedly claims the next unclaimed chunk of controllers until no chunks are left.
+	struct ControllerMoveChunks
+	{
+		PxController* const*		controllers;
+		const PxVec3*				displacements;
+		PxF32						minDist;
+		PxF32						elapsedTime;
+		const PxControllerFilters*	filters;
+		const PxObstacleContext*	obstacles;
+		PxControllerCollisionFlags*	collisionFlags;
+
+		// Chunk i moves the controllers in the range [i*chunkSize, min((i+1)*chunkSize, nbControllers))
+		PxU32						nbControllers;
+		PxU32						chunkSize;
+		PxU32						nbChunks;
+		volatile PxI32				nextChunk;
+		ChunkHits*					chunkHits;
+
+		// Number of submitted tasks that have not yet been released
+		volatile PxI32				nbPendingTasks;
+		Ps::Sync					sync;
+	};
+
+	class ControllerMoveTask : public PxLightCpuTask
+	{
+	public:
+								ControllerMoveTask() : mChunks(NULL), mScratch(NULL)	{}
+
+		static	void			moveChunks(ControllerMoveChunks& chunks, MoveScratch& scratch)
+		{
+			PxU32 chunk;
+			while((chunk=(PxU32)(Ps::atomicIncrement(&chunks.nextChunk)-1)) < chunks.nbChunks)
+			{
+				const PxU32 start = chunk*chunks.chunkSize;
+				const PxU32 end = PxMin(start+chunks.chunkSize, chunks.nbControllers);
+
+				ChunkHits& hits = chunks.chunkHits[chunk];
+				hits.scratch = &scratch;
+				hits.start = scratch.mDeferredHits.size();
+
+				for(PxU32 i=start;i<end;i++)
+				{
+					const PxControllerCollisionFlags flags = toController(chunks.controllers[i])->moveInternal(
+						chunks.displacements[i], chunks.minDist, chunks.elapsedTime, *chunks.filters, chunks.obstacles, scratch, true);
+					if(chunks.collisionFlags)
+						chunks.collisionFlags[i] = flags;
+				}
+
+				hits.end = scratch.mDeferredHits.size();
+			}
+		}
+
+		virtual	void			run()
+		{
+			moveChunks(*mChunks, *mScratch);
+		}
+
+		virtual	void			release()
+		{
+			if(0==Ps::atomicDecrement(&mChunks->nbPendingTasks))
+				mChunks->sync.set();
+		}
+
+		virtual	const char*		getName()	const	{ return "PxControllerManager.moveAll";	}
+
+				ControllerMoveChunks*	mChunks;
+				MoveScratch*			mScratch;
+	};
+}
+
+static void reportDeferredHit(const DeferredHit& deferred)
+{
+	switch(deferred.mType)
+	{
+		case DeferredHit::eSHAPE:
+		{
+			deferred.mReportCallback->onShapeHit(deferred.mHit);
+		}
+		break;
+
+		case DeferredHit::eCONTROLLER:
+		{
+			PxControllersHit hit;
+			static_cast<PxControllerHit&>(hit) = deferred.mHit;
+			hit.other = deferred.mOther;
+			deferred.mReportCallback->onControllerHit(hit);
+		}
+		break;
+
+		case DeferredHit::eOBSTACLE:
+		{
+			PxControllerObstacleHit hit;
+			static_cast<PxControllerHit&>(hit) = deferred.mHit;
+			hit.userData = deferred.mObstacleUserData;
+			deferred.mReportCallback->onObstacleHit(hit);
+		}
+		break;
+	}
+}
+
+void CharacterControllerManager::moveAll(PxU32 nbControllers, PxController* const* controllers, const PxVec3* displacements, PxF32 minDist, PxF32 elapsedTime,
+										 const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxControllerCollisionFlags* collisionFlags,
+										 PxCpuDispatcher* dispatcher)
+{
+	if(!nbControllers)
+		return;
+
+	if(!controllers || !displacements)
+	{
+		Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxControllerManager::moveAll(): controllers and displacements must be non-null");
+		return;
+	}
+
+#ifdef PX_CHECKED
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		if(!controllers[i] || toController(controllers[i])->mManager!=this)
+		{
+			Ps::getFoundation().error(PxErrorCode::eINVALID_PARAMETER, __FILE__, __LINE__, "PxControllerManager::moveAll(): controllers must belong to this manager");
+			return;
+		}
+	}
+#endif
+
+	// The moves collide against the other controllers as they are now, whatever the order in which the controllers are moved
+	const PxU32 nbManaged = mControllers.size();
+	mBatchBoxes.resize(nbManaged);
+	mBatchCapsules.resize(nbManaged);
+	for(PxU32 i=0;i<nbManaged;i++)
+	{
+		Controller* current = mControllers[i];
+		if(current->mType==PxControllerShapeType::eBOX)
+			static_cast<BoxController*>(current)->getOBB(mBatchBoxes[i]);
+		else if(current->mType==PxControllerShapeType::eCAPSULE)
+			static_cast<CapsuleController*>(current)->getCapsule(mBatchCapsules[i]);
+		else PX_ASSERT(0);
+	}
+
+	mBatchPositions.resize(nbControllers);
+	for(PxU32 i=0;i<nbControllers;i++)
+		mBatchPositions[i] = controllers[i]->getPosition();
+
+	// Moves are much cheaper than a task when there are only a few of them.
+	const PxU32 minChunkSize = 16;
+	// Split the work into a few chunks per thread so that threads that finish early can claim more work.
+	const PxU32 nbChunksPerThread = 4;
+
+	if(!dispatcher)
+		dispatcher = mScene.getCpuDispatcher();
+
+	// With eREQUIRE_RW_LOCK every thread reading the scene needs its own read lock, so the calling thread does all the work.
+	PxTaskManager* taskManager = mScene.getTaskManager();
+	const bool useTasks = dispatcher && taskManager && !(mScene.getFlags() & PxSceneFlag::eREQUIRE_RW_LOCK);
+
+	const PxU32 nbThreads = useTasks ? dispatcher->getWorkerCount()+1 : 1;
+	const PxU32 chunkSize = PxMax(minChunkSize, (nbControllers + nbThreads*nbChunksPerThread - 1)/(nbThreads*nbChunksPerThread));
+
+	Ps::InlineArray<ChunkHits, 64> chunkHits;
+
+	ControllerMoveChunks chunks;
+	chunks.controllers		= controllers;
+	chunks.displacements	= displacements;
+	chunks.minDist			= minDist;
+	chunks.elapsedTime		= elapsedTime;
+	chunks.filters			= &filters;
+	chunks.obstacles		= obstacles;
+	chunks.collisionFlags	= collisionFlags;
+	chunks.nbControllers	= nbControllers;
+	chunks.chunkSize		= chunkSize;
+	chunks.nbChunks			= (nbControllers + chunkSize - 1)/chunkSize;
+	chunks.nextChunk		= 0;
+
+	chunkHits.resize(chunks.nbChunks);
+	chunks.chunkHits		= chunkHits.begin();
+
+	// The calling thread moves controllers too so one task fewer than the number of chunks is enough.
+	const PxU32 nbTasks = PxMin(nbThreads-1, chunks.nbChunks-1);
+	chunks.nbPendingTasks	= (PxI32)nbTasks;
+
+	while(mBatchScratches.size()<nbTasks+1)
+		mBatchScratches.pushBack(PX_NEW(MoveScratch));
+
+	if(mRenderBuffer)
+	{
+		for(PxU32 i=0;i<nbTasks+1;i++)
+		{
+			if(!mBatchScratches[i]->mRenderBuffer)
+				mBatchScratches[i]->mRenderBuffer = PX_NEW(Cm::RenderBuffer);
+		}
+	}
+
+	Ps::InlineArray<ControllerMoveTask, 16> tasks;
+	tasks.resize(nbTasks);
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		tasks[i].mChunks = &chunks;
+		tasks[i].mScratch = mBatchScratches[i];
+		tasks[i].setContinuation(*taskManager, NULL);
+		dispatcher->submitTask(tasks[i]);
+	}
+
+	ControllerMoveTask::moveChunks(chunks, *mBatchScratches[nbTasks]);
+	if(nbTasks)
+		chunks.sync.wait();
+
+	// Writes to the scene and hit reports are made here, in the order of the controllers array
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		Controller* controller = toController(controllers[i]);
+		if(mLockingEnabled)
+			controller->mWriteLock.lock();
+
+		controller->updateKinematicTarget(mBatchPositions[i]);
+
+		if(mLockingEnabled)
+			controller->mWriteLock.unlock();
+	}
+
+	for(PxU32 i=0;i<chunks.nbChunks;i++)
+	{
+		const ChunkHits& hits = chunkHits[i];
+		for(PxU32 j=hits.start;j<hits.end;j++)
+			reportDeferredHit(hits.scratch->mDeferredHits[j]);
+	}
+
+	for(PxU32 i=0;i<nbTasks+1;i++)
+	{
+		MoveScratch* scratch = mBatchScratches[i];
+		scratch->mDeferredHits.clear();
+		if(scratch->mRenderBuffer)
+		{
+			if(mRenderBuffer)
+				mRenderBuffer->append(*scratch->mRenderBuffer);
+			scratch->mRenderBuffer->clear();
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //Public factory methods
 
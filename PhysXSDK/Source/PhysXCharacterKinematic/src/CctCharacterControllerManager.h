@@ -21,6 +21,7 @@
 #include "PxMeshQuery.h"
 #include "CmRenderOutput.h"
 #include "CctUtils.h"
+#include "CctController.h"
 #include "PsHashSet.h"
 
 namespace physx
@@ -55,6 +56,9 @@ namespace Cct
 		virtual			PxObstacleContext*				getObstacleContext(PxU32 index);
 		virtual			PxObstacleContext*				createObstacleContext();
 		virtual			void							computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb);
+		virtual			void							moveAll(PxU32 nbControllers, PxController* const* controllers, const PxVec3* displacements, PxF32 minDist, PxF32 elapsedTime,
+																const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxControllerCollisionFlags* collisionFlags,
+																PxCpuDispatcher* dispatcher);
 		virtual			void							setTessellation(bool flag, float maxEdgeLength);
 		virtual			void							setOverlapRecoveryModule(bool flag);
 		virtual			void							setPreciseSweeps(bool flag);
@@ -70,18 +74,19 @@ namespace Cct
 						void							releaseController(PxController& controller);
 						Controller**					getControllers();
 						void							releaseObstacleContext(ObstacleContext& oc);
-						void							resetObstaclesBuffers();
 
 						PxScene&						mScene;
 
 						Cm::RenderBuffer*				mRenderBuffer;
 						PxControllerDebugRenderFlags	mDebugRenderingFlags;
 		// Shared buffers for obstacles
-						Ps::Array<const void*>			mBoxUserData;
-						Ps::Array<PxExtendedBox>		mBoxes;
+						MoveScratch						mMoveScratch;
 
-						Ps::Array<const void*>			mCapsuleUserData;
-						Ps::Array<PxExtendedCapsule>	mCapsules;
+		// Batched moves
+						Ps::Array<PxExtendedBox>		mBatchBoxes;			// Volumes of all controllers at the start of moveAll, indexed like mControllers
+						Ps::Array<PxExtendedCapsule>	mBatchCapsules;
+						Ps::Array<PxExtendedVec3>		mBatchPositions;		// Positions of the moved controllers at the start of moveAll
+						Ps::Array<MoveScratch*>			mBatchScratches;		// One per thread taking part in moveAll
 
 						Ps::Array<Controller*>			mControllers;
 						Ps::HashSet<PxShape*>			mCCTShapes;
@@ -34,6 +34,41 @@ namespace Cct
 {
 	class CharacterControllerManager;
 
+	// Hit found by a batched move, reported to the user once all controllers have moved
+	struct DeferredHit
+	{
+		enum Type
+		{
+			eSHAPE,
+			eCONTROLLER,
+			eOBSTACLE
+		};
+
+		PxControllerShapeHit		mHit;				// Common hit data, plus the touched shape for eSHAPE
+		PxController*				mOther;				// Touched controller for eCONTROLLER
+		const void*					mObstacleUserData;	// Touched obstacle's user data for eOBSTACLE
+		PxUserControllerHitReport*	mReportCallback;
+		Type						mType;
+	};
+
+	// Temporary buffers used by a move. Regular moves share the manager's buffers, each task of a batched move has its own.
+	struct MoveScratch : public Ps::UserAllocated
+	{
+										MoveScratch() : mRenderBuffer(NULL)	{}
+										~MoveScratch();
+
+					void				resetObstacles();
+
+		// Boxes and capsules of other controllers and user obstacles
+		Ps::Array<const void*>			mBoxUserData;
+		Ps::Array<PxExtendedBox>		mBoxes;
+		Ps::Array<const void*>			mCapsuleUserData;
+		Ps::Array<PxExtendedCapsule>	mCapsules;
+		// Batched moves only
+		Cm::RenderBuffer*				mRenderBuffer;	// Debug-render output, merged into the manager's render buffer after the moves
+		Ps::Array<DeferredHit>			mDeferredHits;
+	};
+
 	class Controller : public Ps::UserAllocated, public PxDeletionListener
 	{
 		PX_NOCOPY(Controller)
@@ -52,8 +87,10 @@ namespace Cct
 		virtual		PxF32								getHalfHeightInternal()				const	= 0;
 		virtual		bool								getWorldBox(PxExtendedBounds3& box)	const	= 0;
 		virtual		PxController*						getPxController()							= 0;
+		virtual		PxControllerCollisionFlags			moveInternal(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, MoveScratch& scratch, bool batched)	= 0;
 
 					void								onOriginShift(const PxVec3& shift);
+					void								updateKinematicTarget(const PxExtendedVec3& previousPosition);
 
 					PxControllerShapeType::Enum			mType;
 		// User params
@@ -86,7 +123,7 @@ namespace Cct
 					bool								setPos(const PxExtendedVec3& pos);
 					void								findTouchedObject(const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, const PxVec3& upDirection);
 					bool								rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirection, PxVec3& disp, const PxObstacleContext* obstacleContext);
-					PxControllerCollisionFlags			move(SweptVolume& volume, const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, bool constrainedClimbingMode);
+					PxControllerCollisionFlags			move(SweptVolume& volume, const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles, bool constrainedClimbingMode, MoveScratch& scratch, bool batched);
 					bool								filterTouchedShape(const PxControllerFilters& filters);
 	};
 
@@ -55,6 +55,7 @@ namespace Cct
 		const ObstacleContext*	obstacles;
 		const PxObstacle*		touchedObstacle;
 		ObstacleHandle			touchedObstacleHandle;
+		Ps::Array<DeferredHit>*	deferredHits;	// Hits to report after a batched move, NULL to report them immediately
 	};
 
 	struct PxInternalCBData_FindTouchedGeom : InternalCBData_FindTouchedGeom
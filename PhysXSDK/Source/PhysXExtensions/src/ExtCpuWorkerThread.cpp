@@ -21,7 +21,8 @@ using namespace physx;
 
 Ext::CpuWorkerThread::CpuWorkerThread()
 :	mQueueEntryPool(EXT_TASK_QUEUE_ENTRY_POOL_SIZE),
-	mThreadId(0)
+	mThreadId(0),
+	mRandomState(1)
 {
 }
 
@@ -34,6 +35,24 @@ Ext::CpuWorkerThread::~CpuWorkerThread()
 void Ext::CpuWorkerThread::initialize(DefaultCpuDispatcher* ownerDispatcher)
 {
 	mOwner = ownerDispatcher;
+
+	if(mOwner->isWorkStealing())
+	{
+		mWorkQueue.init(EXT_WORK_STEALING_QUEUE_SIZE);
+		mRandomState = PxU32(size_t(this) >> 4) | 1;	// any non-zero seed, distinct per worker
+	}
+}
+
+
+PxU32 Ext::CpuWorkerThread::nextRandom()
+{
+	// xorshift32, only used to pick steal victims
+	PxU32 x = mRandomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	mRandomState = x;
+	return x;
 }
 
 
@@ -65,6 +84,17 @@ void Ext::CpuWorkerThread::execute()
 {
 	mThreadId = getId();
 
+	if(mOwner->isWorkStealing())
+		executeWorkStealing();
+	else
+		executeSharedQueue();
+
+	quit();
+}
+
+
+void Ext::CpuWorkerThread::executeSharedQueue()
+{
 	while (!quitIsSignalled())
     {
         mOwner->resetWakeSignal();
@@ -84,6 +114,45 @@ void Ext::CpuWorkerThread::execute()
 			mOwner->waitForWork();
 		}
 	}
+}
 
-	quit();
+
+void Ext::CpuWorkerThread::executeWorkStealing()
+{
+	Ps::TlsSet(mOwner->getWorkerTlsIndex(), this);
+
+	PxU32 idleRounds = 0;
+	while (!quitIsSignalled())
+	{
+		PxBaseTask* task = mWorkQueue.pop();
+
+		if(!task)
+			task = mOwner->fetchNextTask(*this);
+
+		if(!task)
+		{
+			if(idleRounds < mOwner->getSpinCount())
+			{
+				idleRounds++;
+				Ps::Thread::yield();
+				continue;
+			}
+
+			// Announce that we are going to sleep before looking at the queues one last
+			// time, a submitter either sees us parked or we see its task.
+			mOwner->beginPark();
+			task = mOwner->fetchNextTask(*this);
+			if(!task)
+				mOwner->waitForWork();
+			mOwner->endPark();
+			idleRounds = 0;
+		}
+
+		if (task)
+		{
+			mOwner->runTask(*task);
+			task->release();
+			idleRounds = 0;
+		}
+	}
 }
@@ -18,6 +18,7 @@
 #include "PsThread.h"
 #include "ExtDefaultCpuDispatcher.h"
 #include "ExtSharedQueueEntryPool.h"
+#include "ExtWorkStealingQueue.h"
 
 
 namespace physx
@@ -48,11 +49,21 @@ namespace Ext
 		PxBaseTask*				giveUpJob();
 		Ps::Thread::Id			getWorkerThreadId() const { return mThreadId; }
 
+		// work stealing mode, see PxDefaultCpuDispatcherMode::eWORK_STEALING
+		bool					tryAcceptJobToWorkQueue(PxBaseTask& task)	{ return mWorkQueue.push(task);	}
+		PxBaseTask*				stealFromWorkQueue()						{ return mWorkQueue.steal();	}
+		PxU32					nextRandom();
+
 	protected:
+		void					executeSharedQueue();
+		void					executeWorkStealing();
+
 		SharedQueueEntryPool<>			mQueueEntryPool;
 		DefaultCpuDispatcher*			mOwner;
 		Ps::SList      				    mLocalJobList;
 		Ps::Thread::Id					mThreadId;
+		WorkStealingQueue				mWorkQueue;
+		PxU32							mRandomState;
 	};
 
 #pragma warning(pop)
@@ -16,19 +16,25 @@
 #include "ExtTaskQueueHelper.h"
 #include "PxTask.h"
 #include "PsString.h"
+#include "PsAtomic.h"
+#include "PsIntrinsics.h"
 
 using namespace physx;
 
 namespace physx
 {
-	PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks);
+	PxDefaultCpuDispatcher* PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode);
 }
 
-PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks)
+PxDefaultCpuDispatcher* physx::PxDefaultCpuDispatcherCreate(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode)
 {
-	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks);
+	return PX_NEW(Ext::DefaultCpuDispatcher)(numThreads, affinityMasks, mode);
 }
 
+// Number of unsuccessful fetch rounds (each followed by a yield) an idle worker goes
+// through in work stealing mode before it goes to sleep on the wake signal.
+#define EXT_WORK_STEALING_SPIN_COUNT 64
+
 
 #if !defined(PX_X360) && !defined(PX_WIIU) && !defined(PX_PSP2)
 void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount)
@@ -41,8 +47,9 @@ void Ext::DefaultCpuDispatcher::getAffinityMasks(PxU32* affinityMasks, PxU32 thr
 #endif
 
 
-Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks)
-	: mQueueEntryPool(EXT_TASK_QUEUE_ENTRY_POOL_SIZE, "QueueEntryPool"), mNumThreads(numThreads), mShuttingDown(false)
+Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode)
+	: mQueueEntryPool(EXT_TASK_QUEUE_ENTRY_POOL_SIZE, "QueueEntryPool"), mNumThreads(numThreads), mMode(mode), mWorkerTlsIndex(0),
+	mSpinCount(EXT_WORK_STEALING_SPIN_COUNT), mNumParkedWorkers(0), mShuttingDown(false)
 #ifdef PX_PROFILE
 	,mRunProfiled(true)
 #else
@@ -57,6 +64,9 @@ Ext::DefaultCpuDispatcher::DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinit
 		getAffinityMasks(defaultAffinityMasks, numThreads);
 		affinityMasks = defaultAffinityMasks;
 	}
+
+	if(isWorkStealing())
+		mWorkerTlsIndex = Ps::TlsAlloc();
 	 
 	// initialize threads first, then start
 
@@ -112,6 +122,9 @@ Ext::DefaultCpuDispatcher::~DefaultCpuDispatcher()
 
 	if (mThreadNames)
 		PX_FREE(mThreadNames);
+
+	if(isWorkStealing())
+		Ps::TlsFree(mWorkerTlsIndex);
 }
 
 
@@ -129,6 +142,27 @@ void Ext::DefaultCpuDispatcher::submitTask(PxBaseTask& task)
 		return;
 	}	
 
+	if(isWorkStealing())
+	{
+		// tasks spawned by a worker go to the bottom of its own deque, everything else
+		// (or the overflow of a full deque) goes through the shared queue
+		CpuWorkerThread* worker = reinterpret_cast<CpuWorkerThread*>(Ps::TlsGet(mWorkerTlsIndex));
+		if(!worker || !worker->tryAcceptJobToWorkQueue(task))
+		{
+			SharedQueueEntry* entry = mQueueEntryPool.getEntry(&task);
+			if (!entry)
+				return;
+			mJobList.push(*entry);
+		}
+
+		// Pairs with the barrier in beginPark(): either a parking worker finds the task
+		// when it checks the queues again or we see it parked and wake it up.
+		Ps::memoryBarrier();
+		if(mNumParkedWorkers)
+			mWorkReady.set();
+		return;
+	}
+
 	// TODO: Could use TLS to make this more efficient
 	for(PxU32 i = 0; i < mNumThreads; ++i)
 	{
@@ -154,6 +188,16 @@ PxBaseTask* Ext::DefaultCpuDispatcher::fetchNextTask()
 	return task;
 }
 
+PxBaseTask* Ext::DefaultCpuDispatcher::fetchNextTask(CpuWorkerThread& worker)
+{
+	PxBaseTask* task = getJob();
+
+	if(!task)
+		task = stealJob(worker);
+
+	return task;
+}
+
 void Ext::DefaultCpuDispatcher::runTask(PxBaseTask& task)
 {
 	if(mRunProfiled)
@@ -198,6 +242,26 @@ PxBaseTask* Ext::DefaultCpuDispatcher::stealJob()
 }
 
 
+PxBaseTask* Ext::DefaultCpuDispatcher::stealJob(CpuWorkerThread& thief)
+{
+	// start at a random victim so that idle workers do not all hammer the same deque
+	const PxU32 start = thief.nextRandom() % mNumThreads;
+
+	for(PxU32 i = 0; i < mNumThreads; ++i)
+	{
+		CpuWorkerThread& victim = mWorkerThreads[(start + i) % mNumThreads];
+		if(&victim == &thief)
+			continue;
+
+		PxBaseTask* task = victim.stealFromWorkQueue();
+		if(task)
+			return task;
+	}
+
+	return NULL;
+}
+
+
 void Ext::DefaultCpuDispatcher::resetWakeSignal()
 {
 	mWorkReady.reset();
@@ -219,3 +283,17 @@ void Ext::DefaultCpuDispatcher::resetWakeSignal()
 	if (mShuttingDown)
 		mWorkReady.set();
 }
+
+
+void Ext::DefaultCpuDispatcher::beginPark()
+{
+	Ps::atomicIncrement(&mNumParkedWorkers);
+	resetWakeSignal();
+	Ps::memoryBarrier();
+}
+
+
+void Ext::DefaultCpuDispatcher::endPark()
+{
+	Ps::atomicDecrement(&mNumParkedWorkers);
+}
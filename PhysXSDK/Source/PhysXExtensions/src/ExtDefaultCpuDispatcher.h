@@ -46,7 +46,7 @@ namespace Ext
 		~DefaultCpuDispatcher();
 
 	public:
-		DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks);
+		DefaultCpuDispatcher(PxU32 numThreads, PxU32* affinityMasks, PxDefaultCpuDispatcherMode::Enum mode = PxDefaultCpuDispatcherMode::eSHARED_QUEUE);
 
 		//---------------------------------------------------------------------------------
 		// physx::CpuDispatcher implementation
@@ -68,12 +68,23 @@ namespace Ext
 		//---------------------------------------------------------------------------------
 		PxBaseTask*		getJob();
 		PxBaseTask*		stealJob();
+		PxBaseTask*		stealJob(CpuWorkerThread& thief);
 		PxBaseTask*		fetchNextTask();
+		PxBaseTask*		fetchNextTask(CpuWorkerThread& worker);
 		void			runTask(PxBaseTask& task);
 
     	void					waitForWork() { mWorkReady.wait(); }
 	    void					resetWakeSignal();
 
+		// work stealing mode: a worker announces it is about to sleep, then has to check
+		// the queues once more before waiting, see CpuWorkerThread::executeWorkStealing()
+		void					beginPark();
+		void					endPark();
+
+		PX_FORCE_INLINE bool	isWorkStealing()	const	{ return mMode == PxDefaultCpuDispatcherMode::eWORK_STEALING;	}
+		PX_FORCE_INLINE PxU32	getSpinCount()		const	{ return mSpinCount;											}
+		PX_FORCE_INLINE PxU32	getWorkerTlsIndex()	const	{ return mWorkerTlsIndex;										}
+
 		static void				getAffinityMasks(PxU32* affinityMasks, PxU32 threadCount);
 
 
@@ -84,6 +95,10 @@ namespace Ext
 				Ps::Sync						mWorkReady;
 				PxU8*							mThreadNames;
 				PxU32							mNumThreads;
+				PxDefaultCpuDispatcherMode::Enum	mMode;
+				PxU32							mWorkerTlsIndex;	// work stealing mode: maps worker threads to their CpuWorkerThread
+				PxU32							mSpinCount;			// work stealing mode: failed fetch rounds before a worker parks
+				volatile PxI32					mNumParkedWorkers;
 				bool							mShuttingDown;
 				bool							mRunProfiled;
 	};
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2008-2015, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+
+#ifndef PX_PHYSICS_EXTENSIONS_NP_WORK_STEALING_QUEUE_H
+#define PX_PHYSICS_EXTENSIONS_NP_WORK_STEALING_QUEUE_H
+
+#include "CmPhysXCommon.h"
+#include "PsAllocator.h"
+#include "PsAtomic.h"
+#include "PsBitUtils.h"
+#include "PsIntrinsics.h"
+
+
+namespace physx
+{
+	class PxBaseTask;
+}
+
+namespace physx
+{
+
+#define EXT_WORK_STEALING_QUEUE_SIZE 256	// must be a power of two
+
+namespace Ext
+{
+	/*
+	Fixed capacity Chase-Lev deque of tasks.
+
+	The owning worker pushes and pops at the bottom (LIFO, so continuation tasks run while their
+	data is still in cache) while other workers steal from the top. Only the owner may call push()
+	and pop(), steal() may be called from any thread. A failed push means the deque is full and the
+	caller has to fall back to the dispatcher's shared queue.
+
+	The indices grow monotonically and are only ever compared through their difference, so they are
+	allowed to wrap around.
+	*/
+	class WorkStealingQueue
+	{
+	public:
+		WorkStealingQueue() : mTasks(NULL), mCapacity(0), mTop(0), mBottom(0)	{}
+		~WorkStealingQueue()													{ release(); }
+
+		void init(PxU32 capacity)
+		{
+			PX_ASSERT(Ps::isPowerOfTwo(capacity));
+			mTasks = reinterpret_cast<PxBaseTask**>(PX_ALLOC(sizeof(PxBaseTask*) * capacity, PX_DEBUG_EXP("WorkStealingQueue")));
+			mCapacity = mTasks ? capacity : 0;
+			mTop = mBottom = 0;
+		}
+
+		void release()
+		{
+			if(mTasks)
+				PX_FREE(mTasks);
+			mTasks = NULL;
+			mCapacity = 0;
+		}
+
+		bool push(PxBaseTask& task)
+		{
+			const PxI32 bottom = mBottom;
+			const PxI32 top = mTop;
+			if(distance(top, bottom) >= PxI32(mCapacity))
+				return false;
+
+			mTasks[PxU32(bottom) & (mCapacity-1)] = &task;
+			Ps::memoryBarrier();	// publish the task before thieves can see the new bottom
+			mBottom = next(bottom);
+			return true;
+		}
+
+		PxBaseTask* pop()
+		{
+			const PxI32 bottom = PxI32(PxU32(mBottom) - 1);
+			mBottom = bottom;
+			Ps::memoryBarrier();	// the bottom update must be visible before we read top
+			const PxI32 top = mTop;
+
+			const PxI32 size = distance(top, bottom);
+			if(size < 0)
+			{
+				// empty, restore the canonical bottom == top state
+				mBottom = top;
+				return NULL;
+			}
+
+			PxBaseTask* task = mTasks[PxU32(bottom) & (mCapacity-1)];
+			if(size > 0)
+				return task;
+
+			// last task, race against the thieves for it
+			if(Ps::atomicCompareExchange(&mTop, next(top), top) != top)
+				task = NULL;
+			mBottom = next(top);
+			return task;
+		}
+
+		PxBaseTask* steal()
+		{
+			const PxI32 top = mTop;
+			Ps::memoryBarrier();
+			const PxI32 bottom = mBottom;
+			if(distance(top, bottom) <= 0)
+				return NULL;
+
+			PxBaseTask* task = mTasks[PxU32(top) & (mCapacity-1)];
+			if(Ps::atomicCompareExchange(&mTop, next(top), top) != top)
+				return NULL;	// lost against the owner or another thief
+
+			return task;
+		}
+
+		bool isEmpty() const
+		{
+			return distance(mTop, mBottom) <= 0;
+		}
+
+	private:
+		static PX_FORCE_INLINE PxI32 distance(PxI32 from, PxI32 to)	{ return PxI32(PxU32(to) - PxU32(from));	}
+		static PX_FORCE_INLINE PxI32 next(PxI32 index)					{ return PxI32(PxU32(index) + 1);			}
+
+		PxBaseTask**		mTasks;
+		PxU32				mCapacity;
+		volatile PxI32		mTop;
+		volatile PxI32		mBottom;
+	};
+
+} // namespace Ext
+
+}
+
+#endif
@@ -1702,8 +1702,11 @@ template<> struct PxEnumTraits< physx::PxParticleReadDataFlag::Enum > { PxEnumTr
 		{ "eDISABLE_CONTACT_REPORT_BUFFER_RESIZE", static_cast<PxU32>( physx::PxSceneFlag::eDISABLE_CONTACT_REPORT_BUFFER_RESIZE ) },
 		{ "eDISABLE_CONTACT_CACHE", static_cast<PxU32>( physx::PxSceneFlag::eDISABLE_CONTACT_CACHE ) },
 		{ "eREQUIRE_RW_LOCK", static_cast<PxU32>( physx::PxSceneFlag::eREQUIRE_RW_LOCK ) },
+		{ "eENABLE_SOLVER_SUB_ISLAND_SCHEDULING", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_SOLVER_SUB_ISLAND_SCHEDULING ) },
 		{ "eENABLE_STABILIZATION", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_STABILIZATION ) },
 		{ "eENABLE_AVERAGE_POINT", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_AVERAGE_POINT ) },
+		{ "eENABLE_CONTACT_DATA_BLOCK_GROWTH", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_CONTACT_DATA_BLOCK_GROWTH ) },
+		{ "eENABLE_BROADPHASE_PARKING", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_BROADPHASE_PARKING ) },
 		{ NULL, 0 }
 	};
 
@@ -1782,6 +1785,8 @@ template<> struct PxEnumTraits< physx::PxVisualizationParameter::Enum > { PxEnum
 		{ "eNONE", static_cast<PxU32>( physx::PxPruningStructure::eNONE ) },
 		{ "eDYNAMIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructure::eDYNAMIC_AABB_TREE ) },
 		{ "eSTATIC_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructure::eSTATIC_AABB_TREE ) },
+		{ "eSTATIC_QUANTIZED_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructure::eSTATIC_QUANTIZED_AABB_TREE ) },
+		{ "eDYNAMIC_REFIT_AABB_TREE", static_cast<PxU32>( physx::PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxPruningStructure::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -343,6 +343,7 @@ void PxVehicleWheelsDynData::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheelsDynData,			PxU32,							mUserDatas,				PxMetaDataFlag::ePTR)	
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheelsDynData,			PxU32,							mNbWheels4,				0)	
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheelsDynData,			PxU32,							mNbActiveWheels,		0)	
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheelsDynData,			PxReal,							mSuspensionQueryValidityRadius,	0)	
 	PX_DEF_BIN_METADATA_ITEMS_AUTO(stream,	PxVehicleWheelsDynData,			PxU32,							mPad,					PxMetaDataFlag::ePADDING)
 
 	PX_DEF_BIN_METADATA_EXTRA_ITEMS(stream,	PxVehicleWheelsDynData,			PxVehicleWheels4DynData,		mWheels4DynData,		mNbWheels4, 0, 0)
@@ -390,6 +391,10 @@ void PxVehicleWheels::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxU32,					mNbNonDrivenWheels,				0)	
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxU8,					mOnConstraintReleaseCounter,	0)	
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxU8,					mType,							0)	
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxU8,					mUpdateLOD,						0)	
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxU8,					mPad0,							PxMetaDataFlag::ePADDING)	
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxReal,					mLODUpdateInterval,				0)	
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels,	PxReal,					mLODAccumulatedTime,			0)	
 	PX_DEF_BIN_METADATA_ITEMS_AUTO(stream,	PxVehicleWheels,	PxU8,					mPad,							PxMetaDataFlag::ePADDING)
 }
 
@@ -497,6 +502,11 @@ void PxVehicleWheels4DynData::getBinaryMetaData(PxOutputStream& stream)
 	PX_DEF_BIN_METADATA_ITEMS_AUTO(stream,	PxVehicleWheels4DynData,	PxU8, 						mRaycastsOrCachedHitResults,	0)	
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels4DynData,	PxVehicleConstraintShader,	mVehicleConstraints,			PxMetaDataFlag::ePTR)
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels4DynData,	PxRaycastQueryResult,		mSqResults,						PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels4DynData,	PxSweepQueryResult,			mSqSweepResults,				PxMetaDataFlag::ePTR)
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels4DynData,	PxTransform,				mCachedHitQueryPose,			0)
+	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels4DynData,	PxF32,						mCachedHitValidityRadius,		0)
 	PX_DEF_BIN_METADATA_ITEM(stream,		PxVehicleWheels4DynData,	bool,						mHasCachedRaycastHitPlane,		0)
+#if defined(PX_P64)
 	PX_DEF_BIN_METADATA_ITEMS_AUTO(stream,	PxVehicleWheels4DynData,	PxU32,						mPad,							PxMetaDataFlag::ePADDING)
+#endif
 }
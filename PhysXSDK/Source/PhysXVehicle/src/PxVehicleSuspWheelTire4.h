@@ -20,6 +20,7 @@
 #include "PxSimpleTypes.h"
 #include "PxVec3.h"
 #include "PxVec4.h"
+#include "PxTransform.h"
 #include "PxBatchQueryDesc.h"
 
 #ifndef PX_DOXYGEN
@@ -159,7 +160,8 @@ public:
 	friend class PxVehicleUpdate;
 
 	PxVehicleWheels4DynData()
-		:	mSqResults(NULL)
+		:	mSqResults(NULL),
+			mSqSweepResults(NULL)
 	{
 		setToRestState();
 	}
@@ -185,6 +187,9 @@ public:
 		PxMemZero(&mRaycastsOrCachedHitResults, sizeof(SuspLineRaycast));
 
 		mSqResults = NULL;
+		mSqSweepResults = NULL;
+		mCachedHitQueryPose = PxTransform(PxIdentity);
+		mCachedHitValidityRadius = 0.0f;
 		mHasCachedRaycastHitPlane = false;
 	}
 
@@ -304,10 +309,32 @@ public:
 
 	/**
 	\brief Set by PxVehicle4WSuspensionRaycasts
+	\note mRaycastsOrCachedHitResults stores the raycasts while mSqResults or mSqSweepResults is non-null and the cached hit results otherwise.
+	Both are set to NULL when the cached hit results are recorded at the end of PxVehicleUpdates.
 	@see PxVehicle4WSuspensionRaycasts
 	*/
 	const PxRaycastQueryResult* mSqResults;
 
+	/**
+	\brief Set by PxVehicleSuspensionSweeps
+	@see PxVehicleSuspensionSweeps
+	*/
+	const PxSweepQueryResult* mSqSweepResults;
+
+	/**
+	\brief Chassis transform at the most recent suspension query.
+	Coherent suspension queries reuse the cached hit planes while each wheel stays within 
+	mCachedHitValidityRadius of its position at this transform.
+	@see PxVehicleWheelsDynData::setSuspensionQueryValidityRadius
+	*/
+	PxTransform mCachedHitQueryPose;
+
+	/**
+	\brief Radius of the volume around each wheel in which the cached hit planes may be reused.
+	Zero if the cached hit planes must be refreshed by the next suspension query.
+	*/
+	PxF32 mCachedHitValidityRadius;
+
 	/**
 	\brief Set true if a raycast hit plane has been recorded and cached.
 	This requires a raycast to be performed and then followed by PxVehicleUpdates
@@ -316,10 +343,8 @@ public:
 	bool mHasCachedRaycastHitPlane;
 
 
-#if !defined(PX_P64)
+#if defined(PX_P64)
 	PxU32 mPad[1];
-#else
-	PxU32 mPad[3];
 #endif
 };
 PX_COMPILE_TIME_ASSERT(0==(sizeof(PxVehicleWheels4DynData) & 15));
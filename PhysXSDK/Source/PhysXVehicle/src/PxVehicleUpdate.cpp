@@ -26,6 +26,11 @@
 #include "PxShape.h"
 #include "PxRigidDynamic.h"
 #include "PxBatchQuery.h"
+#include "PxSphereGeometry.h"
+#include "PxGeometryHelpers.h"
+#include "PxScene.h"
+#include "pxtask/PxTask.h"
+#include "pxtask/PxCpuDispatcher.h"
 #include "PxHeightField.h"
 #include "PxTriangleMesh.h"
 #include "PxHeightFieldGeometry.h"
@@ -36,6 +41,9 @@
 #include "PxRigidBodyExt.h"
 #include "PsFoundation.h"
 #include "PsUtilities.h"
+#include "PsSync.h"
+#include "PsAtomic.h"
+#include "PsInlineArray.h"
 #include "CmBitMap.h"
 #include "PsTime.h"
 #include "PxSceneLock.h"
@@ -171,6 +179,7 @@ enum
 	ePROFILE_RAYCASTS=0,
 	ePROFILE_UPDATES,
 	ePROFILE_POSTUPDATES,
+	ePROFILE_SWEEPS,
 	eMAX_NUM_PROFILES
 };
 
@@ -178,14 +187,16 @@ char gVehicleProfileZoneEventNames[eMAX_NUM_PROFILES][64] =
 {
 	"PxVehicleSuspensionRaycasts", 
 	"PxVehicleUpdates",
-	"PxVehiclePostUpdates"
+	"PxVehiclePostUpdates",
+	"PxVehicleSuspensionSweeps"
 };
 
 PxProfileEventName gProfileEventNames[eMAX_NUM_PROFILES] =
 {
 	PxProfileEventName(gVehicleProfileZoneEventNames[ePROFILE_RAYCASTS], ePROFILE_RAYCASTS),
 	PxProfileEventName(gVehicleProfileZoneEventNames[ePROFILE_UPDATES], ePROFILE_UPDATES),
-	PxProfileEventName(gVehicleProfileZoneEventNames[ePROFILE_POSTUPDATES], ePROFILE_POSTUPDATES)
+	PxProfileEventName(gVehicleProfileZoneEventNames[ePROFILE_POSTUPDATES], ePROFILE_POSTUPDATES),
+	PxProfileEventName(gVehicleProfileZoneEventNames[ePROFILE_SWEEPS], ePROFILE_SWEEPS)
 };
 
 class VehicleEventNameProvider : public PxProfileNameProvider
@@ -1029,6 +1040,24 @@ PX_INLINE void computeSuspensionRaycast
 	suspLineStart-=suspLineDir*(radius+maxBounce);
 }
 
+////////////////////////////////////////////////////////////////////////////
+//Return the blocking hit of the ith wheel recorded by the most recent 
+//suspension raycasts or sweeps, or NULL if there is no hit to process.
+////////////////////////////////////////////////////////////////////////////
+
+PX_FORCE_INLINE const PxLocationHit* getSuspensionQueryHit(const PxVehicleWheels4DynData& wheels4DynData, const PxU32 i)
+{
+	if(wheels4DynData.mSqResults)
+	{
+		return wheels4DynData.mSqResults[i].hasBlock ? &wheels4DynData.mSqResults[i].block : NULL;
+	}
+	else if(wheels4DynData.mSqSweepResults)
+	{
+		return wheels4DynData.mSqSweepResults[i].hasBlock ? &wheels4DynData.mSqSweepResults[i].block : NULL;
+	}
+	return NULL;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////
 //Functions used to integrate rigid body transform and velocity.
@@ -2175,6 +2204,69 @@ void PxVehicleComputeTireForceDefault
 	tireAlignMoment=fMy;
 }
 
+////////////////////////////////////////////////////////////////////////////
+//Tire force function of vehicles updated with PxVehicleUpdateLOD::eSIMPLIFIED.
+//The forces are linear in the slips and clamped to the friction circle, which 
+//matches the default tire model at small slips without any of its trig functions.
+//No camber force and no aligning moment.
+////////////////////////////////////////////////////////////////////////////
+
+void computeTireForceSimplified
+(const void* tireShaderData, 
+ const PxF32 tireFriction,
+ const PxF32 longSlipUnClamped, const PxF32 latSlipUnClamped, const PxF32 camberUnclamped,
+ const PxF32 wheelOmega, const PxF32 wheelRadius, const PxF32 recipWheelRadius,
+ const PxF32 restTireLoad, const PxF32 normalisedTireLoad, const PxF32 tireLoad,
+ const PxF32 gravity, const PxF32 recipGravity,
+ PxF32& wheelTorque, PxF32& tireLongForceMag, PxF32& tireLatForceMag, PxF32& tireAlignMoment)
+{
+	PX_UNUSED(camberUnclamped);
+	PX_UNUSED(wheelOmega);
+	PX_UNUSED(recipWheelRadius);
+	PX_UNUSED(restTireLoad);
+	PX_UNUSED(normalisedTireLoad);
+	PX_UNUSED(recipGravity);
+
+	const PxVehicleTireData& tireData=*((PxVehicleTireData*)tireShaderData);
+
+	PX_ASSERT(tireFriction>0);
+	PX_ASSERT(tireLoad>0);
+
+	wheelTorque=0.0f;
+	tireLongForceMag=0.0f;
+	tireLatForceMag=0.0f;
+	tireAlignMoment=0.0f;
+
+	//Clamp the slips to a minimum value.
+	const PxF32 latSlip = PxAbs(latSlipUnClamped) >= gMinimumSlipThreshold ? latSlipUnClamped : 0.0f;
+	const PxF32 longSlip = PxAbs(longSlipUnClamped) >= gMinimumSlipThreshold ? longSlipUnClamped : 0.0f;
+	if((0==latSlip)&&(0==longSlip))
+	{
+		return;
+	}
+
+	//Lateral stiffness proportional to the tire load, constant longitudinal stiffness.
+	const PxF32 latStiff=tireLoad*tireData.mLatStiffY;
+	const PxF32 longStiff=tireData.mLongitudinalStiffnessPerUnitGravity*gravity;
+	PxF32 fz=longStiff*longSlip;
+	PxF32 fx=-latStiff*latSlip;
+
+	//Clamp the combined force to the friction circle.
+	const PxF32 maxForce=tireFriction*tireLoad;
+	const PxF32 forceSquared=fz*fz + fx*fx;
+	if(forceSquared > maxForce*maxForce)
+	{
+		const PxF32 scale=maxForce*PxRecipSqrt(forceSquared);
+		fz*=scale;
+		fx*=scale;
+	}
+
+	//We can add the torque to the wheel.
+	wheelTorque=-fz*wheelRadius;
+	tireLongForceMag=fz;
+	tireLatForceMag=fx;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //Structures used to process blocks of 4 wheels:  process the raycast result,
 //compute the suspension and tire force, store a number of report variables 
@@ -2403,6 +2495,48 @@ public:
 //6.  record telemetry data (if necessary) and record data for reporting such as hit material, hit normal etc.
 ////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////
+//Compute the hit plane and the friction of the hit recorded by the most recent 
+//suspension raycasts or sweeps for the ith wheel of a block of 4 wheels.
+////////////////////////////////////////////////////////////////////////////
+
+PX_FORCE_INLINE void computeSuspensionQueryHitData
+(const PxLocationHit& hit, const PxVehicleWheels4SimData& wheels4SimData, const PxVehicleWheels4DynData& wheels4DynData, const PxU32 i,
+ const PxVehicleDrivableSurfaceToTireFrictionPairs& frictionPairs,
+ PxVec4& hitPlane, PxF32& frictionMultiplier, PxMaterial*& material, PxU32& surfaceType)
+{
+	//Hit plane.
+	//A sweep reports the contact point and the normal of the surface touched by the wheel.  The jounce is computed
+	//from the point where the suspension line meets the hit plane so move the plane along its normal until it passes 
+	//through the base of a wheel of radius r touching the surface: d' = d - r(1 + n.w).  On flat ground n.w=-1 and 
+	//the plane is the same as the plane found by a raycast.
+	const PxVec3 hitNorm=hit.normal;
+	PxF32 hitD=-hitNorm.dot(hit.position);
+	if(wheels4DynData.mSqSweepResults)
+	{
+		const PxVehicleWheels4DynData::SuspLineRaycast& suspLineRaycast = 
+			(const PxVehicleWheels4DynData::SuspLineRaycast&)wheels4DynData.mRaycastsOrCachedHitResults;
+		hitD-=wheels4SimData.getWheelData(i).mRadius*(1.0f + hitNorm.dot(suspLineRaycast.mDirs[i]));
+	}
+	hitPlane=PxVec4(hitNorm, hitD);
+
+	//Hit friction.
+	surfaceType=0;
+	{
+		//Only get the material if the raycast started outside the hit shape.
+		material = (hit.distance != 0.0f) ? hit.shape->getMaterialFromInternalFaceIndex(hit.faceIndex) : NULL; 
+	}
+	//Hash table for quick lookup of drivable surface type from material.
+	VehicleSurfaceTypeHashTable surfaceTypeHashTable(frictionPairs);
+	if(NULL!=material)
+	{
+		surfaceType=surfaceTypeHashTable.get(material);
+	}
+	const PxVehicleTireData& tire=wheels4SimData.getTireData(i);
+	frictionMultiplier=frictionPairs.getTypePairFriction(surfaceType,tire.mType);
+	PX_ASSERT(frictionMultiplier>=0);
+}
+
 void processSuspTireWheels
 (const PxU32 startWheelIndex, 
  const ProcessSuspWheelTireConstData& constData, const ProcessSuspWheelTireInputData& inputData, 
@@ -2534,48 +2668,33 @@ void processSuspTireWheels
 	PxU32 hitSurfaceTypes4[4];
 	PxVec3 hitContactPoints4[4];
 	PxVec3 hitContactNormals4[4];
-	const PxRaycastQueryResult* PX_RESTRICT sqResults=inputData.vehWheels4DynData->mSqResults;
-	if(sqResults)
+	const PxVehicleWheels4DynData& wheels4DynData=*inputData.vehWheels4DynData;
+	if(wheels4DynData.mSqResults || wheels4DynData.mSqSweepResults)
 	{
 		for(PxU32 i=0;i<inputData.numActiveWheels;i++)
 		{
-			const PxU32 hitCount=PxU32(sqResults[i].hasBlock);
+			const PxLocationHit* hitPtr=getSuspensionQueryHit(wheels4DynData, i);
+			const PxU32 hitCount=PxU32(NULL!=hitPtr);
 			if(hitCount)
 			{
-				const PxRaycastHit& hit=sqResults[i].block;
+				const PxLocationHit& hit=*hitPtr;
 
 				//Test that the hit actor isn't the vehicle itself.
 				PX_CHECK_AND_RETURN(constData.vehActor != hit.actor, "Vehicle raycast has hit itself.  Please check the filter data to avoid this.");
 
 				//Hit count.
-				hitCounts4[i]=PxU32(sqResults[i].hasBlock);
+				hitCounts4[i]=hitCount;
 
 				//Hit distance.
 				hitDistances4[i]=hit.distance;
 
-				//Hit plane.
-				const PxVec3 hitPos=hit.position;
-				const PxVec3 hitNorm=hit.normal;
-				const PxF32 hitD=-hitNorm.dot(hitPos);
-				hitPlanes4[i]=PxVec4(hitNorm, hitD);
-
-				//Hit friction.
-				PxU32 surfaceType=0;
-				PxMaterial* material = NULL;
-				{
-					//Only get the material if the raycast started outside the hit shape.
-					material = (hit.distance != 0.0f) ? hit.shape->getMaterialFromInternalFaceIndex(hit.faceIndex) : NULL; 
-				}
-				//Hash table for quick lookup of drivable surface type from material.
-				const PxVehicleDrivableSurfaceToTireFrictionPairs* PX_RESTRICT frictionPairs=constData.frictionPairs;
-				VehicleSurfaceTypeHashTable surfaceTypeHashTable(*constData.frictionPairs);
-				if(NULL!=material)
-				{
-					surfaceType=surfaceTypeHashTable.get(material);
-				}
-				const PxVehicleTireData& tire=inputData.vehWheels4SimData->getTireData(i);
-				const PxF32 frictionMultiplier=frictionPairs->getTypePairFriction(surfaceType,tire.mType);
-				PX_ASSERT(frictionMultiplier>=0);
+				//Hit plane and hit friction.
+				PxVec4 hitPlane;
+				PxF32 frictionMultiplier;
+				PxMaterial* material;
+				PxU32 surfaceType;
+				computeSuspensionQueryHitData(hit, *inputData.vehWheels4SimData, wheels4DynData, i, *constData.frictionPairs, hitPlane, frictionMultiplier, material, surfaceType);
+				hitPlanes4[i]=hitPlane;
 				hitFrictionMultipliers4[i]=frictionMultiplier;
 
 				//Hit report.
@@ -2588,7 +2707,7 @@ void processSuspTireWheels
 
 				//When we're finished here we need to copy this back to the vehicle.
 				cachedHitCounts[i]=hitCount;
-				cachedHitPlanes[i]=PxVec4(hitNorm, hitD);
+				cachedHitPlanes[i]=hitPlane;
 				cachedHitDistances[i]=hit.distance;
 				cachedFrictionMultipliers[i]=frictionMultiplier;
 			}
@@ -3025,7 +3144,7 @@ void updateCachedHitData
 (const PxU32* PX_RESTRICT cachedHitCounts, const PxVec4* PX_RESTRICT cachedHitPlanes, const PxF32* PX_RESTRICT cachedHitDistances, const PxF32* PX_RESTRICT cachedFrictionMultipliers, 
  PxVehicleWheels4DynData* wheels4DynData)
 {
-	if(wheels4DynData->mSqResults)
+	if(wheels4DynData->mSqResults || wheels4DynData->mSqSweepResults)
 	{
 		wheels4DynData->mHasCachedRaycastHitPlane = true;
 	}
@@ -3040,6 +3159,10 @@ void updateCachedHitData
 		cachedRaycastHitResults->mDistances[i]=cachedHitDistances[i];
 		cachedRaycastHitResults->mFrictionMultipliers[i]=cachedFrictionMultipliers[i];
 	}
+
+	//The scene query results have been consumed and the union now holds the cached hit results.
+	wheels4DynData->mSqResults = NULL;
+	wheels4DynData->mSqSweepResults = NULL;
 }
 
 
@@ -3738,6 +3861,35 @@ void integrateNoDriveWheelSpeeds
 	vehSuspWheelTire4.mWheelSpeeds[3]=result[3];
 }
 
+////////////////////////////////////////////////////////////////////////////
+//Integrate the wheel rotation speeds of a vehicle updated with the simplified model.
+//The engine is rigidly coupled to the driven wheels through the gearbox so each 
+//driven wheel also carries its share of the engine's inertia and damping.
+////////////////////////////////////////////////////////////////////////////
+
+void integrateSimplifiedWheelSpeeds
+(const PxF32 subTimestep, 
+ const PxF32* PX_RESTRICT brakeTorques, const bool* PX_RESTRICT isBrakeApplied, const PxF32* driveTorques, const PxF32* PX_RESTRICT tireTorques, 
+ const PxF32* PX_RESTRICT engineMOIs, const PxF32* PX_RESTRICT engineDampingRates,
+ const PxVehicleWheels4SimData& vehSuspWheelTire4SimData, PxVehicleWheels4DynData& vehSuspWheelTire4)
+{
+	//Same implicit integration as integrateNoDriveWheelSpeeds with the engine inertia and 
+	//damping added to the inertia and damping of each wheel.
+	//w(t+dt)  = [w(t) + torque*dt/inertia]/[1 + damping*dt/inertia]
+	PxF32* PX_RESTRICT wheelSpeeds=vehSuspWheelTire4.mWheelSpeeds;
+	for(PxU32 j=0;j<4;j++)
+	{
+		const PxVehicleWheelData& wheelData=vehSuspWheelTire4SimData.getWheelData(j);
+		const PxF32 dtOverInertia=subTimestep/(wheelData.mMOI + engineMOIs[j]);
+		const PxF32 dampingRate=wheelData.mDampingRate + engineDampingRates[j];
+		PxF32 result=(wheelSpeeds[j] + dtOverInertia*(tireTorques[j] + driveTorques[j] + brakeTorques[j]))/(1.0f + dampingRate*dtOverInertia);
+
+		//If the brakes are on and the wheel has switched direction then lock it at zero.
+		result=(isBrakeApplied[j] && (wheelSpeeds[j]*result<=0)) ? 0.0f : result;
+		wheelSpeeds[j]=result;
+	}
+}
+
 void integrateUndriveWheelRotationSpeeds
 (const PxF32 subTimestep, 
  const PxF32 brake, const PxF32 handbrake, const PxF32* PX_RESTRICT tireTorques, const PxF32* PX_RESTRICT brakeTorques, 
@@ -3978,11 +4130,27 @@ public:
 	static void updatePost(
 		const PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates, const PxU32 numVehicles, PxVehicleWheels** vehicles);
 
+	static void updateParallel(
+		const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+		const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* wheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+		PxCpuDispatcher& dispatcher);
+
 	static void suspensionRaycasts(
 		PxBatchQuery* batchQuery, 
 		const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxRaycastQueryResult* sceneQueryResults,
 		const bool* vehiclesToRaycast);
 
+	static void suspensionSweeps(
+		PxBatchQuery* batchQuery, 
+		const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxSweepQueryResult* sceneQueryResults,
+		const bool* vehiclesToSweep);
+
+	static void suspensionQueries(
+		PxBatchQuery* batchQuery, 
+		const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, 
+		PxRaycastQueryResult* raycastResults, PxSweepQueryResult* sweepResults,
+		const bool* vehiclesToQuery);
+
 	static void updateDrive4W(
 		const PxF32 timestep, 
 		const PxVec3& gravity, const PxF32 gravityMagnitude, const PxF32 recipGravityMagnitude, 
@@ -4007,6 +4175,16 @@ public:
 		const PxVehicleDrivableSurfaceToTireFrictionPairs& drivableSurfaceToTireFrictionPairs,
 		PxVehicleNoDrive* vehDriveTank, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleConcurrentUpdateData* vehConcurrentUpdates);
 
+	static void updateSimplified(
+		const PxF32 timestep, 
+		const PxVec3& gravity, const PxF32 gravityMagnitude, const PxF32 recipGravityMagnitude, 
+		const PxVehicleDrivableSurfaceToTireFrictionPairs& drivableSurfaceToTireFrictionPairs,
+		PxVehicleWheels* vehWheels, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleConcurrentUpdateData* vehConcurrentUpdates);
+
+	static void scaleLODUpdate(const PxF32 momentumScale, const PxVehicleWheels& vehWheels, PxVehicleConcurrentUpdateData& vehConcurrentUpdates);
+
+	static PxU32 computeVehicleUpdateCost(const PxVehicleWheels& vehWheels, const PxF32 timestep);
+
 	static PxU32 computeNumberOfSubsteps(const PxVehicleWheelsSimData& wheelsSimData, const PxVec3& linVel, const PxTransform& globalPose, const PxVec3& forward)
 	{
 		const PxVec3 z=globalPose.q.rotate(forward);
@@ -4069,9 +4247,8 @@ public:
 			{
 				if(!wheelsSimData.getIsWheelDisabled(4*i + j))
 				{
-					const PxU32 hitCount=PxU32(wheels4DynDatas[i].mSqResults[j].hasBlock);
-					const PxRaycastHit& hit=wheels4DynDatas[i].mSqResults[j].block;
-					if(hitCount && hit.actor && hit.actor->is<PxRigidDynamic>())
+					const PxLocationHit* hit=getSuspensionQueryHit(wheels4DynDatas[i], j);
+					if(hit && hit->actor && hit->actor->is<PxRigidDynamic>())
 					{
 						return true;
 					}
@@ -4082,9 +4259,44 @@ public:
 		return false;
 	}
 
+	//Cache the hit planes of suspension queries that won't be processed because the vehicle stays asleep.
+	//This keeps the cached hit planes valid for later updates that don't issue suspension queries.
+	static void cacheSuspensionQueryHits(const PxVehicleWheelsSimData& wheelsSimData, PxVehicleWheelsDynData& wheelsDynData, const PxVehicleDrivableSurfaceToTireFrictionPairs& frictionPairs)
+	{
+		const PxU32 numWheels4=wheelsSimData.mNbWheels4;
+		for(PxU32 i=0;i<numWheels4;i++)
+		{
+			const PxVehicleWheels4SimData& wheels4SimData=wheelsSimData.mWheels4SimData[i];
+			PxVehicleWheels4DynData& wheels4DynData=wheelsDynData.mWheels4DynData[i];
+			if(wheels4DynData.mSqResults || wheels4DynData.mSqSweepResults)
+			{
+				const PxU32 numActiveWheels=PxMin(wheelsSimData.mNbActiveWheels - 4*i, PxU32(4));
+
+				PxU32 cachedHitCounts[4]={0,0,0,0};
+				PxVec4 cachedHitPlanes[4]={PxVec4(0,0,0,0),PxVec4(0,0,0,0),PxVec4(0,0,0,0),PxVec4(0,0,0,0)};
+				PxF32 cachedHitDistances[4]={0,0,0,0};
+				PxF32 cachedFrictionMultipliers[4]={0,0,0,0};
+				for(PxU32 j=0;j<numActiveWheels;j++)
+				{
+					const PxLocationHit* hit=getSuspensionQueryHit(wheels4DynData, j);
+					if(hit)
+					{
+						PxMaterial* material;
+						PxU32 surfaceType;
+						computeSuspensionQueryHitData(*hit, wheels4SimData, wheels4DynData, j, frictionPairs, cachedHitPlanes[j], cachedFrictionMultipliers[j], material, surfaceType);
+						cachedHitCounts[j]=1;
+						cachedHitDistances[j]=hit->distance;
+					}
+				}
+
+				updateCachedHitData(cachedHitCounts, cachedHitPlanes, cachedHitDistances, cachedFrictionMultipliers, &wheels4DynData);
+			}
+		}
+	}
+
 	PX_INLINE static void storeRaycasts(const PxVehicleWheels4DynData& dynData, PxWheelQueryResult* wheelQueryResults)
 	{
-		if(dynData.mSqResults)
+		if(dynData.mSqResults || dynData.mSqSweepResults)
 		{
 			for(PxU32 i=0;i<4;i++)
 			{
@@ -4263,6 +4475,7 @@ PxVehicleDrive4W* vehDrive4W, PxVehicleWheelQueryResult* vehWheelQueryResults, P
 			//No driving inputs and the actor is asleep.
 			//Set internal dynamics to zero.
 			setInternalDynamicsToZero(vehDrive4W);
+			cacheSuspensionQueryHits(vehDrive4W->mWheelsSimData, vehDrive4W->mWheelsDynData, drivableSurfaceToTireFrictionPairs);
 			if(vehConcurrentUpdates) vehConcurrentUpdates->staySleeping = true;
 			return;
 		}
@@ -4832,6 +5045,7 @@ void PxVehicleUpdate::updateDriveNW
 				//No driving inputs and the actor is asleep.
 				//Set internal dynamics to sleep.
 				setInternalDynamicsToZero(vehDriveNW);
+				cacheSuspensionQueryHits(vehDriveNW->mWheelsSimData, vehDriveNW->mWheelsDynData, drivableSurfaceToTireFrictionPairs);
 				if(vehConcurrentUpdates) vehConcurrentUpdates->staySleeping = true;
 				return;
 			}
@@ -5335,6 +5549,7 @@ void PxVehicleUpdate::updateTank
 				//No driving inputs and the actor is asleep.
 				//Set internal dynamics to sleep.
 				setInternalDynamicsToZero(vehDriveTank);
+				cacheSuspensionQueryHits(vehDriveTank->mWheelsSimData, vehDriveTank->mWheelsDynData, drivableSurfaceToTireFrictionPairs);
 				if(vehConcurrentUpdates) vehConcurrentUpdates->staySleeping = true;
 				return;
 			}
@@ -5770,6 +5985,7 @@ void PxVehicleUpdate::updateNoDrive
 				//No driving inputs and the actor is asleep.
 				//Set internal dynamics to sleep.
 				setInternalDynamicsToZero(vehNoDrive);
+				cacheSuspensionQueryHits(vehNoDrive->mWheelsSimData, vehNoDrive->mWheelsDynData, drivableSurfaceToTireFrictionPairs);
 				if(vehConcurrentUpdates) vehConcurrentUpdates->staySleeping = true;
 				return;
 			}
@@ -6007,173 +6223,667 @@ void PxVehicleUpdate::updateNoDrive
 }
 
 
-void PxVehicleUpdate::shiftOrigin(const PxVec3& shift, const PxU32 numVehicles, PxVehicleWheels** vehicles)
+void PxVehicleUpdate::updateSimplified
+(const PxF32 timestep, 
+ const PxVec3& gravity, const PxF32 gravityMagnitude, const PxF32 recipGravityMagnitude,
+ const PxVehicleDrivableSurfaceToTireFrictionPairs& drivableSurfaceToTireFrictionPairs,
+ PxVehicleWheels* vehWheels, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleConcurrentUpdateData* vehConcurrentUpdates)
 {
-	for(PxU32 i=0; i < numVehicles; i++)
-	{
-		//Get the current car.
-		PxVehicleWheels& veh = *vehicles[i];
-		PxVehicleWheels4DynData* PX_RESTRICT wheels4DynData=veh.mWheelsDynData.mWheels4DynData;
-		const PxU32 numWheels4=veh.mWheelsSimData.mNbWheels4;
-
-		//Blocks of 4 wheels.
-		for(PxU32 j=0; j < numWheels4; j++)
-		{
-			bool activeWheelStates[4]={false,false,false,false};
-			computeWheelActiveStates(4*j, veh.mWheelsSimData.mActiveWheelsBitmapBuffer, activeWheelStates);
-
-			if (wheels4DynData[j].mSqResults)  // this is set when a query has been scheduled
-			{
-				PxVehicleWheels4DynData::SuspLineRaycast& raycast = 
-					(PxVehicleWheels4DynData::SuspLineRaycast&)wheels4DynData[j].mRaycastsOrCachedHitResults;
-				
-				for(PxU32 k=0; k < 4; k++)
-				{
-					if (activeWheelStates[k])
-					{
-						raycast.mStarts[k] -= shift;
-
-						if (wheels4DynData[j].mSqResults[k].hasBlock)
-							const_cast<PxVec3&>(wheels4DynData[j].mSqResults[k].block.position) -= shift;
-					}
-				}
-			}
-		}
-	}
-}
-
-}//namespace physx
-
-#if PX_DEBUG_VEHICLE_ON
-
-/////////////////////////////////////////////////////////////////////////////////
-//Update a single vehicle of any type and record the associated telemetry data.
-/////////////////////////////////////////////////////////////////////////////////
+	PX_SIMD_GUARD; // denorm exception in transformInertiaTensor() on osx
 
-void PxVehicleUpdate::updateSingleVehicleAndStoreTelemetryData
-(const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
- PxVehicleWheels* vehWheels, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleTelemetryData& telemetryData)
-{
-	START_TIMER(TIMER_ALL);
+	PX_CHECK_AND_RETURN(
+		!(vehWheels->getRigidDynamicActor()->getRigidBodyFlags() & PxRigidBodyFlag::eKINEMATIC),
+		"Attempting to update a vehicle with a kinematic actor - this isn't allowed");
 
-	PX_CHECK_MSG(gravity.magnitude()>0, "gravity vector must have non-zero length");
-	PX_CHECK_MSG(timestep>0, "timestep must be greater than zero");
-	PX_CHECK_AND_RETURN(gThresholdForwardSpeedForWheelAngleIntegration>0, "PxInitVehicleSDK needs to be called before ever calling PxVehicleUpdateSingleVehicleAndStoreTelemetryData");
-	PX_CHECK_MSG(vehWheels->mWheelsSimData.getNbWheels()==telemetryData.getNbWheelGraphs(), "vehicle and telemetry data need to have the same number of wheels");
-	PX_CHECK_AND_RETURN(NULL==vehWheelQueryResults || vehWheelQueryResults->nbWheelQueryResults >= vehWheels->mWheelsSimData.getNbWheels(),
+	PX_CHECK_AND_RETURN(
+		NULL==vehWheelQueryResults || vehWheelQueryResults->nbWheelQueryResults >= vehWheels->mWheelsSimData.getNbWheels(), 
 		"nbWheelQueryResults must always be greater than or equal to number of wheels in corresponding vehicle");
 
-#ifdef PX_CHECKED
-	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbWheels4;i++)
-	{
-		PX_CHECK_MSG(vehWheels->mWheelsDynData.mWheels4DynData[i].mSqResults, "Need to call PxVehicle4WSuspensionRaycasts before trying to update");
-	}
-	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
-	{
-		PX_CHECK_MSG(vehWheels->mWheelsDynData.mTireForceCalculators->mShaderData[i], "Need to set non-null tire force shader data ptr");
-	}
-	PX_CHECK_MSG(vehWheels->mWheelsDynData.mTireForceCalculators->mShader, "Need to set non-null tire force shader function");
-
-	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
-	{
-		PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(i) || -1==vehWheels->mWheelsSimData.getWheelShapeMapping(i), 
-			"Disabled wheels must not be associated with a PxShape:  use setWheelShapeMapping to remove the association");
-		PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(i) || 0==vehWheels->mWheelsDynData.getWheelRotationSpeed(i), 
-			"Disabled wheels must have zero rotation speed:  use setWheelRotationSpeed to set the wheel to zero rotation speed");
-	}
-#endif
-
-	PxF32 engineGraphData[PxVehicleDriveGraphChannel::eMAX_NB_DRIVE_CHANNELS];
-	PxMemZero(&engineGraphData[0], PxVehicleDriveGraphChannel::eMAX_NB_DRIVE_CHANNELS*sizeof(PxF32));
-	gCarEngineGraphData=engineGraphData;
-
-	PxF32 wheelGraphData[PX_MAX_NB_WHEELS][PxVehicleWheelGraphChannel::eMAX_NB_WHEEL_CHANNELS];
-	PxMemZero(&wheelGraphData[0][0], PX_MAX_NB_WHEELS*PxVehicleWheelGraphChannel::eMAX_NB_WHEEL_CHANNELS*sizeof(PxF32));
-	for(PxU32 i=0;i<4*vehWheels->mWheelsSimData.mNbWheels4;i++)
-	{
-		gCarWheelGraphData[i]=wheelGraphData[i];
-	}
-	for(PxU32 i=4*vehWheels->mWheelsSimData.mNbWheels4; i<PX_MAX_NB_WHEELS;i++)
-	{
-		gCarWheelGraphData[i]=NULL;
-	}
-
-	PxVec3 suspForceAppPoints[PX_MAX_NB_WHEELS];
-	PxMemZero(suspForceAppPoints, PX_MAX_NB_WHEELS*sizeof(PxVec3));
-	gCarSuspForceAppPoints=suspForceAppPoints;
-
-	PxVec3 tireForceAppPoints[PX_MAX_NB_WHEELS];
-	PxMemZero(tireForceAppPoints, PX_MAX_NB_WHEELS*sizeof(PxVec3));
-	gCarTireForceAppPoints=tireForceAppPoints;
+	//Unpack the simulation and instanced dynamics components.
+	const PxVehicleWheels4SimData* wheels4SimDatas=vehWheels->mWheelsSimData.mWheels4SimData;
+	const PxVehicleTireLoadFilterData& tireLoadFilterData=vehWheels->mWheelsSimData.mNormalisedLoadFilter;
+	PxVehicleWheels4DynData* wheels4DynDatas=vehWheels->mWheelsDynData.mWheels4DynData;
+	const PxU32 numWheels4=vehWheels->mWheelsSimData.mNbWheels4;
+	const PxU32 numActiveWheels=vehWheels->mWheelsSimData.mNbActiveWheels;
+	const PxU32 numActiveWheelsInLast4=4-(4*numWheels4-numActiveWheels);
+	PxRigidDynamic* vehActor=vehWheels->mActor;
+	const bool isTank=(PxVehicleTypes::eDRIVETANK==vehWheels->mType);
 
-	const PxF32 gravityMagnitude=gravity.magnitude();
-	const PxF32 recipGravityMagnitude=1.0f/gravityMagnitude;
+	//We need to store that data we are going to write to actors so we can do this at the end in one go with fewer write locks.
+	PxVehicleWheelConcurrentUpdateData wheelConcurrentUpdates[PX_MAX_NB_WHEELS];
+	PxVehicleConcurrentUpdateData vehicleConcurrentUpdates;
+	vehicleConcurrentUpdates.nbConcurrentWheelUpdates = numActiveWheels;
+	vehicleConcurrentUpdates.concurrentWheelUpdates = wheelConcurrentUpdates;
 
+	//Gather the control values, steer angles and the split of the drive torque between the wheels.
+	//Vehicles with an engine deliver the engine torque through the current gear and the differential 
+	//straight to the wheels.  The engine isn't integrated, it follows the speed of the driven wheels.
+	const PxVehicleDriveSimData* driveSimData=NULL;
+	PxVehicleDriveDynData* driveDynData=NULL;
+	PxVehicleNoDrive* vehNoDrive=NULL;
+	PxU32 accelIndex=0;
+	PxF32 accel=0.0f;
+	PxF32 brake=0.0f;
+	PxF32 handbrake=0.0f;
+	PxF32 brakeLeft=0.0f;
+	PxF32 brakeRight=0.0f;
+	PxF32 steer=0.0f;
+	PxF32 thrust=0.0f;
+	PxF32 steerAngles[PX_MAX_NB_WHEELS];
+	PxF32 driveTorqueRatios[PX_MAX_NB_WHEELS];
+	PxF32 aveWheelSpeedContributions[PX_MAX_NB_WHEELS];
+	PxMemSet(steerAngles, 0, sizeof(PxF32)*PX_MAX_NB_WHEELS);
+	PxMemSet(driveTorqueRatios, 0, sizeof(PxF32)*PX_MAX_NB_WHEELS);
+	PxMemSet(aveWheelSpeedContributions, 0, sizeof(PxF32)*PX_MAX_NB_WHEELS);
 	switch(vehWheels->mType)
 	{
 	case PxVehicleTypes::eDRIVE4W:
 		{
 			PxVehicleDrive4W* vehDrive4W=(PxVehicleDrive4W*)vehWheels;
+			driveSimData=&vehDrive4W->mDriveSimData;
+			driveDynData=&vehDrive4W->mDriveDynData;
+			accelIndex=PxVehicleDrive4WControl::eANALOG_INPUT_ACCEL;
 
-			PxVehicleUpdate::updateDrive4W(
-				timestep,
-				gravity, gravityMagnitude, recipGravityMagnitude,
-				vehicleDrivableSurfaceToTireFrictionPairs,
-				vehDrive4W, vehWheelQueryResults, NULL);
-				
-			for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+			PxF32 steerLeft,steerRight;
+			getVehicle4WControlValues(*driveDynData,accel,brake,handbrake,steerLeft,steerRight);
+			steer=steerRight-steerLeft;
+
+			//Only the first 4 wheels are steered and driven, the other wheels keep their toe angle.
+			computeAckermannCorrectedSteerAngles(vehDrive4W->mDriveSimData,wheels4SimDatas[0],steer,steerAngles);
+			for(PxU32 i=4;i<numActiveWheels;i++)
 			{
-				telemetryData.mWheelGraphs[i].updateTimeSlice(wheelGraphData[i]);
-				telemetryData.mSuspforceAppPoints[i]=suspForceAppPoints[i];
-				telemetryData.mTireforceAppPoints[i]=tireForceAppPoints[i];
+				steerAngles[i]=vehWheels->mWheelsSimData.getWheelData(i).mToeAngle;
 			}
-			telemetryData.mEngineGraph->updateTimeSlice(engineGraphData);
+			const PxVehicleDifferential4WData& diffData=vehDrive4W->mDriveSimData.getDiffData();
+			computeDiffTorqueRatios(diffData,handbrake,wheels4DynDatas[0].mWheelSpeeds,driveTorqueRatios);
+			computeDiffAveWheelSpeedContributions(diffData,handbrake,aveWheelSpeedContributions);
 		}
 		break;
+
 	case PxVehicleTypes::eDRIVENW:
 		{
 			PxVehicleDriveNW* vehDriveNW=(PxVehicleDriveNW*)vehWheels;
+			driveSimData=&vehDriveNW->mDriveSimData;
+			driveDynData=&vehDriveNW->mDriveDynData;
+			accelIndex=PxVehicleDriveNWControl::eANALOG_INPUT_ACCEL;
 
-			PxVehicleUpdate::updateDriveNW(
-				timestep,
-				gravity, gravityMagnitude, recipGravityMagnitude,
-				vehicleDrivableSurfaceToTireFrictionPairs,
-				vehDriveNW, vehWheelQueryResults, NULL);
+			PxF32 steerLeft,steerRight;
+			getVehicleNWControlValues(*driveDynData,accel,brake,handbrake,steerLeft,steerRight);
+			steer=steerRight-steerLeft;
 
-			for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+			//Equal torque split between the driven wheels.
+			const PxVehicleDifferentialNWData& diffData=vehDriveNW->mDriveSimData.getDiffData();
+			for(PxU32 i=0;i<numActiveWheels;i++)
 			{
-				telemetryData.mWheelGraphs[i].updateTimeSlice(wheelGraphData[i]);
-				telemetryData.mSuspforceAppPoints[i]=suspForceAppPoints[i];
-				telemetryData.mTireforceAppPoints[i]=tireForceAppPoints[i];
+				const PxVehicleWheelData& wheelData=vehWheels->mWheelsSimData.getWheelData(i);
+				steerAngles[i]=wheelData.mMaxSteer*steer + wheelData.mToeAngle;
+				driveTorqueRatios[i]=diffData.getIsDrivenWheel(i) ? diffData.mInvNbDrivenWheels : 0.0f;
+				aveWheelSpeedContributions[i]=driveTorqueRatios[i];
 			}
-			telemetryData.mEngineGraph->updateTimeSlice(engineGraphData);
 		}
 		break;
 
 	case PxVehicleTypes::eDRIVETANK:
 		{
 			PxVehicleDriveTank* vehDriveTank=(PxVehicleDriveTank*)vehWheels;
+			driveSimData=&vehDriveTank->mDriveSimData;
+			driveDynData=&vehDriveTank->mDriveDynData;
+			accelIndex=PxVehicleDriveTankControl::eANALOG_INPUT_ACCEL;
 
-			PxVehicleUpdate::updateTank(
-				timestep,
-				gravity,gravityMagnitude,recipGravityMagnitude,
-				vehicleDrivableSurfaceToTireFrictionPairs,
-				vehDriveTank, vehWheelQueryResults, NULL);
-				
-			for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+			PxF32 thrustLeft,thrustRight;
+			getTankControlValues(*driveDynData,accel,brakeLeft,brakeRight,thrustLeft,thrustRight);
+			thrust=PxAbs(thrustLeft)+PxAbs(thrustRight);
+
+			//Wheels with even index are on the left track, wheels with odd index on the right track.
+			const PxF32 recipNumActiveWheels=1.0f/(1.0f*numActiveWheels);
+			for(PxU32 i=0;i<numActiveWheels;i++)
 			{
-				telemetryData.mWheelGraphs[i].updateTimeSlice(wheelGraphData[i]);
-				telemetryData.mSuspforceAppPoints[i]=suspForceAppPoints[i];
-				telemetryData.mTireforceAppPoints[i]=tireForceAppPoints[i];
+				driveTorqueRatios[i]=((i & 1) ? thrustRight : thrustLeft)*recipNumActiveWheels;
+				aveWheelSpeedContributions[i]=recipNumActiveWheels;
 			}
-			telemetryData.mEngineGraph->updateTimeSlice(engineGraphData);
 		}
 		break;
+
 	case PxVehicleTypes::eNODRIVE:
 		{
-			PxVehicleNoDrive* vehDriveNoDrive=(PxVehicleNoDrive*)vehWheels;
-
-			PxVehicleUpdate::updateNoDrive(					
+			vehNoDrive=(PxVehicleNoDrive*)vehWheels;
+			for(PxU32 i=0;i<numActiveWheels;i++)
+			{
+				steerAngles[i]=vehNoDrive->mSteerAngles[i];
+			}
+		}
+		break;
+
+	default:
+		PX_CHECK_MSG(false, "updateSimplified - unsupported vehicle type"); 
+		return;
+	}
+
+	//Test if a non-zero drive torque was applied or if a non-zero steer angle was applied.
+	bool finiteInputApplied=false;
+	if(driveDynData)
+	{
+		finiteInputApplied=(0!=accel || 0!=steer || 0!=thrust || driveDynData->getGearDown() || driveDynData->getGearUp());
+	}
+	else
+	{
+		for(PxU32 i=0;i<numActiveWheels;i++)
+		{
+			if(vehNoDrive->mDriveTorques[i]!=0.0f || vehNoDrive->mSteerAngles[i]!=0.0f)
+			{
+				finiteInputApplied=true;
+				break;
+			}
+		}
+	}
+
+	//Wake or sleep.
+	{
+		if(vehActor->isSleeping())
+		{
+			if(finiteInputApplied)
+			{
+				//Driving inputs so we need the actor to start moving.
+				vehicleConcurrentUpdates.wakeup = true;
+			}
+			else if(isOnDynamicActor(vehWheels->mWheelsSimData, vehWheels->mWheelsDynData))
+			{
+				//Driving on dynamic so we need to keep moving.
+				vehicleConcurrentUpdates.wakeup = true;
+			}
+			else
+			{
+				//No driving inputs and the actor is asleep.
+				//Set internal dynamics to sleep.
+				setInternalDynamicsToZero(vehWheels->mWheelsDynData);
+				if(driveDynData)
+				{
+					setInternalDynamicsToZero(*driveDynData);
+				}
+				cacheSuspensionQueryHits(vehWheels->mWheelsSimData, vehWheels->mWheelsDynData, drivableSurfaceToTireFrictionPairs);
+				if(vehConcurrentUpdates) vehConcurrentUpdates->staySleeping = true;
+				return;
+			}
+		}
+	}
+
+	//Gear changes still happen: the engine is rigidly coupled to the wheels so the gear bounds the speed of the vehicle, 
+	//and the vehicle is in the right gear when it returns to the full model.
+	PxF32 G=0.0f;
+	PxU32 currentGear=PxVehicleGearsData::eNEUTRAL;
+	bool isIntentionToAccelerate;
+	if(driveDynData)
+	{
+		if(driveDynData->getUseAutoGears())
+		{
+			const PxF32 autoboxCompensatedAnalogAccel=processAutoBox(accelIndex,timestep,*driveSimData,*driveDynData);
+			accel=isTank ? accel : autoboxCompensatedAnalogAccel;
+		}
+		const PxVehicleGearsData& gearsData=driveSimData->getGearsData();
+		processGears(timestep,gearsData,*driveDynData);
+		currentGear=driveDynData->getCurrentGear();
+		G=computeGearRatio(gearsData,currentGear);
+		isIntentionToAccelerate=isTank ?
+			(accel*thrust>0 && PxVehicleGearsData::eNEUTRAL != currentGear) :
+			(accel>0.0f && 0.0f==brake && 0.0f==handbrake && PxVehicleGearsData::eNEUTRAL != currentGear);
+	}
+	else
+	{
+		PxF32 maxAccel=0;
+		PxF32 maxBrake=0;
+		for(PxU32 i=0;i<numActiveWheels;i++)
+		{
+			maxAccel = PxMax(PxAbs(vehNoDrive->mDriveTorques[i]), maxAccel);
+			maxBrake = PxMax(PxAbs(vehNoDrive->mBrakeTorques[i]), maxBrake);
+		}
+		isIntentionToAccelerate = (maxAccel>0.0f && 0.0f==maxBrake);
+	}
+
+	//In each block of 4 wheels record how many wheels are active.
+	PxU32 numActiveWheelsPerBlock4[PX_MAX_NB_SUSPWHEELTIRE4]={0,0,0,0,0};
+	numActiveWheelsPerBlock4[0]=PxMin(numActiveWheels,(PxU32)4);
+	for(PxU32 i=1;i<numWheels4-1;i++)
+	{
+		numActiveWheelsPerBlock4[i]=4;
+	}
+	numActiveWheelsPerBlock4[numWheels4-1]=numActiveWheelsInLast4;
+	PX_ASSERT(numActiveWheels == numActiveWheelsPerBlock4[0] + numActiveWheelsPerBlock4[1] + numActiveWheelsPerBlock4[2] + numActiveWheelsPerBlock4[3] + numActiveWheelsPerBlock4[4]); 
+
+	//The tire forces are computed from the tire data of each wheel with the simplified tire model.
+	PxVehicleTireForceCalculator4 tires4ForceCalculators[PX_MAX_NB_SUSPWHEELTIRE4];
+	for(PxU32 i=0;i<numWheels4;i++)
+	{
+		tires4ForceCalculators[i].mShaderData[0]=&wheels4SimDatas[i].getTireData(0);
+		tires4ForceCalculators[i].mShaderData[1]=&wheels4SimDatas[i].getTireData(1);
+		tires4ForceCalculators[i].mShaderData[2]=&wheels4SimDatas[i].getTireData(2);
+		tires4ForceCalculators[i].mShaderData[3]=&wheels4SimDatas[i].getTireData(3);
+		tires4ForceCalculators[i].mShader=computeTireForceSimplified;
+	}
+
+	//Mark the suspension/tire constraints as dirty to force them to be updated in the sdk.
+	for(PxU32 i=0;i<numWheels4;i++)
+	{
+		wheels4DynDatas[i].getVehicletConstraintShader().mConstraint->markDirty();
+	}
+
+	//Need to store report data to pose the wheels.
+	PxWheelQueryResult wheelQueryResults[PX_MAX_NB_WHEELS];
+
+	//Center of mass local pose.
+	PxTransform carChassisCMLocalPose;
+	//Compute the transform of the center of mass.
+	PxTransform origCarChassisTransform;
+	PxTransform carChassisTransform;
+	//Inverse mass and inertia to apply the tire/suspension forces as impulses.
+	PxF32 inverseChassisMass;
+	PxVec3 inverseInertia;
+	//Linear and angular velocity.
+	PxVec3 carChassisLinVel;
+	PxVec3 carChassisAngVel;
+	{
+		carChassisCMLocalPose = vehActor->getCMassLocalPose();
+		origCarChassisTransform = vehActor->getGlobalPose().transform(carChassisCMLocalPose);
+		carChassisTransform = origCarChassisTransform;
+		const PxF32 chassisMass = vehActor->getMass();
+		inverseChassisMass = 1.0f/chassisMass;
+		inverseInertia = vehActor->getMassSpaceInvInertiaTensor();
+		carChassisLinVel = vehActor->getLinearVelocity();
+		carChassisAngVel = vehActor->getAngularVelocity();
+	}
+
+	//Store the susp line raycast data.
+	for(PxU32 i=0;i<numWheels4;i++)
+	{
+		storeRaycasts(wheels4DynDatas[i], &wheelQueryResults[4*i]);
+	}
+
+	//Ready to do the update.
+	PxVec3 carChassisLinVelOrig=carChassisLinVel;
+	PxVec3 carChassisAngVelOrig=carChassisAngVel;
+	const PxU32 numSubSteps=computeNumberOfSubsteps(vehWheels->mWheelsSimData,carChassisLinVel,carChassisTransform,gForward);
+	const PxF32 timeFraction=1.0f/(1.0f*numSubSteps);
+	const PxF32 subTimestep=timestep*timeFraction;
+	const PxF32 recipSubTimeStep=1.0f/subTimestep;
+	const PxF32 recipTimestep=1.0f/timestep;
+	const PxF32 minLongSlipDenominator=vehWheels->mWheelsSimData.mMinLongSlipDenominator;
+	ProcessSuspWheelTireConstData constData={timeFraction, subTimestep, recipSubTimeStep, gravity, gravityMagnitude, recipGravityMagnitude, isTank, minLongSlipDenominator, vehActor, &drivableSurfaceToTireFrictionPairs};
+
+	for(PxU32 k=0;k<numSubSteps;k++)
+	{
+		//Set the force and torque for the current update to zero.
+		PxVec3 chassisForce(0,0,0);
+		PxVec3 chassisTorque(0,0,0);
+
+		//Engine torque delivered to the wheels through the current gear.
+		//The engine inertia and damping seen at the wheels scale with the square of the gear ratio.
+		PxF32 wheelsDriveTorque=0.0f;
+		PxF32 wheelsEngineMOI=0.0f;
+		PxF32 wheelsEngineDampingRate=0.0f;
+		if(driveDynData)
+		{
+			const PxVehicleEngineData& engineData=driveSimData->getEngineData();
+			const PxF32 engineOmega=driveDynData->getEngineRotationSpeed();
+			wheelsDriveTorque=computeEngineDriveTorque(engineData,engineOmega,accel)*G;
+			wheelsEngineMOI=engineData.mMOI*G*G;
+			wheelsEngineDampingRate=computeEngineDampingRate(engineData,currentGear,accel)*G*G;
+		}
+
+		for(PxU32 i=0;i<numWheels4;i++)
+		{
+			const PxVehicleWheels4SimData& wheels4SimData=wheels4SimDatas[i];
+			PxVehicleWheels4DynData& wheels4DynData=wheels4DynDatas[i];
+
+			//Work out which wheels are enabled.
+			bool activeWheelStates[4]={false,false,false,false};
+			computeWheelActiveStates(4*i, vehWheels->mWheelsSimData.mActiveWheelsBitmapBuffer, activeWheelStates);
+
+			//Compute the drive and brake torques.
+			PxF32 driveTorques[4]={0.0f,0.0f,0.0f,0.0f};
+			PxF32 brakeTorques[4]={0.0f,0.0f,0.0f,0.0f};
+			bool isBrakeApplied[4]={false,false,false,false};
+			if(vehNoDrive)
+			{
+				PxMemCopy(driveTorques, &vehNoDrive->mDriveTorques[4*i], sizeof(PxF32)*numActiveWheelsPerBlock4[i]);
+				computeNoDriveBrakeTorques
+					(wheels4SimData.mWheels,wheels4DynData.mWheelSpeeds,&vehNoDrive->mBrakeTorques[4*i],
+					 brakeTorques,isBrakeApplied);
+			}
+			else
+			{
+				driveTorques[0]=wheelsDriveTorque*driveTorqueRatios[4*i+0];
+				driveTorques[1]=wheelsDriveTorque*driveTorqueRatios[4*i+1];
+				driveTorques[2]=wheelsDriveTorque*driveTorqueRatios[4*i+2];
+				driveTorques[3]=wheelsDriveTorque*driveTorqueRatios[4*i+3];
+				if(isTank)
+				{
+					computeTankBrakeTorques
+						(&wheels4SimData.getWheelData(0),wheels4DynData.mWheelSpeeds,brakeLeft,brakeRight,
+						 brakeTorques,isBrakeApplied);
+				}
+				else
+				{
+					computeBrakeAndHandBrakeTorques
+						(&wheels4SimData.getWheelData(0),wheels4DynData.mWheelSpeeds,brake,handbrake,
+						 brakeTorques,isBrakeApplied);
+				}
+			}
+
+			//Compute the per wheel accel pedal values.
+			bool isAccelApplied[4]={false,false,false,false};
+			if(isIntentionToAccelerate)
+			{
+				computeIsAccelApplied(driveTorques, isAccelApplied);
+			}
+
+			//Compute jounces, slips, tire forces, suspension forces etc.
+			ProcessSuspWheelTireInputData inputData=
+			{
+				isIntentionToAccelerate, isAccelApplied, isBrakeApplied, &steerAngles[4*i], activeWheelStates,
+				carChassisTransform, carChassisLinVel, carChassisAngVel,
+				&wheels4SimData, &wheels4DynData, &tires4ForceCalculators[i], &tireLoadFilterData, numActiveWheelsPerBlock4[i]
+			};
+			ProcessSuspWheelTireOutputData outputData;
+			processSuspTireWheels(4*i, constData, inputData, outputData);
+			updateLowSpeedTimers(outputData.newLowForwardSpeedTimers, (PxF32*)inputData.vehWheels4DynData->mTireLowForwardSpeedTimers);
+			updateLowSpeedTimers(outputData.newLowSideSpeedTimers, (PxF32*)inputData.vehWheels4DynData->mTireLowSideSpeedTimers);
+			updateJounces(outputData.jounces, (PxF32*)inputData.vehWheels4DynData->mJounces);
+			if((numSubSteps-1) == k)
+			{
+				updateCachedHitData(outputData.cachedHitCounts, outputData.cachedHitPlanes, outputData.cachedHitDistances, outputData.cachedFrictionMultipliers, &wheels4DynData);
+			}
+			chassisForce+=outputData.chassisForce;
+			chassisTorque+=outputData.chassisTorque;
+			if(0 == k)
+			{
+				wheels4DynDatas[i].mVehicleConstraints->mData=outputData.vehConstraintData;
+			}
+			storeSuspWheelTireResults(outputData, inputData.steerAngles, &wheelQueryResults[4*i], numActiveWheelsPerBlock4[i]);
+			storeHitActorForces(outputData, &vehicleConcurrentUpdates.concurrentWheelUpdates[4*i], numActiveWheelsPerBlock4[i]);
+
+			//Integrate the wheel speeds, each driven wheel carries its share of the engine.
+			const PxF32* PX_RESTRICT contributions=&aveWheelSpeedContributions[4*i];
+			const PxF32 engineMOIs[4]=
+			{
+				wheelsEngineMOI*contributions[0],
+				wheelsEngineMOI*contributions[1],
+				wheelsEngineMOI*contributions[2],
+				wheelsEngineMOI*contributions[3]
+			};
+			const PxF32 engineDampingRates[4]=
+			{
+				wheelsEngineDampingRate*contributions[0],
+				wheelsEngineDampingRate*contributions[1],
+				wheelsEngineDampingRate*contributions[2],
+				wheelsEngineDampingRate*contributions[3]
+			};
+			integrateSimplifiedWheelSpeeds(
+				subTimestep,
+				brakeTorques,isBrakeApplied,driveTorques,outputData.tireTorques,engineMOIs,engineDampingRates,
+				wheels4SimData,wheels4DynData);
+
+			integrateNoDriveWheelRotationAngles(
+				subTimestep,
+				driveTorques,
+				outputData.jounces, outputData.forwardSpeeds, isBrakeApplied,
+				wheels4SimData,
+				wheels4DynData);
+		}
+
+		//The engine follows the driven wheels through the gearbox.
+		//In neutral the engine is disconnected from the wheels and keeps its speed.
+		if(driveDynData && PxVehicleGearsData::eNEUTRAL != currentGear)
+		{
+			PxF32 aveWheelSpeed=0.0f;
+			for(PxU32 i=0;i<numActiveWheels;i++)
+			{
+				aveWheelSpeed+=aveWheelSpeedContributions[i]*wheels4DynDatas[i>>2].mWheelSpeeds[i & 3];
+			}
+			const PxF32 maxEngineOmega=driveSimData->getEngineData().mMaxOmega;
+			driveDynData->setEngineRotationSpeed(PxClamp(aveWheelSpeed*G, 0.0f, maxEngineOmega));
+		}
+
+		//Integrate the chassis velocity by applying the accumulated force and torque.
+		integrateBody(inverseChassisMass,inverseInertia,chassisForce,chassisTorque,subTimestep,carChassisLinVel,carChassisAngVel,carChassisTransform);
+	}
+
+	//Set the new chassis linear/angular velocity.
+	if(!gApplyForces)
+	{
+		vehicleConcurrentUpdates.linearMomentumChange = carChassisLinVel;
+		vehicleConcurrentUpdates.angularMomentumChange = carChassisAngVel;
+	}
+	else
+	{
+		//a = (v - v0)/dt, see updateNoDrive.
+		vehicleConcurrentUpdates.linearMomentumChange = (carChassisLinVel-carChassisLinVelOrig)*recipTimestep;
+		vehicleConcurrentUpdates.angularMomentumChange = (carChassisAngVel-carChassisAngVelOrig)*recipTimestep;
+	}
+
+	//Pose the wheels from jounces, rotations angles, and steer angles.
+	for(PxU32 i=0;i<numWheels4;i++)
+	{
+		PxTransform localPoses[4] = {PxTransform(PxIdentity), PxTransform(PxIdentity), PxTransform(PxIdentity), PxTransform(PxIdentity)};
+		computeWheelLocalPoses(wheels4SimDatas[i],wheels4DynDatas[i],&wheelQueryResults[4*i],numActiveWheelsPerBlock4[i],carChassisCMLocalPose,localPoses);
+		wheelQueryResults[4*i + 0].localPose = localPoses[0];
+		wheelQueryResults[4*i + 1].localPose = localPoses[1];
+		wheelQueryResults[4*i + 2].localPose = localPoses[2];
+		wheelQueryResults[4*i + 3].localPose = localPoses[3];
+		vehicleConcurrentUpdates.concurrentWheelUpdates[4*i + 0].localPose = localPoses[0];
+		vehicleConcurrentUpdates.concurrentWheelUpdates[4*i + 1].localPose = localPoses[1];
+		vehicleConcurrentUpdates.concurrentWheelUpdates[4*i + 2].localPose = localPoses[2];
+		vehicleConcurrentUpdates.concurrentWheelUpdates[4*i + 3].localPose = localPoses[3];
+	}
+
+	if(vehWheelQueryResults && vehWheelQueryResults->wheelQueryResults)
+	{
+		PxMemCopy(vehWheelQueryResults->wheelQueryResults, wheelQueryResults, sizeof(PxWheelQueryResult)*numActiveWheels);
+	}
+
+	if(vehConcurrentUpdates)
+	{
+		//Copy across to input data structure so that writes can be applied later.
+		PxMemCopy(vehConcurrentUpdates->concurrentWheelUpdates, vehicleConcurrentUpdates.concurrentWheelUpdates, sizeof(PxVehicleWheelConcurrentUpdateData)*numActiveWheels);
+		vehConcurrentUpdates->linearMomentumChange = vehicleConcurrentUpdates.linearMomentumChange;
+		vehConcurrentUpdates->angularMomentumChange = vehicleConcurrentUpdates.angularMomentumChange;
+		vehConcurrentUpdates->staySleeping = vehicleConcurrentUpdates.staySleeping;
+		vehConcurrentUpdates->wakeup = vehicleConcurrentUpdates.wakeup;
+	}
+	else
+	{
+		//Apply the writes immediately.
+		PxVehicleWheels* vehWheelsArray[1]={vehWheels};
+		PxVehiclePostUpdates(&vehicleConcurrentUpdates, 1, vehWheelsArray);
+	}
+}
+
+void PxVehicleUpdate::shiftOrigin(const PxVec3& shift, const PxU32 numVehicles, PxVehicleWheels** vehicles)
+{
+	for(PxU32 i=0; i < numVehicles; i++)
+	{
+		//Get the current car.
+		PxVehicleWheels& veh = *vehicles[i];
+		PxVehicleWheels4DynData* PX_RESTRICT wheels4DynData=veh.mWheelsDynData.mWheels4DynData;
+		const PxU32 numWheels4=veh.mWheelsSimData.mNbWheels4;
+
+		//Blocks of 4 wheels.
+		for(PxU32 j=0; j < numWheels4; j++)
+		{
+			bool activeWheelStates[4]={false,false,false,false};
+			computeWheelActiveStates(4*j, veh.mWheelsSimData.mActiveWheelsBitmapBuffer, activeWheelStates);
+
+			if (wheels4DynData[j].mSqResults || wheels4DynData[j].mSqSweepResults)  // this is set when a query has been scheduled
+			{
+				PxVehicleWheels4DynData::SuspLineRaycast& raycast = 
+					(PxVehicleWheels4DynData::SuspLineRaycast&)wheels4DynData[j].mRaycastsOrCachedHitResults;
+				
+				for(PxU32 k=0; k < 4; k++)
+				{
+					if (activeWheelStates[k])
+					{
+						raycast.mStarts[k] -= shift;
+
+						const PxLocationHit* hit = getSuspensionQueryHit(wheels4DynData[j], k);
+						if (hit)
+							const_cast<PxVec3&>(hit->position) -= shift;
+					}
+				}
+			}
+			else  // the hit planes of the previous update are cached
+			{
+				PxVehicleWheels4DynData::CachedSuspLineRaycastHitResult& cachedHitResult = 
+					(PxVehicleWheels4DynData::CachedSuspLineRaycastHitResult&)wheels4DynData[j].mRaycastsOrCachedHitResults;
+
+				for(PxU32 k=0; k < 4; k++)
+				{
+					if (cachedHitResult.mCounts[k])
+					{
+						const PxVec4& plane = cachedHitResult.mPlanes[k];
+						cachedHitResult.mPlanes[k].w += PxVec3(plane.x, plane.y, plane.z).dot(shift);
+					}
+				}
+			}
+
+			wheels4DynData[j].mCachedHitQueryPose.p -= shift;
+		}
+	}
+}
+
+}//namespace physx
+
+#if PX_DEBUG_VEHICLE_ON
+
+/////////////////////////////////////////////////////////////////////////////////
+//Update a single vehicle of any type and record the associated telemetry data.
+/////////////////////////////////////////////////////////////////////////////////
+
+void PxVehicleUpdate::updateSingleVehicleAndStoreTelemetryData
+(const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ PxVehicleWheels* vehWheels, PxVehicleWheelQueryResult* vehWheelQueryResults, PxVehicleTelemetryData& telemetryData)
+{
+	START_TIMER(TIMER_ALL);
+
+	PX_CHECK_MSG(gravity.magnitude()>0, "gravity vector must have non-zero length");
+	PX_CHECK_MSG(timestep>0, "timestep must be greater than zero");
+	PX_CHECK_AND_RETURN(gThresholdForwardSpeedForWheelAngleIntegration>0, "PxInitVehicleSDK needs to be called before ever calling PxVehicleUpdateSingleVehicleAndStoreTelemetryData");
+	PX_CHECK_MSG(vehWheels->mWheelsSimData.getNbWheels()==telemetryData.getNbWheelGraphs(), "vehicle and telemetry data need to have the same number of wheels");
+	PX_CHECK_AND_RETURN(NULL==vehWheelQueryResults || vehWheelQueryResults->nbWheelQueryResults >= vehWheels->mWheelsSimData.getNbWheels(),
+		"nbWheelQueryResults must always be greater than or equal to number of wheels in corresponding vehicle");
+
+#ifdef PX_CHECKED
+	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbWheels4;i++)
+	{
+		PX_CHECK_MSG(
+			vehWheels->mWheelsDynData.mWheels4DynData[i].mSqResults || 
+			vehWheels->mWheelsDynData.mWheels4DynData[i].mSqSweepResults ||
+			vehWheels->mWheelsDynData.mWheels4DynData[i].mHasCachedRaycastHitPlane, 
+			"Need to call PxVehicle4WSuspensionRaycasts before trying to update");
+	}
+	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+	{
+		PX_CHECK_MSG(vehWheels->mWheelsDynData.mTireForceCalculators->mShaderData[i], "Need to set non-null tire force shader data ptr");
+	}
+	PX_CHECK_MSG(vehWheels->mWheelsDynData.mTireForceCalculators->mShader, "Need to set non-null tire force shader function");
+
+	for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+	{
+		PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(i) || -1==vehWheels->mWheelsSimData.getWheelShapeMapping(i), 
+			"Disabled wheels must not be associated with a PxShape:  use setWheelShapeMapping to remove the association");
+		PX_CHECK_AND_RETURN(!vehWheels->mWheelsSimData.getIsWheelDisabled(i) || 0==vehWheels->mWheelsDynData.getWheelRotationSpeed(i), 
+			"Disabled wheels must have zero rotation speed:  use setWheelRotationSpeed to set the wheel to zero rotation speed");
+	}
+#endif
+
+	PxF32 engineGraphData[PxVehicleDriveGraphChannel::eMAX_NB_DRIVE_CHANNELS];
+	PxMemZero(&engineGraphData[0], PxVehicleDriveGraphChannel::eMAX_NB_DRIVE_CHANNELS*sizeof(PxF32));
+	gCarEngineGraphData=engineGraphData;
+
+	PxF32 wheelGraphData[PX_MAX_NB_WHEELS][PxVehicleWheelGraphChannel::eMAX_NB_WHEEL_CHANNELS];
+	PxMemZero(&wheelGraphData[0][0], PX_MAX_NB_WHEELS*PxVehicleWheelGraphChannel::eMAX_NB_WHEEL_CHANNELS*sizeof(PxF32));
+	for(PxU32 i=0;i<4*vehWheels->mWheelsSimData.mNbWheels4;i++)
+	{
+		gCarWheelGraphData[i]=wheelGraphData[i];
+	}
+	for(PxU32 i=4*vehWheels->mWheelsSimData.mNbWheels4; i<PX_MAX_NB_WHEELS;i++)
+	{
+		gCarWheelGraphData[i]=NULL;
+	}
+
+	PxVec3 suspForceAppPoints[PX_MAX_NB_WHEELS];
+	PxMemZero(suspForceAppPoints, PX_MAX_NB_WHEELS*sizeof(PxVec3));
+	gCarSuspForceAppPoints=suspForceAppPoints;
+
+	PxVec3 tireForceAppPoints[PX_MAX_NB_WHEELS];
+	PxMemZero(tireForceAppPoints, PX_MAX_NB_WHEELS*sizeof(PxVec3));
+	gCarTireForceAppPoints=tireForceAppPoints;
+
+	const PxF32 gravityMagnitude=gravity.magnitude();
+	const PxF32 recipGravityMagnitude=1.0f/gravityMagnitude;
+
+	switch(vehWheels->mType)
+	{
+	case PxVehicleTypes::eDRIVE4W:
+		{
+			PxVehicleDrive4W* vehDrive4W=(PxVehicleDrive4W*)vehWheels;
+
+			PxVehicleUpdate::updateDrive4W(
+				timestep,
+				gravity, gravityMagnitude, recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs,
+				vehDrive4W, vehWheelQueryResults, NULL);
+				
+			for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+			{
+				telemetryData.mWheelGraphs[i].updateTimeSlice(wheelGraphData[i]);
+				telemetryData.mSuspforceAppPoints[i]=suspForceAppPoints[i];
+				telemetryData.mTireforceAppPoints[i]=tireForceAppPoints[i];
+			}
+			telemetryData.mEngineGraph->updateTimeSlice(engineGraphData);
+		}
+		break;
+	case PxVehicleTypes::eDRIVENW:
+		{
+			PxVehicleDriveNW* vehDriveNW=(PxVehicleDriveNW*)vehWheels;
+
+			PxVehicleUpdate::updateDriveNW(
+				timestep,
+				gravity, gravityMagnitude, recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs,
+				vehDriveNW, vehWheelQueryResults, NULL);
+
+			for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+			{
+				telemetryData.mWheelGraphs[i].updateTimeSlice(wheelGraphData[i]);
+				telemetryData.mSuspforceAppPoints[i]=suspForceAppPoints[i];
+				telemetryData.mTireforceAppPoints[i]=tireForceAppPoints[i];
+			}
+			telemetryData.mEngineGraph->updateTimeSlice(engineGraphData);
+		}
+		break;
+
+	case PxVehicleTypes::eDRIVETANK:
+		{
+			PxVehicleDriveTank* vehDriveTank=(PxVehicleDriveTank*)vehWheels;
+
+			PxVehicleUpdate::updateTank(
+				timestep,
+				gravity,gravityMagnitude,recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs,
+				vehDriveTank, vehWheelQueryResults, NULL);
+				
+			for(PxU32 i=0;i<vehWheels->mWheelsSimData.mNbActiveWheels;i++)
+			{
+				telemetryData.mWheelGraphs[i].updateTimeSlice(wheelGraphData[i]);
+				telemetryData.mSuspforceAppPoints[i]=suspForceAppPoints[i];
+				telemetryData.mTireforceAppPoints[i]=tireForceAppPoints[i];
+			}
+			telemetryData.mEngineGraph->updateTimeSlice(engineGraphData);
+		}
+		break;
+	case PxVehicleTypes::eNODRIVE:
+		{
+			PxVehicleNoDrive* vehDriveNoDrive=(PxVehicleNoDrive*)vehWheels;
+
+			PxVehicleUpdate::updateNoDrive(					
 				timestep,
 				gravity,gravityMagnitude,recipGravityMagnitude,
 				vehicleDrivableSurfaceToTireFrictionPairs,
@@ -6262,6 +6972,7 @@ void PxVehicleUpdate::update
 		{
 			PX_CHECK_MSG(
 				vehWheels->mWheelsDynData.mWheels4DynData[j].mSqResults || 
+				vehWheels->mWheelsDynData.mWheels4DynData[j].mSqSweepResults || 
 				vehWheels->mWheelsDynData.mWheels4DynData[0].mHasCachedRaycastHitPlane ||
 				(vehWheels->mWheelsSimData.getIsWheelDisabled(4*j+0) &&  
 				 vehWheels->mWheelsSimData.getIsWheelDisabled(4*j+1) &&  
@@ -6305,11 +7016,58 @@ void PxVehicleUpdate::update
 	const PxF32 gravityMagnitude=gravity.magnitude();
 	const PxF32 recipGravityMagnitude=1.0f/gravityMagnitude;
 
+	//Writes of vehicles with a reduced level of detail that are applied immediately.
+	PxVehicleWheelConcurrentUpdateData lodWheelUpdates[PX_MAX_NB_WHEELS];
+	PxVehicleConcurrentUpdateData lodConcurrentUpdateData;
+	lodConcurrentUpdateData.concurrentWheelUpdates=lodWheelUpdates;
+	lodConcurrentUpdateData.nbConcurrentWheelUpdates=PX_MAX_NB_WHEELS;
+
 	for(PxU32 i=0;i<numVehicles;i++)
 	{
 		PxVehicleWheels* vehWheels=vehicles[i];
 		PxVehicleWheelQueryResult* vehWheelQueryResults = vehicleWheelQueryResults ? &vehicleWheelQueryResults[i] : NULL;
 		PxVehicleConcurrentUpdateData* vehConcurrentUpdateData = vehicleConcurrentUpdates ? &vehicleConcurrentUpdates[i] : NULL;
+
+		//Vehicles with a reduced level of detail accumulate the elapsed time until it reaches their LOD update interval.
+		//Skipped vehicles are left as they are, apart from caching the hit planes of any suspension queries.
+		//Their wheel query results are not written (see PxVehicleUpdateLOD::eREDUCED_RATE).
+		vehWheels->mLODAccumulatedTime+=timestep;
+		if(PxVehicleUpdateLOD::eFULL!=vehWheels->mUpdateLOD && vehWheels->mLODAccumulatedTime<vehWheels->mLODUpdateInterval)
+		{
+			PxVehicleUpdate::cacheSuspensionQueryHits(vehWheels->mWheelsSimData, vehWheels->mWheelsDynData, vehicleDrivableSurfaceToTireFrictionPairs);
+			if(vehConcurrentUpdateData) vehConcurrentUpdateData->staySleeping = true;
+			continue;
+		}
+		const PxF32 vehTimestep=vehWheels->mLODAccumulatedTime;
+		vehWheels->mLODAccumulatedTime=0.0f;
+
+		//An update that covers several calls is applied to the actors in a single scene step, 
+		//its writes are gathered so that they can be scaled before they are applied.
+		const bool isLODUpdate=(vehTimestep!=timestep);
+		const bool applyLODUpdate=(isLODUpdate && !vehConcurrentUpdateData);
+		if(applyLODUpdate)
+		{
+			vehConcurrentUpdateData=&lodConcurrentUpdateData;
+		}
+
+		if(PxVehicleUpdateLOD::eSIMPLIFIED==vehWheels->mUpdateLOD)
+		{
+			PxVehicleUpdate::updateSimplified(
+				vehTimestep,
+				gravity,gravityMagnitude,recipGravityMagnitude,
+				vehicleDrivableSurfaceToTireFrictionPairs,
+				vehWheels, vehWheelQueryResults, vehConcurrentUpdateData);
+			if(isLODUpdate)
+			{
+				PxVehicleUpdate::scaleLODUpdate(vehTimestep/timestep, *vehWheels, *vehConcurrentUpdateData);
+			}
+			if(applyLODUpdate)
+			{
+				PxVehiclePostUpdates(vehConcurrentUpdateData, 1, &vehWheels);
+			}
+			continue;
+		}
+
 		switch(vehWheels->mType)
 		{
 		case PxVehicleTypes::eDRIVE4W:
@@ -6317,7 +7075,7 @@ void PxVehicleUpdate::update
 				PxVehicleDrive4W* vehDrive4W=(PxVehicleDrive4W*)vehWheels;
 
 				PxVehicleUpdate::updateDrive4W(					
-					timestep,
+					vehTimestep,
 					gravity,gravityMagnitude,recipGravityMagnitude,
 					vehicleDrivableSurfaceToTireFrictionPairs,
 					vehDrive4W, vehWheelQueryResults, vehConcurrentUpdateData);
@@ -6329,7 +7087,7 @@ void PxVehicleUpdate::update
 				PxVehicleDriveNW* vehDriveNW=(PxVehicleDriveNW*)vehWheels;
 
 				PxVehicleUpdate::updateDriveNW(					
-					timestep,
+					vehTimestep,
 					gravity,gravityMagnitude,recipGravityMagnitude,
 					vehicleDrivableSurfaceToTireFrictionPairs,
 					vehDriveNW, vehWheelQueryResults, vehConcurrentUpdateData);
@@ -6341,7 +7099,7 @@ void PxVehicleUpdate::update
 				PxVehicleDriveTank* vehDriveTank=(PxVehicleDriveTank*)vehWheels;
 
 				PxVehicleUpdate::updateTank(
-					timestep,
+					vehTimestep,
 					gravity,gravityMagnitude,recipGravityMagnitude,
 					vehicleDrivableSurfaceToTireFrictionPairs,
 					vehDriveTank, vehWheelQueryResults, vehConcurrentUpdateData);
@@ -6353,7 +7111,7 @@ void PxVehicleUpdate::update
 				PxVehicleNoDrive* vehDriveNoDrive=(PxVehicleNoDrive*)vehWheels;
 
 				PxVehicleUpdate::updateNoDrive(					
-					timestep,
+					vehTimestep,
 					gravity,gravityMagnitude,recipGravityMagnitude,
 					vehicleDrivableSurfaceToTireFrictionPairs,
 					vehDriveNoDrive, vehWheelQueryResults, vehConcurrentUpdateData);
@@ -6364,6 +7122,33 @@ void PxVehicleUpdate::update
 			PX_CHECK_MSG(false, "update - unsupported vehicle type"); 
 			break;
 		}
+
+		if(isLODUpdate)
+		{
+			PxVehicleUpdate::scaleLODUpdate(vehTimestep/timestep, *vehWheels, *vehConcurrentUpdateData);
+		}
+		if(applyLODUpdate)
+		{
+			PxVehiclePostUpdates(vehConcurrentUpdateData, 1, &vehWheels);
+		}
+	}
+}
+
+//The momentum change of an update with a reduced level of detail covers momentumScale calls but is applied in 
+//a single scene step: the chassis acceleration (PxVehicleUpdateMode::eACCELERATION) and the forces on the 
+//actors hit by the wheels are scaled accordingly.  Chassis velocities (PxVehicleUpdateMode::eVELOCITY_CHANGE) 
+//are set as they are.
+void PxVehicleUpdate::scaleLODUpdate(const PxF32 momentumScale, const PxVehicleWheels& vehWheels, PxVehicleConcurrentUpdateData& vehConcurrentUpdates)
+{
+	if(gApplyForces)
+	{
+		vehConcurrentUpdates.linearMomentumChange*=momentumScale;
+		vehConcurrentUpdates.angularMomentumChange*=momentumScale;
+	}
+
+	for(PxU32 i=0;i<vehWheels.mWheelsSimData.mNbActiveWheels;i++)
+	{
+		vehConcurrentUpdates.concurrentWheelUpdates[i].hitActorForce*=momentumScale;
 	}
 }
 
@@ -6466,6 +7251,186 @@ void PxVehicleUpdate::updatePost
 }
 
 
+////////////////////////////////////////////////////////////
+//Update an array of vehicles with tasks on a cpu dispatcher
+////////////////////////////////////////////////////////////
+
+//Estimated cost of updating a vehicle, measured in wheels.  
+//The drivetrain of the engine/gears/clutch/differential costs roughly as much as 4 wheels, 
+//the two tank tracks roughly as much as 2 wheels.
+//Vehicles skipped because of their level of detail cost next to nothing and the 
+//simplified model has no drivetrain to solve.
+PxU32 PxVehicleUpdate::computeVehicleUpdateCost(const PxVehicleWheels& vehWheels, const PxF32 timestep)
+{
+	if(PxVehicleUpdateLOD::eFULL!=vehWheels.mUpdateLOD && (vehWheels.mLODAccumulatedTime+timestep)<vehWheels.mLODUpdateInterval)
+	{
+		return 1;
+	}
+
+	PxU32 cost=vehWheels.mWheelsSimData.getNbWheels();
+	if(PxVehicleUpdateLOD::eSIMPLIFIED==vehWheels.mUpdateLOD)
+	{
+		return cost;
+	}
+
+	switch(vehWheels.getVehicleType())
+	{
+	case PxVehicleTypes::eDRIVE4W:
+	case PxVehicleTypes::eDRIVENW:
+		cost+=4;
+		break;
+	case PxVehicleTypes::eDRIVETANK:
+		cost+=2;
+		break;
+	default:
+		break;
+	}
+	return cost;
+}
+
+namespace
+{
+	//Data shared by all tasks of a call to PxVehicleUpdatesParallel.
+	//Each task repeatedly claims the next unclaimed chunk of vehicles until no chunks are left.
+	struct VehicleUpdateChunks
+	{
+		PxF32 timestep;
+		PxVec3 gravity;
+		const PxVehicleDrivableSurfaceToTireFrictionPairs* frictionPairs;
+		PxVehicleWheels** vehicles;
+		PxVehicleWheelQueryResult* wheelQueryResults;
+		PxVehicleConcurrentUpdateData* concurrentUpdates;
+
+		//Chunk i updates vehicles in the range [chunkStarts[i], chunkStarts[i+1]).
+		const PxU32* chunkStarts;
+		PxU32 nbChunks;
+		volatile PxI32 nextChunk;
+
+		//Number of submitted tasks that have not yet been released.
+		volatile PxI32 nbPendingTasks;
+		Ps::Sync sync;
+	};
+
+	class VehicleUpdateTask : public PxLightCpuTask
+	{
+	public:
+
+		VehicleUpdateTask() : mChunks(NULL) {}
+
+		static void updateChunks(VehicleUpdateChunks& chunks)
+		{
+			PxU32 chunk;
+			while((chunk=(PxU32)(Ps::atomicIncrement(&chunks.nextChunk)-1)) < chunks.nbChunks)
+			{
+				const PxU32 start=chunks.chunkStarts[chunk];
+				const PxU32 nb=chunks.chunkStarts[chunk+1]-start;
+				PxVehicleUpdates(
+					chunks.timestep, chunks.gravity, *chunks.frictionPairs, 
+					nb, chunks.vehicles+start,
+					chunks.wheelQueryResults ? chunks.wheelQueryResults+start : NULL, 
+					chunks.concurrentUpdates+start);
+			}
+		}
+
+		virtual void run()
+		{
+			updateChunks(*mChunks);
+		}
+
+		virtual void release()
+		{
+			if(0==Ps::atomicDecrement(&mChunks->nbPendingTasks))
+			{
+				mChunks->sync.set();
+			}
+		}
+
+		virtual const char* getName() const { return "PxVehicleUpdatesParallel"; }
+
+		VehicleUpdateChunks* mChunks;
+	};
+}
+
+void PxVehicleUpdate::updateParallel
+(const PxF32 timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+ PxCpuDispatcher& dispatcher)
+{
+	PX_CHECK_AND_RETURN(vehicleConcurrentUpdates, "vehicleConcurrentUpdates must be non-null.");
+
+	if(0==numVehicles)
+		return;
+
+	//Chunks much cheaper than this aren't worth the cost of a task.
+	const PxU32 minChunkCost=32;
+	//Split the work into a few chunks per thread so that threads that finish early can claim more work.
+	const PxU32 nbChunksPerThread=4;
+
+	PxU32 totalCost=0;
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		totalCost+=computeVehicleUpdateCost(*vehicles[i], timestep);
+	}
+
+	const PxU32 nbThreads=dispatcher.getWorkerCount()+1;
+	const PxU32 chunkCost=PxMax(minChunkCost, (totalCost + nbThreads*nbChunksPerThread - 1)/(nbThreads*nbChunksPerThread));
+
+	//The tasks need a task manager for their profile events.
+	PxScene* scene=vehicles[0]->getRigidDynamicActor()->getScene();
+	PxTaskManager* taskManager=scene ? scene->getTaskManager() : NULL;
+
+	if(nbThreads<2 || totalCost<2*chunkCost || !taskManager)
+	{
+		update(timestep, gravity, vehicleDrivableSurfaceToTireFrictionPairs, numVehicles, vehicles, vehicleWheelQueryResults, NULL);
+		return;
+	}
+
+	//Cut the vehicles array into contiguous chunks of approximately equal cost.
+	Ps::InlineArray<PxU32, 64> chunkStarts;
+	chunkStarts.pushBack(0);
+	PxU32 cost=0;
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		cost+=computeVehicleUpdateCost(*vehicles[i], timestep);
+		if(cost>=chunkCost && (i+1)<numVehicles)
+		{
+			chunkStarts.pushBack(i+1);
+			cost=0;
+		}
+	}
+	chunkStarts.pushBack(numVehicles);
+
+	VehicleUpdateChunks chunks;
+	chunks.timestep=timestep;
+	chunks.gravity=gravity;
+	chunks.frictionPairs=&vehicleDrivableSurfaceToTireFrictionPairs;
+	chunks.vehicles=vehicles;
+	chunks.wheelQueryResults=vehicleWheelQueryResults;
+	chunks.concurrentUpdates=vehicleConcurrentUpdates;
+	chunks.chunkStarts=chunkStarts.begin();
+	chunks.nbChunks=chunkStarts.size()-1;
+	chunks.nextChunk=0;
+
+	//The calling thread works on the chunks too so one task fewer than the number of chunks is enough.
+	const PxU32 nbTasks=PxMin(nbThreads-1, chunks.nbChunks-1);
+	chunks.nbPendingTasks=(PxI32)nbTasks;
+
+	Ps::InlineArray<VehicleUpdateTask, 16> tasks;
+	tasks.resize(nbTasks);
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		tasks[i].mChunks=&chunks;
+		tasks[i].setContinuation(*taskManager, NULL);
+		dispatcher.submitTask(tasks[i]);
+	}
+
+	VehicleUpdateTask::updateChunks(chunks);
+	chunks.sync.wait();
+
+	//Writes to the scene from different threads aren't permitted so the post-updates are applied here.
+	updatePost(vehicleConcurrentUpdates, numVehicles, vehicles);
+}
+
 void physx::PxVehicleUpdates
 (const PxReal timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
  const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates)
@@ -6483,13 +7448,21 @@ void physx::PxVehiclePostUpdates
 	STOP_PROFILER(ePROFILE_POSTUPDATES)
 }
 
+void physx::PxVehicleUpdatesParallel
+(const PxReal timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
+ const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
+ PxCpuDispatcher& dispatcher)
+{
+	PxVehicleUpdate::updateParallel(timestep, gravity, vehicleDrivableSurfaceToTireFrictionPairs, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates, dispatcher);
+}
+
 void physx::PxVehicleShiftOrigin(const PxVec3& shift, const PxU32 numVehicles, PxVehicleWheels** vehicles)
 {
 	PxVehicleUpdate::shiftOrigin(shift, numVehicles, vehicles);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////
-//The following functions issue  a single batch of suspension raycasts for an array of vehicles of any type.
+//The following functions issue  a single batch of suspension raycasts or sweeps for an array of vehicles of any type.
 //The buffer of sceneQueryResults is distributed among the vehicles in the array 
 //for use in the next PxVehicleUpdates call.
 ///////////////////////////////////////////////////////////////////////////////////
@@ -6498,11 +7471,8 @@ void PxVehicleWheels4SuspensionRaycasts
 (PxBatchQuery* batchQuery, 
  const PxVehicleWheels4SimData& wheels4SimData, PxVehicleWheels4DynData& wheels4DynData, 
  const PxQueryFilterData* carFilterData, const bool* activeWheelStates, const PxU32 numActiveWheels,
- PxRigidDynamic* vehActor)
+ const PxTransform& carChassisTrnsfm, const PxF32 validityRadius)
 {
-	//Get the transform of the chassis.
-	PxTransform carChassisTrnsfm=vehActor->getGlobalPose().transform(vehActor->getCMassLocalPose());
-
 	//Add a raycast for each wheel.
 	for(PxU32 j=0;j<numActiveWheels;j++)
 	{
@@ -6535,6 +7505,11 @@ void PxVehicleWheels4SuspensionRaycasts
 		PxF32 suspLineLength=radius + maxBounce  + maxDroop + radius;
 		//Add another radius on for good measure.
 		suspLineLength+=radius;
+		//Reach far enough to keep the hits valid while the wheel stays inside the validity volume.
+		if(activeWheelStates[j])
+		{
+			suspLineLength+=validityRadius;
+		}
 
 		//Store the susp line ray for later use.
 		PxVehicleWheels4DynData::SuspLineRaycast& raycast = 
@@ -6550,17 +7525,180 @@ void PxVehicleWheels4SuspensionRaycasts
 	}
 }
 
-void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxRaycastQueryResult* sceneQueryResults, const bool* vehiclesToRaycast)
+void PxVehicleWheels4SuspensionSweeps
+(PxBatchQuery* batchQuery, 
+ const PxVehicleWheels4SimData& wheels4SimData, PxVehicleWheels4DynData& wheels4DynData, 
+ const PxQueryFilterData* carFilterData, const bool* activeWheelStates, const PxU32 numActiveWheels,
+ const PxTransform& carChassisTrnsfm, const PxF32 validityRadius, 
+ PxRigidDynamic* vehActor)
 {
-	START_TIMER(TIMER_RAYCASTS);
+	const PxQuat carActorRotation=vehActor->getGlobalPose().q;
+
+	//Add a sweep for each wheel.
+	for(PxU32 j=0;j<numActiveWheels;j++)
+	{
+		const PxVehicleSuspensionData& susp=wheels4SimData.getSuspensionData(j);
+		const PxVehicleWheelData& wheel=wheels4SimData.getWheelData(j);
+
+		const PxVec3& bodySpaceSuspTravelDir=wheels4SimData.getSuspTravelDirection(j);
+		PxVec3 bodySpaceWheelCentreOffset=wheels4SimData.getWheelCentreOffset(j);
+		PxF32 maxDroop=susp.mMaxDroop;
+		PxF32 maxBounce=susp.mMaxCompression;
+		PxF32 radius=wheel.mRadius;
+		PX_ASSERT(maxBounce>=0);
+		PX_ASSERT(maxDroop>=0);
+
+		//Sweep the geometry of the wheel shape if it has a shape that can be swept.
+		//Wheels without a shape or with a shape that can't be swept sweep a sphere of the wheel radius instead.
+		PxGeometryHolder wheelGeometry;
+		PxQuat wheelRotation=carChassisTrnsfm.q;
+		const PxI32 shapeIndex=wheels4SimData.getWheelShapeMapping(j);
+		bool hasWheelGeometry=false;
+		if(activeWheelStates[j] && shapeIndex != -1)
+		{
+			PxShape* wheelShape=NULL;
+			vehActor->getShapes(&wheelShape,1,(PxU32)shapeIndex);
+			PX_ASSERT(wheelShape);
+			const PxGeometryType::Enum geomType=wheelShape->getGeometryType();
+			if(PxGeometryType::eCONVEXMESH==geomType || PxGeometryType::eSPHERE==geomType || 
+			   PxGeometryType::eCAPSULE==geomType || PxGeometryType::eBOX==geomType)
+			{
+				wheelGeometry=wheelShape->getGeometry();
+				wheelRotation=carActorRotation*wheelShape->getLocalPose().q;
+				hasWheelGeometry=true;
+			}
+		}
+
+		if(!activeWheelStates[j])
+		{
+			//For disabled wheels just issue a sweep of almost zero length.
+			//This should be very cheap and ought to hit nothing.
+			bodySpaceWheelCentreOffset=PxVec3(0,0,0);
+			maxDroop=1e-5f*gToleranceScaleLength;
+			maxBounce=1e-5f*gToleranceScaleLength;
+			radius=1e-5f*gToleranceScaleLength;
+		}
+
+		if(!hasWheelGeometry)
+		{
+			wheelGeometry.storeAny(PxSphereGeometry(radius));
+		}
+
+		PxVec3 suspLineStart;
+		PxVec3 suspLineDir;
+		computeSuspensionRaycast(carChassisTrnsfm,bodySpaceWheelCentreOffset,bodySpaceSuspTravelDir,radius,maxBounce,suspLineStart,suspLineDir);
+
+		//Sweep the wheel from its position at max compression to its position at max droop.
+		PxF32 sweepLength=maxBounce + maxDroop;
+		//Add a radius on for good measure.
+		sweepLength+=radius;
+		//Reach far enough to keep the hits valid while the wheel stays inside the validity volume.
+		if(activeWheelStates[j])
+		{
+			sweepLength+=validityRadius;
+		}
+		const PxTransform sweepStartPose(suspLineStart + suspLineDir*radius, wheelRotation);
+
+		//Store the equivalent susp line ray for later use.
+		PxVehicleWheels4DynData::SuspLineRaycast& raycast = 
+			(PxVehicleWheels4DynData::SuspLineRaycast&)wheels4DynData.mRaycastsOrCachedHitResults;
+		raycast.mStarts[j]=suspLineStart;
+		raycast.mDirs[j]=suspLineDir;
+		raycast.mLengths[j]=sweepLength + 2.0f*radius;
+
+		//Add the sweep to the scene query.
+		batchQuery->sweep(
+			wheelGeometry.any(), sweepStartPose, suspLineDir, sweepLength, 0,
+			PxHitFlag::ePOSITION|PxHitFlag::eNORMAL|PxHitFlag::eDISTANCE, carFilterData[j]);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Test if the hit planes cached by the most recent PxVehicleUpdates can be 
+//reused instead of issuing a new suspension query for a block of 4 wheels.
+////////////////////////////////////////////////////////////////////////////
+
+bool isCachedHitDataValid
+(const PxVehicleWheels4SimData& wheels4SimData, const PxVehicleWheels4DynData& wheels4DynData, 
+ const bool* activeWheelStates, const PxU32 numActiveWheels, 
+ const PxTransform& carChassisTrnsfm, const PxF32 validityRadius)
+{
+	//The cached hits must have been found by a query with the same validity radius.
+	//The hit planes are only cached after PxVehicleUpdates has consumed the query results.
+	if(0.0f==validityRadius || validityRadius!=wheels4DynData.mCachedHitValidityRadius ||
+	   !wheels4DynData.mHasCachedRaycastHitPlane || wheels4DynData.mSqResults || wheels4DynData.mSqSweepResults)
+	{
+		return false;
+	}
+
+	const PxVehicleWheels4DynData::CachedSuspLineRaycastHitResult& cachedHitResult = 
+		(const PxVehicleWheels4DynData::CachedSuspLineRaycastHitResult&)wheels4DynData.mRaycastsOrCachedHitResults;
+
+	//Each wheel must have stayed inside the validity volume centred on its position at the time of the query.
+	//The point where the suspension line meets the cached hit plane must also have stayed inside the validity 
+	//volume. This rejects planes that are steep relative to the suspension (eg sweeps touching a kerb edge) 
+	//where a small movement of the wheel leads to a large change in jounce.
+	const PxTransform& queryTrnsfm=wheels4DynData.mCachedHitQueryPose;
+	const PxF32 validityRadiusSquared=validityRadius*validityRadius;
+	for(PxU32 j=0;j<numActiveWheels;j++)
+	{
+		if(activeWheelStates[j])
+		{
+			const PxVec3& bodySpaceWheelCentreOffset=wheels4SimData.getWheelCentreOffset(j);
+			const PxVec3 delta=carChassisTrnsfm.transform(bodySpaceWheelCentreOffset) - queryTrnsfm.transform(bodySpaceWheelCentreOffset);
+			if(delta.magnitudeSquared() >= validityRadiusSquared)
+			{
+				return false;
+			}
+
+			if(cachedHitResult.mCounts[j]>0)
+			{
+				const PxVehicleWheelData& wheel=wheels4SimData.getWheelData(j);
+				const PxVehicleSuspensionData& susp=wheels4SimData.getSuspensionData(j);
+				const PxVec3& bodySpaceSuspTravelDir=wheels4SimData.getSuspTravelDirection(j);
+				const PxVec3 n(cachedHitResult.mPlanes[j].x, cachedHitResult.mPlanes[j].y, cachedHitResult.mPlanes[j].z);
+				const PxF32 d=cachedHitResult.mPlanes[j].w;
+
+				PxVec3 v0,w0,v,w;
+				computeSuspensionRaycast(queryTrnsfm,bodySpaceWheelCentreOffset,bodySpaceSuspTravelDir,wheel.mRadius,susp.mMaxCompression,v0,w0);
+				computeSuspensionRaycast(carChassisTrnsfm,bodySpaceWheelCentreOffset,bodySpaceSuspTravelDir,wheel.mRadius,susp.mMaxCompression,v,w);
+				const PxF32 nw0=n.dot(w0);
+				const PxF32 nw=n.dot(w);
+				if(nw0>=0.0f || nw>=0.0f)
+				{
+					return false;
+				}
+				const PxVec3 p0=v0-w0*((n.dot(v0) + d)/nw0);
+				const PxVec3 p=v-w*((n.dot(v) + d)/nw);
+				if((p-p0).magnitudeSquared() >= validityRadiusSquared)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+void PxVehicleUpdate::suspensionQueries(PxBatchQuery* batchQuery, const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxRaycastQueryResult* raycastResults, PxSweepQueryResult* sweepResults, const bool* vehiclesToQuery)
+{
+	PX_ASSERT((NULL!=raycastResults) != (NULL!=sweepResults));
 
 	//Reset all hit counts to zero.
 	for(PxU32 i=0;i<numSceneQueryResults;i++)
 	{
-		sceneQueryResults[i].hasBlock=false;
+		if(raycastResults)
+		{
+			raycastResults[i].hasBlock=false;
+		}
+		else
+		{
+			sweepResults[i].hasBlock=false;
+		}
 	}
 
-	PxRaycastQueryResult* sqres=sceneQueryResults;
+	PxU32 sqresIndex=0;
 
 	const PxQueryFlags flags = PxQueryFlag::eSTATIC|PxQueryFlag::eDYNAMIC|PxQueryFlag::ePREFILTER;
 	PxQueryFilterData carFilterData[4];
@@ -6569,7 +7707,7 @@ void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 n
 	carFilterData[2].flags=flags;
 	carFilterData[3].flags=flags;
 
-	//Work out the rays for the suspension line raycasts and perform all the raycasts.
+	//Work out the queries of the suspension lines and perform all the queries.
 	for(PxU32 i=0;i<numVehicles;i++)
 	{
 		//Get the current car.
@@ -6579,67 +7717,106 @@ void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 n
 		const PxU32 numWheels4=((veh.mWheelsSimData.mNbActiveWheels & ~3) >> 2);
 		const PxU32 numActiveWheels=veh.mWheelsSimData.mNbActiveWheels;
 		const PxU32 numActiveWheelsInLast4=numActiveWheels-4*numWheels4;
+		const PxF32 validityRadius=veh.mWheelsDynData.mSuspensionQueryValidityRadius;
 		PxRigidDynamic* vehActor=veh.mActor;
 
-		//Set the results pointer and start the raycasts.
-		PX_ASSERT(numActiveWheelsInLast4<4);
+		//Get the transform of the chassis.
+		const PxTransform carChassisTrnsfm=vehActor->getGlobalPose().transform(vehActor->getCMassLocalPose());
 
-		//Blocks of 4 wheels.
-		for(PxU32 j=0;j<numWheels4;j++)
+		//Set the results pointer and start the queries.
+		//The remainder of wheels that don't make up a block of 4 are treated as a final partial block.
+		PX_ASSERT(numActiveWheelsInLast4<4);
+		const PxU32 numBlocks=numWheels4 + (numActiveWheelsInLast4>0 ? 1 : 0);
+		for(PxU32 j=0;j<numBlocks;j++)
 		{
+			const PxU32 numActiveWheelsInBlock=(j<numWheels4) ? 4 : numActiveWheelsInLast4;
+
 			bool activeWheelStates[4]={false,false,false,false};
 			computeWheelActiveStates(4*j, veh.mWheelsSimData.mActiveWheelsBitmapBuffer, activeWheelStates);
 
+			//Reuse the cached hit planes if all wheels are still inside the validity volume.
+			const bool reuseCachedHitData=isCachedHitDataValid(wheels4SimData[j],wheels4DynData[j],activeWheelStates,numActiveWheelsInBlock,carChassisTrnsfm,validityRadius);
+
 			wheels4DynData[j].mSqResults=NULL;
+			wheels4DynData[j].mSqSweepResults=NULL;
 
-			if(NULL==vehiclesToRaycast || vehiclesToRaycast[i])
+			if(NULL==vehiclesToQuery || vehiclesToQuery[i])
 			{
-				if((sceneQueryResults + numSceneQueryResults) >= (sqres+4))
+				//The batch query writes its results contiguously so only blocks that issue queries consume results.
+				if(!reuseCachedHitData)
 				{
-					carFilterData[0].data=wheels4SimData[j].getSceneQueryFilterData(0);
-					carFilterData[1].data=wheels4SimData[j].getSceneQueryFilterData(1);
-					carFilterData[2].data=wheels4SimData[j].getSceneQueryFilterData(2);
-					carFilterData[3].data=wheels4SimData[j].getSceneQueryFilterData(3);
-					wheels4DynData[j].mSqResults=sqres;
-					PxVehicleWheels4SuspensionRaycasts(batchQuery,wheels4SimData[j],wheels4DynData[j],carFilterData,activeWheelStates,4,vehActor);
-				}
-				else
-				{
-					PX_CHECK_MSG(false, "PxVehicleUpdate::suspensionRaycasts - numSceneQueryResults not big enough to support one raycast hit report per wheel.  Increase size of sceneQueryResults");
+					if((sqresIndex + numActiveWheelsInBlock) <= numSceneQueryResults)
+					{
+						for(PxU32 k=0;k<numActiveWheelsInBlock;k++)
+						{
+							carFilterData[k].data=wheels4SimData[j].getSceneQueryFilterData(k);
+						}
+
+						if(raycastResults)
+						{
+							wheels4DynData[j].mSqResults=raycastResults+sqresIndex;
+							PxVehicleWheels4SuspensionRaycasts(batchQuery,wheels4SimData[j],wheels4DynData[j],carFilterData,activeWheelStates,numActiveWheelsInBlock,carChassisTrnsfm,validityRadius);
+						}
+						else
+						{
+							wheels4DynData[j].mSqSweepResults=sweepResults+sqresIndex;
+							PxVehicleWheels4SuspensionSweeps(batchQuery,wheels4SimData[j],wheels4DynData[j],carFilterData,activeWheelStates,numActiveWheelsInBlock,carChassisTrnsfm,validityRadius,vehActor);
+						}
+
+						wheels4DynData[j].mCachedHitQueryPose=carChassisTrnsfm;
+						wheels4DynData[j].mCachedHitValidityRadius=validityRadius;
+					}
+					else
+					{
+						PX_CHECK_MSG(false, "PxVehicleUpdate::suspensionRaycasts - numSceneQueryResults not big enough to support one raycast hit report per wheel.  Increase size of sceneQueryResults");
+					}
+					sqresIndex+=numActiveWheelsInBlock;
 				}
-				sqres+=4;
 			}
 		}
-		//Remainder that don't make up a block of 4.
-		if(numActiveWheelsInLast4>0)
-		{
-			const PxU32 j=numWheels4;
+	}
 
-			bool activeWheelStates[4]={false,false,false,false};
-			computeWheelActiveStates(4*j, veh.mWheelsSimData.mActiveWheelsBitmapBuffer, activeWheelStates);
+	batchQuery->execute();
 
-			wheels4DynData[j].mSqResults=NULL;
-			
-			if(NULL==vehiclesToRaycast || vehiclesToRaycast[i])
+	//Hits on dynamic actors move with the hit actor so they can't be reused.
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		PxVehicleWheels& veh=*vehicles[i];
+		if(0.0f==veh.mWheelsDynData.mSuspensionQueryValidityRadius)
+			continue;
+
+		PxVehicleWheels4DynData* PX_RESTRICT wheels4DynData=veh.mWheelsDynData.mWheels4DynData;
+		const PxU32 numActiveWheels=veh.mWheelsSimData.mNbActiveWheels;
+		const PxU32 numBlocks=(numActiveWheels + 3) >> 2;
+		for(PxU32 j=0;j<numBlocks;j++)
+		{
+			const PxU32 numActiveWheelsInBlock=PxMin(numActiveWheels - 4*j, PxU32(4));
+			for(PxU32 k=0;k<numActiveWheelsInBlock;k++)
 			{
-				if((sceneQueryResults + numSceneQueryResults) >= (sqres+numActiveWheelsInLast4))
-				{
-					if(0<numActiveWheelsInLast4) carFilterData[0].data=wheels4SimData[j].getSceneQueryFilterData(0);
-					if(1<numActiveWheelsInLast4) carFilterData[1].data=wheels4SimData[j].getSceneQueryFilterData(1);
-					if(2<numActiveWheelsInLast4) carFilterData[2].data=wheels4SimData[j].getSceneQueryFilterData(2);
-					wheels4DynData[j].mSqResults=sqres;
-					PxVehicleWheels4SuspensionRaycasts(batchQuery,wheels4SimData[j],wheels4DynData[j],carFilterData,activeWheelStates,numActiveWheelsInLast4,vehActor);
-				}
-				else
+				const PxLocationHit* hit=getSuspensionQueryHit(wheels4DynData[j], k);
+				if(hit && hit->actor && hit->actor->is<PxRigidDynamic>())
 				{
-					PX_CHECK_MSG(false, "PxVehicleUpdate::suspensionRaycasts - numSceneQueryResults not bit enough to support one raycast hit report per wheel.  Increase size of sceneQueryResults");
+					wheels4DynData[j].mCachedHitValidityRadius=0.0f;
 				}
-				sqres+=numActiveWheelsInLast4;
 			}
 		}
 	}
+}
 
-	batchQuery->execute();
+void PxVehicleUpdate::suspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxRaycastQueryResult* sceneQueryResults, const bool* vehiclesToRaycast)
+{
+	START_TIMER(TIMER_RAYCASTS);
+
+	suspensionQueries(batchQuery, numVehicles, vehicles, numSceneQueryResults, sceneQueryResults, NULL, vehiclesToRaycast);
+
+	END_TIMER(TIMER_RAYCASTS);
+}
+
+void PxVehicleUpdate::suspensionSweeps(PxBatchQuery* batchQuery, const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxSweepQueryResult* sceneQueryResults, const bool* vehiclesToSweep)
+{
+	START_TIMER(TIMER_RAYCASTS);
+
+	suspensionQueries(batchQuery, numVehicles, vehicles, numSceneQueryResults, NULL, sceneQueryResults, vehiclesToSweep);
 
 	END_TIMER(TIMER_RAYCASTS);
 }
@@ -6651,3 +7828,10 @@ void physx::PxVehicleSuspensionRaycasts(PxBatchQuery* batchQuery, const PxU32 nu
 	STOP_PROFILER(ePROFILE_RAYCASTS)
 }
 
+void physx::PxVehicleSuspensionSweeps(PxBatchQuery* batchQuery, const PxU32 numVehicles, PxVehicleWheels** vehicles, const PxU32 numSceneQueryResults, PxSweepQueryResult* sceneQueryResults, const bool* vehiclesToSweep)
+{
+	START_PROFILER(ePROFILE_SWEEPS)
+	PxVehicleUpdate::suspensionSweeps(batchQuery, numVehicles, vehicles, numSceneQueryResults, sceneQueryResults, vehiclesToSweep);
+	STOP_PROFILER(ePROFILE_SWEEPS)
+}
+
@@ -420,6 +420,9 @@ void PxVehicleWheels::setToRestState()
 
 	//Set the wheels to rest state.
 	mWheelsDynData.setToRestState();
+
+	//Forget any time accumulated by reduced rate updates.
+	mLODAccumulatedTime=0.0f;
 }
 
 bool PxVehicleWheels::isValid() const
@@ -581,7 +584,14 @@ void PxVehicleWheels::setup
 	for(PxU32 i=0;i<numSuspWheelTire4;i++)
 	{
 		mWheelsDynData.mWheels4DynData[i].mSqResults=NULL;
+		mWheelsDynData.mWheels4DynData[i].mSqSweepResults=NULL;
 	}
+	mWheelsDynData.mSuspensionQueryValidityRadius=0.0f;
+
+	//Update the full model every call to PxVehicleUpdates until told otherwise.
+	mUpdateLOD=PxVehicleUpdateLOD::eFULL;
+	mLODUpdateInterval=0.05f;
+	mLODAccumulatedTime=0.0f;
 
 	//Set up the suspension limits constraints.
 	for(PxU32 i=0;i<numSuspWheelTire4;i++)
@@ -692,6 +702,18 @@ PxReal PxVehicleWheels::computeSidewaysSpeed() const
 	return mActor->getLinearVelocity().dot(vehicleChassisTrnsfm.q.rotate(gRight));
 }
 
+void PxVehicleWheels::setUpdateLOD(const PxVehicleUpdateLOD::Enum lod)
+{
+	PX_CHECK_AND_RETURN(lod < PxVehicleUpdateLOD::eMAX_NB_UPDATE_LODS, "PxVehicleWheels::setUpdateLOD - illegal lod");
+	mUpdateLOD=Ps::to8(lod);
+}
+
+void PxVehicleWheels::setLODUpdateInterval(const PxReal interval)
+{
+	PX_CHECK_AND_RETURN(interval > 0.0f, "PxVehicleWheels::setLODUpdateInterval - interval must be greater than zero");
+	mLODUpdateInterval=interval;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 void PxVehicleWheelsDynData::setUserData(const PxU32 tireIdx, void* userData)
@@ -700,6 +722,17 @@ void PxVehicleWheelsDynData::setUserData(const PxU32 tireIdx, void* userData)
 	mUserDatas[tireIdx]=userData;
 }
 
+void PxVehicleWheelsDynData::setSuspensionQueryValidityRadius(const PxReal radius)
+{
+	PX_CHECK_AND_RETURN(radius >= 0.0f, "PxVehicleWheelsDynData::setSuspensionQueryValidityRadius - radius must be greater than or equal to zero");
+	mSuspensionQueryValidityRadius = radius;
+	//Force a fresh query so that the next cached hits are found with the new query length.
+	for(PxU32 i=0;i<mNbWheels4;i++)
+	{
+		mWheels4DynData[i].mCachedHitValidityRadius=0.0f;
+	}
+}
+
 void* PxVehicleWheelsDynData::getUserData(const PxU32 tireIdx) const
 {
 	PX_CHECK_AND_RETURN_VAL(tireIdx < mNbActiveWheels, "PxVehicleWheelsDynData::setUserData - Illegal wheel", NULL);
@@ -723,7 +756,10 @@ void PxVehicleWheelsDynData::copy(const PxVehicleWheelsDynData& src, const PxU32
 	trg4.mTireLowSideSpeedTimers[trgWheel & 3] = src4.mTireLowSideSpeedTimers[srcWheel & 3];
 	trg4.mWheelRotationAngles[trgWheel & 3] = src4.mWheelRotationAngles[srcWheel & 3];
 
-	if(src4.mSqResults)
+	//The cached hits of the target block are no longer consistent with the pose they were found at.
+	trg4.mCachedHitValidityRadius = 0.0f;
+
+	if(src4.mSqResults || src4.mSqSweepResults)
 	{
 		const PxVehicleWheels4DynData::SuspLineRaycast& suspLineRaycastSrc = (const PxVehicleWheels4DynData::SuspLineRaycast&)src4.mRaycastsOrCachedHitResults;
 		PxVehicleWheels4DynData::SuspLineRaycast& suspLineRaycastTrg = (PxVehicleWheels4DynData::SuspLineRaycast&)trg4.mRaycastsOrCachedHitResults;
@@ -17,6 +17,7 @@
 #include "PsBitUtils.h"
 #include "SqAABBPruner.h"
 #include "SqAABBTree.h"
+#include "SqQuantizedAABBTree.h"
 #include "SqTreeBuilders.h"
 #include "GuSphere.h"
 #include "GuBox.h"
@@ -24,6 +25,7 @@
 #include "CmMemFetch.h"
 #include "SqPrunerTestsSIMD.h"
 #include "CmMemFetch.h"
+#include "PsInlineArray.h"
 
 
 using namespace physx;
@@ -41,9 +43,10 @@ using namespace Cm;
 #define PX_DELETE_AND_RESET(a)
 #endif
 
-AABBPruner::AABBPruner(bool incrementalRebuild) 
+AABBPruner::AABBPruner(bool incrementalRebuild, bool quantizedTree, bool rotateTree) 
 #ifndef __SPU__
 :	mAABBTree			(NULL)
+,	mQuantizedTree		(NULL)
 ,	mNewTree			(NULL)
 ,	mCachedBoxes		(NULL)
 ,	mNbCachedBoxes		(0)
@@ -55,14 +58,25 @@ AABBPruner::AABBPruner(bool incrementalRebuild)
 ,	mRebuildRateHint	(100)
 ,	mAdaptiveRebuildTerm(0)
 ,	mIncrementalRebuild	(incrementalRebuild)
+,	mQuantizeTree		(quantizedTree && !incrementalRebuild)
+,	mRotateTree			(rotateTree && incrementalRebuild)
 ,	mUncommittedChanges(false)
 ,	mNeedsNewTree		(false)
 ,	mDoSaveFixups		(false)
 ,	mNewTreeFixups		(PX_DEBUG_EXP("AABBPrunerMapper::mNewTreeFixups"))
+,	mBuildSAHCost		(0.0f)
+,	mRebuildQualityThreshold(1.5f)
+,	mNbRebuilds			(0)
+,	mNbRefits			(0)
+,	mNbRotations		(0)
 #endif
 {
 	// ensure that there is a vtable
 	PX_COMPILE_TIME_ASSERT(PX_OFFSET_OF(Sq::AABBPruner,mAABBTree)==sizeof(void*));
+	PX_ASSERT(!(quantizedTree && incrementalRebuild));
+	PX_ASSERT(!(rotateTree && !incrementalRebuild));
+	PX_UNUSED(quantizedTree);
+	PX_UNUSED(rotateTree);
 }
 
 
@@ -81,26 +95,42 @@ AABBPruner::~AABBPruner()
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#define SQ_SUBTREE_MIN_OBJECTS	256	// smaller batches are cheaper to keep in the bucket pruner until the next rebuild
+
 bool AABBPruner::addObjects(PrunerHandle* results, const PxBounds3* bounds, const PrunerPayload* payload, PxU32 count)
 {
 	// no need to do refitMarked for added objects since they are not in the tree
 
 	mUncommittedChanges = true;
 
-	PxU32 valid = 0;
+	const PxU32 nbPrevious = mPool.getNbActiveObjects();
+
+	// pool can return an invalid handle if out of preallocated mem
+	// should probably have an error here or not handle this
+	const PxU32 valid = mPool.addObjects(results, bounds, payload, count);
+	for(PxU32 i=valid;i<count;i++)
+		results[i] = INVALID_PRUNERHANDLE;
 
-	for(PxU32 i=0;i<count;i++)
+	// A large batch (e.g. PxScene::addActors streaming in a level tile) gets a tree of its own, attached to the current
+	// tree, instead of going through the bucket pruner. The batch is at the end of the pool. A tree being rebuilt in the
+	// background does not contain the batch, in that case it is queued in the bucket pruner like any other addition.
+	if(mIncrementalRebuild && mAABBTree && mProgress==BUILD_NOT_STARTED && valid>=SQ_SUBTREE_MIN_OBJECTS)
 	{
-		PrunerHandle h = mPool.addObject(bounds[i], payload[i]);
-		results[i] = h;
-		// pool can return an invalid handle if out of preallocated mem
-		// should probably have an error here or not handle this
-		if (h == INVALID_PRUNERHANDLE)
-			break;
+		AABBTree subtree;
+		AABBTreeBuilder TB;
+		TB.mNbPrimitives	= valid;
+		TB.mAABBArray		= mPool.getCurrentWorldBoxes() + nbPrevious;
+		TB.mSettings.mRules	= SPLIT_SAH;
+		TB.mSettings.mLimit	= 1;
+		subtree.build(&TB);
 
-		valid++;
-	}
+		mAABBTree->mergeTree(subtree, nbPrevious);
+		mTreeMap.initMap(PxMax(mPool.getNbActiveObjects(),mNbCachedBoxes),*mAABBTree);
 
+		// the attached tree overlaps the old one, the background rebuild restores the tree quality
+		mNeedsNewTree = true;
+		return valid==count;
+	}
 
 	// Bucket pruner is only used while the dynamic pruner is rebuilding
 	// For the static pruner a full rebuild will happen in commit() every time we modify something
@@ -128,7 +158,10 @@ void AABBPruner::updateObjects(const PrunerHandle* handles, const PxBounds3* new
 
 	if(mIncrementalRebuild && mAABBTree) 
 	{
-		mNeedsNewTree = true; // each update forces a tree rebuild
+		// each update forces a tree rebuild, unless the tree is maintained with rotations
+		// and only rebuilt once its quality degrades (see refitUpdatedAndRemoved)
+		if(!mRotateTree)
+			mNeedsNewTree = true;
 		for(PxU32 i=0; i<count; i++)
 		{
 			PxU32 poolIndex = mPool.getIndex(handles[i]);
@@ -345,6 +378,375 @@ skip_leaf_code:;
 	}
 };
 
+// Traversal of the quantized static tree. The child bounds of a node can only be decoded relative to the node's own
+// dequantized bounds (its frame), so every stack entry carries the frame along with the node index.
+struct QuantizedTraversalEntry
+{
+	PxU32		node;
+	PxBounds3	frame;
+	PxReal		nearDist;	// distance at which the ray enters the node, raycasts only
+};
+typedef Ps::InlineArray<QuantizedTraversalEntry, RAW_TRAVERSAL_STACK_SIZE> QuantizedTraversalStack;
+
+static PX_FORCE_INLINE void getCenterExtentsV(const PxBounds3& bounds, Vec3V& center, Vec3V& extents)
+{
+	const Vec3V minV = V3LoadU(bounds.minimum);
+	const Vec3V maxV = V3LoadU(bounds.maximum);
+	center = V3Scale(V3Add(maxV, minV), FHalf());
+	extents = V3Scale(V3Sub(maxV, minV), FHalf());
+}
+
+// SIMD version of QuantizedAABBTreeNode::getChildBounds, computes exactly the same values
+static PX_FORCE_INLINE void getChildBoundsV(const QuantizedAABBTreeNode& node, PxU32 i, const Vec3V frameMin, const Vec3V frameMax, const Vec3V scale, Vec3V& minV, Vec3V& maxV)
+{
+	const Vec3V qMin = V3LoadU(PxVec3(PxReal(node.minx[i]), PxReal(node.miny[i]), PxReal(node.minz[i])));
+	const Vec3V qMax = V3LoadU(PxVec3(PxReal(SQ_QUANTIZATION_MAX-node.maxx[i]), PxReal(SQ_QUANTIZATION_MAX-node.maxy[i]), PxReal(SQ_QUANTIZATION_MAX-node.maxz[i])));
+	minV = V3Add(frameMin, V3Mul(qMin, scale));
+	maxV = V3Sub(frameMax, V3Mul(qMax, scale));
+}
+
+template<typename Test>
+class QuantizedAABBTreeOverlap
+{
+public:
+	bool operator()(PrunerPayload* objects, const QuantizedAABBTree& tree, const Test& test, PrunerCallback &visitor)
+	{
+		Vec3V center, extents;
+		getCenterExtentsV(tree.getBounds(), center, extents);
+		if(!test(center, extents))
+			return true;
+
+		const QuantizedAABBTreeNode* nodes = tree.getNodes();
+		QuantizedTraversalStack stack;
+		const QuantizedTraversalEntry root = { 0, tree.getBounds(), 0.0f };
+		stack.pushBack(root);
+		while(stack.size())
+		{
+			const QuantizedTraversalEntry current = stack.popBack();
+			const QuantizedAABBTreeNode& node = nodes[current.node];
+			const Vec3V frameMin = V3LoadU(current.frame.minimum);
+			const Vec3V frameMax = V3LoadU(current.frame.maximum);
+			const Vec3V scale = V3LoadU(computeQuantizationScale(current.frame));
+			for(PxU32 i=0;i<QuantizedAABBTreeNode::SIZE && !node.isEmpty(i);i++)
+			{
+				Vec3V childMin, childMax;
+				getChildBoundsV(node, i, frameMin, frameMax, scale, childMin, childMax);
+				center = V3Scale(V3Add(childMax, childMin), FHalf());
+				extents = V3Scale(V3Sub(childMax, childMin), FHalf());
+				if(!test(center, extents))
+					continue;
+
+				if(node.isLeaf(i))
+				{
+					PxReal unusedDistance;
+					if(!visitor.invoke(unusedDistance, translatePxU32ToPrunerPayload(node.getPrimitive(i), objects), 1))
+						return false;
+				}
+				else
+				{
+					QuantizedTraversalEntry& child = stack.insert();
+					child.node = node.getChildNode(i);
+					V3StoreU(childMin, child.frame.minimum);
+					V3StoreU(childMax, child.frame.maximum);
+					child.nearDist = 0.0f;
+				}
+			}
+		}
+		return true;
+	}
+};
+
+static PX_FORCE_INLINE Vec4V loadQuantized4(const PxU16* q)
+{
+#if (defined(PX_X86) || defined (PX_X64)) && COMPILE_VECTOR_INTRINSICS
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(q)), _mm_setzero_si128()));
+#else
+	PX_ALIGN(16, PxI32 values[4]);
+	values[0] = q[0]; values[1] = q[1]; values[2] = q[2]; values[3] = q[3];
+	return Vec4V_From_VecI32V(I4LoadA(values));
+#endif
+}
+
+// Dequantized bounds of all children of a node, transposed for RayAABBTest4.
+// Computes exactly the same values as QuantizedAABBTreeNode::getChildBounds.
+struct QuantizedNodeBounds4
+{
+	Vec4V minX, minY, minZ, maxX, maxY, maxZ;
+
+	PX_FORCE_INLINE QuantizedNodeBounds4(const QuantizedAABBTreeNode& node, const PxBounds3& frame)
+	{
+		PX_COMPILE_TIME_ASSERT(QuantizedAABBTreeNode::SIZE==4);
+		const PxVec3 scale = computeQuantizationScale(frame);
+		const Vec4V qMax = V4Load(PxReal(SQ_QUANTIZATION_MAX));
+		minX = V4Add(V4Load(frame.minimum.x), V4Mul(loadQuantized4(node.minx), V4Load(scale.x)));
+		minY = V4Add(V4Load(frame.minimum.y), V4Mul(loadQuantized4(node.miny), V4Load(scale.y)));
+		minZ = V4Add(V4Load(frame.minimum.z), V4Mul(loadQuantized4(node.minz), V4Load(scale.z)));
+		maxX = V4Sub(V4Load(frame.maximum.x), V4Mul(V4Sub(qMax, loadQuantized4(node.maxx)), V4Load(scale.x)));
+		maxY = V4Sub(V4Load(frame.maximum.y), V4Mul(V4Sub(qMax, loadQuantized4(node.maxy)), V4Load(scale.y)));
+		maxZ = V4Sub(V4Load(frame.maximum.z), V4Mul(V4Sub(qMax, loadQuantized4(node.maxz)), V4Load(scale.z)));
+	}
+
+	// the frames of the internal children pushed on the stack
+	PX_FORCE_INLINE void getChildBounds(PxU32 i, PxBounds3& bounds) const
+	{
+		PX_ALIGN(16, PxReal v[6][4]);
+		V4StoreA(minX, v[0]); V4StoreA(minY, v[1]); V4StoreA(minZ, v[2]);
+		V4StoreA(maxX, v[3]); V4StoreA(maxY, v[4]); V4StoreA(maxZ, v[5]);
+		bounds.minimum = PxVec3(v[0][i], v[1][i], v[2][i]);
+		bounds.maximum = PxVec3(v[3][i], v[4][i], v[5][i]);
+	}
+
+	template<bool tInflate>
+	PX_FORCE_INLINE PxU32 raycast(const Gu::RayAABBTest4& test, Vec4V& tNear) const
+	{
+		return test.check<tInflate>(minX, minY, minZ, maxX, maxY, maxZ, tNear);
+	}
+};
+
+// empty slots are last, they must be masked out since their inverted bounds would pass the slab test
+static PX_FORCE_INLINE PxU32 getChildMask(const QuantizedAABBTreeNode& node)
+{
+	PxU32 mask = 0;
+	for(PxU32 i=0;i<QuantizedAABBTreeNode::SIZE && !node.isEmpty(i);i++)
+		mask |= 1<<i;
+	return mask;
+}
+
+template <bool tInflate> // use inflate=true for sweeps, inflate=false for raycasts
+class QuantizedAABBTreeRaycast
+{
+public:
+	bool operator()(
+		PrunerPayload* objects, const QuantizedAABBTree& tree,
+		const PxVec3& origin, const PxVec3& unitDir, PxReal &maxDist, const PxVec3& inflation,
+		PrunerCallback& pcb)
+	{
+		Gu::RayAABBTest4 test(origin, unitDir, maxDist, inflation);
+
+		const PxBounds3& rootBounds = tree.getBounds();
+		Vec4V tNearV;
+		if(!(test.check<tInflate>(	V4Load(rootBounds.minimum.x), V4Load(rootBounds.minimum.y), V4Load(rootBounds.minimum.z),
+									V4Load(rootBounds.maximum.x), V4Load(rootBounds.maximum.y), V4Load(rootBounds.maximum.z), tNearV) & 1))
+			return true;
+
+		const QuantizedAABBTreeNode* nodes = tree.getNodes();
+		QuantizedTraversalStack stack;
+		const QuantizedTraversalEntry root = { 0, rootBounds, 0.0f };
+		stack.pushBack(root);
+		while(stack.size())
+		{
+			const QuantizedTraversalEntry current = stack.popBack();
+			if(Gu::RayAABBTest4::isCulled(current.nearDist, maxDist))	// the ray has been shortened since the node was pushed
+				continue;
+
+			// all children are tested at once
+			const QuantizedAABBTreeNode& node = nodes[current.node];
+			const QuantizedNodeBounds4 bounds(node, current.frame);
+			PxU32 hitMask = bounds.raycast<tInflate>(test, tNearV) & getChildMask(node);
+			if(!hitMask)
+				continue;
+
+			PX_ALIGN(16, PxReal tNear[4]);
+			V4StoreA(tNearV, tNear);
+
+			// sort the children hit by the ray front to back
+			PxU32 order[QuantizedAABBTreeNode::SIZE];
+			PxU32 nbHits = 0;
+			while(hitMask)
+			{
+				const PxU32 i = Ps::lowestSetBit(hitMask);
+				hitMask &= hitMask-1;
+				PxU32 j = nbHits++;
+				for(; j && tNear[order[j-1]]>tNear[i]; j--)
+					order[j] = order[j-1];
+				order[j] = i;
+			}
+
+			// leaves are reported front to back so that they shorten the ray as early as possible,
+			// internal children are pushed back to front so that the closest one is popped first
+			PxU32 internalChildren[QuantizedAABBTreeNode::SIZE];
+			PxU32 nbInternalChildren = 0;
+			for(PxU32 j=0;j<nbHits;j++)
+			{
+				const PxU32 i = order[j];
+				if(Gu::RayAABBTest4::isCulled(tNear[i], maxDist))
+					break;	// so are all the children behind this one
+
+				if(!node.isLeaf(i))
+				{
+					internalChildren[nbInternalChildren++] = i;
+					continue;
+				}
+
+				PxReal md = maxDist;
+				const PxReal oldMaxDist = maxDist; // we copy since maxDist can be updated in the callback and md<maxDist test below can fail
+				if(!pcb.invoke(md, translatePxU32ToPrunerPayload(node.getPrimitive(i), objects), 1))
+					return false;
+
+				if(md < oldMaxDist)
+				{
+					maxDist = md;
+					test.setDistance(md);
+				}
+			}
+
+			while(nbInternalChildren--)
+			{
+				const PxU32 i = internalChildren[nbInternalChildren];
+				QuantizedTraversalEntry& child = stack.insert();
+				child.node = node.getChildNode(i);
+				bounds.getChildBounds(i, child.frame);
+				child.nearDist = tNear[i];
+			}
+		}
+		return true;
+	}
+};
+
+// Traversal of the quantized tree for a packet of rays. Each node is decoded once for the whole packet and tested
+// against the rays that hit the node itself, which are tracked as a bit mask in the stack entries.
+struct QuantizedPacketTraversalEntry
+{
+	PxU32		node;
+	PxBounds3	frame;
+	PxU32		rays;
+};
+typedef Ps::InlineArray<QuantizedPacketTraversalEntry, RAW_TRAVERSAL_STACK_SIZE> QuantizedPacketTraversalStack;
+
+class QuantizedAABBTreeRaycastPacket
+{
+public:
+	// returns the rays of rayMask for which the query should go on
+	PxU32 operator()(
+		PrunerPayload* objects, const QuantizedAABBTree& tree,
+		const PxVec3* origins, const PxVec3* unitDirs, PxReal* maxDists, PrunerCallback* const* pcbs, PxU32 rayMask)
+	{
+		Gu::RayAABBTest4 tests[SQ_RAY_PACKET_SIZE];
+		PxVec3 packetDir(0.0f);
+		for(PxU32 rays=rayMask; rays; rays &= rays-1)
+		{
+			const PxU32 r = Ps::lowestSetBit(rays);
+			tests[r] = Gu::RayAABBTest4(origins[r], unitDirs[r], maxDists[r], PxVec3(0.0f));
+			packetDir += unitDirs[r];
+		}
+
+		const QuantizedAABBTreeNode* nodes = tree.getNodes();
+		QuantizedPacketTraversalStack stack;
+		const QuantizedPacketTraversalEntry root = { 0, tree.getBounds(), rayMask };
+		stack.pushBack(root);
+		while(stack.size())
+		{
+			const QuantizedPacketTraversalEntry current = stack.popBack();
+			PxU32 rays = current.rays & rayMask;
+			if(!rays)
+				continue;
+
+			const QuantizedAABBTreeNode& node = nodes[current.node];
+			const QuantizedNodeBounds4 bounds(node, current.frame);
+			const PxU32 childMask = getChildMask(node);
+
+			// test every ray against all children, and transpose the results into the rays hitting each child
+			PX_ALIGN(16, PxReal tNear[SQ_RAY_PACKET_SIZE][4]);
+			PxU32 childRays[QuantizedAABBTreeNode::SIZE] = { 0, 0, 0, 0 };
+			for(; rays; rays &= rays-1)
+			{
+				const PxU32 r = Ps::lowestSetBit(rays);
+				Vec4V tNearV;
+				PxU32 hitMask = bounds.raycast<false>(tests[r], tNearV) & childMask;
+				V4StoreA(tNearV, tNear[r]);
+				for(; hitMask; hitMask &= hitMask-1)
+					childRays[Ps::lowestSetBit(hitMask)] |= 1<<r;
+			}
+
+			// children are ordered along the average direction of the packet, which is a good order for coherent rays
+			PxU32 order[QuantizedAABBTreeNode::SIZE];
+			PxReal keys[QuantizedAABBTreeNode::SIZE];
+			PxU32 nbHits = 0;
+			for(PxU32 i=0;i<QuantizedAABBTreeNode::SIZE;i++)
+			{
+				if(!childRays[i])
+					continue;
+
+				PxBounds3 childBounds;
+				bounds.getChildBounds(i, childBounds);
+				const PxReal key = childBounds.getCenter().dot(packetDir);
+				PxU32 j = nbHits++;
+				for(; j && keys[j-1]>key; j--)
+				{
+					keys[j] = keys[j-1];
+					order[j] = order[j-1];
+				}
+				keys[j] = key;
+				order[j] = i;
+			}
+
+			PxU32 internalChildren[QuantizedAABBTreeNode::SIZE];
+			PxU32 nbInternalChildren = 0;
+			for(PxU32 j=0;j<nbHits;j++)
+			{
+				const PxU32 i = order[j];
+				if(!node.isLeaf(i))
+				{
+					internalChildren[nbInternalChildren++] = i;
+					continue;
+				}
+
+				const PrunerPayload* payload = translatePxU32ToPrunerPayload(node.getPrimitive(i), objects);
+				for(PxU32 leafRays = childRays[i] & rayMask; leafRays; leafRays &= leafRays-1)
+				{
+					const PxU32 r = Ps::lowestSetBit(leafRays);
+					if(Gu::RayAABBTest4::isCulled(tNear[r][i], maxDists[r]))	// the ray has been shortened by a previous leaf
+						continue;
+
+					PxReal md = maxDists[r];
+					const PxReal oldMaxDist = maxDists[r];
+					if(!pcbs[r]->invoke(md, payload, 1))
+					{
+						rayMask &= ~(1<<r);
+						if(!rayMask)
+							return 0;
+						continue;
+					}
+
+					if(md < oldMaxDist)
+					{
+						maxDists[r] = md;
+						tests[r].setDistance(md);
+					}
+				}
+			}
+
+			while(nbInternalChildren--)
+			{
+				const PxU32 i = internalChildren[nbInternalChildren];
+				QuantizedPacketTraversalEntry& child = stack.insert();
+				child.node = node.getChildNode(i);
+				bounds.getChildBounds(i, child.frame);
+				child.rays = childRays[i];
+			}
+		}
+		return rayMask;
+	}
+};
+
+template<typename Test>
+static PX_FORCE_INLINE bool overlapTree(PrunerPayload* objects, const AABBTree* tree, const QuantizedAABBTree* quantizedTree, const Test& test, PrunerCallback& pcb)
+{
+	if(quantizedTree)
+		return QuantizedAABBTreeOverlap<Test>()(objects, *quantizedTree, test, pcb);
+	return AABBTreeOverlap<Test>()(objects, *tree, test, pcb);
+}
+
+template <bool tInflate>
+static PX_FORCE_INLINE bool raycastTree(
+	PrunerPayload* objects, const AABBTree* tree, const QuantizedAABBTree* quantizedTree,
+	const PxVec3& origin, const PxVec3& unitDir, PxReal &maxDist, const PxVec3& inflation, PrunerCallback& pcb)
+{
+	if(quantizedTree)
+		return QuantizedAABBTreeRaycast<tInflate>()(objects, *quantizedTree, origin, unitDir, maxDist, inflation, pcb);
+	return AABBTreeRaycast<tInflate>()(objects, *tree, origin, unitDir, maxDist, inflation, pcb);
+}
+
 
 
 PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) const
@@ -353,7 +755,7 @@ PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) c
 
 	PxAgain again = true;
 	
-	if(mAABBTree)
+	if(mAABBTree || mQuantizedTree)
 	{
 		switch(queryVolume.getOriginalPxGeom().getType())
 		{
@@ -362,32 +764,32 @@ PxAgain AABBPruner::overlap(const ShapeData& queryVolume, PrunerCallback& pcb) c
 				if (PxAbs(queryVolume.getPrunerWorldTransform().q.w) < 0.999999f)
 				{	
 					Gu::OBBAABBTest test(queryVolume.getPrunerWorldTransform(), queryVolume.getPrunerBoxGeom(), SQ_PRUNER_INFLATION);
-					again = AABBTreeOverlap<Gu::OBBAABBTest>()(mPool.getObjects(), *mAABBTree, test, pcb);
+					again = overlapTree(mPool.getObjects(), mAABBTree, mQuantizedTree, test, pcb);
 				}
 				else
 				{
 					Gu::AABBAABBTest test(queryVolume.getPrunerInflatedWorldAABB());
-					again = AABBTreeOverlap<Gu::AABBAABBTest>()(mPool.getObjects(), *mAABBTree, test, pcb);
+					again = overlapTree(mPool.getObjects(), mAABBTree, mQuantizedTree, test, pcb);
 				}
 			}
 			break;
 		case PxGeometryType::eCAPSULE:
 			{
 				Gu::CapsuleAABBTest test(queryVolume.getPrunerWorldTransform(), queryVolume.getNPPxCapsule(), SQ_PRUNER_INFLATION);
-				again = AABBTreeOverlap<Gu::CapsuleAABBTest>()(mPool.getObjects(), *mAABBTree, test, pcb);
+				again = overlapTree(mPool.getObjects(), mAABBTree, mQuantizedTree, test, pcb);
 			}
 			break;
 		case PxGeometryType::eSPHERE:
 			{
 				const Gu::Sphere& sphere = queryVolume.getNPGuSphere();
 				Gu::SphereAABBTest test(sphere.center, sphere.radius);
-				again = AABBTreeOverlap<Gu::SphereAABBTest>()(mPool.getObjects(), *mAABBTree, test, pcb);
+				again = overlapTree(mPool.getObjects(), mAABBTree, mQuantizedTree, test, pcb);
 			}
 			break;
 		case PxGeometryType::eCONVEXMESH:
 			{
 				Gu::OBBAABBTest test(queryVolume.getPrunerWorldTransform(), queryVolume.getPrunerBoxGeom(), SQ_PRUNER_INFLATION);
-				again = AABBTreeOverlap<Gu::OBBAABBTest>()(mPool.getObjects(), *mAABBTree, test, pcb);			
+				again = overlapTree(mPool.getObjects(), mAABBTree, mQuantizedTree, test, pcb);			
 			}
 			break;
 		case PxGeometryType::ePLANE:
@@ -412,11 +814,11 @@ PxAgain AABBPruner::sweep(const ShapeData& queryVolume, const PxVec3& unitDir, P
 
 	PxAgain again = true;
 
-	if(mAABBTree)
+	if(mAABBTree || mQuantizedTree)
 	{
 		const PxBounds3& aabb = queryVolume.getPrunerInflatedWorldAABB();
 		PxVec3 extents = aabb.getExtents();
-		again = AABBTreeRaycast<true>()(mPool.getObjects(), *mAABBTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
+		again = raycastTree<true>(mPool.getObjects(), mAABBTree, mQuantizedTree, aabb.getCenter(), unitDir, inOutDistance, extents, pcb);
 	}
 
 	if(again && mIncrementalRebuild && (mBuf0.size() || mBuf1.size()))
@@ -431,8 +833,8 @@ PxAgain AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal&
 
 	PxAgain again = true;
 
-	if(mAABBTree)
-		again = AABBTreeRaycast<false>()(mPool.getObjects(), *mAABBTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
+	if(mAABBTree || mQuantizedTree)
+		again = raycastTree<false>(mPool.getObjects(), mAABBTree, mQuantizedTree, origin, unitDir, inOutDistance, PxVec3(0.0f), pcb);
 		
 	if(again && mIncrementalRebuild && (mBuf0.size() || mBuf1.size()))
 		again = mBucketPruner.raycast(origin, unitDir, inOutDistance, pcb);
@@ -440,6 +842,25 @@ PxAgain AABBPruner::raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal&
 	return again;
 }
 
+PxU32 AABBPruner::raycastPacket(const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerCallback* const* pcbs, PxU32 rayMask) const
+{
+	PX_ASSERT(!mUncommittedChanges);
+
+	// the quantized tree is only used by the static pruner, there are no objects in the bucket pruner to query
+	if(mQuantizedTree)
+	{
+		PX_ASSERT(!mIncrementalRebuild);
+		return QuantizedAABBTreeRaycastPacket()(mPool.getObjects(), *mQuantizedTree, origins, unitDirs, inOutDistances, pcbs, rayMask);
+	}
+
+	for(PxU32 i=0;i<SQ_RAY_PACKET_SIZE;i++)
+	{
+		if((rayMask & (1<<i)) && !raycast(origins[i], unitDirs[i], inOutDistances[i], *pcbs[i]))
+			rayMask &= ~(1<<i);
+	}
+	return rayMask;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**
  *	Other methods of Pruner Interface
@@ -466,6 +887,11 @@ void AABBPruner::setRebuildRateHint(PxU32 nbStepsForRebuild)
 // Commit either performs a refit if background rebuild is not yet finished
 // or swaps the current tree for the second tree rebuilt in the background
 void AABBPruner::commit()
+{
+	commit(NULL);
+}
+
+void AABBPruner::commit(PxTaskManager* taskManager)
 {
 	if(!mUncommittedChanges)
 		// Q: seems like this is both for refit and finalization so is this is correct?
@@ -480,10 +906,10 @@ void AABBPruner::commit()
 	if(!mAABBTree || !mIncrementalRebuild)
 	{
 #ifdef PX_CHECKED
-		if(!mIncrementalRebuild && mAABBTree)
+		if(!mIncrementalRebuild && (mAABBTree || mQuantizedTree))
 			Ps::getFoundation().error(PxErrorCode::ePERF_WARNING, __FILE__, __LINE__, "SceneQuery static AABB Tree rebuilt, because a shape attached to a static actor was added, removed or moved, and PxSceneDesc::staticStructure is set to eSTATIC_AABB_TREE.");
 #endif
-		fullRebuildAABBTree();
+		fullRebuildAABBTree(taskManager);
 		return;
 	}
 
@@ -526,6 +952,7 @@ void AABBPruner::commit()
 		#endif
 		mAABBTree = mNewTree; // set current tree to progressively rebuilt tree
 		mNewTree = NULL; // clear out the progressively rebuild tree pointer
+		mNbRebuilds++;
 
 		// rebuild the tree map to match the current (newly built) tree
 		mTreeMap.initMap(PxMax(mPool.getNbActiveObjects(),mNbCachedBoxes),*mAABBTree);
@@ -550,9 +977,10 @@ void AABBPruner::commit()
 		AABBTreeBuilder TB;
 		TB.mNbPrimitives	= NbObjects;
 		TB.mAABBArray		= mPool.getCurrentWorldBoxes();
-		TB.mSettings.mRules	= SPLIT_SPLATTER_POINTS;
+		TB.mSettings.mRules	= SPLIT_SAH;
 		TB.mSettings.mLimit	= 1;
 		((AABBTree*)getAABBTree())->refit2(&TB, (PxU32*)getAABBTree()->getIndices());
+		mBuildSAHCost = mAABBTree->getSAHCost();
 
 		// mToRemoveFromBucket contains the list of PrunerHandles added
 		// back from when current tree finished rebuilding up to the start of ongoing tree rebuild
@@ -591,6 +1019,10 @@ void AABBPruner::shiftOrigin(const PxVec3& shift)
 	if(mAABBTree)
 		mAABBTree->shiftOrigin(shift);
 
+	// the quantized bounds are relative to each other, requantize them from the shifted pool bounds
+	if(mQuantizedTree)
+		mQuantizedTree->refit(mPool.getCurrentWorldBoxes());
+
 	if(mIncrementalRebuild)
 		mBucketPruner.shiftOrigin(shift);
 
@@ -624,6 +1056,35 @@ void AABBPruner::visualize(Cm::RenderOutput& out, PxU32 color) const
 		Local::_Draw(tree->getNodes(), tree->getNodes(), out);
 	}
 
+	if(mQuantizedTree)
+	{
+		out << PxTransform(PxIdentity);
+		out << color;
+		out << Cm::DebugBox(mQuantizedTree->getBounds(), true);
+
+		const QuantizedAABBTreeNode* nodes = mQuantizedTree->getNodes();
+		QuantizedTraversalStack stack;
+		const QuantizedTraversalEntry root = { 0, mQuantizedTree->getBounds(), 0.0f };
+		stack.pushBack(root);
+		while(stack.size())
+		{
+			const QuantizedTraversalEntry current = stack.popBack();
+			const QuantizedAABBTreeNode& node = nodes[current.node];
+			const PxVec3 scale = computeQuantizationScale(current.frame);
+			for(PxU32 i=0;i<QuantizedAABBTreeNode::SIZE && !node.isEmpty(i);i++)
+			{
+				QuantizedTraversalEntry child;
+				node.getChildBounds(i, current.frame, scale, child.frame);
+				out << Cm::DebugBox(child.frame, true);
+				if(!node.isLeaf(i))
+				{
+					child.node = node.getChildNode(i);
+					stack.pushBack(child);
+				}
+			}
+		}
+	}
+
 	// Render added objects not yet in the tree
 	out << PxTransform(PxIdentity);
 	out << PxU32(PxDebugColor::eARGB_WHITE);
@@ -679,7 +1140,7 @@ bool AABBPruner::buildStep()
 			mBuilder.reset();
 			mBuilder.mNbPrimitives		= mNbCachedBoxes;
 			mBuilder.mAABBArray			= mCachedBoxes;
-			mBuilder.mSettings.mRules	= SPLIT_SPLATTER_POINTS;
+			mBuilder.mSettings.mRules	= SPLIT_SAH;
 			mBuilder.mSettings.mLimit	= 1;
 
 			// start recording modifications to the tree made during rebuild to reapply (fix the new tree) eventually
@@ -757,11 +1218,12 @@ bool AABBPruner::buildStep()
  *	\return		true if success
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool AABBPruner::fullRebuildAABBTree()
+bool AABBPruner::fullRebuildAABBTree(PxTaskManager* taskManager)
 {
 #ifndef __SPU__
 	// Release possibly already existing tree
 	PX_DELETE_AND_RESET(mAABBTree);
+	PX_DELETE_AND_RESET(mQuantizedTree);
 
 	// Don't bother building an AABB-tree if there isn't a single static object
 	const PxU32 nbObjects = mPool.getNbActiveObjects();
@@ -776,15 +1238,35 @@ bool AABBPruner::fullRebuildAABBTree()
 		AABBTreeBuilder TB;
 		TB.mNbPrimitives	= nbObjects;
 		TB.mAABBArray		= mPool.getCurrentWorldBoxes();
-		TB.mSettings.mRules	= SPLIT_SPLATTER_POINTS;
+		TB.mSettings.mRules	= SPLIT_SAH;
 		TB.mSettings.mLimit	= 1; // 1 pool object per tree node
-		Status = mAABBTree->build(&TB);
+		Status = mAABBTree->build(&TB, taskManager);
+	}
+
+	// The quantized tree takes over, the binary tree is only needed to build it
+	if(Status && mQuantizeTree)
+	{
+		PX_ASSERT(!mIncrementalRebuild);
+		mQuantizedTree = PX_NEW(QuantizedAABBTree);
+		Status = mQuantizedTree->build(*mAABBTree, mPool.getCurrentWorldBoxes());
+		if(Status)
+		{
+			PX_DELETE_AND_RESET(mAABBTree);
+		}
+		else
+		{
+			PX_DELETE_AND_RESET(mQuantizedTree);
+		}
 	}
 
 	// No need for the tree map for static pruner
 	if(mIncrementalRebuild)
 		mTreeMap.initMap(PxMax(nbObjects,mNbCachedBoxes),*mAABBTree);
 
+	if(Status)
+		mNbRebuilds++;
+	mBuildSAHCost = mAABBTree ? mAABBTree->getSAHCost() : 0.0f;
+
 	return Status;
 #else
 	return true;
@@ -816,6 +1298,7 @@ void AABBPruner::release() // this can be called from purge()
 	mBuilder.reset();
 	PX_DELETE_AND_RESET(mNewTree);
 	PX_DELETE_AND_RESET(mAABBTree);
+	PX_DELETE_AND_RESET(mQuantizedTree);
 
 	mNbCachedBoxes = 0;
 	mProgress = BUILD_NOT_STARTED;
@@ -843,7 +1326,31 @@ void AABBPruner::refitUpdatedAndRemoved()
 	if(!nbObjects)
 		return;
 
-	Tree->refitMarked(nbObjects, mPool.getCurrentWorldBoxes(), Tree->getIndices());
+	mNbRotations += Tree->refitMarked(nbObjects, mPool.getCurrentWorldBoxes(), Tree->getIndices(), mRotateTree ? &mTreeMap : NULL);
+	mNbRefits++;
+
+	// With rotations the tree is only rebuilt when objects were added or removed, or when the rotations
+	// could not keep up with the moving objects
+	if(mRotateTree && !mNeedsNewTree && getTreeQuality() > mRebuildQualityThreshold)
+		mNeedsNewTree = true;
+}
+
+PxReal AABBPruner::getTreeQuality() const
+{
+	if(mQuantizedTree)
+		return 1.0f;	// static tree, never refitted
+	if(!mAABBTree)
+		return 0.0f;
+	return mBuildSAHCost>0.0f ? mAABBTree->getSAHCost()/mBuildSAHCost : 1.0f;
+}
+
+void AABBPruner::getStatistics(PxPruningStructureStatistics& stats) const
+{
+	stats.nbRebuilds		= mNbRebuilds;
+	stats.nbRefits			= mNbRefits;
+	stats.nbRotations		= mNbRotations;
+	stats.treeQuality		= getTreeQuality();
+	stats.rebuildInProgress	= mProgress!=BUILD_NOT_STARTED;
 }
 #endif
 
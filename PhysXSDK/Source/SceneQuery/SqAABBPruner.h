@@ -20,14 +20,17 @@
 #include "SqTreeBuilders.h"
 
 #include "PsHashSet.h"
+#include "PxSceneDesc.h" // PxPruningStructureStatistics
 
 namespace physx
 {
+	class PxTaskManager;
 
 namespace Sq
 {
 	class AABBTree;
 	class AABBTreeNode;
+	class QuantizedAABBTree;
 
 	enum BuildStatus
 	{
@@ -43,6 +46,9 @@ namespace Sq
 	// The underlying data structure is a binary AABB tree
 	// AABBPruner supports insertions, removals and updates for dynamic objects
 	// The tree is either entirely rebuilt in a single frame (static pruner) or progressively rebuilt over multiple frames (dynamic pruner)
+	// The static pruner can optionally convert its tree into a QuantizedAABBTree after each rebuild and drop the binary tree
+	// The dynamic pruner can optionally rotate its tree while refitting (mRotateTree), updated objects then no longer trigger a rebuild,
+	// only a degraded tree quality does (see mRebuildQualityThreshold)
 	// The rebuild happens on a copy of the tree
 	// the copy is then swapped with current tree at the time commit() is called (only if mBuildState is BUILD_FINISHED),
 	// otherwise commit() will perform a refit operation applying any pending changes to the current tree
@@ -59,7 +65,7 @@ namespace Sq
 #endif
 	{
 		public:
-												AABBPruner(bool incrementalRebuild); // true is equivalent to former dynamic pruner
+												AABBPruner(bool incrementalRebuild, bool quantizedTree = false, bool rotateTree = false); // true is equivalent to former dynamic pruner, quantizedTree is only supported without incremental rebuild, rotateTree only with it
 		virtual									~AABBPruner(); // keep this virtual on SPU as well so the layout is identical to CPU
 
 		// Pruner Interface is non-virtual here to avoid SPU vtable patching
@@ -70,16 +76,23 @@ namespace Sq
 						PxAgain					raycast(const PxVec3& origin, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&)			const;
 						PxAgain					sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&)		const;
 						PxAgain					overlap(const ShapeData& queryVolume, PrunerCallback&) const;
+						// single traversal for the whole packet with a quantized tree, one raycast per ray otherwise
+						PxU32					raycastPacket(const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerCallback* const* pcbs, PxU32 rayMask) const;
 
 						const PrunerPayload&	getPayload(const PrunerHandle& h) const { return mPool.getPayload(h); }
 						void					preallocate(PxU32 entries) { mPool.preallocate(entries); }
 
 						void					commit();
+						// same as commit(), full rebuilds run in parallel on the task manager's CPU dispatcher if one is given.
+						// Blocks until the rebuild is done, so this must not be called from a task.
+						void					commit(PxTaskManager* taskManager);
 						void					shiftOrigin(const PxVec3& shift);
 						void					visualize(Cm::RenderOutput& out, PxU32 color) const;
 
 		// non-pruner interface
 						void					setRebuildRateHint(PxU32 nbStepsForRebuild);	// Besides the actual rebuild steps, 3 additional steps are needed.
+						void					setRebuildQualityThreshold(PxReal threshold)	{ PX_ASSERT(threshold>=1.0f); mRebuildQualityThreshold = threshold;	}
+						void					getStatistics(PxPruningStructureStatistics& stats) const;
 						bool					buildStep();	// returns true if finished
 						void					purge();		// gets rid of internal accel struct
 
@@ -90,12 +103,16 @@ namespace Sq
 		PX_FORCE_INLINE	AABBTree*				getAABBTree()							{ PX_ASSERT(!mUncommittedChanges); return mAABBTree;	}
 		PX_FORCE_INLINE	void					setAABBTree(AABBTree* tree)				{ mAABBTree = tree; }
 		PX_FORCE_INLINE	const AABBTree*			hasAABBTree()	const					{ return mAABBTree;	}
+		PX_FORCE_INLINE	const QuantizedAABBTree*	getQuantizedTree()	const			{ PX_ASSERT(!mUncommittedChanges); return mQuantizedTree;	}
 				
 		// local functions
 		private:
 						Sq::AABBTree*			mAABBTree; // current active tree
 						Sq::AABBTreeBuilder		mBuilder; // this class deals with the details of the actual tree building
 
+						// compact version of the static tree, replaces mAABBTree after each full rebuild if mQuantizeTree is set
+						Sq::QuantizedAABBTree*	mQuantizedTree;
+
 						// tree with build in progress, assigned to mAABBTree in commit, when mProgress is BUILD_FINISHED
 						Sq::AABBTree*			mNewTree;
 
@@ -155,6 +172,13 @@ namespace Sq
 						// bucket pruner is only used with incremental rebuild
 						bool					mIncrementalRebuild;
 
+						// Set once in the constructor, only used by the static pruner (mIncrementalRebuild is false)
+						bool					mQuantizeTree;
+
+						// Set once in the constructor, only used by the dynamic pruner (mIncrementalRebuild is true)
+						// refits also apply tree rotations, and updated objects do not trigger a rebuild
+						bool					mRotateTree;
+
 						// A rebuild can be triggered even when the Pruner is not dirty
 						// mUncommittedChanges is set to true in add, remove, update and buildStep
 						// mUncommittedChanges is set to false in commit
@@ -189,10 +213,21 @@ namespace Sq
 						};
 						Ps::Array<NewTreeFixup>	mNewTreeFixups;
 
+						// SAH cost of mAABBTree when it was built, the tree quality is the current cost relative to this one
+						PxReal					mBuildSAHCost;
+						// with mRotateTree, a rebuild starts when the tree quality exceeds this value
+						PxReal					mRebuildQualityThreshold;
+
+						// Statistics, see PxPruningStructureStatistics
+						PxU32					mNbRebuilds;
+						PxU32					mNbRefits;
+						PxU32					mNbRotations;
+
 						// Internal methods
-						bool					fullRebuildAABBTree(); // full rebuild function, used with static pruner mode
+						bool					fullRebuildAABBTree(PxTaskManager* taskManager); // full rebuild function, used with static pruner mode
 						void					release();
 						void					refitUpdatedAndRemoved();
+						PxReal					getTreeQuality() const;
 						void					updateBucketPruner();
 	};
 
@@ -18,7 +18,10 @@
 #include "PsMathUtils.h"
 #include "GuContainer.h"
 #include "SqAABBTree.h"
+#include "SqAABBTreeUpdateMap.h"
 #include "SqTreeBuilders.h"
+#include "CmTask.h"
+#include "PsSync.h"
 #ifdef SUPPORT_UPDATE_ARRAY
 #include "./GuRevisitedRadix.h"
 #endif
@@ -129,6 +132,139 @@ PxU32 AABBTreeNode::split(const PxBounds3& exactBounds, PxU32 axis, AABBTreeBuil
 	return NbPos;
 }
 
+#define SQ_SAH_NB_BINS							16
+#define SQ_PARALLEL_BUILD_MIN_PRIMS				4096	// below this the serial build is faster than setting up tasks
+#define SQ_PARALLEL_BUILD_MIN_SUBTREE_PRIMS		256		// smaller subtrees are built on the calling thread
+
+static PX_FORCE_INLINE float computeHalfSurfaceArea(const Vec3V boxMin, const Vec3V boxMax)
+{
+	PxVec3 d;
+	V3StoreU(V3Sub(boxMax, boxMin), d);
+	return d.x*d.y + d.y*d.z + d.z*d.x;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Splits the node using a binned surface area heuristic.
+ *	Primitive centers are binned along each axis, the split plane between two bins minimizing
+ *	area(left)*count(left) + area(right)*count(right) is selected.
+ *	The list of indices is reorganized like in split(): primitives above the split plane come first.
+ *	\param		builder		[in] the tree builder
+ *	\return		the number of primitives assigned to the first child, 0 if no valid split was found
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+PxU32 AABBTreeNode::splitSAH(AABBTreeBuilder* builder, PxU32* indices)
+{
+	const PxU32 nbPrims = getNbBuildPrimitives();
+	PxU32* PX_RESTRICT prims = indices + getNodePrimitives();
+
+	// The bins cover the bounds of the primitive centers, not of the primitives
+	Vec3V centerMinV = builder->getSplittingValues(prims[0]);
+	Vec3V centerMaxV = centerMinV;
+	for(PxU32 i=1;i<nbPrims;i++)
+	{
+		const Vec3V c = builder->getSplittingValues(prims[i]);
+		centerMinV = V3Min(centerMinV, c);
+		centerMaxV = V3Max(centerMaxV, c);
+	}
+	PxVec3 centerMin, centerMax;
+	V3StoreU(centerMinV, centerMin);
+	V3StoreU(centerMaxV, centerMax);
+
+	const Vec3V emptyMin = V3Load(PX_MAX_F32);
+	const Vec3V emptyMax = V3Load(-PX_MAX_F32);
+
+	float bestCost = PX_MAX_F32;
+	PxU32 bestAxis = 0xffffffff;
+	PxU32 bestBin = 0;
+	float bestScale = 0.0f;
+
+	for(PxU32 axis=0;axis<3;axis++)
+	{
+		const float extent = centerMax[axis] - centerMin[axis];
+		if(!(extent > 0.0f))
+			continue;	// all centers are on the same plane
+
+		// slightly shrink the scale so that the maximum center lands in the last bin
+		const float scale = (float(SQ_SAH_NB_BINS) * 0.9999f) / extent;
+
+		PxU32 binCount[SQ_SAH_NB_BINS];
+		Vec3V binMin[SQ_SAH_NB_BINS];
+		Vec3V binMax[SQ_SAH_NB_BINS];
+		for(PxU32 b=0;b<SQ_SAH_NB_BINS;b++)
+		{
+			binCount[b] = 0;
+			binMin[b] = emptyMin;
+			binMax[b] = emptyMax;
+		}
+
+		for(PxU32 i=0;i<nbPrims;i++)
+		{
+			const PxU32 index = prims[i];
+			const PxU32 b = PxMin(PxU32((builder->getSplittingValue(index, axis) - centerMin[axis]) * scale), PxU32(SQ_SAH_NB_BINS-1));
+			const PxBounds3& box = builder->mAABBArray[index];
+			binCount[b]++;
+			binMin[b] = V3Min(binMin[b], V3LoadU(box.minimum));
+			binMax[b] = V3Max(binMax[b], V3LoadU(box.maximum));
+		}
+
+		// Sweep from the right to get the area and count of everything above each split plane
+		float rightArea[SQ_SAH_NB_BINS-1];
+		PxU32 rightCount[SQ_SAH_NB_BINS-1];
+		Vec3V accMin = emptyMin;
+		Vec3V accMax = emptyMax;
+		PxU32 accCount = 0;
+		for(PxU32 b=SQ_SAH_NB_BINS-1;b>0;b--)
+		{
+			accMin = V3Min(accMin, binMin[b]);
+			accMax = V3Max(accMax, binMax[b]);
+			accCount += binCount[b];
+			rightArea[b-1] = accCount ? computeHalfSurfaceArea(accMin, accMax) : 0.0f;
+			rightCount[b-1] = accCount;
+		}
+
+		// Sweep from the left and evaluate the cost of each split plane
+		accMin = emptyMin;
+		accMax = emptyMax;
+		accCount = 0;
+		for(PxU32 b=0;b<SQ_SAH_NB_BINS-1;b++)
+		{
+			accMin = V3Min(accMin, binMin[b]);
+			accMax = V3Max(accMax, binMax[b]);
+			accCount += binCount[b];
+			if(!accCount || !rightCount[b])
+				continue;
+
+			const float cost = computeHalfSurfaceArea(accMin, accMax)*float(accCount) + rightArea[b]*float(rightCount[b]);
+			if(cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = b;
+				bestScale = scale;
+			}
+		}
+	}
+
+	if(bestAxis == 0xffffffff)
+		return 0;
+
+	// Reorganize the list of indices in this order: positive (above the split plane) - negative.
+	PxU32 NbPos = 0;
+	for(PxU32 i=0;i<nbPrims;i++)
+	{
+		const PxU32 index = prims[i];
+		const PxU32 b = PxMin(PxU32((builder->getSplittingValue(index, bestAxis) - centerMin[bestAxis]) * bestScale), PxU32(SQ_SAH_NB_BINS-1));
+		if(b > bestBin)
+		{
+			prims[i] = prims[NbPos];
+			prims[NbPos] = index;
+			NbPos++;
+		}
+	}
+	return NbPos;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**
  *	Subdivides the node.
@@ -283,6 +419,13 @@ bool AABBTreeNode::subdivide(const PxBounds3& exactBounds, AABBTreeBuilder* buil
 		// Don't even bother splitting (mainly a performance test)
 		NbPos = getNbBuildPrimitives()>>1;
 	}
+	else if(builder->mSettings.mRules & SPLIT_SAH)
+	{
+		NbPos = splitSAH(builder, indices);
+
+		// Check split validity
+		if(!NbPos || NbPos==getNbBuildPrimitives())	ValidSplit = false;
+	}
 	else
 	{
 		PX_ALWAYS_ASSERT_MESSAGE("Unknown split rule - number of primitives can be clipped.");
@@ -340,13 +483,9 @@ bool AABBTreeNode::subdivide(const PxBounds3& exactBounds, AABBTreeBuilder* buil
  *	\param		builder		[in] the tree builder
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static PxU32 Count=0;
-
 // here parentCenter, parentExtents are conservative bounds (decompressed so far)
 void AABBTreeNode::_buildHierarchy(AABBTreeBuilder* builder, PxU32* indices)
 {
-	Count++;
-
 	// 1) Compute the exact global box for current node
 	PxBounds3 exactBounds;
 	Vec3V bMin, bMax;
@@ -387,7 +526,8 @@ void AABBTreeNode::_buildHierarchy(AABBTreeBuilder* builder, PxU32* indices)
  *	Constructor.
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-AABBTree::AABBTree() : mIndices(NULL), mPool(NULL), mRefitHighestSetWord(0), mTotalNbNodes(0), mTotalPrims(0)
+AABBTree::AABBTree() : mIndices(NULL), mPool(NULL), mRefitHighestSetWord(0),
+	mRefittedInternalNodes(PX_DEBUG_EXP("AABBTree::mRefittedInternalNodes")), mInternalArea(0.0), mTotalNbNodes(0), mTotalPrims(0)
 {
 #ifdef SUPPORT_PROGRESSIVE_BUILDING
 	mStack = NULL;
@@ -424,6 +564,8 @@ void AABBTree::release()
 #ifdef SUPPORT_UPDATE_ARRAY
 	mNbRefitNodes	= 0;
 #endif
+	mRefittedInternalNodes.clear();
+	mInternalArea = 0.0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -433,7 +575,7 @@ void AABBTree::release()
  *	\return		true if success
  */
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool AABBTree::build(AABBTreeBuilder* builder)
+bool AABBTree::build(AABBTreeBuilder* builder, PxTaskManager* taskManager)
 {
 	//gBuildCalls++;
 	// Checkings
@@ -462,9 +604,12 @@ bool AABBTree::build(AABBTreeBuilder* builder)
 	mPool->setNbBuildPrimitivesOrParent(builder->mNbPrimitives);
 
 	// Build the hierarchy
-	Count = 0;
 	mPool->setLeaf();
-	mPool->_buildHierarchy(builder, mIndices);
+	if(taskManager && builder->mSettings.mLimit==1 && builder->mNbPrimitives>=SQ_PARALLEL_BUILD_MIN_PRIMS
+		&& taskManager->getCpuDispatcher() && taskManager->getCpuDispatcher()->getWorkerCount()>1)
+		buildParallel(builder, *taskManager);
+	else
+		mPool->_buildHierarchy(builder, mIndices);
 
 	// Get back total number of nodes
 	mTotalNbNodes	= builder->getCount();
@@ -478,9 +623,153 @@ bool AABBTree::build(AABBTreeBuilder* builder)
 	validate();
 #endif
 
+	computeInternalArea();
 	return true;
 }
 
+namespace
+{
+	// Builds a subtree of a complete tree (one primitive per leaf) on a worker thread.
+	// A subtree with N primitives always has 2*N-1 nodes and the serial builder allocates the descendants
+	// of a node right after the node's children, so the node range of each subtree is known in advance.
+	// Subtrees can thus be built independently and the result is identical to the serial build.
+	class SubtreeBuildTask : public Cm::Task
+	{
+	public:
+		SubtreeBuildTask() : mRoot(NULL), mFirstDescendant(0), mIndices(NULL)	{}
+
+		virtual void runInternal()
+		{
+			mBuilder.setCount(mFirstDescendant);
+			mBuilder.setNbInvalidSplits(0);
+			mBuilder.mTotalPrims = 0;
+			mRoot->_buildHierarchy(&mBuilder, mIndices);
+		}
+
+		virtual const char* getName() const { return "SqAABBTree.buildSubtree"; }
+
+		AABBTreeNode*	mRoot;
+		PxU32			mFirstDescendant;
+		AABBTreeBuilder	mBuilder;
+		PxU32*			mIndices;
+	};
+
+	class BuildCompletionTask : public Cm::Task
+	{
+		PX_NOCOPY(BuildCompletionTask)
+	public:
+		BuildCompletionTask(Ps::Sync& sync) : mSync(sync)	{}
+
+		virtual void runInternal()	{}
+		virtual void release()		{ mSync.set(); }
+
+		virtual const char* getName() const { return "SqAABBTree.buildCompletion"; }
+
+		Ps::Sync&	mSync;
+	};
+
+	struct PendingNode
+	{
+		PendingNode()	{}
+		PendingNode(PxU32 node, PxU32 firstDescendant, PxU32 parent) : mNode(node), mFirstDescendant(firstDescendant), mParent(parent)	{}
+
+		PxU32	mNode;
+		PxU32	mFirstDescendant;
+		PxU32	mParent;
+	};
+}
+
+void AABBTree::buildParallel(AABBTreeBuilder* builder, PxTaskManager& taskManager)
+{
+	PX_ASSERT(builder->mSettings.mLimit==1);
+	AABBTreeNode* base = builder->mNodeBase;
+
+	// Aim for a few subtrees per worker so that uneven splits still balance out
+	const PxU32 nbWorkers = taskManager.getCpuDispatcher()->getWorkerCount();
+	const PxU32 maxSubtreePrims = PxMax(builder->mNbPrimitives/(nbWorkers*4), PxU32(SQ_PARALLEL_BUILD_MIN_SUBTREE_PRIMS));
+
+	Ps::Array<PendingNode> stack;
+	Ps::Array<PendingNode> parentFixups;
+	Ps::Array<SubtreeBuildTask> tasks;
+
+	// Split the top of the tree serially until the remaining subtrees are small enough
+	stack.pushBack(PendingNode(0, 1, 0));
+	while(stack.size())
+	{
+		const PendingNode current = stack.popBack();
+		AABBTreeNode* node = base + current.mNode;
+		parentFixups.pushBack(current);
+
+		const PxU32 nbPrims = node->getNbBuildPrimitives();
+		if(nbPrims<=maxSubtreePrims)
+		{
+			if(nbPrims<SQ_PARALLEL_BUILD_MIN_SUBTREE_PRIMS)
+			{
+				// not worth a task
+				builder->setCount(current.mFirstDescendant);
+				node->_buildHierarchy(builder, mIndices);
+			}
+			else
+			{
+				SubtreeBuildTask& task = tasks.insert();
+				task.mRoot				= node;
+				task.mFirstDescendant	= current.mFirstDescendant;
+				task.mBuilder			= *builder;
+				task.mIndices			= mIndices;
+			}
+			continue;
+		}
+
+		// Same as _buildHierarchy, without the recursion
+		PxBounds3 exactBounds;
+		Vec3V bMin, bMax;
+		builder->computeGlobalBox(node->getPrimitives(mIndices), nbPrims, exactBounds, &bMin, &bMax);
+
+		builder->setCount(current.mFirstDescendant);
+		node->setLeaf();
+		node->subdivide(exactBounds, builder, mIndices);
+		node->compress<1>(bMin, bMax);
+		builder->mTotalPrims += nbPrims;
+
+		if(!node->isLeaf())
+		{
+			const PxU32 pos = PxU32(node->getPos(base) - base);
+			PX_ASSERT(pos==current.mFirstDescendant);
+			const PxU32 nbPos = base[pos].getNbBuildPrimitives();
+			stack.pushBack(PendingNode(pos+1, current.mFirstDescendant + 2*nbPos, current.mNode));
+			stack.pushBack(PendingNode(pos, current.mFirstDescendant + 2, current.mNode));
+		}
+	}
+
+	if(tasks.size())
+	{
+		// the tasks array does not change size anymore, pointers to its entries are stable from here on
+		Ps::Sync sync;
+		BuildCompletionTask completion(sync);
+		completion.setContinuation(taskManager, NULL);
+
+		for(PxU32 i=0;i<tasks.size();i++)
+			tasks[i].setContinuation(taskManager, &completion);
+		for(PxU32 i=0;i<tasks.size();i++)
+			tasks[i].removeReference();
+		completion.removeReference();
+
+		sync.wait();
+
+		for(PxU32 i=0;i<tasks.size();i++)
+		{
+			builder->mTotalPrims += tasks[i].mBuilder.mTotalPrims;
+			builder->setNbInvalidSplits(builder->getNbInvalidSplits() + tasks[i].mBuilder.getNbInvalidSplits());
+		}
+	}
+
+	// The parent shares storage with the number of build primitives, it can only be written once the children are done
+	for(PxU32 i=0;i<parentFixups.size();i++)
+		base[parentFixups[i].mNode].setParent(parentFixups[i].mParent);
+
+	builder->setCount(builder->mNbPrimitives*2 - 1);
+}
+
 #ifdef SUPPORT_PROGRESSIVE_BUILDING
 static PxU32 incrementalBuildHierarchy(FIFOStack2& stack, AABBTreeNode* node, AABBTreeNode* parent, AABBTreeBuilder* builder, PxU32* indices)
 {
@@ -748,6 +1037,7 @@ bool AABBTree::refit2(AABBTreeBuilder* builder, PxU32* indices)
 		}
 	}
 
+	computeInternalArea();
 	return true;
 }
 
@@ -939,12 +1229,198 @@ static PX_FORCE_INLINE void refitNode(	AABBTreeNode* PX_RESTRICT pool, PxU32 ind
 	}
 }
 
-void AABBTree::refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indices)
+static PX_FORCE_INLINE void getNodeMinMax(const AABBTreeNode& node, Vec3V& mn, Vec3V& mx)
+{
+	Vec3V center, extents;
+	node.getAABBCenterExtentsV(&center, &extents);
+	mn = V3Sub(center, extents);
+	mx = V3Add(center, extents);
+}
+
+// half the surface area, nodes of removed objects have inverted bounds and count as zero
+static PX_FORCE_INLINE PxReal computeHalfArea(const Vec3V mn, const Vec3V mx)
+{
+	PxVec3 e;
+	V3StoreU(V3Max(V3Sub(mx, mn), V3Zero()), e);
+	return e.x*e.y + e.y*e.z + e.z*e.x;
+}
+
+static PX_FORCE_INLINE PxReal computeHalfArea(const AABBTreeNode& node)
+{
+	Vec3V mn, mx;
+	getNodeMinMax(node, mn, mx);
+	return computeHalfArea(mn, mx);
+}
+
+void AABBTree::computeInternalArea()
+{
+	mInternalArea = 0.0;
+	for(PxU32 i=0;i<mTotalNbNodes;i++)
+	{
+		if(!mPool[i].isLeaf())
+			mInternalArea += computeHalfArea(mPool[i]);
+	}
+}
+
+PxReal AABBTree::getSAHCost() const
+{
+	if(!mPool)
+		return 0.0f;
+	const PxReal rootArea = computeHalfArea(mPool[0]);
+	return rootArea>0.0f ? PxReal(mInternalArea/rootArea) : 0.0f;
+}
+
+// Patches the references to a node that was moved to pool[index]: the parent pointers of its children,
+// or the tree map entry of its object for a leaf.
+static PX_FORCE_INLINE void patchMovedNode(AABBTreeNode* pool, PxU32 index, const PxU32* indices, AABBTreeUpdateMap& map)
+{
+	const AABBTreeNode& node = pool[index];
+	if(node.isLeaf())
+	{
+		if(node.getNbRuntimePrimitives())
+			map.setNodeIndex(*node.getPrimitives(indices), index);
+	}
+	else
+	{
+		const PxU32 pos = node.getPosOrNodePrimitives();
+		pool[pos].setParent(index);
+		pool[pos+1].setParent(index);
+	}
+}
+
+// Minimal relative area reduction for a rotation to be applied. Node bounds are compressed so tiny
+// improvements are not worth moving nodes for.
+static const PxReal gRotationMinGain = 0.02f;
+
+// a node can only be moved to a slot in front of its children, children always come after their parent
+static PX_FORCE_INLINE bool canMoveNode(const AABBTreeNode* pool, PxU32 node, PxU32 slot)
+{
+	return pool[node].isLeaf() || pool[node].getPosOrNodePrimitives() > slot;
+}
+
+// recomputes the bounds of an internal node from its children, returns the new area
+static PX_FORCE_INLINE PxReal refitFromChildren(AABBTreeNode* pool, PxU32 index)
+{
+	AABBTreeNode& node = pool[index];
+	Vec3V posMin, posMax, negMin, negMax;
+	getNodeMinMax(*node.getPos(pool), posMin, posMax);
+	getNodeMinMax(*node.getNeg(pool), negMin, negMax);
+	node.compress<1>(V3Min(posMin, negMin), V3Max(posMax, negMax));
+	return computeHalfArea(node);
+}
+
+// Tree rotations after Kensler, "Tree Rotations for Improving Bounding Volume Hierarchies": a child of the node is swapped
+// with a grandchild on the other side, or two grandchildren on different sides are swapped, whichever shrinks the children
+// of the node most. The bounds of the node itself do not change. Nodes are swapped in place and only moved to slots in front
+// of their children, so that refitMarked() can keep processing the nodes in reverse index order.
+// Returns the change of the summed internal area.
+PxReal AABBTree::rotate(PxU32 index, PxU32* indices, AABBTreeUpdateMap& map)
+{
+	const AABBTreeNode& node = mPool[index];
+	PX_ASSERT(!node.isLeaf());
+	const PxU32 children[2] = { node.getPosOrNodePrimitives(), node.getPosOrNodePrimitives() + 1 };
+
+	Vec3V childMin[2], childMax[2];
+	PxReal childArea[2];
+	for(PxU32 i=0;i<2;i++)
+	{
+		getNodeMinMax(mPool[children[i]], childMin[i], childMax[i]);
+		childArea[i] = computeHalfArea(childMin[i], childMax[i]);
+	}
+
+	PxReal bestGain = 0.0f, bestOldArea = 0.0f;
+	PxU32 bestA = 0, bestB = 0;
+
+	// child <-> grandchild on the other side, only the other child changes
+	for(PxU32 side=0;side<2;side++)
+	{
+		const PxU32 child = children[side];
+		const AABBTreeNode& siblingNode = mPool[children[1-side]];
+		if(siblingNode.isLeaf())
+			continue;
+
+		const PxReal oldArea = childArea[1-side];
+		const PxU32 firstGrandChild = siblingNode.getPosOrNodePrimitives();
+		for(PxU32 i=0;i<2;i++)
+		{
+			const PxU32 grandChild = firstGrandChild + i;
+			if(!canMoveNode(mPool, child, grandChild))
+				continue;
+
+			// the sibling ends up with the child and the grandchild that stays
+			Vec3V otherMin, otherMax;
+			getNodeMinMax(mPool[firstGrandChild + 1 - i], otherMin, otherMax);
+			const PxReal gain = oldArea - computeHalfArea(V3Min(childMin[side], otherMin), V3Max(childMax[side], otherMax));
+			if(gain > oldArea*gRotationMinGain && gain > bestGain)
+			{
+				bestGain = gain;
+				bestOldArea = oldArea;
+				bestA = child;
+				bestB = grandChild;
+			}
+		}
+	}
+
+	// grandchild <-> grandchild, both children change
+	if(!mPool[children[0]].isLeaf() && !mPool[children[1]].isLeaf())
+	{
+		const PxU32 first[2] = { mPool[children[0]].getPosOrNodePrimitives(), mPool[children[1]].getPosOrNodePrimitives() };
+		Vec3V gcMin[2][2], gcMax[2][2];
+		for(PxU32 i=0;i<2;i++)
+			for(PxU32 j=0;j<2;j++)
+				getNodeMinMax(mPool[first[i] + j], gcMin[i][j], gcMax[i][j]);
+
+		const PxReal oldArea = childArea[0] + childArea[1];
+		for(PxU32 i=0;i<2;i++)
+		{
+			for(PxU32 j=0;j<2;j++)
+			{
+				const PxU32 a = first[0] + i, b = first[1] + j;
+				if(!canMoveNode(mPool, a, b) || !canMoveNode(mPool, b, a))
+					continue;
+
+				const PxReal newArea0 = computeHalfArea(V3Min(gcMin[1][j], gcMin[0][1-i]), V3Max(gcMax[1][j], gcMax[0][1-i]));
+				const PxReal newArea1 = computeHalfArea(V3Min(gcMin[0][i], gcMin[1][1-j]), V3Max(gcMax[0][i], gcMax[1][1-j]));
+				const PxReal gain = oldArea - newArea0 - newArea1;
+				if(gain > oldArea*gRotationMinGain && gain > bestGain)
+				{
+					bestGain = gain;
+					bestOldArea = oldArea;
+					bestA = a;
+					bestB = b;
+				}
+			}
+		}
+	}
+
+	if(bestGain==0.0f)
+		return 0.0f;
+
+	AABBTreeNode& a = mPool[bestA];
+	AABBTreeNode& b = mPool[bestB];
+	const PxU32 parentA = a.getNbBuildPrimitivesOrParent();
+	const PxU32 parentB = b.getNbBuildPrimitivesOrParent();
+	Ps::swap(a, b);
+	a.setParent(parentA);
+	b.setParent(parentB);
+	patchMovedNode(mPool, bestA, indices, map);
+	patchMovedNode(mPool, bestB, indices, map);
+
+	// refit the children of the node that received a new subtree
+	PxReal newArea = 0.0f;
+	if(parentA!=index)
+		newArea += refitFromChildren(mPool, parentA);
+	if(parentB!=index)
+		newArea += refitFromChildren(mPool, parentB);
+	return newArea - bestOldArea;
+}
+
+PxU32 AABBTree::refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indices, AABBTreeUpdateMap* rotationMap)
 {
 	PX_UNUSED(nb_objects);
 
 	if(!mRefitBitmask.getBits())
-		return;	// No refit needed
+		return 0;	// No refit needed
 
 	VecU32V prevScale;
 	Vec3V prevXYZ;
@@ -978,6 +1454,13 @@ void AABBTree::refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indi
 			PX_ASSERT(mRefitBitmask.isSet(Index)); // this was set in markForRefit for node and it's parent chain
 			mRefitBitmask.clearBit(Index); // clear the bit in refitMask to unmark this node
 
+			// the node has not been written yet, remove its old area from the SAH cost
+			if(!mPool[Index].isLeaf())
+			{
+				mInternalArea -= computeHalfArea(mPool[Index]);
+				mRefittedInternalNodes.pushBack(Index);
+			}
+
 			// perform refit & node compression
 			refitNode(mPool, Index, boxes, indices, todoWriteback, todoCompress, prevScale, prevXYZ, bMin, bMax, wMin, wMax);
 		}
@@ -1014,6 +1497,12 @@ void AABBTree::refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indi
 				{
 					mRefitBitmask.clearBit(Index);
 
+					if(!mPool[Index].isLeaf())
+					{
+						mInternalArea -= computeHalfArea(mPool[Index]);
+						mRefittedInternalNodes.pushBack(Index);
+					}
+
 					// todoWriteback, todoCompress are staggered for xbox LHS elimination
 					refitNode(mPool, Index, boxes, indices, todoWriteback, todoCompress, prevScale, prevXYZ, bMin, bMax, wMin, wMax);
 				}
@@ -1030,6 +1519,31 @@ void AABBTree::refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indi
 		todoCompress->compress<0>(bMin, bMax, &prevScale, &prevXYZ);
 		todoCompress->writeBack(prevScale, prevXYZ);
 	}
+
+	const PxU32 nbRefitted = mRefittedInternalNodes.size();
+	for(PxU32 i=0;i<nbRefitted;i++)
+		mInternalArea += computeHalfArea(mPool[mRefittedInternalNodes[i]]);
+
+	// Rotations keep the bounds of the rotated node, so they can run after the refit. The refitted nodes are
+	// visited children first, a rotation only touches nodes below the rotated one.
+	PxU32 nbRotations = 0;
+	if(rotationMap)
+	{
+		for(PxU32 i=0;i<nbRefitted;i++)
+		{
+			const PxReal delta = rotate(mRefittedInternalNodes[i], indices, *rotationMap);
+			if(delta!=0.0f)
+			{
+				mInternalArea += delta;
+				nbRotations++;
+			}
+		}
+#ifdef PX_DEBUG
+		validate();
+#endif
+	}
+	mRefittedInternalNodes.clear();
+	return nbRotations;
 }
 
 void AABBTree::shiftOrigin(const PxVec3& shift)
@@ -1050,6 +1564,88 @@ void AABBTree::shiftOrigin(const PxVec3& shift)
 
 		Current.compress<1>(minV, maxV);
 	}
+
+	// recompression slightly changes the node bounds
+	computeInternalArea();
+}
+
+// The new root goes to pool[0] with the two old roots as its children in pool[1] and pool[2]. The other nodes
+// of this tree follow, then the other nodes of the attached tree, so children still come after their parent.
+static PX_FORCE_INLINE PxU32 remapMergedNode(PxU32 index, PxU32 rootIndex, PxU32 offset)
+{
+	return index ? index+offset : rootIndex;
+}
+
+static void copyMergedNodes(AABBTreeNode* PX_RESTRICT dst, const AABBTreeNode* PX_RESTRICT src, PxU32 nbNodes, PxU32 rootIndex, PxU32 offset, PxU32 primitiveOffset)
+{
+	for(PxU32 i=0;i<nbNodes;i++)
+	{
+		AABBTreeNode& node = dst[remapMergedNode(i, rootIndex, offset)];
+		node = src[i];
+		if(node.isLeaf())
+			node.setPosOrNodePrimitives(node.getPosOrNodePrimitives() + primitiveOffset);
+		else
+			node.setPos(node.getPosOrNodePrimitives() + offset);
+		node.setParent(i ? remapMergedNode(node.getNbBuildPrimitivesOrParent(), rootIndex, offset) : 0);
+	}
+}
+
+void AABBTree::mergeTree(const AABBTree& tree, PxU32 indexOffset)
+{
+	PX_ASSERT(mPool && tree.mPool);
+
+	// complete trees, one primitive per leaf
+	const PxU32 nbPrims = (mTotalNbNodes+1)/2;
+	const PxU32 nbTreePrims = (tree.mTotalNbNodes+1)/2;
+	const PxU32 nbNodes = mTotalNbNodes + tree.mTotalNbNodes + 1;
+
+	// nodes marked for refit move along with the merge
+	Ps::Array<PxU32> marked PX_DEBUG_EXP("AABBTree::mergeTree");
+	if(mRefitBitmask.getBits())
+	{
+		for(PxU32 i=0;i<mTotalNbNodes;i++)
+		{
+			if(mRefitBitmask.isSet(i))
+				marked.pushBack(remapMergedNode(i, 1, 2));
+		}
+		mRefitBitmask.init(nbNodes);
+		mRefitHighestSetWord = 0;
+#ifdef SUPPORT_UPDATE_ARRAY
+		mNbRefitNodes = 0;
+#endif
+	}
+
+	PxU32* indices = (PxU32*)PX_ALLOC(sizeof(PxU32)*(nbPrims+nbTreePrims), PX_DEBUG_EXP("AABB tree indices"));
+	PxMemCopy(indices, mIndices, sizeof(PxU32)*nbPrims);
+	for(PxU32 i=0;i<nbTreePrims;i++)
+		indices[nbPrims+i] = tree.mIndices[i] + indexOffset;
+
+	AABBTreeNode* pool = PX_NEW(AABBTreeNode)[nbNodes];
+	copyMergedNodes(pool, mPool, mTotalNbNodes, 1, 2, 0);
+	copyMergedNodes(pool, tree.mPool, tree.mTotalNbNodes, 2, mTotalNbNodes+1, nbPrims);
+
+	Vec3V mn0, mx0, mn1, mx1;
+	getNodeMinMax(pool[1], mn0, mx0);
+	getNodeMinMax(pool[2], mn1, mx1);
+	pool[0].setPos(1);
+	pool[0].setParent(0);
+	pool[0].compress<1>(V3Min(mn0, mn1), V3Max(mx0, mx1));
+
+	PX_DELETE_ARRAY(mPool);
+	PX_FREE(mIndices);
+	mPool			= pool;
+	mIndices		= indices;
+	mTotalNbNodes	= nbNodes;
+	mTotalPrims		+= tree.mTotalPrims + nbPrims + nbTreePrims;
+
+	for(PxU32 i=0;i<marked.size();i++)
+		markForRefit(marked[i]);
+
+#ifdef PX_DEBUG
+	validate();
+#endif
+
+	computeInternalArea();
 }
 
 #ifdef PX_DEBUG
@@ -16,6 +16,7 @@
 #include "PxMemory.h"
 #include "PsUserAllocated.h"
 #include "PsVecMath.h"
+#include "PsArray.h"
 #include "PxBounds3.h"
 
 #define SUPPORT_PROGRESSIVE_BUILDING
@@ -24,6 +25,7 @@
 
 namespace physx
 {
+	class PxTaskManager;
 
 using namespace shdfnd::aos;
 
@@ -37,6 +39,7 @@ static const PxF32   scaleMul1 = 1.0f/10000.0f;
 	class Plane;
 	class Container;
 	class AABBTreeBuilder;
+	class AABBTreeUpdateMap;
 
 	class BitArray
 	{
@@ -101,7 +104,9 @@ static const PxF32   scaleMul1 = 1.0f/10000.0f;
 											AABBTree();
 											~AABBTree();
 		// Build
-						bool				build(AABBTreeBuilder* builder);
+		// If a task manager is given, complete trees (builder->mSettings.mLimit==1) are built in parallel on its CPU dispatcher.
+		// The calling thread blocks until the build is done, so this must not be called from a task.
+						bool				build(AABBTreeBuilder* builder, PxTaskManager* taskManager = NULL);
 #ifdef SUPPORT_PROGRESSIVE_BUILDING
 						PxU32				progressiveBuild(AABBTreeBuilder* builder, PxU32 progress, PxU32 limit);
 #endif
@@ -130,13 +135,27 @@ static const PxF32   scaleMul1 = 1.0f/10000.0f;
 						// adds node[index] to a list of nodes to refit when refitMarked is called
 						// Note that this includes updating the hierarchy up the chain
 						void				markForRefit(PxU32 index);
-						void				refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indices);
+						// If a map is given, tree rotations are applied to the refitted nodes to keep the SAH cost from degrading.
+						// Rotations move nodes around in the pool, the map is updated for moved leaves. Returns the number of rotations.
+						PxU32				refitMarked(PxU32 nb_objects, const PxBounds3* boxes, PxU32* indices, AABBTreeUpdateMap* rotationMap = NULL);
+
+						// SAH cost of the tree, i.e. the summed surface area of the internal nodes relative to the root's.
+						// It is recomputed by build() and refit2() and kept up to date by refitMarked().
+						PxReal				getSAHCost()		const;
+
+						// Attaches a complete tree (one primitive per leaf) as a sibling of the root. The primitives of the given tree
+						// are offset by indexOffset. Nodes and primitives are renumbered, nodes marked for refit stay marked.
+						void				mergeTree(const AABBTree& tree, PxU32 indexOffset);
 
 						void				shiftOrigin(const PxVec3& shift);
 #if PX_IS_SPU // SPU specific pointer patching
 		PX_FORCE_INLINE	void				setNodes(AABBTreeNode* lsPool) {  mPool = lsPool; }
 #endif
 		private:
+						void				buildParallel(AABBTreeBuilder* builder, PxTaskManager& taskManager);
+						void				computeInternalArea();
+						PxReal				rotate(PxU32 index, PxU32* indices, AABBTreeUpdateMap& map);
+
 						PxU32*				mIndices;	//!< Indices in the app list. Indices are reorganized during build (permutation).
 						AABBTreeNode*		mPool;		//!< Linear pool of nodes for complete trees. NULL otherwise. [Opcode 1.3]
 						BitArray			mRefitBitmask; //!< bit is set for each node index in markForRefit
@@ -145,6 +164,8 @@ static const PxF32   scaleMul1 = 1.0f/10000.0f;
 						PxU32				mNbRefitNodes;
 						PxU32				mRefitArray[SUPPORT_UPDATE_ARRAY];
 #endif
+						Ps::Array<PxU32>	mRefittedInternalNodes;	//!< Internal nodes refitted by the current refitMarked() call, in decreasing index order
+						PxF64				mInternalArea;			//!< Summed half surface area of the internal nodes, see getSAHCost()
 		// Stats
 						PxU32				mTotalNbNodes;		//!< Number of nodes in the tree.
 						PxU32				mTotalPrims;
@@ -272,6 +293,7 @@ static const PxF32   scaleMul1 = 1.0f/10000.0f;
 
 					// Internal methods
 					PX_INLINE PxU32		split(const PxBounds3& exactBounds, PxU32 axis, AABBTreeBuilder* builder, PxU32* indices);
+					PX_INLINE PxU32		splitSAH(AABBTreeBuilder* builder, PxU32* indices);
 					PX_INLINE bool		subdivide(const PxBounds3& exactBounds, AABBTreeBuilder* builder, PxU32* indices);
 					PX_INLINE void		_buildHierarchy(AABBTreeBuilder* builder, PxU32* indices);
 	};
@@ -58,7 +58,8 @@ void AABBTreeUpdateMap::initMap(PxU32 nbObjects, const Sq::AABBTree& tree)
 	const AABBTreeNode*	nodes = tree.getNodes();
 	for(PxU32 i=0;i<nbNodes;i++)
 	{
-		if(nodes[i].isLeaf() && nodes[i].getPrimitives(tree.getIndices()))
+		// leaves of removed objects are skipped, they are only left behind in trees the objects were removed from
+		if(nodes[i].isLeaf() && nodes[i].getNbRuntimePrimitives())
 		{
 			PX_ASSERT(nodes[i].getNbRuntimePrimitives()==1);
 			PxU32 index = nodes[i].getPrimitives(tree.getIndices())[0];
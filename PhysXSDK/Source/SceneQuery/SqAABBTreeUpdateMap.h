@@ -53,6 +53,13 @@ namespace Sq
 			return i < mMapping.size() ? mMapping[i] : INVALID_NODE_ID;
 		}
 
+		// called when the leaf of a pool object moved to another node, e.g. by a tree rotation
+		void setNodeIndex(PxU32 poolIndex, PxU32 nodeIndex)
+		{
+			PX_ASSERT(poolIndex < mMapping.size());
+			mMapping[poolIndex] = nodeIndex;
+		}
+
 	private:
 		bool checkMap(PxU32 numPoolObjects, const AABBTree& tree) const;
 
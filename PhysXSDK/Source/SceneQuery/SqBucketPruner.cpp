@@ -2175,11 +2175,7 @@ PxAgain	BucketPrunerCore::overlap(const ShapeData& queryVolume, PrunerCallback&
 
 void BucketPrunerCore::shiftOrigin(const PxVec3& shift)
 {
-	for(PxU32 i=0;i<mNbFree;i++)
-	{
-		mFreeBounds[i].minimum -= shift;
-		mFreeBounds[i].maximum -= shift;
-	}
+	shiftBounds(mFreeBounds, mNbFree, shift);
 
 	const PxU32 nb = mCoreNbObjects;
 	//if (nb)
@@ -2192,11 +2188,7 @@ void BucketPrunerCore::shiftOrigin(const PxVec3& shift)
 #endif
 		encodeBoxMinMax(mGlobalBox, mSortAxis);
 
-		for(PxU32 i=0; i < nb; i++)
-		{
-			mCoreBoxes[i].minimum -= shift;
-			mCoreBoxes[i].maximum -= shift;
-		}
+		shiftBounds(mCoreBoxes, nb, shift);
 
 		for(PxU32 i=0; i < mSortedNb; i++)
 		{
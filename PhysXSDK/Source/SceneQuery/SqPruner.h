@@ -35,6 +35,7 @@ namespace Sq
 typedef PxU32 PrunerHandle;
 static const PrunerHandle INVALID_PRUNERHANDLE = 0xFFffFFff;
 static const PxReal SQ_PRUNER_INFLATION = 1.01f; // pruner test shape inflation (not narrow phase shape)
+#define SQ_RAY_PACKET_SIZE 16 // max number of rays in a Pruner::raycastPacket() call, one bit per ray in the masks
 
 class ShapeData
 {
@@ -250,6 +251,26 @@ public:
 	virtual	PxAgain	overlap(const ShapeData& queryVolume, PrunerCallback&) const = 0;
 	virtual	PxAgain	sweep(const ShapeData& queryVolume, const PxVec3& unitDir, PxReal& inOutDistance, PrunerCallback&) const = 0;
 
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/**
+	 *	Raycasts a packet of up to SQ_RAY_PACKET_SIZE rays, each with its own distance and callback.
+	 *	Pruners that can share the traversal between coherent rays override this, the default runs one raycast per ray.
+	 *
+	 *	\param		rayMask		[in]	bit i is set if ray i takes part in the query
+	 *
+	 *	\return		the bits of rayMask for which the query should continue, i.e. the PxAgain result of each ray
+	 */
+	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	virtual	PxU32	raycastPacket(const PxVec3* origins, const PxVec3* unitDirs, PxReal* inOutDistances, PrunerCallback* const* pcbs, PxU32 rayMask) const
+	{
+		for(PxU32 i=0;i<SQ_RAY_PACKET_SIZE;i++)
+		{
+			if((rayMask & (1<<i)) && !raycast(origins[i], unitDirs[i], inOutDistances[i], *pcbs[i]))
+				rayMask &= ~(1<<i);
+		}
+		return rayMask;
+	}
+
 
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/**
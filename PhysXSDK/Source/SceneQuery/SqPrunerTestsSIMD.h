@@ -93,6 +93,65 @@ protected:
 	RayAABBTest& operator=(const RayAABBTest&);
 };
 
+// Slab test of a ray against 4 boxes at once, used by the 4-wide quantized tree.
+// The boxes are passed transposed (one vector per bound) and grown by the inflation for sweeps.
+struct RayAABBTest4
+{
+	PX_FORCE_INLINE RayAABBTest4() {}
+
+	PX_FORCE_INLINE RayAABBTest4(const PxVec3& origin, const PxVec3& unitDir, const PxReal maxDist, const PxVec3& inflation)
+	: mOriginX(V4Load(origin.x)), mOriginY(V4Load(origin.y)), mOriginZ(V4Load(origin.z))
+	, mInvDirX(V4Load(safeInvert(unitDir.x))), mInvDirY(V4Load(safeInvert(unitDir.y))), mInvDirZ(V4Load(safeInvert(unitDir.z)))
+	, mInflationX(V4Load(inflation.x)), mInflationY(V4Load(inflation.y)), mInflationZ(V4Load(inflation.z))
+	, mMaxDist(V4Load(maxDist))
+	{
+	}
+
+	PX_FORCE_INLINE void setDistance(PxReal distance)
+	{
+		mMaxDist = V4Load(distance);
+	}
+
+	// returns the mask of the boxes hit between 0 and the ray length, and the distance at which the ray enters each box
+	template<bool TInflate>
+	PX_FORCE_INLINE PxU32 check(const Vec4V minX, const Vec4V minY, const Vec4V minZ, const Vec4V maxX, const Vec4V maxY, const Vec4V maxZ, Vec4V& tNear) const
+	{
+		const Vec4V tx0 = V4Mul(V4Sub(TInflate ? V4Sub(minX, mInflationX) : minX, mOriginX), mInvDirX);
+		const Vec4V tx1 = V4Mul(V4Sub(TInflate ? V4Add(maxX, mInflationX) : maxX, mOriginX), mInvDirX);
+		const Vec4V ty0 = V4Mul(V4Sub(TInflate ? V4Sub(minY, mInflationY) : minY, mOriginY), mInvDirY);
+		const Vec4V ty1 = V4Mul(V4Sub(TInflate ? V4Add(maxY, mInflationY) : maxY, mOriginY), mInvDirY);
+		const Vec4V tz0 = V4Mul(V4Sub(TInflate ? V4Sub(minZ, mInflationZ) : minZ, mOriginZ), mInvDirZ);
+		const Vec4V tz1 = V4Mul(V4Sub(TInflate ? V4Add(maxZ, mInflationZ) : maxZ, mOriginZ), mInvDirZ);
+
+		tNear = V4Max(V4Max(V4Min(tx0, tx1), V4Min(ty0, ty1)), V4Max(V4Min(tz0, tz1), V4Zero()));
+		const Vec4V tFar = V4Min(V4Min(V4Max(tx0, tx1), V4Max(ty0, ty1)), V4Min(V4Max(tz0, tz1), mMaxDist));
+
+		// the slab distances are not exact, scale the exit distance up so that grazing rays are not culled
+		return BGetBitMask(V4IsGrtrOrEq(V4Mul(tFar, V4Load(tolerance())), tNear));
+	}
+
+	// conservative tNear > distance test for the entry distances returned by check()
+	static PX_FORCE_INLINE bool isCulled(PxReal tNear, PxReal distance)
+	{
+		return tNear > distance * tolerance();
+	}
+
+	Vec4V mOriginX, mOriginY, mOriginZ;
+	Vec4V mInvDirX, mInvDirY, mInvDirZ;
+	Vec4V mInflationX, mInflationY, mInflationZ;
+	Vec4V mMaxDist;
+
+private:
+	// relative error bound of the slab distances
+	static PX_FORCE_INLINE PxReal tolerance()	{ return 1.0000004f; }
+
+	// a zero direction gives infinite slab distances that turn into NaNs for rays lying exactly on a slab plane
+	static PX_FORCE_INLINE PxReal safeInvert(PxReal d)
+	{
+		return PxAbs(d) > 1e-20f ? 1.0f/d : (d < 0.0f ? -1e20f : 1e20f);
+	}
+};
+
 // probably not worth having a SIMD version of this unless the traversal passes Vec3Vs
 struct AABBAABBTest
 {
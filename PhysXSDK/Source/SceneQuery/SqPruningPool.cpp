@@ -123,6 +123,20 @@ PrunerHandle PruningPool::addObject(const PxBounds3& worldAABB, const PrunerPayl
 	return handle;
 }
 
+PxU32 PruningPool::addObjects(PrunerHandle* results, const PxBounds3* worldAABBs, const PrunerPayload* payloads, PxU32 count)
+{
+	if(mNbObjects+count > mMaxNbObjects) // same growth policy as addObject(), but at least large enough for the batch
+		resize(PxMax<PxU32>(mNbObjects+count, PxMax<PxU32>(mMaxNbObjects*2, 64)));
+
+	for(PxU32 i=0;i<count;i++)
+	{
+		results[i] = addObject(worldAABBs[i], payloads[i]);
+		if(results[i] == INVALID_PRUNERHANDLE)
+			return i;
+	}
+	return count;
+}
+
 PxU32 PruningPool::removeObject(PrunerHandle h)
 {
 	PX_ASSERT(mNbObjects);
@@ -151,9 +165,5 @@ PxU32 PruningPool::removeObject(PrunerHandle h)
 
 void PruningPool::shiftOrigin(const PxVec3& shift)
 {
-	for(PxU32 i=0; i < mNbObjects; i++)
-	{
-		mWorldBoxes[i].minimum -= shift;
-		mWorldBoxes[i].maximum -= shift;
-	}
+	shiftBounds(mWorldBoxes, mNbObjects, shift);
 }
@@ -14,11 +14,40 @@
 #define SQ_PRUNINGPOOL_H
 
 #include "SqPruner.h"
+#include "PsVecMath.h"
 
 namespace physx
 {
 namespace Sq
 {
+	// Translates an array of bounds by -shift. Two PxBounds3 are 12 floats, so they are processed as 3 unaligned
+	// SIMD subtractions against the shift rotated to (x,y,z,x), (y,z,x,y) and (z,x,y,z).
+	PX_FORCE_INLINE void shiftBounds(PxBounds3* PX_RESTRICT boxes, PxU32 nbBoxes, const PxVec3& shift)
+	{
+		using namespace Ps::aos;
+
+		const PxF32 pattern[6] = { shift.x, shift.y, shift.z, shift.x, shift.y, shift.z };
+		const Vec4V s0 = V4LoadU(pattern);
+		const Vec4V s1 = V4LoadU(pattern+1);
+		const Vec4V s2 = V4LoadU(pattern+2);
+
+		PxF32* PX_RESTRICT data = &boxes->minimum.x;
+		PxU32 nbPairs = nbBoxes>>1;
+		while(nbPairs--)
+		{
+			V4StoreU(V4Sub(V4LoadU(data), s0), data);
+			V4StoreU(V4Sub(V4LoadU(data+4), s1), data+4);
+			V4StoreU(V4Sub(V4LoadU(data+8), s2), data+8);
+			data += 12;
+		}
+
+		if(nbBoxes&1)
+		{
+			boxes[nbBoxes-1].minimum -= shift;
+			boxes[nbBoxes-1].maximum -= shift;
+		}
+	}
+
 	// This class is designed to maintain a two way mapping between pair(PrunerPayload,AABB) and PrunerHandle
 	// Internally there's also an index for handles (AP: can be simplified?)
 	// This class effectively stores bounded pruner payloads, returns a PrunerHandle and allows O(1)
@@ -40,6 +69,8 @@ namespace Sq
 			virtual void					shiftOrigin(const PxVec3& shift);
 
 					PrunerHandle			addObject(const PxBounds3& worldAABB, const PrunerPayload& payload);
+					// grows the pool once for the whole batch, returns the number of objects added
+					PxU32					addObjects(PrunerHandle* results, const PxBounds3* worldAABBs, const PrunerPayload* payloads, PxU32 count);
 
 					// this function will swap the last object with the hole formed by removed PrunerHandle object
 					// and return the removed last object's index in the pool
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2008-2015, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#include "PxMemory.h"
+#include "PsArray.h"
+#include "PsAlignedMalloc.h"
+#include "SqQuantizedAABBTree.h"
+#include "SqAABBTree.h"
+
+using namespace physx;
+using namespace Sq;
+
+PX_COMPILE_TIME_ASSERT(sizeof(QuantizedAABBTreeNode)==64);
+
+// largest q such that dequantizeMin(q) <= value
+static PX_FORCE_INLINE PxU16 quantizeMin(PxReal value, PxReal frameMin, PxReal scale)
+{
+	if(scale==0.0f)
+		return 0;
+
+	const PxReal f = (value - frameMin) / scale;
+	PxU32 q = !(f > 0.0f) ? 0 : f >= PxReal(SQ_QUANTIZATION_MAX) ? SQ_QUANTIZATION_MAX : PxU32(f);
+	// the division above is not exact, walk down until the dequantized value is conservative
+	while(q && dequantizeMin(q, frameMin, scale) > value)
+		q--;
+	return PxU16(q);
+}
+
+// smallest q such that dequantizeMax(q) >= value
+static PX_FORCE_INLINE PxU16 quantizeMax(PxReal value, PxReal frameMin, PxReal frameMax, PxReal scale)
+{
+	if(scale==0.0f)
+		return SQ_QUANTIZATION_MAX;
+
+	const PxReal f = PxCeil((value - frameMin) / scale);
+	PxU32 q = !(f < PxReal(SQ_QUANTIZATION_MAX)) ? SQ_QUANTIZATION_MAX : f <= 0.0f ? 0 : PxU32(f);
+	while(q<SQ_QUANTIZATION_MAX && dequantizeMax(q, frameMax, scale) < value)
+		q++;
+	return PxU16(q);
+}
+
+void QuantizedAABBTreeNode::setChildBounds(PxU32 index, const PxBounds3& frame, const PxVec3& scale, const PxBounds3& bounds)
+{
+	minx[index] = quantizeMin(bounds.minimum.x, frame.minimum.x, scale.x);
+	miny[index] = quantizeMin(bounds.minimum.y, frame.minimum.y, scale.y);
+	minz[index] = quantizeMin(bounds.minimum.z, frame.minimum.z, scale.z);
+	maxx[index] = quantizeMax(bounds.maximum.x, frame.minimum.x, frame.maximum.x, scale.x);
+	maxy[index] = quantizeMax(bounds.maximum.y, frame.minimum.y, frame.maximum.y, scale.y);
+	maxz[index] = quantizeMax(bounds.maximum.z, frame.minimum.z, frame.maximum.z, scale.z);
+}
+
+void QuantizedAABBTreeNode::setEmpty(PxU32 index)
+{
+	minx[index] = miny[index] = minz[index] = SQ_QUANTIZATION_MAX;
+	maxx[index] = maxy[index] = maxz[index] = 0;
+	children[index] = EMPTY;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+QuantizedAABBTree::QuantizedAABBTree() : mNodes(NULL), mNbNodes(0)
+{
+	mBounds.setEmpty();
+}
+
+QuantizedAABBTree::~QuantizedAABBTree()
+{
+	release();
+}
+
+void QuantizedAABBTree::release()
+{
+	Ps::AlignedAllocator<64>().deallocate(mNodes);
+	mNodes = NULL;
+	mNbNodes = 0;
+	mBounds.setEmpty();
+}
+
+static PX_FORCE_INLINE PxReal computeHalfSurfaceArea(const AABBTreeNode* node)
+{
+	const PxVec3 e = node->getAABBExtents();
+	return e.x*e.y + e.y*e.z + e.z*e.x;
+}
+
+bool QuantizedAABBTree::build(const AABBTree& tree, const PxBounds3* boxes)
+{
+	release();
+
+	const AABBTreeNode* base = tree.getNodes();
+	const PxU32* indices = tree.getIndices();
+	if(!base || !tree.getNbNodes())
+		return false;
+
+	// Collapse the binary tree: each quad node is opened up to SIZE children by repeatedly replacing
+	// the internal child with the largest surface area by its two children.
+	struct PendingNode
+	{
+		const AABBTreeNode*	binaryNode;
+		PxU32				parent;
+		PxU32				slot;
+	};
+
+	Ps::Array<QuantizedAABBTreeNode, Ps::AlignedAllocator<64> > nodes;
+	nodes.reserve(tree.getNbNodes()/3 + 1);
+	Ps::Array<PendingNode> stack;
+
+	PendingNode root = { base, 0xffffffff, 0 };
+	stack.pushBack(root);
+	while(stack.size())
+	{
+		const PendingNode current = stack.popBack();
+
+		const PxU32 nodeIndex = nodes.size();
+		if(current.parent!=0xffffffff)
+			nodes[current.parent].children[current.slot] = nodeIndex;
+
+		const AABBTreeNode* candidates[QuantizedAABBTreeNode::SIZE];
+		PxU32 nbCandidates;
+		if(current.binaryNode->isLeaf())	// single primitive tree
+		{
+			candidates[0] = current.binaryNode;
+			nbCandidates = 1;
+		}
+		else
+		{
+			candidates[0] = current.binaryNode->getPos(base);
+			candidates[1] = current.binaryNode->getNeg(base);
+			nbCandidates = 2;
+			while(nbCandidates<QuantizedAABBTreeNode::SIZE)
+			{
+				PxU32 best = 0xffffffff;
+				PxReal bestArea = -1.0f;
+				for(PxU32 i=0;i<nbCandidates;i++)
+				{
+					if(candidates[i]->isLeaf())
+						continue;
+					const PxReal area = computeHalfSurfaceArea(candidates[i]);
+					if(area>bestArea)
+					{
+						bestArea = area;
+						best = i;
+					}
+				}
+				if(best==0xffffffff)
+					break;
+
+				const AABBTreeNode* opened = candidates[best];
+				candidates[best] = opened->getPos(base);
+				candidates[nbCandidates++] = opened->getNeg(base);
+			}
+		}
+
+		QuantizedAABBTreeNode& node = nodes.insert();
+		for(PxU32 i=0;i<QuantizedAABBTreeNode::SIZE;i++)
+			node.setEmpty(i);
+
+		for(PxU32 i=0;i<nbCandidates;i++)
+		{
+			if(candidates[i]->isLeaf())
+			{
+				const PxU32 primitive = *candidates[i]->getPrimitives(indices);
+				PX_ASSERT(!(primitive & QuantizedAABBTreeNode::LEAF_FLAG));
+				node.children[i] = primitive | QuantizedAABBTreeNode::LEAF_FLAG;
+			}
+			else
+				node.children[i] = 0;	// patched when the child node is emitted
+		}
+
+		// push in reverse order so that the first internal child is emitted right after its parent
+		for(PxU32 i=nbCandidates;i--;)
+		{
+			if(!candidates[i]->isLeaf())
+			{
+				PendingNode child = { candidates[i], nodeIndex, i };
+				stack.pushBack(child);
+			}
+		}
+	}
+
+	mNbNodes = nodes.size();
+	mNodes = reinterpret_cast<QuantizedAABBTreeNode*>(Ps::AlignedAllocator<64>().allocate(sizeof(QuantizedAABBTreeNode)*mNbNodes, __FILE__, __LINE__));
+	if(!mNodes)
+	{
+		mNbNodes = 0;
+		return false;
+	}
+	PxMemCopy(mNodes, nodes.begin(), sizeof(QuantizedAABBTreeNode)*mNbNodes);
+
+	refit(boxes);
+	return true;
+}
+
+void QuantizedAABBTree::refit(const PxBounds3* boxes)
+{
+	if(!mNbNodes)
+		return;
+
+	// Children always come after their parent, so a backward pass computes the exact bounds of each node
+	Ps::Array<PxBounds3> bounds;
+	bounds.resizeUninitialized(mNbNodes);
+	for(PxU32 i=mNbNodes;i--;)
+	{
+		const QuantizedAABBTreeNode& node = mNodes[i];
+		PxBounds3 nodeBounds = PxBounds3::empty();
+		for(PxU32 j=0;j<QuantizedAABBTreeNode::SIZE;j++)
+		{
+			if(node.isEmpty(j))
+				continue;
+			nodeBounds.include(node.isLeaf(j) ? boxes[node.getPrimitive(j)] : bounds[node.getChildNode(j)]);
+		}
+		bounds[i] = nodeBounds;
+	}
+
+	// and a forward pass quantizes each node's children against the node's frame. The frame of a child is its
+	// dequantized bounds, which overwrite the exact bounds after use.
+	mBounds = bounds[0];
+	for(PxU32 i=0;i<mNbNodes;i++)
+	{
+		QuantizedAABBTreeNode& node = mNodes[i];
+		const PxBounds3 frame = bounds[i];
+		const PxVec3 scale = computeQuantizationScale(frame);
+		for(PxU32 j=0;j<QuantizedAABBTreeNode::SIZE;j++)
+		{
+			if(node.isEmpty(j))
+				continue;
+
+			if(node.isLeaf(j))
+				node.setChildBounds(j, frame, scale, boxes[node.getPrimitive(j)]);
+			else
+			{
+				const PxU32 child = node.getChildNode(j);
+				PX_ASSERT(child>i);
+				node.setChildBounds(j, frame, scale, bounds[child]);
+				node.getChildBounds(j, frame, scale, bounds[child]);
+			}
+		}
+	}
+
+#ifdef PX_DEBUG
+	validate(boxes);
+#endif
+}
+
+#ifdef PX_DEBUG
+// verify that the dequantized bounds of every child contain the primitives below it
+void QuantizedAABBTree::validate(const PxBounds3* boxes) const
+{
+	struct Entry
+	{
+		PxU32		node;
+		PxBounds3	frame;
+	};
+
+	Ps::Array<Entry> stack;
+	Entry root = { 0, mBounds };
+	stack.pushBack(root);
+	while(stack.size())
+	{
+		const Entry current = stack.popBack();
+		const QuantizedAABBTreeNode& node = mNodes[current.node];
+		const PxVec3 scale = computeQuantizationScale(current.frame);
+		for(PxU32 j=0;j<QuantizedAABBTreeNode::SIZE;j++)
+		{
+			if(node.isEmpty(j))
+				continue;
+
+			Entry child;
+			node.getChildBounds(j, current.frame, scale, child.frame);
+			PX_ASSERT(child.frame.isInside(current.frame));
+			if(node.isLeaf(j))
+			{
+				PX_ASSERT(boxes[node.getPrimitive(j)].isInside(child.frame));
+			}
+			else
+			{
+				child.node = node.getChildNode(j);
+				PX_ASSERT(child.node>current.node && child.node<mNbNodes);
+				stack.pushBack(child);
+			}
+		}
+	}
+}
+#endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2008-2015, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef SQ_QUANTIZED_AABBTREE_H
+#define SQ_QUANTIZED_AABBTREE_H
+
+#include "CmPhysXCommon.h"
+#include "PxBounds3.h"
+#include "PsUserAllocated.h"
+
+#define SQ_QUANTIZED_NODE_SIZE	4		// changing this number changes the node layout, it has to fill exactly one 64 bytes cache line
+#define SQ_QUANTIZATION_MAX		65535
+
+namespace physx
+{
+namespace Sq
+{
+	class AABBTree;
+
+	// Scale used to dequantize the child bounds of a node from the node's own (dequantized) bounds, the "frame".
+	// Build and traversal code must both go through this function and dequantizeMin/Max so they see bit-identical boxes.
+	// Frames too large to be quantized get a zero scale, their children then conservatively dequantize to the full frame.
+	PX_FORCE_INLINE PxVec3 computeQuantizationScale(const PxBounds3& frame)
+	{
+		PxVec3 scale = (frame.maximum - frame.minimum) * (1.0f/PxReal(SQ_QUANTIZATION_MAX));
+		// also catches NaNs
+		if(!(scale.x <= PX_MAX_F32))	scale.x = 0.0f;
+		if(!(scale.y <= PX_MAX_F32))	scale.y = 0.0f;
+		if(!(scale.z <= PX_MAX_F32))	scale.z = 0.0f;
+		return scale;
+	}
+
+	// the min bound is relative to the frame's min and the max bound to the frame's max,
+	// so that 0 and SQ_QUANTIZATION_MAX always dequantize exactly to the frame bounds.
+	PX_FORCE_INLINE PxReal dequantizeMin(PxU32 q, PxReal frameMin, PxReal scale)	{ return frameMin + PxReal(q)*scale;							}
+	PX_FORCE_INLINE PxReal dequantizeMax(PxU32 q, PxReal frameMax, PxReal scale)	{ return frameMax - PxReal(SQ_QUANTIZATION_MAX-q)*scale;	}
+
+	/////////////////////////////////////////////////////////////////////////
+	// QuantizedAABBTreeNode holds SQ_QUANTIZED_NODE_SIZE transposed children in one cache line.
+	// Child bounds are stored as 16-bit values relative to the bounds of the node itself, which in turn
+	// are the dequantized child bounds stored in the parent node (or the tree bounds for the root).
+	PX_ALIGN_PREFIX(64)
+	struct QuantizedAABBTreeNode
+	{
+		enum { SIZE = SQ_QUANTIZED_NODE_SIZE };
+		enum { EMPTY = 0xffffffff, LEAF_FLAG = 0x80000000 };
+
+		PxU16	minx[SIZE];	// [min=SQ_QUANTIZATION_MAX, max=0] is used for empty slots
+		PxU16	miny[SIZE];
+		PxU16	minz[SIZE];
+		PxU16	maxx[SIZE];
+		PxU16	maxy[SIZE];
+		PxU16	maxz[SIZE];
+		PxU32	children[SIZE];	// EMPTY, LEAF_FLAG|primitive index, or index of the child node. Empty slots are always last.
+
+		PX_FORCE_INLINE	bool	isEmpty(PxU32 index)		const	{ return children[index]==EMPTY;									}
+		PX_FORCE_INLINE	PxU32	isLeaf(PxU32 index)			const	{ PX_ASSERT(!isEmpty(index)); return children[index] & LEAF_FLAG;	}
+		PX_FORCE_INLINE	PxU32	getPrimitive(PxU32 index)	const	{ PX_ASSERT(isLeaf(index)); return children[index] & ~LEAF_FLAG;	}
+		PX_FORCE_INLINE	PxU32	getChildNode(PxU32 index)	const	{ PX_ASSERT(!isLeaf(index)); return children[index];				}
+
+		PX_FORCE_INLINE	void	getChildBounds(PxU32 index, const PxBounds3& frame, const PxVec3& scale, PxBounds3& bounds) const
+		{
+			bounds.minimum = PxVec3(dequantizeMin(minx[index], frame.minimum.x, scale.x),
+									dequantizeMin(miny[index], frame.minimum.y, scale.y),
+									dequantizeMin(minz[index], frame.minimum.z, scale.z));
+			bounds.maximum = PxVec3(dequantizeMax(maxx[index], frame.maximum.x, scale.x),
+									dequantizeMax(maxy[index], frame.maximum.y, scale.y),
+									dequantizeMax(maxz[index], frame.maximum.z, scale.z));
+		}
+
+						void	setChildBounds(PxU32 index, const PxBounds3& frame, const PxVec3& scale, const PxBounds3& bounds);
+						void	setEmpty(PxU32 index);
+	} PX_ALIGN_SUFFIX(64);
+
+	/////////////////////////////////////////////////////////////////////////
+	// Read-only 4-wide tree with quantized bounds, used by the static pruner to cut memory and cache misses.
+	// Nodes are stored in depth-first order, the first internal child of a node always directly follows it.
+	// The hierarchy is fixed once built, refit() only recomputes the quantized bounds.
+	class QuantizedAABBTree : public Ps::UserAllocated
+	{
+		public:
+											QuantizedAABBTree();
+											~QuantizedAABBTree();
+
+		// Converts a complete AABB tree (a single primitive per leaf) built over 'boxes'. The source tree is not referenced afterwards.
+						bool				build(const AABBTree& tree, const PxBounds3* boxes);
+		// Recomputes the quantized bounds from new primitive bounds, e.g. after shifting the origin
+						void				refit(const PxBounds3* boxes);
+						void				release();
+
+		PX_FORCE_INLINE	const QuantizedAABBTreeNode*	getNodes()		const	{ return mNodes;	}
+		PX_FORCE_INLINE	PxU32							getNbNodes()	const	{ return mNbNodes;	}
+		// Bounds of the whole tree, i.e. the frame of the root node
+		PX_FORCE_INLINE	const PxBounds3&				getBounds()		const	{ return mBounds;	}
+		PX_FORCE_INLINE	PxU32							getUsedBytes()	const	{ return sizeof(QuantizedAABBTreeNode)*mNbNodes;	}
+#ifdef PX_DEBUG
+						void				validate(const PxBounds3* boxes) const;
+#endif
+		private:
+						QuantizedAABBTreeNode*	mNodes;
+						PxU32					mNbNodes;
+						PxBounds3				mBounds;
+	};
+
+} // namespace Sq
+
+}
+
+#endif // SQ_QUANTIZED_AABBTREE_H
@@ -52,6 +52,13 @@ SceneQueryManager::SceneQueryManager(Scb::Scene& scene, const PxSceneDesc& desc)
 
 	setDynamicTreeRebuildRateHint(desc.dynamicTreeRebuildRateHint);
 
+	mRebuildQualityThreshold = desc.dynamicTreeRebuildQualityThreshold;
+	for(PxU32 i=0;i<2;i++)
+	{
+		if(mPruners[i] && mPrunerType[i] == PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE)
+			static_cast<AABBPruner*>(mPruners[i])->setRebuildQualityThreshold(mRebuildQualityThreshold);
+	}
+
 	preallocate(desc.limits.maxNbStaticShapes, desc.limits.maxNbDynamicShapes);
 }
 
@@ -67,8 +74,10 @@ Pruner* SceneQueryManager::createPruner(PxPruningStructure::Enum type)
 	switch(type)
 	{
 		case PxPruningStructure::eSTATIC_AABB_TREE:		return PX_NEW(AABBPruner)(false);
+		case PxPruningStructure::eSTATIC_QUANTIZED_AABB_TREE:	return PX_NEW(AABBPruner)(false, true);
 		case PxPruningStructure::eNONE:					return PX_NEW(BucketPruner);
 		case PxPruningStructure::eDYNAMIC_AABB_TREE:	return PX_NEW(AABBPruner)(true);
+		case PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE:	return PX_NEW(AABBPruner)(true, false, true);
 		case PxPruningStructure::eLAST:
 		default:										break;
 	}
@@ -132,6 +141,55 @@ ActorShape* SceneQueryManager::addShape(const NpShape& shape, const PxRigidActor
 	return createRef(index, handle);
 }
 
+void SceneQueryManager::addShapes(const ShapeInsertion* shapes, PxU32 nbShapes, bool dynamic)
+{
+	if(!nbShapes)
+		return;
+
+	PxU32 index = (PxU32)dynamic;
+	PX_ASSERT(mPruners[index]);
+
+	Ps::Array<PrunerPayload> payloads PX_DEBUG_EXP("SQaddShapesPayloads");
+	Ps::Array<PxBounds3> bounds PX_DEBUG_EXP("SQaddShapesBounds");
+	Ps::Array<PrunerHandle> handles PX_DEBUG_EXP("SQaddShapesHandles");
+	payloads.resizeUninitialized(nbShapes);
+	bounds.resizeUninitialized(nbShapes);
+	handles.resizeUninitialized(nbShapes);
+
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		const Scb::Shape& scbShape = shapes[i].shape->getScbShape();
+		const Scb::Actor& scbActor = gOffsetTable.convertPxActor2Scb(*shapes[i].actor);
+		payloads[i].data[0] = (size_t)&scbShape;
+		payloads[i].data[1] = (size_t)&scbActor;
+
+		if(shapes[i].hasBounds)
+			bounds[i] = inflateBounds(shapes[i].bounds);
+		else
+			bounds[i] = Sq::computeWorldAABB(scbShape, scbActor);
+	}
+
+	mPruners[index]->addObjects(handles.begin(), bounds.begin(), payloads.begin(), nbShapes);
+	mTimestamp[index]++;
+
+	// same invariant as in addShape(), the dirty map only needs to cover the largest new handle
+	PrunerHandle maxHandle = 0;
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		if(handles[i]!=INVALID_PRUNERHANDLE)
+			maxHandle = PxMax(maxHandle, handles[i]);
+	}
+	if(mDirtyMap[index].size() <= maxHandle)
+		mDirtyMap[index].resize(PxMax<PxU32>(PxMax<PxU32>(mDirtyMap[index].size() * 2, 1024), maxHandle+1));
+
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		if(handles[i]!=INVALID_PRUNERHANDLE)
+			mDirtyMap[index].reset(handles[i]);
+		*shapes[i].data = createRef(index, handles[i]);
+	}
+}
+
 const PrunerPayload& SceneQueryManager::getPayload(const ActorShape* ref) const
 {
 	PxU32 index = getPrunerIndex(ref);
@@ -163,7 +221,7 @@ void SceneQueryManager::setDynamicTreeRebuildRateHint(PxU32 rebuildRateHint)
 
 	for(PxU32 i=0;i<2;i++)
 	{
-		if(mPruners[i] && mPrunerType[i] == PxPruningStructure::eDYNAMIC_AABB_TREE)
+		if(mPruners[i] && isDynamicTree(mPrunerType[i]))
 			static_cast<AABBPruner*>(mPruners[i])->setRebuildRateHint(rebuildRateHint);
 	}
 }
@@ -254,12 +312,17 @@ void SceneQueryManager::processSimUpdates()
 	// flush user modified objects
 	flushShapes();
 
+	// we are on the thread calling fetchResults(), full tree rebuilds can run on the scene's workers
+	PxTaskManager* taskManager = mScene.getScScene().getTaskManagerPtr();
 	for(PxU32 i=0;i<2;i++)
 	{
-		if(mPruners[i] && mPrunerType[i] == PxPruningStructure::eDYNAMIC_AABB_TREE)
+		if(mPruners[i] && isDynamicTree(mPrunerType[i]))
 			static_cast<AABBPruner*>(mPruners[i])->buildStep();
 
-		mPruners[i]->commit();
+		if(mPrunerType[i] != PxPruningStructure::eNONE)
+			static_cast<AABBPruner*>(mPruners[i])->commit(taskManager);
+		else
+			mPruners[i]->commit();
 	}
 }
 
@@ -303,14 +366,26 @@ void SceneQueryManager::forceDynamicTreeRebuild(bool rebuildStaticStructure, boo
 	Ps::Mutex::ScopedLock lock(mSceneQueryLock);
 	for(PxU32 i=0; i<2; i++)
 	{
-		if(rebuild[i] && mPruners[i] && mPrunerType[i] == PxPruningStructure::eDYNAMIC_AABB_TREE)
+		if(rebuild[i] && mPruners[i] && isDynamicTree(mPrunerType[i]))
 		{
 			static_cast<AABBPruner*>(mPruners[i])->purge();
-			static_cast<AABBPruner*>(mPruners[i])->commit();
+			static_cast<AABBPruner*>(mPruners[i])->commit(mScene.getScScene().getTaskManagerPtr());
 		}
 	}
 }
 
+void SceneQueryManager::getPruningStructureStatistics(PxPruningStructureStatistics& staticStats, PxPruningStructureStatistics& dynamicStats) const
+{
+	PxPruningStructureStatistics* stats[2] = { &staticStats, &dynamicStats };
+	for(PxU32 i=0; i<2; i++)
+	{
+		if(mPruners[i] && mPrunerType[i] != PxPruningStructure::eNONE)
+			static_cast<const AABBPruner*>(mPruners[i])->getStatistics(*stats[i]);
+		else
+			*stats[i] = PxPruningStructureStatistics();
+	}
+}
+
 void SceneQueryManager::shiftOrigin(const PxVec3& shift)
 {
 	mPruners[0]->shiftOrigin(shift);
@@ -63,6 +63,16 @@ namespace Sq
 	};
 	extern OffsetTable gOffsetTable;
 
+	// shape queued for SceneQueryManager::addShapes()
+	struct ShapeInsertion
+	{
+		const NpShape*		shape;
+		const PxRigidActor*	actor;
+		ActorShape**		data;		// receives the created ActorShape
+		PxBounds3			bounds;		// simulation bounds, computed from the shape's pose if hasBounds is false
+		bool				hasBounds;
+	};
+
 	class SceneQueryManager : public Ps::UserAllocated
 	{
 		PX_NOCOPY(SceneQueryManager)
@@ -71,6 +81,8 @@ namespace Sq
 														~SceneQueryManager();
 
 						ActorShape*						addShape(const NpShape& shape, const PxRigidActor& actor, bool dynamic, PxBounds3* bounds=NULL);
+						// batched addShape(), used for PxScene::addActors(): all shapes go to the pruner in a single addObjects() call
+						void							addShapes(const ShapeInsertion* shapes, PxU32 nbShapes, bool dynamic);
 						void							removeShape(ActorShape* shapeData);
 						const PrunerPayload&			getPayload(const ActorShape* shapeData) const;
 						// returns true if current combination of pruners is accepted on SPU:
@@ -104,6 +116,7 @@ namespace Sq
 						
 						void							flushUpdates();
 						void							forceDynamicTreeRebuild(bool rebuildStaticStructure, bool rebuildDynamicStructure);
+						void							getPruningStructureStatistics(PxPruningStructureStatistics& staticStats, PxPruningStructureStatistics& dynamicStats) const;
 
 		// Force a rebuild of the aabb/loose octree etc to allow raycasting on multiple threads.
 						void							processSimUpdates();
@@ -123,6 +136,7 @@ namespace Sq
 
 						PxPruningStructure::Enum		mPrunerType[2];
 						PxU32							mRebuildRateHint;
+						PxReal							mRebuildQualityThreshold;
 
 						Scb::Scene&						mScene;
 
@@ -140,6 +154,8 @@ namespace Sq
 		static ActorShape* createRef(PxU32 index, PxU32 handle)	{ return reinterpret_cast<ActorShape*>(size_t((handle<<2) | 2 | index));	}
 
 		static Pruner*									createPruner(PxPruningStructure::Enum type);
+		// true for the structures that rebuild their tree over several frames
+		static bool										isDynamicTree(PxPruningStructure::Enum type)	{ return type == PxPruningStructure::eDYNAMIC_AABB_TREE || type == PxPruningStructure::eDYNAMIC_REFIT_AABB_TREE;	}
 	};
 
 } // namespace Sq
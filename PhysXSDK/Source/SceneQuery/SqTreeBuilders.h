@@ -35,6 +35,7 @@ namespace Sq
 		SPLIT_BEST_AXIS			= (1<<2),		//!< Try largest axis, then second, then last
 		SPLIT_BALANCED			= (1<<3),		//!< Try to keep a well-balanced tree
 		SPLIT_FIFTY				= (1<<4),		//!< Arbitrary 50-50 split
+		SPLIT_SAH				= (1<<5),		//!< Binned surface area heuristic on primitive centers
 		//
 		SPLIT_FORCE_DWORD		= 0x7fffffff
 	};
@@ -1084,6 +1084,7 @@ void Sc::Scene::collideStep(PxBaseTask* continuation)
 	PIX_PROFILE_ZONE(collideStep)
 
 	mStats->simStart();
+	mStats->setNbWorkerThreads(continuation->getTaskManager()->getCpuDispatcher()->getWorkerCount());
 	getInteractionScene().getLowLevelContext()->beginUpdate();
 
 	prepareParticleSystems();
@@ -1156,6 +1157,7 @@ void Sc::Scene::clothPreprocessing(PxBaseTask* /*continuation*/)
 void Sc::Scene::broadPhase(PxBaseTask* continuation)
 {
 	CM_PROFILE_START_CROSSTHREAD(getEventProfiler(), Cm::ProfileEventId::Basic::GetbroadPhase())
+	mStats->startPhase(PxSimulationStatistics::eBROAD_PHASE);
 #if PX_USE_CLOTH_API
 	for (PxU32 i = 0; i < mCloths.size(); ++i)
 		mCloths[i]->getSim()->updateBounds();
@@ -1180,12 +1182,14 @@ void Sc::Scene::postBroadPhase(PxBaseTask* /*continuation*/)
 
 	// reset thread context before any tasks are spawned that fetch it (see US6664)
 	getInteractionScene().getLowLevelContext()->resetThreadContexts();
+	mStats->endPhase(PxSimulationStatistics::eBROAD_PHASE);
 	CM_PROFILE_STOP_CROSSTHREAD(getEventProfiler(), Cm::ProfileEventId::Basic::GetbroadPhase())
 } 
 
 void Sc::Scene::rigidBodyNarrowPhase(PxBaseTask* continuation)
 {
 	CM_PROFILE_START_CROSSTHREAD(getEventProfiler(), Cm::ProfileEventId::Basic::GetnarrowPhase())
+	mStats->startPhase(PxSimulationStatistics::eNARROW_PHASE);
 	PxsContext* context=getInteractionScene().getLowLevelContext();
 	context->updateContactManager(mDt, continuation); // Starts update of contact managers
 }
@@ -1207,6 +1211,7 @@ void Sc::Scene::postNarrowPhase(PxBaseTask* /*continuation*/)
 #ifdef PX_PS3
 	stopTimerMarker(ePOSTNARROWPHASE);
 #endif
+	mStats->endPhase(PxSimulationStatistics::eNARROW_PHASE);
 	CM_PROFILE_STOP_CROSSTHREAD(getEventProfiler(), Cm::ProfileEventId::Basic::GetnarrowPhase())
 	CM_PROFILE_STOP_CROSSTHREAD(getEventProfiler(), Cm::ProfileEventId::Basic::Getcollision())
 }
@@ -1260,6 +1265,7 @@ void Sc::Scene::processNarrowPhaseTouchEvents()
 void Sc::Scene::islandGen(PxBaseTask* continuation)
 {
 	CM_PROFILE_START_CROSSTHREAD(getEventProfiler(), Cm::ProfileEventId::Basic::GetrigidBodySolver())
+	mStats->startPhase(PxSimulationStatistics::eISLAND_GEN);
 	PxsContext* context = getInteractionScene().getLowLevelContext();
 
 	processNarrowPhaseTouchEvents();
@@ -1451,6 +1457,9 @@ void Sc::Scene::postIslandGenSecondPass(PxBaseTask*)
 
 void Sc::Scene::solver(PxBaseTask* continuation)
 {
+	mStats->endPhase(PxSimulationStatistics::eISLAND_GEN);
+	mStats->startPhase(PxSimulationStatistics::eSOLVER);
+
 #ifdef PX_PS3
 	startTimerMarker(eBEFORESOLVER);
 #endif
@@ -1505,6 +1514,7 @@ void Sc::Scene::updateDynamics(PxBaseTask* continuation)
 void Sc::Scene::updateCCDMultiPass(PxBaseTask* parentContinuation)
 {
 	CM_PROFILE_ZONE_WITH_SUBSYSTEM(*this,Sim,updateCCDMultiPass);
+	mStats->startPhase(PxSimulationStatistics::eCCD);
 
 	{
 		CM_PROFILE_ZONE_WITH_SUBSYSTEM(*this,IslandGen,freeBuffers);
@@ -1611,6 +1621,9 @@ void Sc::Scene::updateCCDSinglePass(PxBaseTask* continuation)
 
 void Sc::Scene::postSolver(PxBaseTask* continuation)
 {
+	mStats->endPhase(PxSimulationStatistics::eSOLVER);
+	mStats->startPhase(PxSimulationStatistics::ePOST_SOLVER);
+
 	PxsContext* llContext = getInteractionScene().getLowLevelContext();
 	PxcNpMemBlockPool& blockPool = llContext->getNpMemBlockPool();
 
@@ -1629,6 +1642,8 @@ void Sc::Scene::postSolver(PxBaseTask* continuation)
 
 #if PX_ENABLE_SIM_STATS
 	llContext->getSimStats().mPeakConstraintBlockAllocations = blockPool.getPeakConstraintBlockCount();
+	llContext->getSimStats().mNbContactDataBlocks = blockPool.getAllocatedBlockCount();
+	llContext->getSimStats().mNbContactDataBlocksOverLimit = blockPool.getPeakBlocksOverLimit();
 #endif
 
 	// - Performs joint projection
@@ -1637,6 +1652,8 @@ void Sc::Scene::postSolver(PxBaseTask* continuation)
 	afterIntegration(continuation);
 	// - Updates touch flags
 	afterSolver(0); 		
+
+	mStats->endPhase(PxSimulationStatistics::ePOST_SOLVER);
 }
 
 void Sc::Scene::postCCDPass(PxBaseTask* /*continuation*/)
@@ -1714,6 +1731,9 @@ void Sc::Scene::finalizationPhase(PxBaseTask* /*continuation*/)
 {
 	CM_PROFILE_ZONE_WITH_SUBSYSTEM(*this,Sim,sceneFinalization);
 
+	if(mPublicFlags & PxSceneFlag::eENABLE_CCD)
+		mStats->endPhase(PxSimulationStatistics::eCCD);
+
 	{
 		CM_PROFILE_ZONE_WITH_SUBSYSTEM(*this,IslandGen,freeBuffers);
 		getInteractionScene().getLLIslandManager().freeBuffers();
@@ -14,6 +14,7 @@
 #include "ScSimStats.h"
 #include "PxvSimStats.h"
 #include "PxMemory.h"
+#include "PsTime.h"
 
 using namespace physx;
 
@@ -23,6 +24,8 @@ Sc::SimStats::SimStats()
 {
 	PxMemZero(&numBroadPhaseAdds, sBroadphaseAddRemoveSize);
 	PxMemZero(&numBroadPhaseRemoves, sBroadphaseAddRemoveSize);
+	PxMemZero(&phaseTimings, sizeof(phaseTimings));
+	nbWorkerThreads = 0;
 
 	clear();
 }
@@ -46,6 +49,37 @@ void Sc::SimStats::simStart()
 	PxMemMove(numBroadPhaseAdds, numBroadPhaseAddsPending, sBroadphaseAddRemoveSize);
 	PxMemMove(numBroadPhaseRemoves, numBroadPhaseRemovesPending, sBroadphaseAddRemoveSize);
 	clear();
+
+	PxMemZero(&phaseTimings, sizeof(phaseTimings));
+#endif
+}
+
+
+void Sc::SimStats::startPhase(PxSimulationStatistics::PhaseType phase)
+{
+#if PX_ENABLE_SIM_STATS
+	PhaseTiming& t = phaseTimings[phase];
+	t.startSample = Cm::TaskStatistics::sample();
+	t.startCounter = Ps::Time::getCurrentCounterValue();
+#else
+	PX_UNUSED(phase);
+#endif
+}
+
+
+void Sc::SimStats::endPhase(PxSimulationStatistics::PhaseType phase)
+{
+#if PX_ENABLE_SIM_STATS
+	const PxU64 endCounter = Ps::Time::getCurrentCounterValue();
+	const Cm::TaskStatistics::Sample endSample = Cm::TaskStatistics::sample();
+
+	PhaseTiming& t = phaseTimings[phase];
+	const PxReal tensOfNanosToSeconds = 1.0f / PxReal(Ps::Time::sNumTensOfNanoSecondsInASecond);
+	t.time = PxReal(Ps::Time::getBootCounterFrequency().toTensOfNanos(endCounter - t.startCounter)) * tensOfNanosToSeconds;
+	t.taskTime = PxReal(endSample.taskTime - t.startSample.taskTime) * tensOfNanosToSeconds;
+	t.nbTasks = endSample.nbTasks - t.startSample.nbTasks;
+#else
+	PX_UNUSED(phase);
 #endif
 }
 
@@ -112,5 +146,22 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.peakConstraintMemory = simStats.mPeakConstraintBlockAllocations * 16 * 1024;
 	s.compressedContactSize = simStats.mTotalCompressedContactSize;
 	s.requiredContactConstraintMemory = simStats.mTotalConstraintSize;
+	s.nbContactDataBlocks = simStats.mNbContactDataBlocks;
+	s.nbContactDataBlocksOverLimit = simStats.mNbContactDataBlocksOverLimit;
+	s.peakNarrowPhaseThreadMemory = simStats.mPeakNpThreadMemory;
+
+	PX_COMPILE_TIME_ASSERT(PxU32(PxvSimStats::eSOLVER_PARTITION_SIZE_BUCKETS) == PxU32(PxSimulationStatistics::eSOLVER_PARTITION_SIZE_BUCKETS));
+	s.nbSolverPartitions = simStats.numSolverPartitions;
+	s.maxSolverPartitionSize = simStats.maxSolverPartitionSize;
+	for(PxU32 i=0; i < PxSimulationStatistics::eSOLVER_PARTITION_SIZE_BUCKETS; i++)
+		s.nbSolverPartitionsBySize[i] = simStats.numSolverPartitionsBySize[i];
+
+	s.nbWorkerThreads = nbWorkerThreads;
+	for(PxU32 i=0; i < PxSimulationStatistics::ePHASE_COUNT; i++)
+	{
+		s.phaseTime[i] = phaseTimings[i].time;
+		s.nbPhaseTasks[i] = phaseTimings[i].nbTasks;
+		s.phaseTaskTime[i] = phaseTimings[i].taskTime;
+	}
 #endif
 }
@@ -19,6 +19,7 @@
 #include "CmPhysXCommon.h"
 #include "PxGeometry.h"
 #include "PxSimulationStatistics.h"
+#include "CmTaskStatistics.h"
 
 namespace physx
 {
@@ -56,6 +57,15 @@ namespace Sc
 			numBroadPhaseRemovesPending[v]++;
 		}
 
+		PX_INLINE void setNbWorkerThreads(PxU32 nb)
+		{
+			nbWorkerThreads = nb;
+		}
+
+		// the phases run one after the other, each phase can start and end on a different thread
+		void startPhase(PxSimulationStatistics::PhaseType phase);
+		void endPhase(PxSimulationStatistics::PhaseType phase);
+
 	private:
 		// Broadphase adds/removes for the current simulation step
 		PxU32	numBroadPhaseAdds[PxSimulationStatistics::eVOLUME_COUNT];
@@ -66,6 +76,18 @@ namespace Sc
 		PxU32	numBroadPhaseRemovesPending[PxSimulationStatistics::eVOLUME_COUNT];
 
 		PxU32   numTriggerPairs[PxGeometryType::eCONVEXMESH+1][PxGeometryType::eGEOMETRY_COUNT];
+
+		// Phase timings for the current simulation step
+		struct PhaseTiming
+		{
+			PxU64						startCounter;
+			Cm::TaskStatistics::Sample	startSample;
+			PxReal						time;
+			PxReal						taskTime;
+			PxU32						nbTasks;
+		};
+		PhaseTiming	phaseTimings[PxSimulationStatistics::ePHASE_COUNT];
+		PxU32		nbWorkerThreads;
 	};
 
 } // namespace Sc
@@ -28,6 +28,7 @@ PhysXCommon_cppfiles   += ./../../Common/src/CmFreeListAllocator.cpp
 PhysXCommon_cppfiles   += ./../../Common/src/CmMathUtils.cpp
 PhysXCommon_cppfiles   += ./../../Common/src/CmPtrTable.cpp
 PhysXCommon_cppfiles   += ./../../Common/src/CmRenderOutput.cpp
+PhysXCommon_cppfiles   += ./../../Common/src/CmTaskStatistics.cpp
 PhysXCommon_cppfiles   += ./../../Common/src/CmVisualization.cpp
 PhysXCommon_cppfiles   += ./../../GeomUtils/src/GuBox.cpp
 PhysXCommon_cppfiles   += ./../../GeomUtils/src/GuBoxPruning.cpp
@@ -6,6 +6,7 @@ SceneQuery_cppfiles   += ./../../SceneQuery/SqAABBTree.cpp
 SceneQuery_cppfiles   += ./../../SceneQuery/SqAABBTreeUpdateMap.cpp
 SceneQuery_cppfiles   += ./../../SceneQuery/SqBucketPruner.cpp
 SceneQuery_cppfiles   += ./../../SceneQuery/SqPruningPool.cpp
+SceneQuery_cppfiles   += ./../../SceneQuery/SqQuantizedAABBTree.cpp
 SceneQuery_cppfiles   += ./../../SceneQuery/SqSceneQueryManager.cpp
 SceneQuery_cppfiles   += ./../../SceneQuery/SqUtilities.cpp
 
@@ -17,10 +17,16 @@
 #include "Ps.h"
 
 namespace physx { namespace shdfnd {
-	class Cpu
+	class PX_FOUNDATION_API Cpu
 	{
 	public:
 		static PxU8 getCpuId();
+
+		// True if both the CPU and the OS support AVX. This executes cpuid, so callers should cache the result.
+		static bool hasAVX();
+
+		// True if both the CPU and the OS support AVX2. This executes cpuid, so callers should cache the result.
+		static bool hasAVX2();
 	};
 }}
 
@@ -26,6 +26,23 @@
 	#define cpuid(op, reg) reg[0]=reg[1]=reg[2]=reg[3]=0;
 #endif
 
+#if defined(PX_X86)
+#define cpuidex(op, subop, reg)\
+    __asm__ __volatile__("pushl %%ebx      \n\t" /* save %ebx */\
+                 "cpuid            \n\t"\
+                 "movl %%ebx, %1   \n\t" /* save what cpuid just put in %ebx */\
+                 "popl %%ebx       \n\t" /* restore the old %ebx */\
+                 : "=a"(reg[0]), "=r"(reg[1]), "=c"(reg[2]), "=d"(reg[3])\
+                 : "a"(op), "c"(subop)\
+                 : "cc")
+#elif defined(PX_X64)
+#define cpuidex(op, subop, reg)\
+    __asm__ __volatile__("cpuid"\
+                 : "=a"(reg[0]), "=b"(reg[1]), "=c"(reg[2]), "=d"(reg[3])\
+                 : "a"(op), "c"(subop)\
+                 : "cc")
+#endif
+
 namespace physx { namespace shdfnd {
 
 	physx::PxU8 Cpu::getCpuId()
@@ -34,4 +51,36 @@ namespace physx { namespace shdfnd {
 		cpuid(1, cpuInfo);
 		return static_cast<physx::PxU8>(  cpuInfo[1] >> 24 ); // APIC Physical ID
 	}
+
+	bool Cpu::hasAVX()
+	{
+#if defined(PX_X86) || defined(PX_X64)
+		// AVX and OSXSAVE, then check that the OS saves the YMM registers
+		PxU32 cpuInfo[4];
+		cpuidex(1, 0, cpuInfo);
+		if((cpuInfo[2] & (1<<27 | 1<<28)) != (1<<27 | 1<<28))
+			return false;
+		PxU32 xcr0, xcr0High;
+		__asm__ __volatile__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+		PX_UNUSED(xcr0High);
+		return (xcr0 & 6) == 6;
+#else
+		return false;
+#endif
+	}
+
+	bool Cpu::hasAVX2()
+	{
+#if defined(PX_X86) || defined(PX_X64)
+		PxU32 cpuInfo[4];
+		cpuidex(0, 0, cpuInfo);
+		if(cpuInfo[0] < 7 || !hasAVX())
+			return false;
+
+		cpuidex(7, 0, cpuInfo);
+		return (cpuInfo[1] & (1<<5)) != 0;
+#else
+		return false;
+#endif
+	}
 }}
@@ -32,6 +32,16 @@ namespace physx { namespace shdfnd {
 		cpuid(cpuInfo);
 		return static_cast<physx::PxU8>(  cpuInfo[1] >> 24 ); // APIC Physical ID
 	}
+
+	bool Cpu::hasAVX()
+	{
+		return false;
+	}
+
+	bool Cpu::hasAVX2()
+	{
+		return false;
+	}
 #else
 	PxU8 Cpu::getCpuId()
 	{
@@ -40,5 +50,26 @@ namespace physx { namespace shdfnd {
 		__cpuid(CPUInfo, InfoType);
 		return static_cast<PxU8>(  CPUInfo[1] >> 24 ); // APIC Physical ID
 	}
+
+	bool Cpu::hasAVX()
+	{
+		// AVX and OSXSAVE, then check that the OS saves the YMM registers
+		int CPUInfo[4];
+		__cpuid(CPUInfo, 1);
+		if((CPUInfo[2] & (1<<27 | 1<<28)) != (1<<27 | 1<<28))
+			return false;
+		return (_xgetbv(0) & 6) == 6;
+	}
+
+	bool Cpu::hasAVX2()
+	{
+		int CPUInfo[4];
+		__cpuid(CPUInfo, 0);
+		if(CPUInfo[0] < 7 || !hasAVX())
+			return false;
+
+		__cpuidex(CPUInfo, 7, 0);
+		return (CPUInfo[1] & (1<<5)) != 0;
+	}
 #endif
 }}